@@ -3,6 +3,7 @@
 #include "Logger.h"
 #include "../network/HttpClient.h"
 #include "../services/LogUploader.h"
+#include "../services/MayaBatchRunner.h"
 #include <QDir>
 #include <QStandardPaths>
 #include <QTimer>
@@ -39,6 +40,13 @@ void Application::initialize()
     // 加载配置
     m_config->load();
 
+    // 日志轮转和归档保留策略
+    Logger::RotationPolicy logPolicy;
+    logPolicy.maxFileBytes = m_config->logMaxFileSize();
+    logPolicy.maxArchiveBytes = m_config->logArchiveMaxSize();
+    logPolicy.maxArchiveDays = m_config->logArchiveDays();
+    m_logger->setRotationPolicy(logPolicy);
+
     // 从 .env 文件加载 OSS 配置（如果还没有配置）
     if (m_config->ossAccessKey().isEmpty()) {
         loadOssConfigFromEnv();
@@ -46,6 +54,7 @@ void Application::initialize()
 
     // 配置 HTTP 客户端
     HttpClient::instance().setBaseUrl(m_config->apiBaseUrl());
+    HttpClient::instance().setHttp2Enabled(m_config->http2Enabled());
     m_logger->info("Application", QString("API Base URL: %1").arg(m_config->apiBaseUrl()));
 
     // 创建必要的目录
@@ -65,8 +74,12 @@ void Application::uploadLogsToOSS()
 {
     m_logger->info("Application", QString::fromUtf8("开始上传日志文件到 OSS"));
 
-    // 获取所有日志文件
-    QStringList logFiles = m_logger->getAllLogFiles();
+    // 水位线之后的归档，以及当前日志文件中新写入的部分（上传器按文件记录已上传的偏移）
+    m_logger->flush();
+    QStringList logFiles = m_logger->pendingUploads();
+    if (!m_logger->currentLogFilePath().isEmpty()) {
+        logFiles.append(m_logger->currentLogFilePath());
+    }
 
     if (logFiles.isEmpty()) {
         m_logger->info("Application", QString::fromUtf8("没有日志文件需要上传"));
@@ -75,6 +88,7 @@ void Application::uploadLogsToOSS()
 
     // 创建日志上传器
     LogUploader* uploader = new LogUploader(this);
+    uploader->setStateFile(m_logger->archiveDirectory() + "/upload.offsets");
 
     // 连接信号
     connect(uploader, &LogUploader::allLogsUploaded, this, [this, uploader]() {
@@ -82,6 +96,10 @@ void Application::uploadLogsToOSS()
         uploader->deleteLater();
     });
 
+    connect(uploader, &LogUploader::logUploaded, this, [this](const QString& filePath) {
+        m_logger->markUploaded(filePath);
+    });
+
     connect(uploader, &LogUploader::logUploadFailed, this, [this](const QString& filePath, const QString& error) {
         m_logger->warning("Application", QString::fromUtf8("日志上传失败: %1, 错误: %2").arg(filePath).arg(error));
     });
@@ -180,5 +198,6 @@ void Application::loadOssConfigFromEnv()
 void Application::cleanup()
 {
     m_logger->info("Application", "应用程序关闭");
+    MayaBatchRunner::shutdownIfStarted();
     m_config->save();
 }
@@ -45,6 +45,17 @@ void Config::setWsBaseUrl(const QString &url)
     emit configChanged();
 }
 
+bool Config::http2Enabled() const
+{
+    return m_settings->value("api/http2Enabled", true).toBool();
+}
+
+void Config::setHttp2Enabled(bool enabled)
+{
+    m_settings->setValue("api/http2Enabled", enabled);
+    emit configChanged();
+}
+
 // 用户配置
 QString Config::accessToken() const
 {
@@ -165,6 +176,51 @@ void Config::setCacheMaxSize(qint64 size)
     emit configChanged();
 }
 
+int Config::uiUpdateRate() const
+{
+    return m_settings->value("general/uiUpdateRate", 30).toInt();
+}
+
+void Config::setUiUpdateRate(int rate)
+{
+    m_settings->setValue("general/uiUpdateRate", rate);
+    emit configChanged();
+}
+
+// 日志配置
+qint64 Config::logMaxFileSize() const
+{
+    return m_settings->value("log/maxFileSize", 8 * 1024 * 1024LL).toLongLong(); // 默认8MB
+}
+
+void Config::setLogMaxFileSize(qint64 size)
+{
+    m_settings->setValue("log/maxFileSize", size);
+    emit configChanged();
+}
+
+qint64 Config::logArchiveMaxSize() const
+{
+    return m_settings->value("log/archiveMaxSize", 200 * 1024 * 1024LL).toLongLong(); // 默认200MB
+}
+
+void Config::setLogArchiveMaxSize(qint64 size)
+{
+    m_settings->setValue("log/archiveMaxSize", size);
+    emit configChanged();
+}
+
+int Config::logArchiveDays() const
+{
+    return m_settings->value("log/archiveDays", 14).toInt();
+}
+
+void Config::setLogArchiveDays(int days)
+{
+    m_settings->setValue("log/archiveDays", days);
+    emit configChanged();
+}
+
 // OSS配置
 QString Config::ossAccessKey() const
 {
@@ -25,6 +25,9 @@ public:
     QString wsBaseUrl() const;
     void setWsBaseUrl(const QString &url);
 
+    bool http2Enabled() const; // 是否允许 HTTP/2
+    void setHttp2Enabled(bool enabled);
+
     // 用户配置
     QString accessToken() const;
     void setAccessToken(const QString &token);
@@ -62,6 +65,19 @@ public:
     qint64 cacheMaxSize() const; // 字节
     void setCacheMaxSize(qint64 size);
 
+    int uiUpdateRate() const; // 任务进度界面刷新频率（次/秒）
+    void setUiUpdateRate(int rate);
+
+    // 日志配置
+    qint64 logMaxFileSize() const; // 单个日志文件轮转大小（字节）
+    void setLogMaxFileSize(qint64 size);
+
+    qint64 logArchiveMaxSize() const; // 日志归档总大小上限（字节）
+    void setLogArchiveMaxSize(qint64 size);
+
+    int logArchiveDays() const; // 日志归档保留天数
+    void setLogArchiveDays(int days);
+
     // OSS配置
     QString ossAccessKey() const;
     void setOssAccessKey(const QString &key);
@@ -0,0 +1,513 @@
+#include "LogFormat.h"
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtEndian>
+#include <cstring>
+
+const char LogFormat::Magic[4] = {'Y', 'T', 'L', '1'};
+const char LogFormat::ArchiveSuffix[] = ".ylogz";
+const char LogFormat::BlockMagic[4] = {'Y', 'T', 'Z', '1'};
+
+namespace {
+
+void putVarint(QByteArray &out, quint64 value)
+{
+    while (value >= 0x80) {
+        out.append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.append(static_cast<char>(value));
+}
+
+void putZigzag(QByteArray &out, qint64 value)
+{
+    putVarint(out, (static_cast<quint64>(value) << 1) ^ static_cast<quint64>(value >> 63));
+}
+
+void putString(QByteArray &out, const QByteArray &utf8)
+{
+    putVarint(out, static_cast<quint64>(utf8.size()));
+    out.append(utf8);
+}
+
+/**
+ * @brief 段内顺序读取，越界后 ok() 为 false
+ */
+class Reader
+{
+public:
+    Reader(const char *data, qint64 size) : m_data(data), m_size(size), m_pos(0), m_ok(true) {}
+
+    bool ok() const { return m_ok; }
+    bool atEnd() const { return m_pos >= m_size; }
+    qint64 pos() const { return m_pos; }
+
+    quint8 byte()
+    {
+        if (m_pos >= m_size) {
+            m_ok = false;
+            return 0;
+        }
+        return static_cast<quint8>(m_data[m_pos++]);
+    }
+
+    quint64 varint()
+    {
+        quint64 value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            quint8 b = byte();
+            value |= static_cast<quint64>(b & 0x7F) << shift;
+            if (!(b & 0x80)) {
+                return value;
+            }
+        }
+        m_ok = false;
+        return 0;
+    }
+
+    qint64 zigzag()
+    {
+        quint64 value = varint();
+        return static_cast<qint64>(value >> 1) ^ -static_cast<qint64>(value & 1);
+    }
+
+    QString string()
+    {
+        quint64 length = varint();
+        if (!m_ok || length > static_cast<quint64>(m_size - m_pos)) {
+            m_ok = false;
+            return QString();
+        }
+        QString value = QString::fromUtf8(m_data + m_pos, static_cast<qsizetype>(length));
+        m_pos += static_cast<qint64>(length);
+        return value;
+    }
+
+    double float64()
+    {
+        if (m_size - m_pos < 8) {
+            m_ok = false;
+            return 0.0;
+        }
+        quint64 bits = qFromLittleEndian<quint64>(m_data + m_pos);
+        m_pos += 8;
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+private:
+    const char *m_data;
+    qint64 m_size;
+    qint64 m_pos;
+    bool m_ok;
+};
+
+/**
+ * @brief 解码一个段的负载，返回是否完整无误
+ */
+bool decodePayload(Reader &reader, qint64 baseTimestamp, const std::function<void(const LogEntry &)> &onEntry,
+                   int &count)
+{
+    QHash<quint32, QString> categories;
+    QHash<quint32, QString> templates;
+    qint64 timestamp = baseTimestamp;
+
+    while (!reader.atEnd()) {
+        quint8 tag = reader.byte();
+        switch (tag) {
+            case LogFormat::DefineCategory: {
+                quint32 id = static_cast<quint32>(reader.varint());
+                categories.insert(id, reader.string());
+                break;
+            }
+            case LogFormat::DefineTemplate: {
+                quint32 id = static_cast<quint32>(reader.varint());
+                templates.insert(id, reader.string());
+                break;
+            }
+            case LogFormat::RecordEntry: {
+                LogEntry entry;
+                timestamp += reader.zigzag();
+                entry.timestamp = timestamp;
+                entry.level = reader.byte();
+                entry.category = categories.value(static_cast<quint32>(reader.varint()));
+                quint32 templateId = static_cast<quint32>(reader.varint());
+                if (templateId != 0) {
+                    entry.templ = templates.value(templateId);
+                }
+                int argCount = reader.byte();
+                entry.args.reserve(argCount);
+                for (int i = 0; i < argCount && reader.ok(); ++i) {
+                    LogArg arg;
+                    arg.type = static_cast<LogArg::Type>(reader.byte());
+                    switch (arg.type) {
+                        case LogArg::Int:    arg.i = reader.zigzag(); break;
+                        case LogArg::Double: arg.d = reader.float64(); break;
+                        case LogArg::String: arg.s = reader.string(); break;
+                        default: return false;
+                    }
+                    entry.args.append(arg);
+                }
+                if (!reader.ok()) {
+                    return false;
+                }
+                onEntry(entry);
+                ++count;
+                break;
+            }
+            case LogFormat::TextEntry: {
+                LogEntry entry;
+                timestamp += reader.zigzag();
+                entry.timestamp = timestamp;
+                entry.isText = true;
+                entry.args.append(LogArg(reader.string()));
+                if (!reader.ok()) {
+                    return false;
+                }
+                onEntry(entry);
+                ++count;
+                break;
+            }
+            default:
+                return false;
+        }
+        if (!reader.ok()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+QString LogArg::toString() const
+{
+    switch (type) {
+        case Int:    return QString::number(i);
+        case Double: return QString::number(d);
+        case String: return s;
+    }
+    return QString();
+}
+
+QString LogEntry::message() const
+{
+    if (templ.isEmpty()) {
+        return args.isEmpty() ? QString() : args.first().s;
+    }
+    return LogFormat::applyArgs(templ, args.constData(), args.size());
+}
+
+const char *LogFormat::levelName(int level)
+{
+    switch (level) {
+        case 0:  return "DEBUG";
+        case 1:  return "INFO ";
+        case 2:  return "WARN ";
+        case 3:  return "ERROR";
+        default: return "UNKN ";
+    }
+}
+
+QString LogFormat::applyArgs(const QString &templ, const LogArg *args, int argCount)
+{
+    QString result = templ;
+    for (int i = 0; i < argCount; ++i) {
+        switch (args[i].type) {
+            case LogArg::Int:    result = result.arg(args[i].i); break;
+            case LogArg::Double: result = result.arg(args[i].d); break;
+            case LogArg::String: result = result.arg(args[i].s); break;
+        }
+    }
+    return result;
+}
+
+QString LogFormat::formatText(const LogEntry &entry)
+{
+    if (entry.isText) {
+        return entry.message();
+    }
+
+    return QString("[%1] [%2] [%3] %4")
+        .arg(QDateTime::fromMSecsSinceEpoch(entry.timestamp).toString("yyyy-MM-dd HH:mm:ss"))
+        .arg(QLatin1String(levelName(entry.level)))
+        .arg(entry.category)
+        .arg(entry.message());
+}
+
+QByteArray LogFormat::formatJson(const LogEntry &entry)
+{
+    QJsonObject object;
+    object["time"] = QDateTime::fromMSecsSinceEpoch(entry.timestamp).toString(Qt::ISODateWithMs);
+    object["timestamp"] = entry.timestamp;
+    if (entry.isText) {
+        object["text"] = entry.message();
+        return QJsonDocument(object).toJson(QJsonDocument::Compact);
+    }
+
+    object["level"] = QString::fromLatin1(levelName(entry.level)).trimmed();
+    object["category"] = entry.category;
+    object["message"] = entry.message();
+    if (!entry.templ.isEmpty()) {
+        object["template"] = entry.templ;
+        QJsonArray args;
+        for (const LogArg &arg : entry.args) {
+            switch (arg.type) {
+                case LogArg::Int:    args.append(arg.i); break;
+                case LogArg::Double: args.append(arg.d); break;
+                case LogArg::String: args.append(arg.s); break;
+            }
+        }
+        object["args"] = args;
+    }
+    return QJsonDocument(object).toJson(QJsonDocument::Compact);
+}
+
+int LogFormat::decode(const QByteArray &data, const std::function<void(const LogEntry &)> &onEntry,
+                      bool *complete)
+{
+    int count = 0;
+    bool clean = true;
+    qint64 pos = 0;
+    const qint64 size = data.size();
+    const char *bytes = data.constData();
+
+    while (pos < size) {
+        if (size - pos < 4 || std::memcmp(bytes + pos, Magic, 4) != 0) {
+            // 不是段头：向后查找下一个段头
+            clean = false;
+            qsizetype next = data.indexOf(QByteArray::fromRawData(Magic, 4), pos + 1);
+            if (next < 0) {
+                break;
+            }
+            pos = next;
+            continue;
+        }
+
+        Reader header(bytes + pos + 4, size - pos - 4);
+        quint64 payloadLength = header.varint();
+        qint64 baseTimestamp = static_cast<qint64>(header.varint());
+        qint64 payloadStart = pos + 4 + header.pos();
+        if (!header.ok() || payloadLength > static_cast<quint64>(size - payloadStart)) {
+            // 末尾未写完的段
+            clean = false;
+            pos += 4;
+            continue;
+        }
+
+        Reader payload(bytes + payloadStart, static_cast<qint64>(payloadLength));
+        if (!decodePayload(payload, baseTimestamp, onEntry, count)) {
+            clean = false;
+        }
+        pos = payloadStart + static_cast<qint64>(payloadLength);
+    }
+
+    if (complete) {
+        *complete = clean;
+    }
+    return count;
+}
+
+int LogFormat::decodeFile(const QString &filePath, const std::function<void(const LogEntry &)> &onEntry,
+                          bool *complete)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (complete) {
+            *complete = false;
+        }
+        return 0;
+    }
+
+    QByteArray data = file.readAll();
+    if (isCompressed(data)) {
+        bool blocksComplete = true;
+        data = decompressBlocks(data, &blocksComplete);
+        int count = decode(data, onEntry, complete);
+        if (complete && !blocksComplete) {
+            *complete = false;
+        }
+        return count;
+    }
+    return decode(data, onEntry, complete);
+}
+
+QByteArray LogFormat::compressBlock(const QByteArray &data, int level)
+{
+    QByteArray compressed = qCompress(data, level);
+    QByteArray block;
+    block.reserve(8 + compressed.size());
+    block.append(BlockMagic, 4);
+    char length[4];
+    qToBigEndian(static_cast<quint32>(compressed.size()), length);
+    block.append(length, 4);
+    block.append(compressed);
+    return block;
+}
+
+bool LogFormat::isCompressed(const QByteArray &data)
+{
+    return data.size() >= 4 && std::memcmp(data.constData(), BlockMagic, 4) == 0;
+}
+
+QByteArray LogFormat::decompressBlocks(const QByteArray &data, bool *complete)
+{
+    QByteArray result;
+    bool clean = true;
+    qint64 pos = 0;
+    const qint64 size = data.size();
+
+    while (pos < size) {
+        if (size - pos < 8 || std::memcmp(data.constData() + pos, BlockMagic, 4) != 0) {
+            clean = false;
+            break;
+        }
+        quint32 length = qFromBigEndian<quint32>(data.constData() + pos + 4);
+        if (length > static_cast<quint64>(size - pos - 8)) {
+            // 末尾未写完的块
+            clean = false;
+            break;
+        }
+        QByteArray block = qUncompress(reinterpret_cast<const uchar *>(data.constData() + pos + 8),
+                                       static_cast<qsizetype>(length));
+        if (block.isEmpty() && length > 0) {
+            clean = false;
+            break;
+        }
+        result.append(block);
+        pos += 8 + length;
+    }
+
+    if (complete) {
+        *complete = clean;
+    }
+    return result;
+}
+
+LogSegmentWriter::LogSegmentWriter()
+    : m_baseTimestamp(0)
+    , m_lastTimestamp(0)
+    , m_segment(1)
+{
+    // id 0 保留（模板 0 表示没有模板）
+    m_categoryDefinedIn.append(0);
+    m_templateDefinedIn.append(0);
+}
+
+void LogSegmentWriter::beginRecord(qint64 timestamp)
+{
+    if (m_payload.isEmpty()) {
+        m_baseTimestamp = timestamp;
+        m_lastTimestamp = timestamp;
+    }
+}
+
+quint32 LogSegmentWriter::categoryId(const QString &category)
+{
+    quint32 id = m_categories.value(category, 0);
+    if (id == 0) {
+        id = static_cast<quint32>(m_categoryDefinedIn.size());
+        m_categories.insert(category, id);
+        m_categoryDefinedIn.append(0);
+    }
+    if (m_categoryDefinedIn[id] != m_segment) {
+        m_categoryDefinedIn[id] = m_segment;
+        m_payload.append(static_cast<char>(LogFormat::DefineCategory));
+        putVarint(m_payload, id);
+        putString(m_payload, category.toUtf8());
+    }
+    return id;
+}
+
+quint32 LogSegmentWriter::templateId(const char *templ)
+{
+    if (!templ) {
+        return 0;
+    }
+
+    // 查找时不复制模板
+    QByteArray key = QByteArray::fromRawData(templ, static_cast<qsizetype>(std::strlen(templ)));
+    quint32 id = m_templates.value(key, 0);
+    if (id == 0) {
+        id = static_cast<quint32>(m_templateDefinedIn.size());
+        m_templates.insert(QByteArray(key.constData(), key.size()), id);
+        m_templateDefinedIn.append(0);
+    }
+    if (m_templateDefinedIn[id] != m_segment) {
+        m_templateDefinedIn[id] = m_segment;
+        m_payload.append(static_cast<char>(LogFormat::DefineTemplate));
+        putVarint(m_payload, id);
+        putString(m_payload, key);
+    }
+    return id;
+}
+
+void LogSegmentWriter::addRecord(qint64 timestamp, int level, const QString &category,
+                                 const char *templ, const LogArg *args, int argCount)
+{
+    beginRecord(timestamp);
+
+    // 定义要写在记录之前
+    quint32 categoryIndex = categoryId(category);
+    quint32 templateIndex = templateId(templ);
+
+    m_payload.append(static_cast<char>(LogFormat::RecordEntry));
+    putZigzag(m_payload, timestamp - m_lastTimestamp);
+    m_lastTimestamp = timestamp;
+    m_payload.append(static_cast<char>(level));
+    putVarint(m_payload, categoryIndex);
+    putVarint(m_payload, templateIndex);
+    m_payload.append(static_cast<char>(argCount));
+    for (int i = 0; i < argCount; ++i) {
+        const LogArg &arg = args[i];
+        m_payload.append(static_cast<char>(arg.type));
+        switch (arg.type) {
+            case LogArg::Int:
+                putZigzag(m_payload, arg.i);
+                break;
+            case LogArg::Double: {
+                quint64 bits;
+                std::memcpy(&bits, &arg.d, sizeof(bits));
+                char le[8];
+                qToLittleEndian(bits, le);
+                m_payload.append(le, 8);
+                break;
+            }
+            case LogArg::String:
+                putString(m_payload, arg.s.toUtf8());
+                break;
+        }
+    }
+}
+
+void LogSegmentWriter::addText(qint64 timestamp, const QString &text)
+{
+    beginRecord(timestamp);
+
+    m_payload.append(static_cast<char>(LogFormat::TextEntry));
+    putZigzag(m_payload, timestamp - m_lastTimestamp);
+    m_lastTimestamp = timestamp;
+    putString(m_payload, text.toUtf8());
+}
+
+QByteArray LogSegmentWriter::takeSegment()
+{
+    if (m_payload.isEmpty()) {
+        return QByteArray();
+    }
+
+    QByteArray segment;
+    segment.reserve(m_payload.size() + 24);
+    segment.append(LogFormat::Magic, 4);
+    putVarint(segment, static_cast<quint64>(m_payload.size()));
+    putVarint(segment, static_cast<quint64>(m_baseTimestamp));
+    segment.append(m_payload);
+
+    m_payload.resize(0);
+    m_segment++;
+    return segment;
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+
+/**
+ * @brief 结构化日志的一个参数
+ */
+struct LogArg
+{
+    enum Type : quint8 {
+        Int = 0,
+        Double = 1,
+        String = 2
+    };
+
+    static const int MaxArgs = 6;
+
+    Type type = Int;
+    qint64 i = 0;
+    double d = 0.0;
+    QString s;
+
+    LogArg() = default;
+    LogArg(int value) : type(Int), i(value) {}
+    LogArg(unsigned int value) : type(Int), i(value) {}
+    LogArg(long value) : type(Int), i(value) {}
+    LogArg(long long value) : type(Int), i(value) {}
+    LogArg(unsigned long value) : type(Int), i(static_cast<qint64>(value)) {}
+    LogArg(unsigned long long value) : type(Int), i(static_cast<qint64>(value)) {}
+    LogArg(bool value) : type(Int), i(value ? 1 : 0) {}
+    LogArg(double value) : type(Double), d(value) {}
+    LogArg(const QString &value) : type(String), s(value) {}
+    LogArg(const char *value) : type(String), s(QString::fromUtf8(value)) {}
+
+    QString toString() const;
+};
+
+/**
+ * @brief 解码后的一条日志
+ */
+struct LogEntry
+{
+    qint64 timestamp = 0;           // 毫秒时间戳
+    int level = 0;                  // Logger::LogLevel；isText 时无意义
+    bool isText = false;            // 原样文本（启动分隔符、系统信息、崩溃信息）
+    QString category;
+    QString templ;                  // 消息模板；为空时 args[0] 即完整消息
+    QVector<LogArg> args;
+
+    /**
+     * @brief 用参数填充模板得到的消息
+     */
+    QString message() const;
+};
+
+/**
+ * @brief 结构化二进制日志格式
+ *
+ * 日志文件由只追加的段组成，每段自包含（用到的分类和模板在段内重新定义），
+ * 从任意段开始都能解码，文件末尾写了一半的段会被忽略：
+ *
+ *   段    := "YTL1" varint(负载长度) varint(基准时间戳 ms) 负载
+ *   负载  := 条目*
+ *   条目  := 0x01 varint(id) 字符串                       定义分类
+ *          | 0x02 varint(id) 字符串                       定义消息模板
+ *          | 0x03 zigzag(时间差) u8(级别) varint(分类) varint(模板) u8(参数个数) 参数*
+ *          | 0x04 zigzag(时间差) 字符串                     原样文本
+ *   参数  := u8(类型) (zigzag 整数 | 8 字节小端 double | 字符串)
+ *   字符串 := varint(字节数) UTF-8
+ *
+ * 时间差相对段内上一条记录；模板 id 0 表示没有模板，唯一的字符串参数就是完整消息。
+ *
+ * 压缩归档和上传到 OSS 的对象是压缩块的序列，每块独立压缩，可以逐块追加：
+ *
+ *   块    := "YTZ1" u32be(压缩数据字节数) qCompress(原始数据)
+ */
+class LogFormat
+{
+public:
+    static const char Magic[4];
+    static const char ArchiveSuffix[];      // 压缩归档的扩展名
+    static const char BlockMagic[4];
+
+    enum EntryTag : quint8 {
+        DefineCategory = 0x01,
+        DefineTemplate = 0x02,
+        RecordEntry = 0x03,
+        TextEntry = 0x04
+    };
+
+    /**
+     * @brief 文本形式的级别名
+     */
+    static const char *levelName(int level);
+
+    /**
+     * @brief 一行文本日志（与原文本日志格式一致，不含换行）
+     */
+    static QString formatText(const LogEntry &entry);
+
+    /**
+     * @brief 一行 JSON（不含换行）
+     */
+    static QByteArray formatJson(const LogEntry &entry);
+
+    /**
+     * @brief 依次用参数替换模板中的 %1、%2…（与 QString::arg 链式调用相同）
+     */
+    static QString applyArgs(const QString &templ, const LogArg *args, int argCount);
+
+    /**
+     * @brief 解码日志数据
+     * @param onEntry 每解码一条日志调用一次
+     * @param complete 输出：数据是否以完整的段结束（为 false 表示末尾有未写完或损坏的数据）
+     * @return 解码出的日志条数
+     *
+     * 遇到损坏的段时向后查找下一个段头继续解码。
+     */
+    static int decode(const QByteArray &data, const std::function<void(const LogEntry &)> &onEntry,
+                      bool *complete = nullptr);
+
+    /**
+     * @brief 压缩一块数据
+     */
+    static QByteArray compressBlock(const QByteArray &data, int level = 6);
+
+    /**
+     * @brief 数据是否以压缩块开头
+     */
+    static bool isCompressed(const QByteArray &data);
+
+    /**
+     * @brief 依次解压所有压缩块并拼接
+     * @param complete 输出：是否全部是完整的块（为 false 表示末尾有未写完或损坏的数据）
+     */
+    static QByteArray decompressBlocks(const QByteArray &data, bool *complete = nullptr);
+
+    /**
+     * @brief 解码日志文件（*.ylog，或由压缩块组成的归档 *.ylogz）
+     */
+    static int decodeFile(const QString &filePath, const std::function<void(const LogEntry &)> &onEntry,
+                          bool *complete = nullptr);
+};
+
+/**
+ * @brief 日志段编码器
+ *
+ * 分类和模板在编码器生命周期内分配固定 id，每段只在第一次用到时写入定义。
+ * 不是线程安全的，由日志写线程独占使用。
+ */
+class LogSegmentWriter
+{
+public:
+    LogSegmentWriter();
+
+    /**
+     * @brief 追加一条结构化日志
+     * @param templ 消息模板（UTF-8），为空时 args[0] 为完整消息
+     */
+    void addRecord(qint64 timestamp, int level, const QString &category,
+                   const char *templ, const LogArg *args, int argCount);
+
+    /**
+     * @brief 追加一段原样文本
+     */
+    void addText(qint64 timestamp, const QString &text);
+
+    bool isEmpty() const { return m_payload.isEmpty(); }
+
+    /**
+     * @brief 当前段负载字节数
+     */
+    int size() const { return m_payload.size(); }
+
+    /**
+     * @brief 结束当前段，返回完整的段数据并开始新段
+     */
+    QByteArray takeSegment();
+
+private:
+    void beginRecord(qint64 timestamp);
+    quint32 categoryId(const QString &category);
+    quint32 templateId(const char *templ);
+
+    QByteArray m_payload;
+    qint64 m_baseTimestamp;
+    qint64 m_lastTimestamp;
+    quint32 m_segment;                          // 当前段序号（从 1 开始）
+
+    QHash<QString, quint32> m_categories;
+    QHash<QByteArray, quint32> m_templates;
+    QVector<quint32> m_categoryDefinedIn;       // id -> 最近一次定义所在的段
+    QVector<quint32> m_templateDefinedIn;
+};
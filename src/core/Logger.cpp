@@ -1,50 +1,146 @@
 #include "Logger.h"
 #include <QDateTime>
 #include <QDir>
+#include <QDate>
+#include <QSaveFile>
 #include <QStandardPaths>
 #include <QDebug>
-#include <QStringConverter>
 #include <QSysInfo>
 #include <QCoreApplication>
+#include <QThread>
+#include <cstdio>
+
+namespace {
+// 队列容量；超过一半时唤醒写线程
+const size_t QUEUE_CAPACITY = 8192;
+// 攒够这么多字节或等待这么久就写入并 flush
+const int BATCH_BYTES = 64 * 1024;
+const unsigned long FLUSH_INTERVAL_MS = 200;
+// 崩溃时等待写线程释放文件的最长时间，超时后崩溃信息写入单独的 crash-*.ylog
+const int CRASH_LOCK_TIMEOUT_MS = 500;
+// 归档文件名中序号的位数，按文件名排序即按归档顺序
+const int ARCHIVE_SEQ_WIDTH = 8;
+const char UPLOAD_WATERMARK_FILE[] = "upload.watermark";
+// 归档时每次读取并压缩的字节数（每块独立压缩）
+const qint64 ARCHIVE_BLOCK_BYTES = 1024 * 1024;
+}
 
 Logger::Logger(QObject *parent)
     : QObject(parent)
     , m_logFile(nullptr)
-    , m_stream(nullptr)
     , m_minLevel(Debug)
+    , m_consoleOutput(true)
+    , m_queue(new MpscRingBuffer<Record>(QUEUE_CAPACITY))
+    , m_writer(nullptr)
+    , m_running(false)
+    , m_stopping(false)
+    , m_activeProducers(0)
+    , m_wakeRequested(false)
+    , m_cachedSecond(-1)
+    , m_fileOpenedAt(0)
+    , m_nextArchiveSeq(1)
+    , m_uploadWatermark(0)
+    , m_linesWritten(0)
+    , m_batches(0)
+    , m_queueFullWaits(0)
 {
+    m_consoleBuffer.reserve(BATCH_BYTES * 2);
+    m_archivePool.setMaxThreadCount(1);
 }
 
 Logger::~Logger()
 {
-    if (m_stream) {
-        m_stream->flush();
-        delete m_stream;
-    }
+    shutdown();
+
+    // 还没开始的归档任务下次启动时作为遗留文件重新归档
+    m_archivePool.clear();
+    m_archivePool.waitForDone();
+
     if (m_logFile) {
         m_logFile->close();
         delete m_logFile;
     }
 }
 
-void Logger::initialize()
+void Logger::initialize(const QString &logPath)
 {
-    m_logPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/logs";
+    if (m_writer) {
+        return;
+    }
+
+    m_logPath = logPath.isEmpty()
+        ? QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/logs"
+        : logPath;
     QDir().mkpath(m_logPath);
+    QDir().mkpath(archiveDirectory());
+
+    loadUploadWatermark();
+    openLogFileLocked();
+    archiveLeftoverFiles();
 
-    QString logFileName = QDateTime::currentDateTime().toString("yyyy-MM-dd") + ".log";
-    QString logFilePath = m_logPath + "/" + logFileName;
+    // 无法打开文件时写线程仍然负责控制台输出
+    m_writer = QThread::create([this]() { writerLoop(); });
+    m_writer->setObjectName("Logger");
+    m_writer->start(QThread::LowPriority);
+    m_running.store(true, std::memory_order_release);
 
-    m_logFile = new QFile(logFilePath);
-    if (m_logFile->open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
-        m_stream = new QTextStream(m_logFile);
-        m_stream->setEncoding(QStringConverter::Utf8);
+    // 记录启动分隔符
+    Record record;
+    record.timestamp = currentTimestamp();
+    record.level = RawText;
+    record.argCount = 1;
+    record.args[0] = LogArg(QString("=").repeated(80) + "\n"
+        + QString("Application Started: %1").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss")) + "\n"
+        + QString("=").repeated(80));
+    submit(record);
+}
 
-        // 记录启动分隔符
-        writeToFile(QString("=").repeated(80));
-        writeToFile(QString("Application Started: %1").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss")));
-        writeToFile(QString("=").repeated(80));
+void Logger::openLogFileLocked()
+{
+    // 结构化日志与 qDebug 重定向的文本日志（yyyy-MM-dd.log）分开存放；
+    // 同一秒内多次轮转时加序号区分
+    QString baseName = QDateTime::currentDateTime().toString("yyyy-MM-dd_HHmmss");
+    QString logFilePath = m_logPath + "/" + baseName + ".ylog";
+    for (int i = 1; QFile::exists(logFilePath); ++i) {
+        logFilePath = QString("%1/%2_%3.ylog").arg(m_logPath, baseName).arg(i);
     }
+
+    if (!m_logFile) {
+        m_logFile = new QFile(logFilePath);
+    } else {
+        m_logFile->setFileName(logFilePath);
+    }
+    if (!m_logFile->open(QIODevice::WriteOnly)) {
+        qWarning() << "无法打开日志文件:" << logFilePath;
+    }
+    m_fileOpenedAt = currentTimestamp();
+}
+
+void Logger::archiveLeftoverFiles()
+{
+    // 上次中断时写了一半的归档
+    QDir archiveDir(archiveDirectory());
+    for (const QString &name : archiveDir.entryList(QStringList() << "*.tmp", QDir::Files)) {
+        archiveDir.remove(name);
+    }
+
+    // 上次运行留下的结构化日志，以及之前几天 qDebug 重定向的文本日志（当天的还在写入）
+    const QString today = QDate::currentDate().toString("yyyy-MM-dd");
+    const QString current = QFileInfo(m_logFile->fileName()).absoluteFilePath();
+    QFileInfoList files = QDir(m_logPath).entryInfoList(QStringList() << "*.ylog" << "*.log",
+                                                        QDir::Files, QDir::Time | QDir::Reversed);
+    for (const QFileInfo &fileInfo : files) {
+        if (fileInfo.absoluteFilePath() == current) {
+            continue;
+        }
+        if (fileInfo.suffix() == "log" && fileInfo.completeBaseName() >= today) {
+            continue;
+        }
+        scheduleArchive(fileInfo.absoluteFilePath());
+    }
+
+    RotationPolicy policy = m_policy;
+    m_archivePool.start([this, policy]() { applyRetention(policy); });
 }
 
 void Logger::debug(const QString &category, const QString &message)
@@ -73,57 +169,465 @@ void Logger::log(LogLevel level, const QString &category, const QString &message
         return;
     }
 
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss");
-    QString levelStr = levelToString(level);
-    QString logMessage = QString("[%1] [%2] [%3] %4")
-                            .arg(timestamp)
-                            .arg(levelStr)
-                            .arg(category)
-                            .arg(message);
+    // 只复制隐式共享的字符串，编码在写线程完成
+    Record record;
+    record.timestamp = currentTimestamp();
+    record.level = level;
+    record.category = category;
+    record.argCount = 1;
+    record.args[0] = LogArg(message);
+    submit(record);
+}
+
+qint64 Logger::currentTimestamp()
+{
+    return QDateTime::currentMSecsSinceEpoch();
+}
+
+void Logger::submit(Record &record)
+{
+    // 先登记再检查 m_running（都是顺序一致的原子操作）：shutdown() 清除 m_running 后
+    // 会等登记的调用方入队完成再做最后一次写出，看到 m_running 为 true 的日志不会丢
+    m_activeProducers.fetch_add(1);
+    if (!m_running.load()) {
+        m_activeProducers.fetch_sub(1);
+
+        // 未初始化或已关闭：在调用线程直接输出
+        QMutexLocker locker(&m_mutex);
+        appendRecord(record);
+        writeBufferLocked();
+        return;
+    }
+
+    bool urgent = record.level >= Error;
+    while (!m_queue->tryPush(record)) {
+        m_queueFullWaits.fetch_add(1, std::memory_order_relaxed);
+        if (m_stopping.load()) {
+            // 正在关闭，写线程可能已经退出：自己腾出空位
+            QMutexLocker locker(&m_mutex);
+            drainLocked();
+            continue;
+        }
+        // 队列已满：写线程跟不上，让出时间片等它腾出空位
+        wakeWriter();
+        QThread::yieldCurrentThread();
+    }
+    m_activeProducers.fetch_sub(1);
 
-    // 输出到控制台
-    qDebug().noquote() << logMessage;
+    if (urgent || m_queue->approximateSize() >= m_queue->capacity() / 2) {
+        wakeWriter();
+    }
+}
 
-    // 写入文件
-    writeToFile(logMessage);
+void Logger::wakeWriter()
+{
+    // 已经请求过唤醒时不再加锁
+    if (m_wakeRequested.exchange(true)) {
+        return;
+    }
+
+    QMutexLocker locker(&m_wakeMutex);
+    m_wakeCondition.wakeOne();
 }
 
-void Logger::writeToFile(const QString &message)
+void Logger::writerLoop()
+{
+    while (!m_stopping.load()) {
+        {
+            QMutexLocker locker(&m_wakeMutex);
+            if (!m_wakeRequested.load() && !m_stopping.load()) {
+                m_wakeCondition.wait(&m_wakeMutex, FLUSH_INTERVAL_MS);
+            }
+        }
+        m_wakeRequested.store(false);
+
+        QMutexLocker locker(&m_mutex);
+        drainLocked();
+    }
+}
+
+void Logger::drainLocked()
+{
+    Record record;
+    qint64 lines = 0;
+    while (m_queue->tryPop(record)) {
+        appendRecord(record);
+        ++lines;
+        if (m_segmentWriter.size() >= BATCH_BYTES) {
+            writeBufferLocked();
+        }
+    }
+
+    m_linesWritten.fetch_add(lines, std::memory_order_relaxed);
+    writeBufferLocked();
+}
+
+void Logger::appendRecord(const Record &record)
+{
+    if (record.level == RawText) {
+        m_segmentWriter.addText(record.timestamp, record.args[0].s);
+    } else {
+        m_segmentWriter.addRecord(record.timestamp, record.level, record.category,
+                                  record.templ, record.args, record.argCount);
+    }
+
+    if (m_consoleOutput) {
+        appendConsoleLine(record);
+    }
+}
+
+void Logger::appendConsoleLine(const Record &record)
+{
+    if (record.level == RawText) {
+        m_consoleBuffer += record.args[0].s.toUtf8();
+        m_consoleBuffer += '\n';
+        return;
+    }
+
+    // 同一秒内的日志复用格式化好的时间
+    qint64 second = record.timestamp / 1000;
+    if (second != m_cachedSecond) {
+        m_cachedSecond = second;
+        m_cachedTimestamp = QDateTime::fromMSecsSinceEpoch(record.timestamp).toString("yyyy-MM-dd HH:mm:ss").toUtf8();
+    }
+
+    QString message = record.templ
+        ? LogFormat::applyArgs(QString::fromUtf8(record.templ), record.args, record.argCount)
+        : record.args[0].s;
+
+    m_consoleBuffer += '[';
+    m_consoleBuffer += m_cachedTimestamp;
+    m_consoleBuffer += "] [";
+    m_consoleBuffer += LogFormat::levelName(record.level);
+    m_consoleBuffer += "] [";
+    m_consoleBuffer += record.category.toUtf8();
+    m_consoleBuffer += "] ";
+    m_consoleBuffer += message.toUtf8();
+    m_consoleBuffer += '\n';
+}
+
+void Logger::writeBufferLocked()
+{
+    if (m_segmentWriter.isEmpty()) {
+        return;
+    }
+
+    QByteArray segment = m_segmentWriter.takeSegment();
+    if (m_logFile && m_logFile->isOpen()) {
+        m_logFile->write(segment);
+        m_logFile->flush();
+    }
+    if (!m_consoleBuffer.isEmpty()) {
+        fwrite(m_consoleBuffer.constData(), 1, static_cast<size_t>(m_consoleBuffer.size()), stderr);
+        m_consoleBuffer.resize(0);
+    }
+
+    m_batches.fetch_add(1, std::memory_order_relaxed);
+    rotateIfNeededLocked();
+}
+
+void Logger::rotateIfNeededLocked()
+{
+    if (!m_logFile || !m_logFile->isOpen()) {
+        return;
+    }
+
+    if (m_logFile->size() >= m_policy.maxFileBytes
+        || currentTimestamp() - m_fileOpenedAt >= m_policy.maxFileAgeSecs * 1000LL) {
+        rotateLocked();
+    }
+}
+
+void Logger::rotateLocked()
+{
+    if (!m_logFile) {
+        return;
+    }
+
+    // 段是自包含的，新文件不需要任何文件头
+    QString closedPath = m_logFile->fileName();
+    m_logFile->close();
+    openLogFileLocked();
+    scheduleArchive(closedPath);
+}
+
+void Logger::rotate()
 {
     QMutexLocker locker(&m_mutex);
+    drainLocked();
+    rotateLocked();
+}
 
-    if (m_stream) {
-        *m_stream << message << "\n";
-        m_stream->flush();
+void Logger::setRotationPolicy(const RotationPolicy &policy)
+{
+    QMutexLocker locker(&m_mutex);
+    m_policy = policy;
+
+    // 新策略可能更严格：立即检查当前文件和已有归档
+    rotateIfNeededLocked();
+    if (!m_logPath.isEmpty()) {
+        m_archivePool.start([this, policy]() { applyRetention(policy); });
     }
 }
 
-QString Logger::levelToString(LogLevel level) const
+Logger::RotationPolicy Logger::rotationPolicy() const
 {
-    switch (level) {
-        case Debug:   return "DEBUG";
-        case Info:    return "INFO ";
-        case Warning: return "WARN ";
-        case Error:   return "ERROR";
-        default:      return "UNKN ";
+    QMutexLocker locker(&m_mutex);
+    return m_policy;
+}
+
+void Logger::scheduleArchive(const QString &filePath)
+{
+    RotationPolicy policy = m_policy;
+    m_archivePool.start([this, filePath, policy]() { archiveFile(filePath, policy); });
+}
+
+void Logger::archiveFile(const QString &filePath, const RotationPolicy &policy)
+{
+    QFile source(filePath);
+    if (!source.open(QIODevice::ReadOnly)) {
+        qWarning() << "无法打开待归档的日志文件:" << filePath;
+        return;
+    }
+    QDateTime modified = source.fileTime(QFileDevice::FileModificationTime);
+
+    if (source.size() == 0) {
+        source.close();
+        QFile::remove(filePath);
+        return;
+    }
+
+    // 先写临时文件再改名，归档目录里只会出现完整的归档
+    qint64 sequence = m_nextArchiveSeq.fetch_add(1);
+    QString archivePath = QString("%1/%2_%3z")
+        .arg(archiveDirectory())
+        .arg(sequence, ARCHIVE_SEQ_WIDTH, 10, QChar('0'))
+        .arg(QFileInfo(filePath).fileName());
+    QString tempPath = archivePath + ".tmp";
+
+    QFile archive(tempPath);
+    bool written = archive.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    while (written && !source.atEnd()) {
+        QByteArray block = source.read(ARCHIVE_BLOCK_BYTES);
+        written = !block.isEmpty() && archive.write(LogFormat::compressBlock(block)) >= 0;
     }
+    source.close();
+    if (!written) {
+        qWarning() << "日志归档失败:" << filePath << archive.errorString();
+        archive.close();
+        archive.remove();
+        return;
+    }
+    // 保留原文件的修改时间，保留期限按日志本身的时间计算（先 flush，否则关闭时会再次更新）
+    archive.flush();
+    archive.setFileTime(modified, QFileDevice::FileModificationTime);
+    archive.close();
+
+    if (!QFile::rename(tempPath, archivePath)) {
+        qWarning() << "日志归档失败:" << filePath << "无法重命名";
+        QFile::remove(tempPath);
+        return;
+    }
+    QFile::remove(filePath);
+
+    applyRetention(policy);
 }
 
-void Logger::logCrash(const QString &crashMessage)
+void Logger::applyRetention(const RotationPolicy &policy)
+{
+    // 从最新的归档开始累计，超出总大小或保留期限的全部删除
+    QStringList archives = archiveFiles();
+    QDateTime expiry = QDateTime::currentDateTime().addDays(-policy.maxArchiveDays);
+    qint64 totalBytes = 0;
+    bool overBudget = false;
+    int removed = 0;
+
+    for (int i = archives.size() - 1; i >= 0; --i) {
+        QFileInfo fileInfo(archives[i]);
+        totalBytes += fileInfo.size();
+        overBudget = overBudget || totalBytes > policy.maxArchiveBytes;
+        if (overBudget || fileInfo.lastModified() < expiry) {
+            if (QFile::remove(archives[i])) {
+                ++removed;
+            }
+        }
+    }
+
+    if (removed > 0) {
+        qDebug() << "清理日志归档:" << removed << "个";
+    }
+}
+
+QStringList Logger::archiveFiles() const
+{
+    QDir archiveDir(archiveDirectory());
+    QStringList filters;
+    filters << QString("*") + LogFormat::ArchiveSuffix << "*.logz";
+
+    QStringList paths;
+    for (const QFileInfo &fileInfo : archiveDir.entryInfoList(filters, QDir::Files, QDir::Name)) {
+        paths.append(fileInfo.absoluteFilePath());
+    }
+    return paths;
+}
+
+qint64 Logger::archiveSequence(const QString &filePath)
+{
+    bool ok = false;
+    qint64 sequence = QFileInfo(filePath).fileName().section('_', 0, 0).toLongLong(&ok);
+    return ok ? sequence : 0;
+}
+
+void Logger::loadUploadWatermark()
+{
+    QMutexLocker locker(&m_uploadMutex);
+
+    QFile file(archiveDirectory() + "/" + UPLOAD_WATERMARK_FILE);
+    if (file.open(QIODevice::ReadOnly)) {
+        m_uploadWatermark = file.readAll().trimmed().toLongLong();
+    }
+
+    // 归档全部被清理后序号也不能回退，否则新归档会落在水位线之下
+    qint64 lastSequence = m_uploadWatermark;
+    for (const QString &path : archiveFiles()) {
+        lastSequence = qMax(lastSequence, archiveSequence(path));
+    }
+    m_nextArchiveSeq.store(lastSequence + 1);
+}
+
+QStringList Logger::pendingUploads() const
 {
+    QMutexLocker locker(&m_uploadMutex);
+
+    QStringList pending;
+    for (const QString &path : archiveFiles()) {
+        qint64 sequence = archiveSequence(path);
+        if (sequence > m_uploadWatermark && !m_uploadedSeqs.contains(sequence)) {
+            pending.append(path);
+        }
+    }
+    return pending;
+}
+
+void Logger::markUploaded(const QString &archivePath)
+{
+    QMutexLocker locker(&m_uploadMutex);
+
+    qint64 sequence = archiveSequence(archivePath);
+    if (sequence <= m_uploadWatermark) {
+        return;
+    }
+    m_uploadedSeqs.insert(sequence);
+
+    // 已被清理的归档不在列表中，直接跳过
+    qint64 watermark = m_uploadWatermark;
+    for (const QString &path : archiveFiles()) {
+        qint64 current = archiveSequence(path);
+        if (current <= watermark) {
+            continue;
+        }
+        if (!m_uploadedSeqs.remove(current)) {
+            break;
+        }
+        watermark = current;
+    }
+
+    if (watermark == m_uploadWatermark) {
+        return;
+    }
+    m_uploadWatermark = watermark;
+
+    QSaveFile file(archiveDirectory() + "/" + UPLOAD_WATERMARK_FILE);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QByteArray::number(watermark));
+        file.commit();
+    }
+}
+
+qint64 Logger::uploadWatermark() const
+{
+    QMutexLocker locker(&m_uploadMutex);
+    return m_uploadWatermark;
+}
+
+bool Logger::waitForArchiving(int timeoutMs)
+{
+    return m_archivePool.waitForDone(timeoutMs);
+}
+
+void Logger::flush()
+{
+    QMutexLocker locker(&m_mutex);
+    drainLocked();
+}
+
+void Logger::shutdown()
+{
+    if (!m_writer) {
+        return;
+    }
+
+    // 之后的日志在调用线程直接写入
+    m_running.store(false);
+    m_stopping.store(true);
+    wakeWriter();
+    m_writer->wait();
+    delete m_writer;
+    m_writer = nullptr;
+
+    // 等待在清除 m_running 之前已经开始入队的调用方，它们的日志由下面的写出处理
+    while (m_activeProducers.load() > 0) {
+        QThread::yieldCurrentThread();
+    }
+
     QMutexLocker locker(&m_mutex);
+    drainLocked();
+}
+
+Logger::Stats Logger::stats() const
+{
+    Stats stats;
+    stats.linesWritten = m_linesWritten.load(std::memory_order_relaxed);
+    stats.batches = m_batches.load(std::memory_order_relaxed);
+    stats.queueFullWaits = m_queueFullWaits.load(std::memory_order_relaxed);
+    return stats;
+}
 
-    if (m_stream) {
-        *m_stream << "\n";
-        *m_stream << "!" << QString("!").repeated(78) << "!\n";
-        *m_stream << "! CRASH DETECTED\n";
-        *m_stream << "!" << QString("!").repeated(78) << "!\n";
-        *m_stream << "Time: " << QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss") << "\n";
-        *m_stream << "Message: " << crashMessage << "\n";
-        *m_stream << "\nStack Trace:\n";
-        *m_stream << getStackTrace() << "\n";
-        *m_stream << "!" << QString("!").repeated(78) << "!\n";
-        m_stream->flush();
+void Logger::logCrash(const QString &crashMessage)
+{
+    QString text = QString("\n")
+        + "!" + QString("!").repeated(78) + "!\n"
+        + "! CRASH DETECTED\n"
+        + "!" + QString("!").repeated(78) + "!\n"
+        + "Time: " + QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss") + "\n"
+        + "Message: " + crashMessage + "\n"
+        + "\nStack Trace:\n"
+        + getStackTrace() + "\n"
+        + "!" + QString("!").repeated(78) + "!";
+
+    // 崩溃时不能依赖写线程：在当前线程写出队列中已有的日志和崩溃信息
+    if (m_mutex.tryLock(CRASH_LOCK_TIMEOUT_MS)) {
+        drainLocked();
+        Record record;
+        record.timestamp = currentTimestamp();
+        record.level = RawText;
+        record.argCount = 1;
+        record.args[0] = LogArg(text);
+        appendRecord(record);
+        writeBufferLocked();
+        m_mutex.unlock();
+    } else if (!m_logPath.isEmpty()) {
+        // 写线程卡在写文件中，不能与它同时写 m_logFile：单独编码一段写入独立的崩溃日志，
+        // 下次启动时与其他遗留日志一起归档上传
+        LogSegmentWriter writer;
+        writer.addText(currentTimestamp(), text);
+        QString crashPath = QString("%1/crash-%2.ylog")
+            .arg(m_logPath, QDateTime::currentDateTime().toString("yyyy-MM-dd_HHmmsszzz"));
+        QFile crashFile(crashPath);
+        if (crashFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            crashFile.write(writer.takeSegment());
+            crashFile.flush();
+        }
     }
 
     // 同时输出到控制台
@@ -138,7 +642,7 @@ QStringList Logger::getAllLogFiles() const
     }
 
     QStringList filters;
-    filters << "*.log";
+    filters << "*.ylog" << "*.log";
 
     QFileInfoList fileList = logDir.entryInfoList(filters, QDir::Files, QDir::Time);
     QStringList paths;
@@ -147,26 +651,29 @@ QStringList Logger::getAllLogFiles() const
         paths.append(fileInfo.absoluteFilePath());
     }
 
+    // 压缩归档
+    paths += archiveFiles();
+
     return paths;
 }
 
 void Logger::logSystemInfo()
 {
-    QMutexLocker locker(&m_mutex);
-
-    if (m_stream) {
-        *m_stream << "\n";
-        *m_stream << "System Information:\n";
-        *m_stream << QString("-").repeated(80) << "\n";
-        *m_stream << "Application: " << QCoreApplication::applicationName() << "\n";
-        *m_stream << "Version: " << QCoreApplication::applicationVersion() << "\n";
-        *m_stream << "OS: " << QSysInfo::prettyProductName() << "\n";
-        *m_stream << "Kernel: " << QSysInfo::kernelType() << " " << QSysInfo::kernelVersion() << "\n";
-        *m_stream << "CPU Architecture: " << QSysInfo::currentCpuArchitecture() << "\n";
-        *m_stream << "Build ABI: " << QSysInfo::buildAbi() << "\n";
-        *m_stream << QString("-").repeated(80) << "\n";
-        m_stream->flush();
-    }
+    Record record;
+    record.timestamp = currentTimestamp();
+    record.level = RawText;
+    record.argCount = 1;
+    record.args[0] = LogArg(QString("\n")
+        + "System Information:\n"
+        + QString("-").repeated(80) + "\n"
+        + "Application: " + QCoreApplication::applicationName() + "\n"
+        + "Version: " + QCoreApplication::applicationVersion() + "\n"
+        + "OS: " + QSysInfo::prettyProductName() + "\n"
+        + "Kernel: " + QSysInfo::kernelType() + " " + QSysInfo::kernelVersion() + "\n"
+        + "CPU Architecture: " + QSysInfo::currentCpuArchitecture() + "\n"
+        + "Build ABI: " + QSysInfo::buildAbi() + "\n"
+        + QString("-").repeated(80));
+    submit(record);
 }
 
 QString Logger::getStackTrace() const
@@ -3,11 +3,30 @@
 #include <QObject>
 #include <QString>
 #include <QFile>
-#include <QTextStream>
 #include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+#include <QSet>
+#include <atomic>
+#include <memory>
+#include "MpscRingBuffer.h"
+#include "LogFormat.h"
+
+class QThread;
 
 /**
  * @brief 日志管理类
+ *
+ * 调用线程只把时间戳、级别、分类和消息放入无锁环形队列，格式化、控制台输出和
+ * 写文件都在后台写线程完成；写线程按批（64KB 或 200ms）写入并 flush，
+ * 错误级别的日志会立即唤醒写线程。flush() 和 logCrash() 在调用线程同步写出。
+ *
+ * 日志文件（*.ylog）使用 LogFormat 结构化二进制格式：分类和消息模板只写 id，
+ * 参数按类型保存。用 logf() 记录的日志在调用线程不做任何字符串格式化。
+ *
+ * 日志文件按大小和时长轮转（yyyy-MM-dd_HHmmss.ylog），关闭的文件在后台压缩到
+ * archive 目录（<序号>_<原文件名>z），并按保留期限和总大小清理最旧的归档。
+ * 归档序号单调递增，上传水位线记录连续上传成功的最后一个序号，只有更新的归档需要上传。
  */
 class Logger : public QObject
 {
@@ -21,10 +40,33 @@ public:
         Error = 3
     };
 
+    /**
+     * @brief 写入统计
+     */
+    struct Stats {
+        qint64 linesWritten = 0;    // 已写入文件的行（记录）数
+        qint64 batches = 0;         // 写入并 flush 的批次数
+        qint64 queueFullWaits = 0;  // 队列满时调用方等待的次数
+    };
+
+    /**
+     * @brief 轮转和保留策略
+     */
+    struct RotationPolicy {
+        qint64 maxFileBytes = 8 * 1024 * 1024;      // 单个日志文件超过该大小时轮转
+        int maxFileAgeSecs = 24 * 3600;             // 日志文件打开超过该时长时轮转
+        qint64 maxArchiveBytes = 200 * 1024 * 1024; // 归档总大小上限，超出时删除最旧的
+        int maxArchiveDays = 14;                    // 归档保留天数
+    };
+
     explicit Logger(QObject *parent = nullptr);
     ~Logger();
 
-    void initialize();
+    /**
+     * @brief 打开日志文件并启动写线程
+     * @param logPath 日志目录，为空时使用应用数据目录下的 logs
+     */
+    void initialize(const QString &logPath = QString());
 
     void debug(const QString &category, const QString &message);
     void info(const QString &category, const QString &message);
@@ -33,18 +75,65 @@ public:
 
     void log(LogLevel level, const QString &category, const QString &message);
 
+    /**
+     * @brief 按模板记录日志，参数按类型保存，格式化推迟到读取日志时
+     * @param templ 消息模板（UTF-8 字符串字面量，如 "上传完成: %1, 耗时 %2 ms"），
+     *              写线程处理前必须一直有效
+     */
+    template <typename... Args>
+    void logf(LogLevel level, const QString &category, const char *templ, const Args &... args)
+    {
+        static_assert(sizeof...(Args) <= LogArg::MaxArgs, "too many log arguments");
+        if (level < m_minLevel) {
+            return;
+        }
+
+        Record record;
+        record.timestamp = currentTimestamp();
+        record.level = level;
+        record.category = category;
+        record.templ = templ;
+        record.argCount = static_cast<int>(sizeof...(Args));
+        int index = 0;
+        ((record.args[index++] = LogArg(args)), ...);
+        (void)index;
+        submit(record);
+    }
+
+    template <typename... Args>
+    void debugf(const QString &category, const char *templ, const Args &... args) { logf(Debug, category, templ, args...); }
+    template <typename... Args>
+    void infof(const QString &category, const char *templ, const Args &... args) { logf(Info, category, templ, args...); }
+    template <typename... Args>
+    void warningf(const QString &category, const char *templ, const Args &... args) { logf(Warning, category, templ, args...); }
+    template <typename... Args>
+    void errorf(const QString &category, const char *templ, const Args &... args) { logf(Error, category, templ, args...); }
+
     /**
      * @brief 记录崩溃信息（包含堆栈跟踪）
+     *
+     * 先同步写出队列中已有的日志，再写入崩溃信息并 flush，不依赖写线程。
+     * 写线程长时间占用日志文件时，崩溃信息写入单独的 crash-<时间>.ylog。
      */
     void logCrash(const QString &crashMessage);
 
+    /**
+     * @brief 同步写出队列中已有的日志并 flush 到磁盘
+     */
+    void flush();
+
+    /**
+     * @brief 是否同时输出到控制台（默认输出）
+     */
+    void setConsoleOutput(bool enabled) { m_consoleOutput = enabled; }
+
     /**
      * @brief 获取当前日志文件路径
      */
     QString currentLogFilePath() const { return m_logFile ? m_logFile->fileName() : QString(); }
 
     /**
-     * @brief 获取所有日志文件路径
+     * @brief 获取所有日志文件路径（包括压缩归档）
      */
     QStringList getAllLogFiles() const;
 
@@ -53,14 +142,149 @@ public:
      */
     void logSystemInfo();
 
+    Stats stats() const;
+
+    void setRotationPolicy(const RotationPolicy &policy);
+    RotationPolicy rotationPolicy() const;
+
+    /**
+     * @brief 关闭当前日志文件并打开新文件，关闭的文件在后台压缩归档
+     */
+    void rotate();
+
+    /**
+     * @brief 等待后台压缩和清理完成
+     * @return 超时返回 false
+     */
+    bool waitForArchiving(int timeoutMs = -1);
+
+    /**
+     * @brief 归档目录
+     */
+    QString archiveDirectory() const { return m_logPath + "/archive"; }
+
+    /**
+     * @brief 水位线之后、本次运行中还未上传的归档（按序号升序）
+     */
+    QStringList pendingUploads() const;
+
+    /**
+     * @brief 标记归档已上传
+     *
+     * 水位线推进到连续上传成功的最后一个序号并保存；中间有失败的归档时，
+     * 它之后已上传的归档下次启动会再上传一次（同名对象覆盖）。
+     */
+    void markUploaded(const QString &archivePath);
+
+    /**
+     * @brief 上传水位线（已上传归档的最大连续序号，0 表示没有）
+     */
+    qint64 uploadWatermark() const;
+
 private:
-    void writeToFile(const QString &message);
-    QString levelToString(LogLevel level) const;
+    /**
+     * @brief 队列中的一条日志，编码和格式化推迟到写线程
+     */
+    struct Record {
+        qint64 timestamp = 0;       // 毫秒时间戳
+        int level = 0;              // LogLevel，RawText 表示原样写入的文本
+        QString category;
+        const char *templ = nullptr;    // 消息模板；为空时 args[0] 是完整消息
+        int argCount = 0;
+        LogArg args[LogArg::MaxArgs];
+    };
+
+    static const int RawText = -1;
+
+    static qint64 currentTimestamp();
+
+    /**
+     * @brief 放入队列；队列满时唤醒写线程并等待空位。写线程未启动时直接输出
+     */
+    void submit(Record &record);
+
+    /**
+     * @brief 写线程主循环
+     */
+    void writerLoop();
+
+    /**
+     * @brief 取出队列中的全部日志并写入文件（调用方持有 m_mutex）
+     */
+    void drainLocked();
+
+    /**
+     * @brief 把缓冲区写入文件和控制台并 flush（调用方持有 m_mutex）
+     */
+    void writeBufferLocked();
+
+    /**
+     * @brief 打开新的日志文件（调用方持有 m_mutex 或写线程未启动）
+     */
+    void openLogFileLocked();
+
+    /**
+     * @brief 当前文件超过大小或时长时轮转（调用方持有 m_mutex）
+     */
+    void rotateIfNeededLocked();
+    void rotateLocked();
+
+    /**
+     * @brief 启动时归档上次运行留下的日志文件
+     */
+    void archiveLeftoverFiles();
+
+    /**
+     * @brief 在后台线程压缩归档一个已关闭的日志文件，然后按策略清理
+     */
+    void scheduleArchive(const QString &filePath);
+    void archiveFile(const QString &filePath, const RotationPolicy &policy);
+    void applyRetention(const RotationPolicy &policy);
+
+    QStringList archiveFiles() const;
+    static qint64 archiveSequence(const QString &filePath);
+    void loadUploadWatermark();
+
+    void appendRecord(const Record &record);
+    void appendConsoleLine(const Record &record);
+    void wakeWriter();
+    void shutdown();
+
     QString getStackTrace() const;
 
     QFile *m_logFile;
-    QTextStream *m_stream;
-    QMutex m_mutex;
+    mutable QMutex m_mutex;         // 消费端互斥：写线程、flush、logCrash 之一持有
     LogLevel m_minLevel;
     QString m_logPath;
+    bool m_consoleOutput;
+
+    std::unique_ptr<MpscRingBuffer<Record>> m_queue;
+    QThread *m_writer;
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_stopping;
+    std::atomic<int> m_activeProducers; // 看到 m_running 为 true、正在入队的调用方数
+
+    QMutex m_wakeMutex;
+    QWaitCondition m_wakeCondition;
+    std::atomic<bool> m_wakeRequested;
+
+    // 以下只在持有 m_mutex 时访问
+    LogSegmentWriter m_segmentWriter;   // 当前段（写入文件）
+    QByteArray m_consoleBuffer;         // 当前批次的控制台文本
+    qint64 m_cachedSecond;
+    QByteArray m_cachedTimestamp;
+
+    RotationPolicy m_policy;            // 持有 m_mutex 时访问
+    qint64 m_fileOpenedAt;
+
+    QThreadPool m_archivePool;          // 单线程，归档按顺序完成
+    std::atomic<qint64> m_nextArchiveSeq;
+
+    mutable QMutex m_uploadMutex;
+    qint64 m_uploadWatermark;
+    QSet<qint64> m_uploadedSeqs;        // 本次运行已上传、但水位线还没越过的归档
+
+    std::atomic<qint64> m_linesWritten;
+    std::atomic<qint64> m_batches;
+    std::atomic<qint64> m_queueFullWaits;
 };
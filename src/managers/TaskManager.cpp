@@ -6,21 +6,45 @@
 #include "TaskManager.h"
 #include "../core/Logger.h"
 #include "../core/Application.h"
+#include "../core/Config.h"
 #include <QSettings>
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QFile>
+#include <QSaveFile>
 #include <QDir>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrent>
 #include <algorithm>
 
+namespace {
+// 每页任务数；同步时逐页合并，任务总数不受限制
+const int TASK_PAGE_SIZE = 200;
+}
+
 TaskManager::TaskManager(QObject *parent)
     : QObject(parent)
     , m_wsClient(nullptr)
-    , m_fileUploader(nullptr)
+    , m_uploadScheduler(nullptr)
+    , m_updateCoalescer(nullptr)
+    , m_syncInProgress(false)
+    , m_syncQueued(false)
     , m_isInitialized(false)
 {
-    // 创建文件上传器
-    m_fileUploader = new FileUploader(this);
+    // 创建上传调度器，多个任务的场景文件并行上传
+    m_uploadScheduler = new UploadScheduler(this);
+    connectUploadSignals();
+
+    // 高频的进度/状态推送按界面刷新频率合并后再写入任务
+    Config* config = Application::instance().config();
+    m_updateCoalescer = new TaskUpdateCoalescer(config ? config->uiUpdateRate() : 30, this);
+    connect(m_updateCoalescer, &TaskUpdateCoalescer::updatesFlushed, this, &TaskManager::onUpdatesFlushed);
+    if (config) {
+        connect(config, &Config::configChanged, this, [this, config]() {
+            m_updateCoalescer->setFlushRate(config->uiUpdateRate());
+        });
+    }
 }
 
 TaskManager::~TaskManager()
@@ -107,44 +131,145 @@ int TaskManager::getTaskCountByStatus(TaskStatus status) const
 
 void TaskManager::refreshTaskList()
 {
-    Application::instance().logger()->info("TaskManager", QString::fromUtf8("刷新任务列表"));
+    if (m_syncInProgress) {
+        m_syncQueued = true;
+        return;
+    }
+
+    m_syncInProgress = true;
+    m_sync = TaskSync();
+    m_sync.since = m_lastSyncAt;
+
+    if (m_sync.since.isValid()) {
+        Application::instance().logger()->infof("TaskManager", "增量同步任务列表，起点: %1",
+            m_sync.since.toString(Qt::ISODateWithMs));
+    } else {
+        Application::instance().logger()->info("TaskManager", QString::fromUtf8("全量同步任务列表"));
+    }
+
+    fetchTaskPage(QString());
+}
 
+void TaskManager::fetchTaskPage(const QString& cursor)
+{
     ApiService::instance().getTasks(
         QString(),  // status filter
-        0,          // skip
-        100,        // limit
-        [this](const QJsonObject& response) {
-            // 清空当前任务列表
-            qDeleteAll(m_tasks);
-            m_tasks.clear();
-            m_taskMap.clear();
-
-            // 解析任务列表
+        cursor,
+        TASK_PAGE_SIZE,
+        m_sync.since,
+        [this, cursor](const QJsonObject& response) {
+            // 以第一页的服务器时间作为下次增量同步的起点，分页期间的修改下次还会拉到
+            if (m_sync.pages++ == 0) {
+                m_sync.watermark = QDateTime::fromString(response["serverTime"].toString(), Qt::ISODateWithMs);
+            }
+
             QJsonArray tasksArray = response["tasks"].toArray();
             for (const QJsonValue& value : tasksArray) {
-                QJsonObject taskJson = value.toObject();
-                Task* task = Task::fromJson(taskJson, this);
-                addTask(task);
+                switch (mergeTask(value.toObject())) {
+                    case MergeResult::Inserted: m_sync.added++; break;
+                    case MergeResult::Updated: m_sync.updated++; break;
+                    default: break;
+                }
             }
 
-            // 排序任务
-            sortTasks();
+            QJsonArray deletedArray = response["deletedTaskIds"].toArray();
+            for (const QJsonValue& value : deletedArray) {
+                QString taskId = value.toString();
+                if (m_taskMap.contains(taskId)) {
+                    removeTask(taskId);
+                    m_sync.removed++;
+                }
+            }
 
-            Application::instance().logger()->info("TaskManager", QString::fromUtf8("任务列表刷新成功，共 %1 个任务").arg(m_tasks.size()));
-            emit taskListUpdated();
+            QString nextCursor = response["nextCursor"].toString();
+            if (!nextCursor.isEmpty() && nextCursor != cursor) {
+                fetchTaskPage(nextCursor);
+                return;
+            }
+            finishSync(true);
         },
         [this](int statusCode, const QString& error) {
-            Application::instance().logger()->error("TaskManager", QString::fromUtf8("刷新任务列表失败: %1").arg(error));
+            Application::instance().logger()->errorf("TaskManager", "刷新任务列表失败: %1", error);
+            finishSync(false);
         }
     );
 }
 
+void TaskManager::finishSync(bool success)
+{
+    if (success) {
+        // 全量同步：服务器上已不存在的任务从本地移除（草稿和上传中的任务还没有 taskId，不受影响）
+        if (!m_sync.since.isValid()) {
+            for (int row = m_tasks.size() - 1; row >= 0; --row) {
+                Task* task = m_tasks[row];
+                if (!task->taskId().isEmpty() && !m_sync.seenIds.contains(task->taskId())
+                    && m_uploadingTasks.key(task).isEmpty()) {
+                    removeTaskAt(row);
+                    m_sync.removed++;
+                }
+            }
+        }
+
+        // 服务器没有返回时间时，退回到本轮见到的最大 updatedAt
+        if (m_sync.watermark.isValid()) {
+            m_lastSyncAt = m_sync.watermark;
+        } else {
+            for (Task* task : m_tasks) {
+                if (task->updatedAt() > m_lastSyncAt) {
+                    m_lastSyncAt = task->updatedAt();
+                }
+            }
+        }
+
+        Application::instance().logger()->infof("TaskManager", "任务列表同步完成: 新增 %1，更新 %2，删除 %3，共 %4 个任务",
+            m_sync.added, m_sync.updated, m_sync.removed, m_tasks.size());
+        emit taskListSynced(m_sync.added, m_sync.updated, m_sync.removed);
+    }
+    // 失败时保留原水位，下次从同一起点重新同步（合并是幂等的）
+
+    m_sync = TaskSync();
+    m_syncInProgress = false;
+
+    if (m_syncQueued) {
+        m_syncQueued = false;
+        refreshTaskList();
+    }
+}
+
+TaskManager::MergeResult TaskManager::mergeTask(const QJsonObject& taskData)
+{
+    QString taskId = taskData["taskId"].toString();
+    if (taskId.isEmpty()) {
+        return MergeResult::Invalid;
+    }
+    m_sync.seenIds.insert(taskId);
+
+    Task* task = m_taskMap.value(taskId, nullptr);
+    if (!task) {
+        addTask(Task::fromJson(taskData, this));
+        return MergeResult::Inserted;
+    }
+
+    QDateTime updatedAt = QDateTime::fromString(taskData["updatedAt"].toString(), Qt::ISODateWithMs);
+    if (updatedAt.isValid() && task->updatedAt().isValid() && updatedAt <= task->updatedAt()) {
+        return MergeResult::Unchanged;
+    }
+
+    // 原地更新，界面持有的任务指针保持有效；只有变化的字段会触发重绘
+    QDateTime createdAt = task->createdAt();
+    task->updateFromJson(taskData);
+    if (task->createdAt() != createdAt) {
+        repositionTask(task);
+    }
+    return MergeResult::Updated;
+}
+
 void TaskManager::createTask(const QString& taskName, const QString& sceneFile, RenderConfig* config)
 {
     qDebug() << "========== 创建新任务 ==========";
     qDebug() << "任务名称:" << taskName;
     qDebug() << "场景文件:" << sceneFile;
-    Application::instance().logger()->info("TaskManager", QString::fromUtf8("创建新任务: %1").arg(taskName));
+    Application::instance().logger()->infof("TaskManager", "创建新任务: %1", taskName);
 
     // 创建任务对象
     Task* task = new Task(this);
@@ -162,9 +287,8 @@ void TaskManager::createTask(const QString& taskName, const QString& sceneFile,
     // 添加到列表
     addTask(task);
 
-    Application::instance().logger()->info("TaskManager", QString::fromUtf8("任务创建成功: %1").arg(taskName));
+    Application::instance().logger()->infof("TaskManager", "任务创建成功: %1", taskName);
     emit taskCreated(task);
-    emit taskListUpdated();
 }
 
 void TaskManager::submitTask(Task* task)
@@ -175,7 +299,7 @@ void TaskManager::submitTask(Task* task)
         return;
     }
 
-    Application::instance().logger()->info("TaskManager", QString::fromUtf8("提交任务: %1").arg(task->taskName()));
+    Application::instance().logger()->infof("TaskManager", "提交任务: %1", task->taskName());
 
     // 检查场景文件是否存在
     QString sceneFile = task->sceneFile();
@@ -187,13 +311,16 @@ void TaskManager::submitTask(Task* task)
 
     QFile file(sceneFile);
     if (!file.exists()) {
-        Application::instance().logger()->error("TaskManager", QString::fromUtf8("提交任务失败: 场景文件不存在: %1").arg(sceneFile));
+        Application::instance().logger()->errorf("TaskManager", "提交任务失败: 场景文件不存在: %1", sceneFile);
         emit taskSubmissionFailed("", QString::fromUtf8("场景文件不存在: %1").arg(sceneFile));
         return;
     }
 
     // 生成本地临时 ID（用于跟踪上传进度）
     QString localTaskId = QString("local_%1").arg(QDateTime::currentMSecsSinceEpoch());
+    for (int suffix = 1; m_uploadingTasks.contains(localTaskId); ++suffix) {
+        localTaskId = QString("local_%1_%2").arg(QDateTime::currentMSecsSinceEpoch()).arg(suffix);
+    }
 
     // 添加到任务列表（如果还没有）
     if (!m_tasks.contains(task)) {
@@ -203,132 +330,406 @@ void TaskManager::submitTask(Task* task)
     // 更新任务状态为上传中
     task->setStatus(TaskStatus::Uploading);
     task->setProgress(0);
-    m_uploadingTasks[localTaskId] = task;
+    trackUpload(localTaskId, task);
 
-    Application::instance().logger()->info("TaskManager", QString::fromUtf8("开始上传场景文件: %1").arg(sceneFile));
+    Application::instance().logger()->infof("TaskManager", "开始上传场景文件: %1", sceneFile);
     emit taskStatusUpdated(localTaskId, TaskStatus::Uploading);
-    emit taskListUpdated();
 
-    // 先断开之前可能存在的所有连接，避免重复连接
-    disconnect(m_fileUploader, &FileUploader::progressChanged, this, nullptr);
-    disconnect(m_fileUploader, &FileUploader::uploadFinished, this, nullptr);
-    disconnect(m_fileUploader, &FileUploader::uploadError, this, nullptr);
+    // 立即保存，收集依赖期间崩溃时重启后重新提交
+    saveTasksToLocal();
+
+    // 在后台收集场景依赖（纹理、缓存、引用场景等），完成后一起上传
+    QFutureWatcher<ScenePackage>* watcher = new QFutureWatcher<ScenePackage>(this);
+    connect(watcher, &QFutureWatcher<ScenePackage>::finished, this, [this, watcher, localTaskId]() {
+        ScenePackage package = watcher->result();
+        watcher->deleteLater();
 
-    // 连接上传器信号 - 使用 Qt::UniqueConnection 避免重复连接
-    connect(m_fileUploader, &FileUploader::progressChanged, this,
-        [this, localTaskId, task](int progress, qint64 uploadedBytes, qint64 totalBytes) {
-            if (!m_uploadingTasks.contains(localTaskId)) {
-                return; // 任务已被取消或完成
+        if (!m_uploadingTasks.contains(localTaskId)) {
+            return; // 任务已被取消
+        }
+        startPackageUpload(localTaskId, package);
+    });
+    // Config 只能在 GUI 线程读取
+    MayaDetector::CacheSettings cacheSettings = MayaDetector::CacheSettings::fromConfig();
+    watcher->setFuture(QtConcurrent::run([sceneFile, cacheSettings]() {
+        return ScenePackager::collect(sceneFile, cacheSettings);
+    }));
+}
+
+void TaskManager::startPackageUpload(const QString& localTaskId, const ScenePackage& package)
+{
+    Task* task = m_uploadingTasks.value(localTaskId, nullptr);
+
+    if (package.scene.localPath.isEmpty()) {
+        failUpload(localTaskId, QString::fromUtf8("无法读取场景文件: %1").arg(task->sceneFile()));
+        return;
+    }
+
+    if (!package.missing.isEmpty()) {
+        Application::instance().logger()->warningf("TaskManager", "场景有 %1 个素材找不到，将不会上传: %2",
+            package.missing.size(), package.missing.join(", "));
+    }
+
+    Application::instance().logger()->infof("TaskManager", "上传场景及 %1 个依赖文件，共 %2 MB",
+        package.assets.size(), package.totalBytes / 1024 / 1024);
+
+    QVector<ScenePackageFile> files;
+    files << package.scene << package.assets;
+
+    // 其他任务正在上传的同一素材直接等待其完成，不重复上传
+    UploadSubmission submission;
+    submission.task = task;
+    submission.package = package;
+    QStringList newJobs;
+    for (int i = 0; i < files.size(); ++i) {
+        QString jobId = m_uploadScheduler->jobForFile(files[i].localPath);
+        if (jobId.isEmpty()) {
+            jobId = (i == 0) ? localTaskId : QString("%1_%2").arg(localTaskId).arg(i);
+            newJobs << jobId;
+        }
+        submission.pendingJobs[jobId] = files[i].localPath;
+        submission.uploadedBytes[jobId] = 0;
+    }
+    m_submissions[localTaskId] = submission;
+
+    // 保存场景包和上传任务，崩溃或重启后从上传日志续传
+    saveTasksToLocal();
+
+    // 场景和素材按任务优先级并行上传
+    int priority = static_cast<int>(task->priority());
+    for (const QString& jobId : newJobs) {
+        m_uploadScheduler->enqueue(jobId, m_submissions[localTaskId].pendingJobs.value(jobId), priority);
+        if (!m_submissions.contains(localTaskId)) {
+            return; // 上传失败，已处理
+        }
+    }
+}
+
+void TaskManager::trackUpload(const QString& localTaskId, Task* task)
+{
+    m_uploadingTasks[localTaskId] = task;
+
+    // 上传过程中修改优先级，调度器随之调整分片分配
+    connect(task, &Task::priorityChanged, this, [this, localTaskId, task]() {
+        auto it = m_submissions.constFind(localTaskId);
+        if (it == m_submissions.constEnd()) {
+            return;
+        }
+        for (const QString& jobId : it->pendingJobs.keys()) {
+            m_uploadScheduler->setPriority(jobId, static_cast<int>(task->priority()));
+        }
+    });
+}
+
+QJsonObject TaskManager::uploadToJson(const QString& localTaskId) const
+{
+    QJsonObject upload;
+    upload["localTaskId"] = localTaskId;
+
+    auto it = m_submissions.constFind(localTaskId);
+    if (it == m_submissions.constEnd()) {
+        return upload; // 还在收集依赖，或正在向服务器创建任务
+    }
+
+    QJsonObject jobs;
+    for (auto job = it->pendingJobs.constBegin(); job != it->pendingJobs.constEnd(); ++job) {
+        jobs[job.key()] = job.value();
+    }
+    QJsonObject uploadedBytes;
+    for (auto bytes = it->uploadedBytes.constBegin(); bytes != it->uploadedBytes.constEnd(); ++bytes) {
+        uploadedBytes[bytes.key()] = bytes.value();
+    }
+    QJsonObject uploads;
+    for (auto file = it->uploads.constBegin(); file != it->uploads.constEnd(); ++file) {
+        uploads[file.key()] = file.value();
+    }
+
+    upload["package"] = ScenePackager::packageToJson(it->package);
+    upload["jobs"] = jobs;
+    upload["uploadedBytes"] = uploadedBytes;
+    upload["uploads"] = uploads;
+    return upload;
+}
+
+void TaskManager::resumeUpload(Task* task, const QJsonObject& upload)
+{
+    QString localTaskId = upload["localTaskId"].toString();
+    if (localTaskId.isEmpty() || !upload.contains("package") || m_uploadingTasks.contains(localTaskId)) {
+        // 收集依赖期间中断，没有场景包记录，重新提交
+        submitTask(task);
+        if (m_uploadingTasks.key(task).isEmpty()) {
+            task->setStatus(TaskStatus::Failed);  // 场景文件已不存在
+        }
+        return;
+    }
+
+    Application::instance().logger()->infof("TaskManager", "继续上传中断的任务: %1", task->taskName());
+
+    UploadSubmission submission;
+    submission.task = task;
+    submission.package = ScenePackager::packageFromJson(upload["package"].toObject());
+
+    QJsonObject uploadedBytes = upload["uploadedBytes"].toObject();
+    for (auto it = uploadedBytes.constBegin(); it != uploadedBytes.constEnd(); ++it) {
+        submission.uploadedBytes[it.key()] = it.value().toInteger();
+    }
+    QJsonObject uploads = upload["uploads"].toObject();
+    for (auto it = uploads.constBegin(); it != uploads.constEnd(); ++it) {
+        submission.uploads[it.key()] = it.value().toObject();
+    }
+
+    // 未完成的文件重新入队，上传器按上传日志沿用原会话、跳过已确认的分片；
+    // 其他恢复的任务已在上传同一文件时直接等待它
+    QStringList newJobs;
+    QJsonObject jobs = upload["jobs"].toObject();
+    for (auto it = jobs.constBegin(); it != jobs.constEnd(); ++it) {
+        QString localPath = it.value().toString();
+        QString jobId = m_uploadScheduler->jobForFile(localPath);
+        if (jobId.isEmpty()) {
+            jobId = it.key();
+            if (!m_uploadScheduler->contains(jobId)) {
+                newJobs << jobId;
             }
-            task->setProgress(progress);
-            emit fileUploadProgress(localTaskId, progress, uploadedBytes, totalBytes);
-            emit taskProgressUpdated(localTaskId, progress);
-        },
-        Qt::UniqueConnection
-    );
+        }
+        submission.uploadedBytes.remove(it.key());
+        submission.pendingJobs[jobId] = localPath;
+        submission.uploadedBytes[jobId] = 0;
+    }
 
-    connect(m_fileUploader, &FileUploader::uploadFinished, this,
-        [this, localTaskId, task, sceneFile](bool success) {
-            if (!m_uploadingTasks.contains(localTaskId)) {
-                return; // 任务已被取消或完成
+    trackUpload(localTaskId, task);
+    m_submissions[localTaskId] = submission;
+    emitSubmissionProgress(localTaskId);
+
+    if (submission.pendingJobs.isEmpty()) {
+        // 文件已全部上传，中断时还没有创建任务
+        UploadSubmission finished = m_submissions.take(localTaskId);
+        createUploadedTask(localTaskId, task, ScenePackager::buildManifest(finished.package, finished.uploads));
+        return;
+    }
+
+    int priority = static_cast<int>(task->priority());
+    for (const QString& jobId : newJobs) {
+        m_uploadScheduler->enqueue(jobId, m_submissions[localTaskId].pendingJobs.value(jobId), priority);
+        if (!m_submissions.contains(localTaskId)) {
+            return; // 上传失败，已处理
+        }
+    }
+}
+
+void TaskManager::connectUploadSignals()
+{
+    connect(m_uploadScheduler, &UploadScheduler::jobProgress, this,
+        [this](const QString& jobId, int progress, qint64 uploadedBytes, qint64 totalBytes) {
+            // 一个文件可能被多个任务共用，更新所有等待它的任务
+            for (const QString& localTaskId : submissionsWaitingFor(jobId)) {
+                UploadSubmission& submission = m_submissions[localTaskId];
+                submission.uploadedBytes[jobId] = uploadedBytes;
+                emitSubmissionProgress(localTaskId);
             }
+        }
+    );
 
-            if (!success) {
-                Application::instance().logger()->error("TaskManager", QString::fromUtf8("文件上传失败"));
-                task->setStatus(TaskStatus::Failed);
-                task->setErrorMessage(QString::fromUtf8("文件上传失败"));
-                m_uploadingTasks.remove(localTaskId);
-                emit fileUploadFailed(localTaskId, QString::fromUtf8("文件上传失败"));
-                emit taskSubmissionFailed(localTaskId, QString::fromUtf8("文件上传失败"));
-                emit taskListUpdated();
-                return;
+    connect(m_uploadScheduler, &UploadScheduler::jobUploaded, this,
+        [this](const QString& jobId, const QString& uploadId, const QString& fileHash) {
+            QJsonObject upload;
+            upload["uploadId"] = uploadId;
+            upload["fileHash"] = fileHash;
+
+            for (const QString& localTaskId : submissionsWaitingFor(jobId)) {
+                UploadSubmission& submission = m_submissions[localTaskId];
+                submission.uploads[submission.pendingJobs.value(jobId)] = upload;
             }
+        }
+    );
 
-            Application::instance().logger()->info("TaskManager", QString::fromUtf8("文件上传成功，开始创建任务"));
-
-            // 文件上传成功，调用后端 API 创建任务
-            QJsonObject taskJson = task->toJson();
-            taskJson["sceneFileUrl"] = sceneFile;  // 实际应该是 OSS URL，这里简化处理
-
-            ApiService::instance().createTask(
-                taskJson,
-                [this, localTaskId, task](const QJsonObject& response) {
-                    if (!m_uploadingTasks.contains(localTaskId)) {
-                        return; // 任务已被取消
-                    }
-
-                    // 更新任务 ID
-                    QString taskId = response["taskId"].toString();
-                    task->setTaskId(taskId);
-                    task->setStatus(TaskStatus::Pending);
-                    task->setProgress(0);
-
-                    // 更新 map
-                    m_taskMap[taskId] = task;
-                    m_uploadingTasks.remove(localTaskId);
-
-                    Application::instance().logger()->info("TaskManager", QString::fromUtf8("任务提交成功: %1").arg(taskId));
-                    emit taskSubmitted(taskId);
-                    emit taskStatusUpdated(taskId, TaskStatus::Pending);
-                    emit taskListUpdated();
-                },
-                [this, localTaskId, task](int statusCode, const QString& error) {
-                    if (!m_uploadingTasks.contains(localTaskId)) {
-                        return; // 任务已被取消
-                    }
-
-                    Application::instance().logger()->error("TaskManager", QString::fromUtf8("任务提交失败: %1").arg(error));
-                    task->setStatus(TaskStatus::Failed);
-                    task->setErrorMessage(error);
-                    m_uploadingTasks.remove(localTaskId);
-                    emit taskSubmissionFailed(localTaskId, error);
-                    emit taskListUpdated();
+    connect(m_uploadScheduler, &UploadScheduler::jobFinished, this,
+        [this](const QString& jobId, bool success) {
+            for (const QString& localTaskId : submissionsWaitingFor(jobId)) {
+                if (!success) {
+                    Application::instance().logger()->error("TaskManager", QString::fromUtf8("文件上传失败"));
+                    failUpload(localTaskId, QString::fromUtf8("文件上传失败"));
+                    continue;
                 }
-            );
-        },
-        Qt::UniqueConnection
+
+                UploadSubmission& submission = m_submissions[localTaskId];
+                QString localPath = submission.pendingJobs.take(jobId);
+                submission.uploadedBytes[jobId] = QFileInfo(localPath).size();
+                emitSubmissionProgress(localTaskId);
+
+                if (submission.pendingJobs.isEmpty()) {
+                    // 场景和全部依赖都已上传，带上路径映射清单创建任务
+                    UploadSubmission finished = m_submissions.take(localTaskId);
+                    createUploadedTask(localTaskId, finished.task,
+                                       ScenePackager::buildManifest(finished.package, finished.uploads));
+                }
+            }
+        }
+    );
+
+    connect(m_uploadScheduler, &UploadScheduler::jobError, this,
+        [this](const QString& jobId, const QString& error) {
+            for (const QString& localTaskId : submissionsWaitingFor(jobId)) {
+                Application::instance().logger()->errorf("TaskManager", "文件上传错误: %1", error);
+                failUpload(localTaskId, error);
+            }
+        }
     );
 
-    connect(m_fileUploader, &FileUploader::uploadError, this,
-        [this, localTaskId, task](const QString& error) {
+    connect(m_uploadScheduler, &UploadScheduler::tuningChanged, this, &TaskManager::uploadTuningChanged);
+}
+
+QStringList TaskManager::submissionsWaitingFor(const QString& jobId) const
+{
+    QStringList result;
+    for (auto it = m_submissions.constBegin(); it != m_submissions.constEnd(); ++it) {
+        if (it->pendingJobs.contains(jobId)) {
+            result << it.key();
+        }
+    }
+    return result;
+}
+
+void TaskManager::emitSubmissionProgress(const QString& localTaskId)
+{
+    const UploadSubmission& submission = m_submissions[localTaskId];
+
+    qint64 uploadedBytes = 0;
+    for (qint64 bytes : submission.uploadedBytes) {
+        uploadedBytes += bytes;
+    }
+    qint64 totalBytes = submission.package.totalBytes;
+    int progress = totalBytes > 0 ? static_cast<int>(qMin<qint64>(uploadedBytes * 100 / totalBytes, 100)) : 0;
+
+    m_updateCoalescer->setProgress(submission.task, localTaskId, progress, uploadedBytes, totalBytes);
+}
+
+void TaskManager::onUpdatesFlushed(const QList<TaskUpdate>& updates)
+{
+    for (const TaskUpdate& update : updates) {
+        if (update.fields & TaskUpdate::StatusField) {
+            emit taskStatusUpdated(update.taskId, update.status);
+        }
+        if (update.fields & TaskUpdate::BytesField) {
+            emit fileUploadProgress(update.taskId, update.progress, update.uploadedBytes, update.totalBytes);
+        }
+        if (update.fields & TaskUpdate::ProgressField) {
+            emit taskProgressUpdated(update.taskId, update.progress);
+        }
+    }
+
+    emit tasksUpdated(updates);
+}
+
+void TaskManager::failUpload(const QString& localTaskId, const QString& error)
+{
+    Task* task = m_uploadingTasks.take(localTaskId);
+    if (!task) {
+        return;
+    }
+
+    // 取消只属于该任务的其余文件上传
+    cancelOrphanJobs(m_submissions.take(localTaskId).pendingJobs.keys());
+
+    disconnect(task, &Task::priorityChanged, this, nullptr);
+    m_updateCoalescer->flush();
+    task->setStatus(TaskStatus::Failed);
+    task->setErrorMessage(error);
+    saveTasksToLocal();
+    emit fileUploadFailed(localTaskId, error);
+    emit taskSubmissionFailed(localTaskId, error);
+}
+
+void TaskManager::cancelOrphanJobs(const QStringList& jobIds)
+{
+    // 其他任务也在等待的文件继续上传
+    QStringList orphanJobs;
+    for (const QString& jobId : jobIds) {
+        if (submissionsWaitingFor(jobId).isEmpty()) {
+            orphanJobs << jobId;
+        }
+    }
+    if (orphanJobs.isEmpty()) {
+        return;
+    }
+
+    // 在事件循环中执行，避免在上传器的信号中重入
+    QMetaObject::invokeMethod(this, [this, orphanJobs]() {
+        for (const QString& jobId : orphanJobs) {
+            m_uploadScheduler->cancel(jobId);
+        }
+    }, Qt::QueuedConnection);
+}
+
+void TaskManager::createUploadedTask(const QString& localTaskId, Task* task, const QJsonObject& manifest)
+{
+    Application::instance().logger()->info("TaskManager", QString::fromUtf8("文件上传成功，开始创建任务"));
+
+    disconnect(task, &Task::priorityChanged, this, nullptr);
+
+    // 文件上传成功，调用后端 API 创建任务
+    QJsonObject taskJson = task->toJson();
+    taskJson["sceneFileUrl"] = task->sceneFile();  // 实际应该是 OSS URL，这里简化处理
+    taskJson["assetManifest"] = manifest;           // 场景中原始路径 -> 上传后相对路径
+
+    ApiService::instance().createTask(
+        taskJson,
+        [this, localTaskId, task](const QJsonObject& response) {
+            if (!m_uploadingTasks.contains(localTaskId)) {
+                return; // 任务已被取消
+            }
+
+            // 更新任务 ID
+            m_updateCoalescer->flush();
+            QString taskId = response["taskId"].toString();
+            task->setTaskId(taskId);
+            task->setStatus(TaskStatus::Pending);
+            task->setProgress(0);
+
+            // 更新 map
+            m_taskMap[taskId] = task;
+            m_uploadingTasks.remove(localTaskId);
+            saveTasksToLocal();  // 不再作为未完成的上传在重启后恢复
+
+            Application::instance().logger()->infof("TaskManager", "任务提交成功: %1", taskId);
+            emit taskSubmitted(taskId);
+            emit taskStatusUpdated(taskId, TaskStatus::Pending);
+        },
+        [this, localTaskId, task](int statusCode, const QString& error) {
             if (!m_uploadingTasks.contains(localTaskId)) {
-                return; // 任务已被取消或完成
+                return; // 任务已被取消
             }
 
-            Application::instance().logger()->error("TaskManager", QString::fromUtf8("文件上传错误: %1").arg(error));
+            Application::instance().logger()->errorf("TaskManager", "任务提交失败: %1", error);
+            m_updateCoalescer->flush();
             task->setStatus(TaskStatus::Failed);
             task->setErrorMessage(error);
             m_uploadingTasks.remove(localTaskId);
-            emit fileUploadFailed(localTaskId, error);
+            saveTasksToLocal();
             emit taskSubmissionFailed(localTaskId, error);
-            emit taskListUpdated();
-        },
-        Qt::UniqueConnection
+        }
     );
-
-    // 开始上传文件
-    m_fileUploader->startUpload(sceneFile, localTaskId);
 }
 
 void TaskManager::startTask(const QString& taskId)
 {
-    Application::instance().logger()->info("TaskManager", QString::fromUtf8("开始任务: %1").arg(taskId));
+    Application::instance().logger()->infof("TaskManager", "开始任务: %1", taskId);
 
     ApiService::instance().resumeTask(
         taskId,
         [this, taskId](const QJsonObject& response) {
-            // 更新本地任务状态
+            // 更新本地任务状态（先提交之前收到的推送，避免之后覆盖）
+            m_updateCoalescer->flush();
             Task* task = getTaskById(taskId);
             if (task) {
                 task->setStatus(TaskStatus::Rendering);
             }
 
-            Application::instance().logger()->info("TaskManager", QString::fromUtf8("任务开始成功: %1").arg(taskId));
+            Application::instance().logger()->infof("TaskManager", "任务开始成功: %1", taskId);
             emit taskOperationSuccess(taskId, "start");
             emit taskStatusUpdated(taskId, TaskStatus::Rendering);
         },
         [this, taskId](int statusCode, const QString& error) {
-            Application::instance().logger()->error("TaskManager", QString::fromUtf8("开始任务失败: %1").arg(error));
+            Application::instance().logger()->errorf("TaskManager", "开始任务失败: %1", error);
             emit taskOperationFailed(taskId, "start", error);
         }
     );
@@ -336,23 +737,24 @@ void TaskManager::startTask(const QString& taskId)
 
 void TaskManager::pauseTask(const QString& taskId)
 {
-    Application::instance().logger()->info("TaskManager", QString::fromUtf8("暂停任务: %1").arg(taskId));
+    Application::instance().logger()->infof("TaskManager", "暂停任务: %1", taskId);
 
     ApiService::instance().pauseTask(
         taskId,
         [this, taskId](const QJsonObject& response) {
-            // 更新本地任务状态
+            // 更新本地任务状态（先提交之前收到的推送，避免之后覆盖）
+            m_updateCoalescer->flush();
             Task* task = getTaskById(taskId);
             if (task) {
                 task->setStatus(TaskStatus::Paused);
             }
 
-            Application::instance().logger()->info("TaskManager", QString::fromUtf8("任务暂停成功: %1").arg(taskId));
+            Application::instance().logger()->infof("TaskManager", "任务暂停成功: %1", taskId);
             emit taskOperationSuccess(taskId, "pause");
             emit taskStatusUpdated(taskId, TaskStatus::Paused);
         },
         [this, taskId](int statusCode, const QString& error) {
-            Application::instance().logger()->error("TaskManager", QString::fromUtf8("暂停任务失败: %1").arg(error));
+            Application::instance().logger()->errorf("TaskManager", "暂停任务失败: %1", error);
             emit taskOperationFailed(taskId, "pause", error);
         }
     );
@@ -360,23 +762,24 @@ void TaskManager::pauseTask(const QString& taskId)
 
 void TaskManager::resumeTask(const QString& taskId)
 {
-    Application::instance().logger()->info("TaskManager", QString::fromUtf8("恢复任务: %1").arg(taskId));
+    Application::instance().logger()->infof("TaskManager", "恢复任务: %1", taskId);
 
     ApiService::instance().resumeTask(
         taskId,
         [this, taskId](const QJsonObject& response) {
-            // 更新本地任务状态
+            // 更新本地任务状态（先提交之前收到的推送，避免之后覆盖）
+            m_updateCoalescer->flush();
             Task* task = getTaskById(taskId);
             if (task) {
                 task->setStatus(TaskStatus::Queued);
             }
 
-            Application::instance().logger()->info("TaskManager", QString::fromUtf8("任务恢复成功: %1").arg(taskId));
+            Application::instance().logger()->infof("TaskManager", "任务恢复成功: %1", taskId);
             emit taskOperationSuccess(taskId, "resume");
             emit taskStatusUpdated(taskId, TaskStatus::Queued);
         },
         [this, taskId](int statusCode, const QString& error) {
-            Application::instance().logger()->error("TaskManager", QString::fromUtf8("恢复任务失败: %1").arg(error));
+            Application::instance().logger()->errorf("TaskManager", "恢复任务失败: %1", error);
             emit taskOperationFailed(taskId, "resume", error);
         }
     );
@@ -384,31 +787,71 @@ void TaskManager::resumeTask(const QString& taskId)
 
 void TaskManager::cancelTask(const QString& taskId)
 {
-    Application::instance().logger()->info("TaskManager", QString::fromUtf8("取消任务: %1").arg(taskId));
+    Application::instance().logger()->infof("TaskManager", "取消任务: %1", taskId);
 
     ApiService::instance().cancelTask(
         taskId,
         [this, taskId](const QJsonObject& response) {
-            // 更新本地任务状态
+            // 更新本地任务状态（先提交之前收到的推送，避免之后覆盖）
+            m_updateCoalescer->flush();
             Task* task = getTaskById(taskId);
             if (task) {
                 task->setStatus(TaskStatus::Cancelled);
             }
 
-            Application::instance().logger()->info("TaskManager", QString::fromUtf8("任务取消成功: %1").arg(taskId));
+            Application::instance().logger()->infof("TaskManager", "任务取消成功: %1", taskId);
             emit taskOperationSuccess(taskId, "cancel");
             emit taskStatusUpdated(taskId, TaskStatus::Cancelled);
         },
         [this, taskId](int statusCode, const QString& error) {
-            Application::instance().logger()->error("TaskManager", QString::fromUtf8("取消任务失败: %1").arg(error));
+            Application::instance().logger()->errorf("TaskManager", "取消任务失败: %1", error);
             emit taskOperationFailed(taskId, "cancel", error);
         }
     );
 }
 
+void TaskManager::cancelUpload(Task* task)
+{
+    if (!task || !task->taskId().isEmpty()) {
+        return;
+    }
+
+    QString localTaskId = m_uploadingTasks.key(task);
+    Application::instance().logger()->infof("TaskManager", "取消上传: %1", task->taskName());
+
+    if (!localTaskId.isEmpty()) {
+        // 收集依赖或创建任务的回调看到任务已不在上传列表中，会直接返回
+        m_uploadingTasks.remove(localTaskId);
+        cancelOrphanJobs(m_submissions.take(localTaskId).pendingJobs.keys());
+        disconnect(task, &Task::priorityChanged, this, nullptr);
+    }
+
+    m_updateCoalescer->flush();
+    task->setStatus(TaskStatus::Cancelled);
+    saveTasksToLocal();
+
+    emit taskOperationSuccess(localTaskId, "cancel");
+    emit taskStatusUpdated(localTaskId, TaskStatus::Cancelled);
+}
+
+void TaskManager::removeLocalTask(Task* task)
+{
+    if (!task || !task->taskId().isEmpty()) {
+        return;
+    }
+
+    if (!m_uploadingTasks.key(task).isEmpty()) {
+        cancelUpload(task);
+    }
+
+    Application::instance().logger()->infof("TaskManager", "删除本地任务: %1", task->taskName());
+    removeTaskAt(m_tasks.indexOf(task));
+    saveTasksToLocal();
+}
+
 void TaskManager::deleteTask(const QString& taskId)
 {
-    Application::instance().logger()->info("TaskManager", QString::fromUtf8("删除任务: %1").arg(taskId));
+    Application::instance().logger()->infof("TaskManager", "删除任务: %1", taskId);
 
     ApiService::instance().deleteTask(
         taskId,
@@ -417,13 +860,11 @@ void TaskManager::deleteTask(const QString& taskId)
             // 从本地列表删除
             removeTask(taskId);
 
-            Application::instance().logger()->info("TaskManager", QString::fromUtf8("任务删除成功: %1").arg(taskId));
+            Application::instance().logger()->infof("TaskManager", "任务删除成功: %1", taskId);
             emit taskOperationSuccess(taskId, "delete");
-            emit taskRemoved(taskId);
-            emit taskListUpdated();
         },
         [this, taskId](int statusCode, const QString& error) {
-            Application::instance().logger()->error("TaskManager", QString::fromUtf8("删除任务失败: %1").arg(error));
+            Application::instance().logger()->errorf("TaskManager", "删除任务失败: %1", error);
             emit taskOperationFailed(taskId, "delete", error);
         }
     );
@@ -431,7 +872,7 @@ void TaskManager::deleteTask(const QString& taskId)
 
 void TaskManager::fetchTaskDetails(const QString& taskId)
 {
-    Application::instance().logger()->info("TaskManager", QString::fromUtf8("获取任务详情: %1").arg(taskId));
+    Application::instance().logger()->infof("TaskManager", "获取任务详情: %1", taskId);
 
     ApiService::instance().getTask(
         taskId,
@@ -440,18 +881,18 @@ void TaskManager::fetchTaskDetails(const QString& taskId)
             updateTask(taskId, response);
 
             Task* task = getTaskById(taskId);
-            Application::instance().logger()->info("TaskManager", QString::fromUtf8("任务详情获取成功: %1").arg(taskId));
+            Application::instance().logger()->infof("TaskManager", "任务详情获取成功: %1", taskId);
             emit taskDetailsFetched(task);
         },
         [this, taskId](int statusCode, const QString& error) {
-            Application::instance().logger()->error("TaskManager", QString::fromUtf8("获取任务详情失败: %1").arg(error));
+            Application::instance().logger()->errorf("TaskManager", "获取任务详情失败: %1", error);
         }
     );
 }
 
 void TaskManager::downloadTaskResults(const QString& taskId, const QString& savePath)
 {
-    Application::instance().logger()->info("TaskManager", QString::fromUtf8("下载任务结果: %1 -> %2").arg(taskId, savePath));
+    Application::instance().logger()->infof("TaskManager", "下载任务结果: %1 -> %2", taskId, savePath);
 
     // 这里需要实现文件下载逻辑
     // 可以使用 HttpClient 的下载功能
@@ -462,18 +903,35 @@ void TaskManager::clearAllTasks()
 {
     Application::instance().logger()->info("TaskManager", QString::fromUtf8("清空所有任务"));
 
-    qDeleteAll(m_tasks);
+    QList<Task*> tasks = m_tasks;
     m_tasks.clear();
     m_taskMap.clear();
 
+    // 本地列表已清空，下次同步需要全量拉取
+    m_lastSyncAt = QDateTime();
+
     emit taskListUpdated();
+    for (Task* task : tasks) {
+        task->deleteLater();
+    }
 }
 
 void TaskManager::saveTasksToLocal()
 {
+    QHash<Task*, QString> uploadingIds;
+    for (auto it = m_uploadingTasks.constBegin(); it != m_uploadingTasks.constEnd(); ++it) {
+        uploadingIds[it.value()] = it.key();
+    }
+
     QJsonArray tasksArray;
     for (Task* task : m_tasks) {
-        tasksArray.append(task->toJson());
+        QJsonObject taskJson = task->toJson();
+        // 未完成的上传一并保存，重启后继续
+        auto uploading = uploadingIds.constFind(task);
+        if (uploading != uploadingIds.constEnd()) {
+            taskJson["upload"] = uploadToJson(uploading.value());
+        }
+        tasksArray.append(taskJson);
     }
 
     QJsonObject root;
@@ -487,10 +945,9 @@ void TaskManager::saveTasksToLocal()
     QString dataPath = QDir::homePath() + "/AppData/Roaming/YunTu";
     QDir().mkpath(dataPath);
 
-    QFile file(dataPath + "/tasks.json");
-    if (file.open(QIODevice::WriteOnly)) {
-        file.write(data);
-        file.close();
+    // 上传过程中也会保存，先写临时文件再替换，崩溃时不会留下写了一半的列表
+    QSaveFile file(dataPath + "/tasks.json");
+    if (file.open(QIODevice::WriteOnly) && file.write(data) == data.size() && file.commit()) {
         Application::instance().logger()->debug("TaskManager", QString::fromUtf8("任务列表已保存到本地"));
     } else {
         Application::instance().logger()->error("TaskManager", QString::fromUtf8("保存任务列表失败"));
@@ -515,15 +972,29 @@ void TaskManager::loadTasksFromLocal()
         QJsonObject root = doc.object();
         QJsonArray tasksArray = root["tasks"].toArray();
 
+        // 批量加载后统一排序，整体通知一次
+        QList<QPair<Task*, QJsonObject>> interruptedUploads;
         for (const QJsonValue& value : tasksArray) {
             QJsonObject taskJson = value.toObject();
             Task* task = Task::fromJson(taskJson, this);
-            addTask(task);
+            m_tasks.append(task);
+            if (!task->taskId().isEmpty()) {
+                m_taskMap[task->taskId()] = task;
+            }
+            if (task->status() == TaskStatus::Uploading) {
+                interruptedUploads.append(qMakePair(task, taskJson["upload"].toObject()));
+            }
         }
 
         sortTasks();
+        emit taskListUpdated();
+
+        Application::instance().logger()->infof("TaskManager", "从本地加载 %1 个任务", m_tasks.size());
 
-        Application::instance().logger()->info("TaskManager", QString::fromUtf8("从本地加载 %1 个任务").arg(m_tasks.size()));
+        // 上次退出或崩溃时还在上传的任务继续上传
+        for (const auto& interrupted : interruptedUploads) {
+            resumeUpload(interrupted.first, interrupted.second);
+        }
     } else {
         Application::instance().logger()->error("TaskManager", QString::fromUtf8("加载本地任务列表失败"));
     }
@@ -535,12 +1006,14 @@ void TaskManager::addTask(Task* task)
         return;
     }
 
-    m_tasks.append(task);
+    int row = insertionRow(task);
+    m_tasks.insert(row, task);
 
     if (!task->taskId().isEmpty()) {
         m_taskMap[task->taskId()] = task;
     }
 
+    emit taskInserted(row, task);
     emit taskAdded(task);
 }
 
@@ -548,29 +1021,59 @@ void TaskManager::removeTask(const QString& taskId)
 {
     Task* task = m_taskMap.value(taskId, nullptr);
     if (task) {
-        m_tasks.removeOne(task);
-        m_taskMap.remove(taskId);
-        delete task;
+        removeTaskAt(m_tasks.indexOf(task));
     }
 }
 
-void TaskManager::updateTask(const QString& taskId, const QJsonObject& taskData)
+void TaskManager::removeTaskAt(int row)
 {
-    Task* task = getTaskById(taskId);
-    if (!task) {
-        // 任务不存在，创建新任务
-        task = Task::fromJson(taskData, this);
-        addTask(task);
-    } else {
-        // 更新现有任务
-        task->setTaskName(taskData["taskName"].toString());
-        task->setStatus(static_cast<TaskStatus>(taskData["status"].toInt()));
-        task->setProgress(taskData["progress"].toInt());
-        task->setPriority(static_cast<TaskPriority>(taskData["priority"].toInt()));
-        // ... 更新其他字段
+    if (row < 0 || row >= m_tasks.size()) {
+        return;
     }
 
-    emit taskListUpdated();
+    Task* task = m_tasks.takeAt(row);
+    QString taskId = task->taskId();
+    m_taskMap.remove(taskId);
+
+    emit taskRowRemoved(row, task);
+    emit taskRemoved(taskId);
+
+    // 延迟释放，当前事件中仍持有该指针的界面不会访问到已释放的对象
+    task->deleteLater();
+}
+
+void TaskManager::repositionTask(Task* task)
+{
+    int from = m_tasks.indexOf(task);
+    if (from < 0) {
+        return;
+    }
+
+    m_tasks.removeAt(from);
+    int to = insertionRow(task);
+    m_tasks.insert(to, task);
+
+    if (from != to) {
+        emit taskMoved(from, to);
+    }
+}
+
+int TaskManager::insertionRow(Task* task) const
+{
+    // 按创建时间降序（最新的在前面），创建时间相同的排在已有任务之后
+    auto it = std::upper_bound(m_tasks.begin(), m_tasks.end(), task, [](Task* a, Task* b) {
+        return a->createdAt() > b->createdAt();
+    });
+    return static_cast<int>(it - m_tasks.begin());
+}
+
+void TaskManager::updateTask(const QString& taskId, const QJsonObject& taskData)
+{
+    QJsonObject data = taskData;
+    if (!data.contains("taskId")) {
+        data["taskId"] = taskId;
+    }
+    mergeTask(data);
 }
 
 void TaskManager::connectWebSocketSignals()
@@ -589,8 +1092,7 @@ void TaskManager::handleTaskStatusUpdate(const QString& taskId, int status)
 {
     Task* task = getTaskById(taskId);
     if (task) {
-        task->setStatus(static_cast<TaskStatus>(status));
-        emit taskStatusUpdated(taskId, static_cast<TaskStatus>(status));
+        m_updateCoalescer->setStatus(task, taskId, static_cast<TaskStatus>(status));
     }
 }
 
@@ -598,8 +1100,7 @@ void TaskManager::handleTaskProgressUpdate(const QString& taskId, int progress)
 {
     Task* task = getTaskById(taskId);
     if (task) {
-        task->setProgress(progress);
-        emit taskProgressUpdated(taskId, progress);
+        m_updateCoalescer->setProgress(task, taskId, progress);
     }
 }
 
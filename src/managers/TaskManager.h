@@ -9,11 +9,15 @@
 #include <QObject>
 #include <QList>
 #include <QMap>
+#include <QSet>
+#include <QDateTime>
 #include "../models/Task.h"
 #include "../models/RenderConfig.h"
 #include "../network/ApiService.h"
 #include "../network/WebSocketClient.h"
-#include "../network/FileUploader.h"
+#include "../network/UploadScheduler.h"
+#include "../services/ScenePackager.h"
+#include "TaskUpdateCoalescer.h"
 
 /**
  * @brief 任务管理器
@@ -73,7 +77,11 @@ public:
     int getTaskCountByStatus(TaskStatus status) const;
 
     /**
-     * @brief 从服务器刷新任务列表
+     * @brief 从服务器同步任务列表
+     *
+     * 首次同步按游标分页拉取全部任务；之后只拉取上次同步以来有变化的任务。
+     * 结果按 taskId 原地合并到现有任务对象，并通过 taskInserted / taskRowRemoved /
+     * taskMoved 逐行通知。同步进行中再次调用时，会在本轮结束后再同步一次。
      */
     void refreshTaskList();
 
@@ -115,12 +123,25 @@ public:
      */
     void cancelTask(const QString& taskId);
 
+    /**
+     * @brief 取消还没有提交到服务器的任务（上传中或草稿）
+     *
+     * 取消该任务的文件上传（其他任务也在等待的文件继续上传），任务标记为已取消。
+     * 这类任务还没有服务器 ID，不能使用 cancelTask。
+     */
+    void cancelUpload(Task* task);
+
     /**
      * @brief 删除任务
      * @param taskId 任务ID
      */
     void deleteTask(const QString& taskId);
 
+    /**
+     * @brief 从本地列表删除还没有服务器 ID 的任务（仍在上传时先取消上传）
+     */
+    void removeLocalTask(Task* task);
+
     /**
      * @brief 获取任务详情
      * @param taskId 任务ID
@@ -146,15 +167,48 @@ public:
 
     /**
      * @brief 从本地加载任务列表
+     *
+     * 上次退出或崩溃时仍在上传的任务会继续上传：按保存的场景包重新入队，
+     * 各文件从上传日志续传，只发送服务端还没有的分片。
      */
     void loadTasksFromLocal();
 
+    /**
+     * @brief 进度/状态推送的合并器（可调整刷新频率、读取统计）
+     */
+    TaskUpdateCoalescer* updateCoalescer() const { return m_updateCoalescer; }
+
 signals:
     /**
-     * @brief 任务列表更新信号
+     * @brief 整个任务列表被替换（清空、从本地加载）
+     *
+     * 单个任务的增删移动使用下面的逐行信号
      */
     void taskListUpdated();
 
+    /**
+     * @brief 任务已插入到第 row 行
+     */
+    void taskInserted(int row, Task* task);
+
+    /**
+     * @brief 第 row 行的任务已从列表移除（任务对象随后 deleteLater）
+     */
+    void taskRowRemoved(int row, Task* task);
+
+    /**
+     * @brief 任务从第 from 行移动到第 to 行（创建时间变化导致排序位置变化）
+     */
+    void taskMoved(int from, int to);
+
+    /**
+     * @brief 一轮服务器同步完成
+     * @param added 新增任务数
+     * @param updated 有变化的任务数
+     * @param removed 删除的任务数
+     */
+    void taskListSynced(int added, int updated, int removed);
+
     /**
      * @brief 任务添加信号
      */
@@ -175,6 +229,11 @@ signals:
      */
     void taskProgressUpdated(const QString& taskId, int progress);
 
+    /**
+     * @brief 一帧内合并后的进度/状态变化（已写入任务对象）
+     */
+    void tasksUpdated(const QList<TaskUpdate>& updates);
+
     /**
      * @brief 任务创建成功信号
      */
@@ -226,12 +285,30 @@ signals:
      */
     void fileUploadFailed(const QString& taskId, const QString& error);
 
+    /**
+     * @brief 上传并发/分片大小决策变化信号
+     * @param concurrency 全局并发分片数
+     * @param chunkSize 新上传使用的分片大小
+     * @param bytesPerSecond 估计的链路带宽
+     */
+    void uploadTuningChanged(int concurrency, qint64 chunkSize, qint64 bytesPerSecond);
+
 private:
     explicit TaskManager(QObject *parent = nullptr);
     ~TaskManager();
 
     /**
-     * @brief 添加任务到列表
+     * @brief 服务器任务合并结果
+     */
+    enum class MergeResult {
+        Inserted,       // 本地没有，新建任务
+        Updated,        // 已有任务，字段有变化
+        Unchanged,      // 已有任务，updatedAt 未变化
+        Invalid         // 缺少 taskId
+    };
+
+    /**
+     * @brief 按创建时间将任务插入到对应位置
      */
     void addTask(Task* task);
 
@@ -240,11 +317,42 @@ private:
      */
     void removeTask(const QString& taskId);
 
+    /**
+     * @brief 移除第 row 行的任务
+     */
+    void removeTaskAt(int row);
+
+    /**
+     * @brief 任务创建时间变化后移动到新的排序位置
+     */
+    void repositionTask(Task* task);
+
+    /**
+     * @brief 任务按创建时间降序应处的行
+     */
+    int insertionRow(Task* task) const;
+
     /**
      * @brief 更新任务信息
      */
     void updateTask(const QString& taskId, const QJsonObject& taskData);
 
+    /**
+     * @brief 按 taskId 将服务器数据原地合并到本地任务，不存在时插入
+     */
+    MergeResult mergeTask(const QJsonObject& taskData);
+
+    /**
+     * @brief 拉取一页任务并合并，还有下一页时继续拉取
+     */
+    void fetchTaskPage(const QString& cursor);
+
+    /**
+     * @brief 结束一轮同步
+     * @param success 全部分页是否都已成功合并
+     */
+    void finishSync(bool success);
+
     /**
      * @brief 连接 WebSocket 信号
      */
@@ -261,17 +369,105 @@ private:
     void handleTaskProgressUpdate(const QString& taskId, int progress);
 
     /**
-     * @brief 按创建时间排序任务
+     * @brief 连接上传调度器信号（按本地临时ID分发到对应任务）
+     */
+    void connectUploadSignals();
+
+    /**
+     * @brief 合并器提交一批变化后，按任务发出原有的进度/状态信号
+     */
+    void onUpdatesFlushed(const QList<TaskUpdate>& updates);
+
+    /**
+     * @brief 场景依赖收集完成后，上传场景和全部依赖文件
+     */
+    void startPackageUpload(const QString& localTaskId, const ScenePackage& package);
+
+    /**
+     * @brief 记录正在上传的任务，优先级变化时调整其上传任务
+     */
+    void trackUpload(const QString& localTaskId, Task* task);
+
+    /**
+     * @brief 未完成的提交（本地临时ID、场景包、上传任务）转为 JSON，随任务保存
+     */
+    QJsonObject uploadToJson(const QString& localTaskId) const;
+
+    /**
+     * @brief 重启后恢复未完成的提交
+     * @param upload uploadToJson 保存的内容；没有场景包时重新提交
+     */
+    void resumeUpload(Task* task, const QJsonObject& upload);
+
+    /**
+     * @brief 等待某个上传任务的提交（本地临时ID列表）
+     */
+    QStringList submissionsWaitingFor(const QString& jobId) const;
+
+    /**
+     * @brief 汇总场景包所有文件的上传进度
+     */
+    void emitSubmissionProgress(const QString& localTaskId);
+
+    /**
+     * @brief 取消已移除的提交的上传任务（其他提交也在等待的继续上传）
+     */
+    void cancelOrphanJobs(const QStringList& jobIds);
+
+    /**
+     * @brief 场景包上传完成后向服务器创建任务
+     * @param manifest 路径映射清单
+     */
+    void createUploadedTask(const QString& localTaskId, Task* task, const QJsonObject& manifest);
+
+    /**
+     * @brief 上传失败时更新任务状态
+     */
+    void failUpload(const QString& localTaskId, const QString& error);
+
+    /**
+     * @brief 按创建时间排序任务（批量加载后使用）
      */
     void sortTasks();
 
 private:
+    /**
+     * @brief 正在上传的场景包
+     */
+    struct UploadSubmission {
+        Task* task = nullptr;
+        ScenePackage package;
+        QMap<QString, QString> pendingJobs;     // 未完成的上传任务 -> 本地文件路径
+        QMap<QString, qint64> uploadedBytes;    // 上传任务 -> 已上传字节数
+        QMap<QString, QJsonObject> uploads;     // 本地文件路径 -> 上传结果
+    };
+
+    /**
+     * @brief 进行中的一轮服务器同步
+     */
+    struct TaskSync {
+        QDateTime since;                // 无效时为全量同步
+        QDateTime watermark;            // 本轮同步后的增量同步起点
+        QSet<QString> seenIds;          // 全量同步中服务器返回的任务
+        int added = 0;
+        int updated = 0;
+        int removed = 0;
+        int pages = 0;
+    };
+
     WebSocketClient* m_wsClient;
-    FileUploader* m_fileUploader;
+    UploadScheduler* m_uploadScheduler;
+    TaskUpdateCoalescer* m_updateCoalescer;
 
     QList<Task*> m_tasks;
     QMap<QString, Task*> m_taskMap;  // taskId -> Task* 快速查找
     QMap<QString, Task*> m_uploadingTasks;  // 正在上传的任务（本地临时ID -> Task*）
+    QMap<QString, UploadSubmission> m_submissions;  // 本地临时ID -> 场景包上传状态
+
+    TaskSync m_sync;
+    QDateTime m_lastSyncAt;             // 上次成功同步的水位（服务器时间）
+    bool m_syncInProgress;
+    bool m_syncQueued;                  // 同步进行中又请求了同步
 
     bool m_isInitialized;
 };
@@ -0,0 +1,109 @@
+/**
+ * @file TaskUpdateCoalescer.cpp
+ * @brief 任务高频更新合并器实现
+ */
+
+#include "TaskUpdateCoalescer.h"
+
+TaskUpdateCoalescer::TaskUpdateCoalescer(int flushRate, QObject *parent)
+    : QObject(parent)
+    , m_flushRate(0)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &TaskUpdateCoalescer::flush);
+
+    setFlushRate(flushRate);
+}
+
+TaskUpdateCoalescer::~TaskUpdateCoalescer()
+{
+}
+
+void TaskUpdateCoalescer::setFlushRate(int flushRate)
+{
+    m_flushRate = qBound(1, flushRate, 240);
+    m_timer.setInterval(1000 / m_flushRate);
+}
+
+void TaskUpdateCoalescer::setProgress(Task *task, const QString &taskId, int progress,
+                                      qint64 uploadedBytes, qint64 totalBytes)
+{
+    TaskUpdate &update = pendingFor(task, taskId, TaskUpdate::ProgressField);
+    update.progress = progress;
+
+    if (uploadedBytes >= 0) {
+        update.fields |= TaskUpdate::BytesField;
+        update.uploadedBytes = uploadedBytes;
+        update.totalBytes = totalBytes;
+    }
+}
+
+void TaskUpdateCoalescer::setStatus(Task *task, const QString &taskId, TaskStatus status)
+{
+    pendingFor(task, taskId, TaskUpdate::StatusField).status = status;
+}
+
+TaskUpdate &TaskUpdateCoalescer::pendingFor(Task *task, const QString &taskId, int field)
+{
+    m_stats.eventsIn++;
+
+    auto it = m_pendingIndex.constFind(taskId);
+    if (it != m_pendingIndex.constEnd()) {
+        TaskUpdate &update = m_pending[it.value()];
+        if (update.fields & field) {
+            m_stats.eventsMerged++;
+        }
+        update.task = task;
+        update.fields |= field;
+        return update;
+    }
+
+    TaskUpdate update;
+    update.task = task;
+    update.taskId = taskId;
+    update.fields = field;
+    m_pendingIndex.insert(taskId, m_pending.size());
+    m_pending.append(update);
+
+    // 一帧内第一个事件启动定时器，之后的事件只更新记录
+    if (!m_timer.isActive()) {
+        m_timer.start();
+    }
+    return m_pending.last();
+}
+
+void TaskUpdateCoalescer::flush()
+{
+    m_timer.stop();
+    if (m_pending.isEmpty()) {
+        return;
+    }
+
+    QList<TaskUpdate> updates;
+    updates.swap(m_pending);
+    m_pendingIndex.clear();
+    m_stats.flushes++;
+
+    for (const TaskUpdate &update : updates) {
+        Task *task = update.task.data();
+        if (!task) {
+            continue; // 任务已被移除
+        }
+
+        bool changed = false;
+        if ((update.fields & TaskUpdate::StatusField) && task->status() != update.status) {
+            task->setStatus(update.status);
+            changed = true;
+        }
+        if ((update.fields & TaskUpdate::ProgressField) && task->progress() != qBound(0, update.progress, 100)) {
+            task->setProgress(update.progress);
+            changed = true;
+        }
+        if (changed) {
+            m_stats.tasksChanged++;
+        }
+    }
+
+    emit updatesFlushed(updates);
+}
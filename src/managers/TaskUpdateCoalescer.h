@@ -0,0 +1,122 @@
+/**
+ * @file TaskUpdateCoalescer.h
+ * @brief 任务高频更新合并器
+ */
+
+#ifndef TASKUPDATECOALESCER_H
+#define TASKUPDATECOALESCER_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QTimer>
+#include "../models/Task.h"
+
+/**
+ * @brief 一次合并提交中单个任务的变化
+ */
+struct TaskUpdate {
+    /**
+     * @brief 本次提交中有变化的字段
+     */
+    enum Field {
+        ProgressField = 0x1,
+        StatusField = 0x2,
+        BytesField = 0x4        // 上传字节数（只用于上传进度）
+    };
+
+    QPointer<Task> task;
+    QString taskId;             // 服务器任务ID，上传中为本地临时ID
+    int fields = 0;
+    int progress = 0;
+    TaskStatus status = TaskStatus::Draft;
+    qint64 uploadedBytes = 0;
+    qint64 totalBytes = 0;
+};
+
+/**
+ * @brief 任务高频更新合并器
+ *
+ * WebSocket 进度推送和上传进度每秒可能有成百上千次，逐条写入任务会让界面线程
+ * 忙于重绘。合并器只记录每个任务最新的字段值，按显示帧率（默认 30 Hz）统一写入
+ * 任务并发出一次批量变化：同一帧内一个任务无论收到多少事件，最多重绘一次。
+ *
+ * 只在界面线程使用。
+ */
+class TaskUpdateCoalescer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 统计信息
+     */
+    struct Stats {
+        qint64 eventsIn = 0;        // 收到的更新事件
+        qint64 eventsMerged = 0;    // 被同一帧内后续事件覆盖的事件
+        qint64 flushes = 0;         // 提交次数
+        qint64 tasksChanged = 0;    // 提交时字段确实变化的任务数（即需要重绘的行数）
+    };
+
+    /**
+     * @param flushRate 每秒最多提交次数
+     */
+    explicit TaskUpdateCoalescer(int flushRate = 30, QObject *parent = nullptr);
+    ~TaskUpdateCoalescer();
+
+    /**
+     * @brief 设置每秒最多提交次数（1-240）
+     */
+    void setFlushRate(int flushRate);
+    int flushRate() const { return m_flushRate; }
+
+    /**
+     * @brief 记录任务进度
+     * @param uploadedBytes 已上传字节数，小于 0 表示不是上传进度
+     */
+    void setProgress(Task *task, const QString &taskId, int progress,
+                     qint64 uploadedBytes = -1, qint64 totalBytes = -1);
+
+    /**
+     * @brief 记录任务状态
+     */
+    void setStatus(Task *task, const QString &taskId, TaskStatus status);
+
+    /**
+     * @brief 立即提交所有待提交的变化
+     *
+     * 直接修改任务状态前先调用，保证之前收到的推送不会在之后覆盖新状态。
+     */
+    void flush();
+
+    /**
+     * @brief 是否有待提交的变化
+     */
+    bool hasPending() const { return !m_pending.isEmpty(); }
+
+    Stats stats() const { return m_stats; }
+    void resetStats() { m_stats = Stats(); }
+
+signals:
+    /**
+     * @brief 一批变化已写入任务
+     * @param updates 本次提交的变化，每个任务一条
+     */
+    void updatesFlushed(const QList<TaskUpdate> &updates);
+
+private:
+    /**
+     * @brief 取得任务待提交的记录，不存在时新建并启动提交定时器
+     */
+    TaskUpdate &pendingFor(Task *task, const QString &taskId, int field);
+
+private:
+    QTimer m_timer;
+    int m_flushRate;
+    QList<TaskUpdate> m_pending;
+    QHash<QString, int> m_pendingIndex;     // taskId -> m_pending 下标
+    Stats m_stats;
+};
+
+#endif // TASKUPDATECOALESCER_H
@@ -163,17 +163,31 @@ void Task::setOutputFormat(const QString &format)
 
 void Task::setCreatedAt(const QDateTime &time)
 {
-    m_createdAt = time;
+    if (m_createdAt != time) {
+        m_createdAt = time;
+        emit taskDataChanged();
+    }
 }
 
 void Task::setStartedAt(const QDateTime &time)
 {
-    m_startedAt = time;
+    if (m_startedAt != time) {
+        m_startedAt = time;
+        emit taskDataChanged();
+    }
 }
 
 void Task::setCompletedAt(const QDateTime &time)
 {
-    m_completedAt = time;
+    if (m_completedAt != time) {
+        m_completedAt = time;
+        emit taskDataChanged();
+    }
+}
+
+void Task::setUpdatedAt(const QDateTime &time)
+{
+    m_updatedAt = time;
 }
 
 void Task::setEstimatedCost(double cost)
@@ -232,6 +246,7 @@ QJsonObject Task::toJson() const
     json["createdAt"] = m_createdAt.toString(Qt::ISODate);
     json["startedAt"] = m_startedAt.toString(Qt::ISODate);
     json["completedAt"] = m_completedAt.toString(Qt::ISODate);
+    json["updatedAt"] = m_updatedAt.toString(Qt::ISODateWithMs);
     json["estimatedCost"] = m_estimatedCost;
     json["actualCost"] = m_actualCost;
     json["errorMessage"] = m_errorMessage;
@@ -241,43 +256,51 @@ QJsonObject Task::toJson() const
 Task* Task::fromJson(const QJsonObject &json, QObject *parent)
 {
     Task *task = new Task(parent);
+    task->updateFromJson(json);
+    return task;
+}
 
-    task->setTaskId(json["taskId"].toString());
-    task->setTaskName(json["taskName"].toString());
-    task->setSceneFile(json["sceneFile"].toString());
-    task->setMayaVersion(json["mayaVersion"].toString());
-    task->setRenderer(json["renderer"].toString());
-    task->setStatus(static_cast<TaskStatus>(json["status"].toInt()));
-    task->setPriority(static_cast<TaskPriority>(json["priority"].toInt()));
-    task->setProgress(json["progress"].toInt());
-    task->setStartFrame(json["startFrame"].toInt());
-    task->setEndFrame(json["endFrame"].toInt());
-    task->setFrameStep(json["frameStep"].toInt());
-    task->setWidth(json["width"].toInt());
-    task->setHeight(json["height"].toInt());
-    task->setOutputPath(json["outputPath"].toString());
-    task->setOutputFormat(json["outputFormat"].toString());
+void Task::updateFromJson(const QJsonObject &json)
+{
+    if (json.contains("taskId")) setTaskId(json["taskId"].toString());
+    if (json.contains("taskName")) setTaskName(json["taskName"].toString());
+    if (json.contains("sceneFile")) setSceneFile(json["sceneFile"].toString());
+    if (json.contains("mayaVersion")) setMayaVersion(json["mayaVersion"].toString());
+    if (json.contains("renderer")) setRenderer(json["renderer"].toString());
+    if (json.contains("status")) setStatus(static_cast<TaskStatus>(json["status"].toInt()));
+    if (json.contains("priority")) setPriority(static_cast<TaskPriority>(json["priority"].toInt()));
+    if (json.contains("progress")) setProgress(json["progress"].toInt());
+    if (json.contains("startFrame")) setStartFrame(json["startFrame"].toInt());
+    if (json.contains("endFrame")) setEndFrame(json["endFrame"].toInt());
+    if (json.contains("frameStep")) setFrameStep(json["frameStep"].toInt());
+    if (json.contains("width")) setWidth(json["width"].toInt());
+    if (json.contains("height")) setHeight(json["height"].toInt());
+    if (json.contains("outputPath")) setOutputPath(json["outputPath"].toString());
+    if (json.contains("outputFormat")) setOutputFormat(json["outputFormat"].toString());
 
     QString createdAtStr = json["createdAt"].toString();
     if (!createdAtStr.isEmpty()) {
-        task->setCreatedAt(QDateTime::fromString(createdAtStr, Qt::ISODate));
+        setCreatedAt(QDateTime::fromString(createdAtStr, Qt::ISODate));
     }
 
     QString startedAtStr = json["startedAt"].toString();
     if (!startedAtStr.isEmpty()) {
-        task->setStartedAt(QDateTime::fromString(startedAtStr, Qt::ISODate));
+        setStartedAt(QDateTime::fromString(startedAtStr, Qt::ISODate));
     }
 
     QString completedAtStr = json["completedAt"].toString();
     if (!completedAtStr.isEmpty()) {
-        task->setCompletedAt(QDateTime::fromString(completedAtStr, Qt::ISODate));
+        setCompletedAt(QDateTime::fromString(completedAtStr, Qt::ISODate));
     }
 
-    task->setEstimatedCost(json["estimatedCost"].toDouble());
-    task->setActualCost(json["actualCost"].toDouble());
-    task->setErrorMessage(json["errorMessage"].toString());
+    QString updatedAtStr = json["updatedAt"].toString();
+    if (!updatedAtStr.isEmpty()) {
+        setUpdatedAt(QDateTime::fromString(updatedAtStr, Qt::ISODateWithMs));
+    }
 
-    return task;
+    if (json.contains("estimatedCost")) setEstimatedCost(json["estimatedCost"].toDouble());
+    if (json.contains("actualCost")) setActualCost(json["actualCost"].toDouble());
+    if (json.contains("errorMessage")) setErrorMessage(json["errorMessage"].toString());
 }
 
 QString Task::statusString() const
@@ -76,6 +76,7 @@ public:
     QDateTime createdAt() const { return m_createdAt; }
     QDateTime startedAt() const { return m_startedAt; }
     QDateTime completedAt() const { return m_completedAt; }
+    QDateTime updatedAt() const { return m_updatedAt; }
     double estimatedCost() const { return m_estimatedCost; }
     double actualCost() const { return m_actualCost; }
     QString errorMessage() const { return m_errorMessage; }
@@ -100,6 +101,7 @@ public:
     void setCreatedAt(const QDateTime &time);
     void setStartedAt(const QDateTime &time);
     void setCompletedAt(const QDateTime &time);
+    void setUpdatedAt(const QDateTime &time);
     void setEstimatedCost(double cost);
     void setActualCost(double cost);
     void setErrorMessage(const QString &message);
@@ -110,6 +112,13 @@ public:
     QJsonObject toJson() const;
     static Task* fromJson(const QJsonObject &json, QObject *parent = nullptr);
 
+    /**
+     * @brief 用服务器返回的数据原地更新任务（只更新 json 中出现的字段）
+     *
+     * 字段没有变化时不发出信号，同步时未变化的任务不会触发重绘。
+     */
+    void updateFromJson(const QJsonObject &json);
+
     // 工具方法
     QString statusString() const;
     QString priorityString() const;
@@ -154,6 +163,7 @@ private:
     QDateTime m_createdAt;
     QDateTime m_startedAt;
     QDateTime m_completedAt;
+    QDateTime m_updatedAt;          // 服务器最后修改时间（增量同步用）
 
     // 费用信息
     double m_estimatedCost;
@@ -0,0 +1,150 @@
+/**
+ * @file TaskListModel.cpp
+ * @brief 任务列表模型实现
+ */
+
+#include "TaskListModel.h"
+#include "../managers/TaskManager.h"
+
+TaskListModel::TaskListModel(bool followTaskManager, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_rowsDirty(false)
+{
+    if (!followTaskManager) {
+        return;
+    }
+
+    TaskManager &manager = TaskManager::instance();
+    connect(&manager, &TaskManager::taskListUpdated,
+            this, &TaskListModel::reloadFromTaskManager);
+    connect(&manager, &TaskManager::taskInserted,
+            this, &TaskListModel::onTaskInserted);
+    connect(&manager, &TaskManager::taskRowRemoved,
+            this, &TaskListModel::onTaskRowRemoved);
+    connect(&manager, &TaskManager::taskMoved,
+            this, &TaskListModel::onTaskMoved);
+
+    setTasks(manager.getAllTasks());
+}
+
+TaskListModel::~TaskListModel()
+{
+}
+
+int TaskListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_tasks.size();
+}
+
+QVariant TaskListModel::data(const QModelIndex &index, int role) const
+{
+    Task *task = taskAt(index.row());
+    if (!index.isValid() || !task) {
+        return QVariant();
+    }
+
+    switch (role) {
+        case Qt::DisplayRole:
+            return task->taskName();
+        case Qt::ToolTipRole:
+            return task->sceneFile();
+        case TaskRole:
+            return QVariant::fromValue(task);
+        case TaskIdRole:
+            return task->taskId();
+        case StatusRole:
+            return static_cast<int>(task->status());
+        case ProgressRole:
+            return task->progress();
+        default:
+            return QVariant();
+    }
+}
+
+QHash<int, QByteArray> TaskListModel::roleNames() const
+{
+    QHash<int, QByteArray> roles = QAbstractListModel::roleNames();
+    roles[TaskRole] = "task";
+    roles[TaskIdRole] = "taskId";
+    roles[StatusRole] = "status";
+    roles[ProgressRole] = "progress";
+    return roles;
+}
+
+void TaskListModel::setTasks(const QList<Task*> &tasks)
+{
+    beginResetModel();
+    m_tasks = tasks;
+    m_rowsDirty = true;
+    for (Task *task : m_tasks) {
+        // 已连接过的任务不会重复连接；已移出列表的任务在 onTaskDataChanged 中忽略
+        connect(task, &Task::taskDataChanged, this, &TaskListModel::onTaskDataChanged,
+                Qt::UniqueConnection);
+    }
+    endResetModel();
+}
+
+int TaskListModel::rowOf(Task *task) const
+{
+    // 插入/移除会改变后面所有行的行号，集中到下次查找时重建一次
+    if (m_rowsDirty) {
+        m_rows.clear();
+        m_rows.reserve(m_tasks.size());
+        for (int row = 0; row < m_tasks.size(); ++row) {
+            m_rows.insert(m_tasks[row], row);
+        }
+        m_rowsDirty = false;
+    }
+    return m_rows.value(task, -1);
+}
+
+Task* TaskListModel::taskAt(int row) const
+{
+    return (row >= 0 && row < m_tasks.size()) ? m_tasks[row] : nullptr;
+}
+
+void TaskListModel::onTaskDataChanged()
+{
+    int row = rowOf(qobject_cast<Task*>(sender()));
+    if (row < 0) {
+        return;
+    }
+
+    QModelIndex changed = index(row);
+    emit dataChanged(changed, changed);
+}
+
+void TaskListModel::reloadFromTaskManager()
+{
+    setTasks(TaskManager::instance().getAllTasks());
+}
+
+void TaskListModel::onTaskInserted(int row, Task *task)
+{
+    beginInsertRows(QModelIndex(), row, row);
+    m_tasks.insert(row, task);
+    m_rowsDirty = true;
+    connect(task, &Task::taskDataChanged, this, &TaskListModel::onTaskDataChanged,
+            Qt::UniqueConnection);
+    endInsertRows();
+}
+
+void TaskListModel::onTaskRowRemoved(int row, Task *task)
+{
+    beginRemoveRows(QModelIndex(), row, row);
+    m_tasks.removeAt(row);
+    m_rowsDirty = true;
+    disconnect(task, &Task::taskDataChanged, this, &TaskListModel::onTaskDataChanged);
+    endRemoveRows();
+}
+
+void TaskListModel::onTaskMoved(int from, int to)
+{
+    // beginMoveRows 的目标位置是移动前的行号，向后移动时要越过自身
+    if (!beginMoveRows(QModelIndex(), from, from, QModelIndex(), to > from ? to + 1 : to)) {
+        return;
+    }
+    m_tasks.move(from, to);
+    m_rowsDirty = true;
+    endMoveRows();
+}
@@ -0,0 +1,95 @@
+/**
+ * @file TaskListModel.h
+ * @brief 任务列表模型
+ */
+
+#ifndef TASKLISTMODEL_H
+#define TASKLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QList>
+#include "Task.h"
+
+/**
+ * @brief 任务列表模型
+ *
+ * 将任务列表暴露给 QListView，配合 TaskItemDelegate 绘制：
+ * 任务本身不创建任何控件，只有可见的行会被绘制。
+ *
+ * 默认跟随 TaskManager 的任务列表：任务增删和移动按行插入/移除/移动，
+ * 任务字段变化时只刷新对应的行，只有整个列表被替换时才重置模型。
+ */
+class TaskListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 数据角色
+     */
+    enum TaskRoles {
+        TaskRole = Qt::UserRole + 1,    // Task*（委托绘制时一次取得全部字段）
+        TaskIdRole,
+        StatusRole,
+        ProgressRole
+    };
+
+    /**
+     * @param followTaskManager 是否跟随 TaskManager 的任务列表（测试时可关闭后用 setTasks 填充）
+     */
+    explicit TaskListModel(bool followTaskManager = true, QObject *parent = nullptr);
+    ~TaskListModel();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    /**
+     * @brief 替换全部任务（重置模型）
+     */
+    void setTasks(const QList<Task*> &tasks);
+
+    /**
+     * @brief 获取指定行的任务
+     */
+    Task* taskAt(int row) const;
+
+    /**
+     * @brief 获取任务所在行，不在列表中时返回 -1
+     */
+    int rowOf(Task *task) const;
+
+private slots:
+    /**
+     * @brief 任务字段变化，刷新对应的行
+     */
+    void onTaskDataChanged();
+
+    /**
+     * @brief 重新读取 TaskManager 的任务列表
+     */
+    void reloadFromTaskManager();
+
+    /**
+     * @brief TaskManager 在 row 行插入了任务
+     */
+    void onTaskInserted(int row, Task *task);
+
+    /**
+     * @brief TaskManager 移除了 row 行的任务
+     */
+    void onTaskRowRemoved(int row, Task *task);
+
+    /**
+     * @brief TaskManager 将任务从 from 行移动到 to 行
+     */
+    void onTaskMoved(int from, int to);
+
+private:
+    QList<Task*> m_tasks;
+    mutable QHash<Task*, int> m_rows;   // Task* -> 行号，行变化后在下次查找时重建
+    mutable bool m_rowsDirty;
+};
+
+#endif // TASKLISTMODEL_H
@@ -1,5 +1,6 @@
 #include "ApiService.h"
 #include "HttpClient.h"
+#include <QJsonArray>
 #include <QDebug>
 
 ApiService& ApiService::instance()
@@ -144,8 +145,9 @@ void ApiService::createTask(const QJsonObject& taskData,
 }
 
 void ApiService::getTasks(const QString& status,
-                         int skip,
+                         const QString& cursor,
                          int limit,
+                         const QDateTime& since,
                          SuccessCallback onSuccess,
                          ErrorCallback onError)
 {
@@ -153,7 +155,12 @@ void ApiService::getTasks(const QString& status,
     if (!status.isEmpty()) {
         params["status"] = status;
     }
-    params["skip"] = QString::number(skip);
+    if (!cursor.isEmpty()) {
+        params["cursor"] = cursor;
+    }
+    if (since.isValid()) {
+        params["since"] = since.toUTC().toString(Qt::ISODateWithMs);
+    }
     params["limit"] = QString::number(limit);
 
     HttpClient::instance().get("/api/v1/tasks", params, onSuccess, onError);
@@ -227,3 +234,25 @@ void ApiService::generateDownloadUrl(const QString& taskId,
     QString path = QString("/api/v1/files/download/%1/%2").arg(taskId).arg(fileName);
     HttpClient::instance().get(path, {}, onSuccess, onError);
 }
+
+void ApiService::getUploadedChunks(const QString& uploadId,
+                                  SuccessCallback onSuccess,
+                                  ErrorCallback onError)
+{
+    QMap<QString, QString> params;
+    params["taskId"] = uploadId;
+
+    HttpClient::instance().get("/api/v1/files/upload/chunks", params, onSuccess, onError);
+}
+
+void ApiService::checkBlockHashes(const QString& fileHash,
+                                  const QStringList& blockHashes,
+                                  SuccessCallback onSuccess,
+                                  ErrorCallback onError)
+{
+    QJsonObject data;
+    data["fileHash"] = fileHash;
+    data["hashes"] = QJsonArray::fromStringList(blockHashes);
+
+    HttpClient::instance().post("/api/v1/files/chunks/check", data, onSuccess, onError);
+}
@@ -2,6 +2,7 @@
 
 #include <QObject>
 #include <QJsonObject>
+#include <QDateTime>
 #include <functional>
 
 class User;
@@ -123,11 +124,19 @@ public:
                    ErrorCallback onError = nullptr);
 
     /**
-     * @brief 获取任务列表
+     * @brief 获取任务列表（游标分页，支持增量同步）
+     * @param status 状态筛选，为空时返回全部状态
+     * @param cursor 上一页响应中的 nextCursor，为空时从第一页开始
+     * @param limit 每页数量
+     * @param since 只返回该时间之后有变化的任务（包括已删除的任务ID），无效时返回全部
+     *
+     * 响应: { tasks: [...], nextCursor: "...", deletedTaskIds: [...], serverTime: "..." }
+     * nextCursor 为空表示已是最后一页
      */
     void getTasks(const QString& status = QString(),
-                 int skip = 0,
+                 const QString& cursor = QString(),
                  int limit = 20,
+                 const QDateTime& since = QDateTime(),
                  SuccessCallback onSuccess = nullptr,
                  ErrorCallback onError = nullptr);
 
@@ -186,6 +195,28 @@ public:
                             SuccessCallback onSuccess = nullptr,
                             ErrorCallback onError = nullptr);
 
+    /**
+     * @brief 查询上传会话中服务端已收到的分片
+     * @param uploadId 上传会话 ID（分片上传时使用的 taskId）
+     *
+     * 响应：{ "uploadedChunks": [0, 1, 5, ...] }
+     */
+    void getUploadedChunks(const QString& uploadId,
+                          SuccessCallback onSuccess = nullptr,
+                          ErrorCallback onError = nullptr);
+
+    /**
+     * @brief 查询服务端已存在的内容（按内容哈希去重）
+     * @param fileHash 整个文件的 SHA-256
+     * @param blockHashes 去重块（固定大小，与传输分片无关）的 SHA-256 列表
+     *
+     * 响应：{ "fileExists": false, "existing": ["<sha256>", ...] }
+     */
+    void checkBlockHashes(const QString& fileHash,
+                          const QStringList& blockHashes,
+                          SuccessCallback onSuccess = nullptr,
+                          ErrorCallback onError = nullptr);
+
 private:
     ApiService();
     ~ApiService();
@@ -0,0 +1,125 @@
+#include "ChunkHashCache.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QDebug>
+
+namespace {
+const qint64 DEFAULT_MAX_SIZE = 32 * 1024 * 1024;
+const int DEFAULT_MAX_AGE_DAYS = 30;
+}
+
+ChunkHashCache::ChunkHashCache(const QString& directory, qint64 maxSize, int maxAgeDays)
+    : m_directory(directory)
+    , m_maxSize(maxSize > 0 ? maxSize : DEFAULT_MAX_SIZE)
+    , m_maxAgeDays(maxAgeDays > 0 ? maxAgeDays : DEFAULT_MAX_AGE_DAYS)
+{
+}
+
+QString ChunkHashCache::defaultDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/cache/chunk-hashes";
+}
+
+int ChunkHashCache::blockCount(qint64 fileSize)
+{
+    return static_cast<int>((fileSize + BLOCK_SIZE - 1) / BLOCK_SIZE);
+}
+
+QString ChunkHashCache::cachePath(const QString& filePath) const
+{
+    // 大小和修改时间不参与键而是保存在条目中，文件修改后新结果覆盖旧条目，不留孤儿文件
+    QByteArray keySource = QFileInfo(filePath).absoluteFilePath().toUtf8();
+    QString key = QString::fromLatin1(QCryptographicHash::hash(keySource, QCryptographicHash::Sha1).toHex());
+    return m_directory + "/" + key + ".json";
+}
+
+bool ChunkHashCache::lookup(const QString& filePath, QVector<QByteArray>* blockHashes, QByteArray* fileHash) const
+{
+    QString path = cachePath(filePath);
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    file.close();
+
+    QFileInfo info(filePath);
+    QJsonArray hashes = root["blockHashes"].toArray();
+    if (root["fileSize"].toInteger() != info.size()
+        || root["mtime"].toInteger() != info.lastModified().toMSecsSinceEpoch()
+        || root["blockSize"].toInteger() != BLOCK_SIZE
+        || hashes.size() != blockCount(info.size()) || root["fileHash"].toString().isEmpty()) {
+        return false;
+    }
+
+    blockHashes->clear();
+    blockHashes->reserve(hashes.size());
+    for (const QJsonValue& value : hashes) {
+        blockHashes->append(value.toString().toLatin1());
+    }
+    *fileHash = root["fileHash"].toString().toLatin1();
+
+    // 刷新最近使用时间
+    QFile touch(path);
+    if (touch.open(QIODevice::ReadWrite)) {
+        touch.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    }
+    return true;
+}
+
+void ChunkHashCache::store(const QString& filePath, const QVector<QByteArray>& blockHashes, const QByteArray& fileHash)
+{
+    QJsonArray hashes;
+    for (const QByteArray& hash : blockHashes) {
+        hashes.append(QString::fromLatin1(hash));
+    }
+
+    QFileInfo info(filePath);
+    QJsonObject root;
+    root["filePath"] = info.absoluteFilePath();
+    root["fileSize"] = info.size();
+    root["mtime"] = info.lastModified().toMSecsSinceEpoch();
+    root["blockSize"] = BLOCK_SIZE;
+    root["fileHash"] = QString::fromLatin1(fileHash);
+    root["blockHashes"] = hashes;
+
+    QDir().mkpath(m_directory);
+
+    // 多个上传器可能同时写同一文件，先写临时文件再替换
+    QSaveFile file(cachePath(filePath));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "ChunkHashCache: 无法写入缓存" << file.fileName();
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qWarning() << "ChunkHashCache: 无法写入缓存" << file.fileName();
+        return;
+    }
+
+    prune();
+}
+
+void ChunkHashCache::prune() const
+{
+    // 按修改时间从新到旧：超过保留天数的、累计超出上限的条目全部删除
+    QFileInfoList entries = QDir(m_directory).entryInfoList(QStringList() << "*.json", QDir::Files, QDir::Time);
+    QDateTime expiry = QDateTime::currentDateTime().addDays(-m_maxAgeDays);
+
+    qint64 total = 0;
+    for (const QFileInfo& entry : entries) {
+        total += entry.size();
+        if (total > m_maxSize || entry.lastModified() < expiry) {
+            QFile::remove(entry.absoluteFilePath());
+        }
+    }
+}
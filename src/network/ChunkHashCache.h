@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <QByteArray>
+
+/**
+ * @brief 内容哈希本地缓存
+ *
+ * 以文件路径为键，缓存整个文件的 SHA-256 以及每个去重块（固定 BLOCK_SIZE 字节，
+ * 与传输分片大小无关）的 SHA-256，同时记录文件大小和修改时间，不一致时视为未命中。
+ * 同一场景反复提交时无需重新计算哈希（无论这次按多大的分片传输），
+ * 文件修改后重新写入会覆盖同一条目。
+ *
+ * 每个文件一个 JSON 缓存文件，存放在 AppData/cache/chunk-hashes 下；
+ * 缓存文件的修改时间作为最近使用时间，写入时删除超过保留天数的条目，
+ * 总大小超过上限时按 LRU 删除。
+ */
+class ChunkHashCache
+{
+public:
+    /**
+     * @param directory 缓存目录
+     * @param maxSize 缓存总大小上限（字节），<= 0 时使用默认值（32MB）
+     * @param maxAgeDays 条目保留天数（按最近使用时间），<= 0 时使用默认值（30 天）
+     */
+    explicit ChunkHashCache(const QString& directory = defaultDirectory(), qint64 maxSize = 0, int maxAgeDays = 0);
+
+    /**
+     * @brief 去重块大小
+     *
+     * 自适应分片大小都是 1MB 的整数倍，分片边界总是落在块边界上。
+     */
+    static constexpr qint64 BLOCK_SIZE = 1024 * 1024;
+
+    /**
+     * @brief 文件按 BLOCK_SIZE 切分的块数
+     */
+    static int blockCount(qint64 fileSize);
+
+    /**
+     * @brief 查找缓存，命中时刷新最近使用时间
+     * @return 文件大小、修改时间和块大小都一致时返回 true
+     */
+    bool lookup(const QString& filePath, QVector<QByteArray>* blockHashes, QByteArray* fileHash) const;
+
+    /**
+     * @brief 写入缓存，并删除过期和超出上限的条目
+     */
+    void store(const QString& filePath, const QVector<QByteArray>& blockHashes, const QByteArray& fileHash);
+
+    static QString defaultDirectory();
+
+private:
+    QString cachePath(const QString& filePath) const;
+    void prune() const;
+
+    QString m_directory;
+    qint64 m_maxSize;
+    int m_maxAgeDays;
+};
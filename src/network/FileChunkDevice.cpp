@@ -0,0 +1,66 @@
+#include "FileChunkDevice.h"
+#include <QDebug>
+
+FileChunkDevice::FileChunkDevice(const QString& filePath, qint64 offset, qint64 size, QObject *parent)
+    : QIODevice(parent)
+    , m_file(filePath)
+    , m_offset(offset)
+    , m_size(size)
+{
+}
+
+FileChunkDevice::~FileChunkDevice()
+{
+    close();
+}
+
+bool FileChunkDevice::open(OpenMode mode)
+{
+    // 只支持只读
+    if (mode & QIODevice::WriteOnly) {
+        return false;
+    }
+
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "FileChunkDevice: 无法打开文件" << m_file.fileName();
+        return false;
+    }
+
+    if (m_offset < 0 || m_offset + m_size > m_file.size()) {
+        qWarning() << "FileChunkDevice: 分片范围越界" << m_offset << m_size;
+        m_file.close();
+        return false;
+    }
+
+    return QIODevice::open(mode);
+}
+
+void FileChunkDevice::close()
+{
+    if (isOpen()) {
+        QIODevice::close();
+    }
+    m_file.close();
+}
+
+qint64 FileChunkDevice::readData(char *data, qint64 maxSize)
+{
+    qint64 remaining = m_size - pos();
+    if (remaining <= 0) {
+        return 0;
+    }
+
+    qint64 toRead = qMin(maxSize, remaining);
+    if (m_file.pos() != m_offset + pos() && !m_file.seek(m_offset + pos())) {
+        return -1;
+    }
+
+    return m_file.read(data, toRead);
+}
+
+qint64 FileChunkDevice::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    return -1;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QIODevice>
+#include <QFile>
+
+/**
+ * @brief 文件分片只读设备
+ *
+ * 将文件中 [offset, offset + size) 的区间包装为一个独立的 QIODevice，
+ * 用于以 application/octet-stream 方式流式上传分片，
+ * 无需把整个分片读入内存。
+ */
+class FileChunkDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    FileChunkDevice(const QString& filePath, qint64 offset, qint64 size, QObject *parent = nullptr);
+    ~FileChunkDevice();
+
+    bool open(OpenMode mode) override;
+    void close() override;
+
+    bool isSequential() const override { return false; }
+    qint64 size() const override { return m_size; }
+
+    qint64 chunkOffset() const { return m_offset; }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    QFile m_file;
+    qint64 m_offset;
+    qint64 m_size;
+};
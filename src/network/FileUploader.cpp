@@ -1,17 +1,26 @@
 #include "FileUploader.h"
 #include "HttpClient.h"
+#include "FileChunkDevice.h"
+#include "MappedFileReader.h"
+#include "ApiService.h"
+#include "UploadScheduler.h"
+#include <QJsonArray>
 #include <QFileInfo>
+#include <QBuffer>
 #include <QCryptographicHash>
 #include <QTimer>
 #include <QDebug>
 
 FileUploader::FileUploader(QObject *parent)
     : QObject(parent)
-    , m_file(nullptr)
+    , m_resumed(false)
     , m_fileSize(0)
     , m_chunkSize(5 * 1024 * 1024)  // 默认5MB
     , m_maxConcurrency(3)  // 默认3个并发
     , m_maxRetries(3)  // 默认重试3次
+    , m_transferMode(BinaryStream)
+    , m_adaptive(true)
+    , m_scheduler(nullptr)
     , m_uploadingCount(0)
     , m_completedCount(0)
     , m_isUploading(false)
@@ -23,14 +32,56 @@ FileUploader::FileUploader(QObject *parent)
     m_speedTimer = new QTimer(this);
     m_speedTimer->setInterval(1000);  // 每秒更新一次速度
     connect(m_speedTimer, &QTimer::timeout, this, &FileUploader::onSpeedTimerTimeout);
+
+    m_rateController = new UploadRateController(this);
+    m_rateController->reset(m_maxConcurrency, m_chunkSize);
+    connect(m_rateController, &UploadRateController::decisionChanged, this, &FileUploader::onDecisionChanged);
+
+    m_clock.start();
 }
 
 FileUploader::~FileUploader()
 {
-    if (m_file) {
-        m_file->close();
-        delete m_file;
+}
+
+void FileUploader::setChunkSize(qint64 size)
+{
+    m_chunkSize = size;
+    m_rateController->reset(m_maxConcurrency, m_chunkSize);
+}
+
+void FileUploader::setConcurrency(int count)
+{
+    m_maxConcurrency = count;
+    m_rateController->reset(m_maxConcurrency, m_chunkSize);
+}
+
+void FileUploader::setRateController(UploadRateController* controller)
+{
+    if (!controller || controller == m_rateController) {
+        return;
     }
+
+    disconnect(m_rateController, nullptr, this, nullptr);
+    if (m_rateController->parent() == this) {
+        delete m_rateController;
+    }
+
+    m_rateController = controller;
+    connect(m_rateController, &UploadRateController::decisionChanged, this, &FileUploader::onDecisionChanged);
+}
+
+void FileUploader::onDecisionChanged(int concurrency, qint64 chunkSize, qint64 bytesPerSecond)
+{
+    emit tuningChanged(concurrency, chunkSize, bytesPerSecond);
+
+    // 分片调小时，尚未发送的大分片不再按原大小发送
+    splitPendingChunks();
+}
+
+int FileUploader::currentConcurrency() const
+{
+    return m_adaptive ? m_rateController->concurrency() : m_maxConcurrency;
 }
 
 void FileUploader::startUpload(const QString& filePath, const QString& taskId)
@@ -43,22 +94,38 @@ void FileUploader::startUpload(const QString& filePath, const QString& taskId)
     m_filePath = filePath;
     m_taskId = taskId;
 
-    // 打开文件
-    m_file = new QFile(filePath);
-    if (!m_file->open(QIODevice::ReadOnly)) {
+    // 打开并映射文件，所有分片共用
+    m_reader = QSharedPointer<MappedFileReader>::create(filePath);
+    if (!m_reader->open()) {
         emit uploadError("无法打开文件: " + filePath);
-        delete m_file;
-        m_file = nullptr;
+        m_reader.reset();
         return;
     }
 
-    m_fileSize = m_file->size();
+    m_fileSize = m_reader->size();
     m_uploadedBytes = 0;
     m_lastUploadedBytes = 0;
 
     qDebug() << "FileUploader: 开始上传文件" << filePath;
     qDebug() << "文件大小:" << m_fileSize << "字节";
 
+    // 自适应模式下使用控制器建议的分片大小
+    if (m_adaptive) {
+        m_chunkSize = m_rateController->chunkSize();
+    }
+    // 分片边界对齐到去重块，服务端已有的块能整片跳过
+    if (m_chunkSize >= ChunkHashCache::BLOCK_SIZE) {
+        m_chunkSize -= m_chunkSize % ChunkHashCache::BLOCK_SIZE;
+    }
+
+    // 断点续传：加载日志中已确认的分片，沿用原上传会话和分片布局
+    // （重启后重新提交的上传任务 ID 与原来不同，会话以日志记录为准）
+    m_resumed = m_journal.open(filePath, m_chunkSize, taskId);
+    m_uploadId = m_journal.isOpen() ? m_journal.uploadId() : taskId;
+    if (m_resumed) {
+        m_chunkSize = m_journal.chunkSize();
+    }
+
     // 准备分片
     prepareChunks();
 
@@ -66,8 +133,12 @@ void FileUploader::startUpload(const QString& filePath, const QString& taskId)
     m_isPaused = false;
     m_speedTimer->start();
 
-    // 开始上传
-    uploadNextChunk();
+    if (m_resumed) {
+        applyUploadedChunks(m_journal.confirmedChunks());
+    }
+
+    // 计算内容哈希 -> 查询服务端已有的块 -> 开始上传
+    computeHashes();
 }
 
 void FileUploader::pause()
@@ -95,12 +166,8 @@ void FileUploader::cancel()
     m_isUploading = false;
     m_isPaused = false;
     m_speedTimer->stop();
-
-    if (m_file) {
-        m_file->close();
-        delete m_file;
-        m_file = nullptr;
-    }
+    m_reader.reset();
+    m_journal.close();  // 保留日志，再次提交时可续传
 
     qDebug() << "FileUploader: 上传已取消";
     emit uploadFinished(false);
@@ -120,12 +187,345 @@ void FileUploader::prepareChunks()
         chunk.offset = i * m_chunkSize;
         chunk.size = qMin(m_chunkSize, m_fileSize - chunk.offset);
         chunk.uploaded = false;
+        chunk.uploading = false;
         chunk.retryCount = 0;
+        chunk.startedAt = 0;
 
         m_chunks.append(chunk);
     }
 
-    qDebug() << "FileUploader: 分片数量:" << totalChunks;
+    // 续传时重放中断前的拆分，恢复与服务端一致的分片序号
+    if (m_resumed) {
+        for (const UploadJournal::Split& split : m_journal.splits()) {
+            if (split.chunkIndex < m_chunks.size() && split.size < m_chunks[split.chunkIndex].size) {
+                splitChunk(split.chunkIndex, split.size);
+            }
+        }
+    }
+
+    qDebug() << "FileUploader: 分片数量:" << m_chunks.size();
+}
+
+void FileUploader::splitPendingChunks()
+{
+    if (!m_adaptive || !m_isUploading) {
+        return;
+    }
+
+    // 新的分片边界仍对齐到去重块
+    qint64 size = m_rateController->chunkSize();
+    if (size >= ChunkHashCache::BLOCK_SIZE) {
+        size -= size % ChunkHashCache::BLOCK_SIZE;
+    }
+    if (size <= 0) {
+        return;
+    }
+
+    const int count = m_chunks.size();
+    for (int i = 0; i < count; ++i) {
+        const ChunkInfo& chunk = m_chunks[i];
+        if (chunk.uploaded || chunk.uploading || chunk.size <= size) {
+            continue;
+        }
+        splitChunk(i, size);
+        m_journal.markSplit(i, size);
+    }
+
+    if (m_chunks.size() > count) {
+        qDebug() << "FileUploader: 未发送的分片按" << size << "字节拆分，分片数量:"
+                 << count << "->" << m_chunks.size();
+    }
+}
+
+void FileUploader::splitChunk(int chunkIndex, qint64 size)
+{
+    const qint64 offset = m_chunks[chunkIndex].offset;
+    const qint64 end = offset + m_chunks[chunkIndex].size;
+    m_chunks[chunkIndex].size = size;
+
+    for (qint64 pieceOffset = offset + size; pieceOffset < end; pieceOffset += size) {
+        ChunkInfo piece;
+        piece.index = m_chunks.size();
+        piece.offset = pieceOffset;
+        piece.size = qMin(size, end - pieceOffset);
+        piece.uploaded = false;
+        piece.uploading = false;
+        piece.retryCount = 0;
+        piece.startedAt = 0;
+
+        m_chunks.append(piece);
+    }
+}
+
+QByteArray FileUploader::hashRange(const QSharedPointer<MappedFileReader>& reader, qint64 offset, qint64 size)
+{
+    QByteArray view = reader->view(offset, size);
+    if (!view.isNull()) {
+        QByteArray hash = QCryptographicHash::hash(view, QCryptographicHash::Sha256).toHex();
+        reader->release(offset);
+        return hash;
+    }
+
+    // 映射失败时流式读取
+    FileChunkDevice device(reader->fileName(), offset, size);
+    QCryptographicHash hasher(QCryptographicHash::Sha256);
+    if (device.open(QIODevice::ReadOnly) && hasher.addData(&device)) {
+        return hasher.result().toHex();
+    }
+    return QByteArray();
+}
+
+QByteArray FileUploader::hashFile(const QSharedPointer<MappedFileReader>& reader)
+{
+    QCryptographicHash hasher(QCryptographicHash::Sha256);
+    const qint64 fileSize = reader->size();
+
+    for (qint64 offset = 0; offset < fileSize; offset += ChunkHashCache::BLOCK_SIZE) {
+        qint64 size = qMin(ChunkHashCache::BLOCK_SIZE, fileSize - offset);
+        QByteArray view = reader->view(offset, size);
+        if (!view.isNull()) {
+            hasher.addData(view);
+            reader->release(offset);
+            continue;
+        }
+
+        FileChunkDevice device(reader->fileName(), offset, size);
+        if (!device.open(QIODevice::ReadOnly) || !hasher.addData(&device)) {
+            return QByteArray();
+        }
+    }
+    return hasher.result().toHex();
+}
+
+void FileUploader::computeHashes()
+{
+    m_blockHashes.clear();
+    m_fileHash.clear();
+
+    // 文件未变化（路径、大小、修改时间一致）时直接使用缓存的哈希，与本次的分片大小无关
+    QVector<QByteArray> blockHashes;
+    QByteArray fileHash;
+    if (m_hashCache.lookup(m_filePath, &blockHashes, &fileHash)) {
+        qDebug() << "FileUploader: 内容哈希命中缓存";
+        m_blockHashes = blockHashes;
+        m_fileHash = fileHash;
+        onHashesReady();
+        return;
+    }
+
+    qDebug() << "FileUploader: 计算内容哈希...";
+
+    // 去重块哈希在线程池中并行计算，结果按块顺序返回；
+    // 整个文件的 SHA-256 只能顺序计算，同时在另一个线程进行
+    QSharedPointer<MappedFileReader> reader = m_reader;
+    QVector<qint64> blockOffsets;
+    blockOffsets.reserve(ChunkHashCache::blockCount(m_fileSize));
+    for (qint64 offset = 0; offset < m_fileSize; offset += ChunkHashCache::BLOCK_SIZE) {
+        blockOffsets.append(offset);
+    }
+
+    QFuture<QByteArray> blocksFuture = QtConcurrent::mapped(blockOffsets, [reader](qint64 offset) -> QByteArray {
+        return hashRange(reader, offset, qMin(ChunkHashCache::BLOCK_SIZE, reader->size() - offset));
+    });
+    QFuture<QByteArray> fileFuture = QtConcurrent::run([reader]() {
+        return hashFile(reader);
+    });
+
+    QFutureWatcher<QByteArray>* blocksWatcher = new QFutureWatcher<QByteArray>(this);
+    QFutureWatcher<QByteArray>* fileWatcher = new QFutureWatcher<QByteArray>(this);
+    QSharedPointer<int> pending = QSharedPointer<int>::create(2);
+
+    // 两个计算都完成后继续
+    auto onFinished = [this, reader, blocksWatcher, fileWatcher, pending]() {
+        if (--*pending > 0) {
+            return;
+        }
+
+        QList<QByteArray> hashes = blocksWatcher->future().results();
+        QByteArray fileHash = fileWatcher->result();
+        blocksWatcher->deleteLater();
+        fileWatcher->deleteLater();
+
+        if (reader != m_reader) {
+            return; // 上传已取消或重新开始
+        }
+
+        if (hashes.size() != ChunkHashCache::blockCount(m_fileSize) || hashes.contains(QByteArray()) || fileHash.isEmpty()) {
+            qWarning() << "FileUploader: 计算内容哈希失败";
+            m_isUploading = false;
+            m_speedTimer->stop();
+            m_journal.close();
+            emit uploadError("读取文件失败: " + m_filePath);
+            emit uploadFinished(false);
+            return;
+        }
+
+        m_blockHashes = QVector<QByteArray>(hashes.begin(), hashes.end());
+        m_fileHash = fileHash;
+        m_hashCache.store(m_filePath, m_blockHashes, m_fileHash);
+
+        onHashesReady();
+    };
+    connect(blocksWatcher, &QFutureWatcher<QByteArray>::finished, this, onFinished);
+    connect(fileWatcher, &QFutureWatcher<QByteArray>::finished, this, onFinished);
+    blocksWatcher->setFuture(blocksFuture);
+    fileWatcher->setFuture(fileFuture);
+}
+
+void FileUploader::onHashesReady()
+{
+    if (m_resumed) {
+        queryUploadedChunks();
+    } else {
+        checkExistingChunks();
+    }
+}
+
+void FileUploader::queryUploadedChunks()
+{
+    // 以服务端记录为准：服务端会话过期时日志中的分片也需要重传
+    QSharedPointer<MappedFileReader> reader = m_reader;
+
+    ApiService::instance().getUploadedChunks(
+        m_uploadId,
+        [this, reader](const QJsonObject& response) {
+            if (reader != m_reader) {
+                return; // 上传已取消或重新开始
+            }
+
+            QSet<int> uploadedChunks;
+            for (const QJsonValue& value : response["uploadedChunks"].toArray()) {
+                uploadedChunks.insert(value.toInt());
+            }
+
+            applyUploadedChunks(uploadedChunks);
+            for (int index : uploadedChunks) {
+                m_journal.markConfirmed(index);
+            }
+
+            checkExistingChunks();
+        },
+        [this, reader](int statusCode, const QString& error) {
+            if (reader != m_reader) {
+                return;
+            }
+
+            // 查询失败时仅依据本地日志续传
+            qWarning() << "FileUploader: 查询已上传分片失败，使用本地日志:" << error;
+            checkExistingChunks();
+        }
+    );
+}
+
+void FileUploader::applyUploadedChunks(const QSet<int>& uploadedChunks)
+{
+    m_completedCount = 0;
+    m_uploadedBytes = 0;
+
+    for (ChunkInfo& chunk : m_chunks) {
+        if (chunk.uploading) {
+            continue;
+        }
+        chunk.uploaded = uploadedChunks.contains(chunk.index);
+        if (chunk.uploaded) {
+            m_completedCount++;
+            m_uploadedBytes += chunk.size;
+        }
+    }
+
+    m_lastUploadedBytes = m_uploadedBytes;
+
+    qDebug() << "FileUploader: 续传，跳过已上传分片" << m_completedCount << "/" << m_chunks.size();
+    if (m_fileSize > 0) {
+        updateProgress();
+    }
+}
+
+int FileUploader::firstBlock(const ChunkInfo& chunk)
+{
+    return static_cast<int>(chunk.offset / ChunkHashCache::BLOCK_SIZE);
+}
+
+int FileUploader::lastBlock(const ChunkInfo& chunk)
+{
+    return static_cast<int>((chunk.offset + qMax<qint64>(chunk.size, 1) - 1) / ChunkHashCache::BLOCK_SIZE);
+}
+
+void FileUploader::checkExistingChunks()
+{
+    // 未上传分片覆盖的去重块
+    QStringList pendingHashes;
+    QSet<int> pendingBlocks;
+    for (const ChunkInfo& chunk : m_chunks) {
+        if (chunk.uploaded) {
+            continue;
+        }
+        for (int block = firstBlock(chunk); block <= lastBlock(chunk) && block < m_blockHashes.size(); ++block) {
+            if (!pendingBlocks.contains(block)) {
+                pendingBlocks.insert(block);
+                pendingHashes.append(QString::fromLatin1(m_blockHashes[block]));
+            }
+        }
+    }
+
+    if (pendingHashes.isEmpty()) {
+        uploadNextChunk();
+        return;
+    }
+
+    QSharedPointer<MappedFileReader> reader = m_reader;
+
+    ApiService::instance().checkBlockHashes(
+        QString::fromLatin1(m_fileHash),
+        pendingHashes,
+        [this, reader](const QJsonObject& response) {
+            if (reader != m_reader) {
+                return; // 上传已取消或重新开始
+            }
+
+            bool fileExists = response["fileExists"].toBool();
+            QSet<QByteArray> existing;
+            for (const QJsonValue& value : response["existing"].toArray()) {
+                existing.insert(value.toString().toLatin1());
+            }
+
+            // 分片覆盖的块服务端都已有（可能来自其他任务或其他分片大小的上传）时无需再传
+            int skipped = 0;
+            for (ChunkInfo& chunk : m_chunks) {
+                if (chunk.uploaded || chunk.uploading) {
+                    continue;
+                }
+                bool allExist = true;
+                for (int block = firstBlock(chunk); allExist && block <= lastBlock(chunk); ++block) {
+                    allExist = block < m_blockHashes.size() && existing.contains(m_blockHashes[block]);
+                }
+                if (fileExists || allExist) {
+                    chunk.uploaded = true;
+                    m_completedCount++;
+                    m_uploadedBytes += chunk.size;
+                    m_journal.markConfirmed(chunk.index);
+                    skipped++;
+                }
+            }
+
+            if (skipped > 0) {
+                m_lastUploadedBytes = m_uploadedBytes;
+                qDebug() << "FileUploader: 服务端已有" << skipped << "个分片的内容，跳过上传";
+                updateProgress();
+            }
+
+            uploadNextChunk();
+        },
+        [this, reader](int statusCode, const QString& error) {
+            if (reader != m_reader) {
+                return;
+            }
+
+            // 去重查询失败不影响上传，全部分片正常上传
+            qWarning() << "FileUploader: 查询已有分片失败:" << error;
+            uploadNextChunk();
+        }
+    );
 }
 
 void FileUploader::uploadNextChunk()
@@ -134,6 +534,11 @@ void FileUploader::uploadNextChunk()
         return;
     }
 
+    // 内容哈希尚未就绪（计算中暂停后又继续），等哈希计算完成后再上传
+    if (m_fileHash.isEmpty()) {
+        return;
+    }
+
     // 检查是否所有分片都已完成
     if (m_completedCount >= m_chunks.size()) {
         // 所有分片上传完成，合并文件
@@ -141,16 +546,34 @@ void FileUploader::uploadNextChunk()
         return;
     }
 
+    // 由调度器管理时申请槽位，调度器再回调 sendNextChunk
+    if (m_scheduler) {
+        m_scheduler->requestSlot(this);
+        return;
+    }
+
     // 上传下一个分片（限制并发数）
-    while (m_uploadingCount < m_maxConcurrency && m_completedCount + m_uploadingCount < m_chunks.size()) {
-        // 查找下一个未上传的分片
-        for (int i = 0; i < m_chunks.size(); ++i) {
-            if (!m_chunks[i].uploaded && m_chunkData.contains(i) == false) {
-                uploadChunk(i);
-                break;
-            }
+    int concurrency = currentConcurrency();
+    for (int i = 0; i < m_chunks.size() && m_uploadingCount < concurrency; ++i) {
+        if (!m_chunks[i].uploaded && !m_chunks[i].uploading) {
+            uploadChunk(i);
+        }
+    }
+}
+
+bool FileUploader::sendNextChunk()
+{
+    if (m_isPaused || !m_isUploading || m_fileHash.isEmpty()) {
+        return false;
+    }
+
+    for (int i = 0; i < m_chunks.size(); ++i) {
+        if (!m_chunks[i].uploaded && !m_chunks[i].uploading) {
+            uploadChunk(i);
+            return true;
         }
     }
+    return false;
 }
 
 void FileUploader::uploadChunk(int chunkIndex)
@@ -159,42 +582,72 @@ void FileUploader::uploadChunk(int chunkIndex)
         return;
     }
 
-    const ChunkInfo& chunk = m_chunks[chunkIndex];
+    const ChunkInfo chunk = m_chunks[chunkIndex];
+    const QSharedPointer<MappedFileReader> reader = m_reader;
+    const bool streaming = (m_transferMode == BinaryStream);
 
     qDebug() << "FileUploader: 准备上传分片" << chunkIndex << "/" << m_chunks.size();
 
+    m_chunks[chunkIndex].uploading = true;
     m_uploadingCount++;
 
-    // 使用 QtConcurrent 在后台线程读取文件和计算 MD5
-    // 这样不会阻塞 UI 线程
-    QFuture<QPair<QByteArray, QByteArray>> future = QtConcurrent::run([this, chunk]() -> QPair<QByteArray, QByteArray> {
-        // 在后台线程中执行耗时操作
-        QFile file(m_filePath);
-        if (!file.open(QIODevice::ReadOnly)) {
-            return QPair<QByteArray, QByteArray>();
+    // 使用 QtConcurrent 在后台线程读取分片，这样不会阻塞 UI 线程
+    // 优先使用内存映射视图，请求体直接引用映射内存，无需拷贝；
+    // 映射失败时回退到普通文件读取
+    QFuture<ChunkPayload> future = QtConcurrent::run([reader, chunk, streaming]() -> ChunkPayload {
+        ChunkPayload payload;
+
+        QByteArray view = reader->view(chunk.offset, chunk.size);
+        if (!view.isNull()) {
+            payload.data = view;
+            payload.mapped = true;
+            payload.ok = true;
+            return payload;
         }
 
-        file.seek(chunk.offset);
-        QByteArray chunkData = file.read(chunk.size);
-        file.close();
+        if (streaming) {
+            // 二进制模式发送时再从文件流式读取，分片数据不常驻内存
+            payload.ok = true;
+            return payload;
+        }
 
-        // 计算 MD5
-        QByteArray hash = QCryptographicHash::hash(chunkData, QCryptographicHash::Md5).toHex();
+        QFile file(reader->fileName());
+        if (!file.open(QIODevice::ReadOnly)) {
+            return payload;
+        }
 
-        return QPair<QByteArray, QByteArray>(chunkData, hash);
+        file.seek(chunk.offset);
+        payload.data = file.read(chunk.size);
+        payload.ok = (payload.data.size() == chunk.size);
+        return payload;
     });
 
     // 使用 QFutureWatcher 监听后台任务完成
-    QFutureWatcher<QPair<QByteArray, QByteArray>>* watcher = new QFutureWatcher<QPair<QByteArray, QByteArray>>(this);
-
-    connect(watcher, &QFutureWatcher<QPair<QByteArray, QByteArray>>::finished, this, [this, chunkIndex, watcher]() {
-        QPair<QByteArray, QByteArray> result = watcher->result();
-        QByteArray chunkData = result.first;
-        QByteArray hash = result.second;
+    QFutureWatcher<ChunkPayload>* watcher = new QFutureWatcher<ChunkPayload>(this);
 
+    connect(watcher, &QFutureWatcher<ChunkPayload>::finished, this, [this, chunkIndex, chunk, reader, streaming, watcher]() {
+        ChunkPayload payload = watcher->result();
         watcher->deleteLater();
 
-        if (chunkData.isEmpty()) {
+        // 读取期间上传被取消，或已回退到 JSON 模式（流式回退路径没有分片数据），放弃本次结果
+        bool cancelled = !m_isUploading || reader != m_reader;
+        bool needsData = streaming && m_transferMode == JsonBase64 && !payload.mapped;
+        if (cancelled || needsData) {
+            if (payload.mapped) {
+                reader->release(chunk.offset);
+            }
+            if (cancelled) {
+                releaseChunkSlot();
+            } else {
+                // 沿用同一槽位重新读取
+                m_uploadingCount--;
+                m_chunks[chunkIndex].uploading = false;
+                uploadChunk(chunkIndex);
+            }
+            return;
+        }
+
+        if (!payload.ok) {
             qWarning() << "FileUploader: 读取分片" << chunkIndex << "失败";
             onChunkUploaded(chunkIndex, false);
             return;
@@ -202,49 +655,176 @@ void FileUploader::uploadChunk(int chunkIndex)
 
         qDebug() << "FileUploader: 开始上传分片" << chunkIndex << "/" << m_chunks.size();
 
-        m_chunkData[chunkIndex] = chunkData;
-
-        // 构造上传参数（使用JSON格式）
-        QJsonObject data;
-        data["taskId"] = m_taskId;
-        data["chunkIndex"] = chunkIndex;
-        data["totalChunks"] = m_chunks.size();
-        data["chunkHash"] = QString::fromLatin1(hash);
-        data["chunkData"] = QString::fromLatin1(chunkData.toBase64());
-
-        HttpClient::instance().post(
-            "/api/v1/files/upload/chunk",
-            data,
-            [this, chunkIndex](const QJsonObject& response) {
-                // 上传成功
-                onChunkUploaded(chunkIndex, true);
-            },
-            [this, chunkIndex](int statusCode, const QString& error) {
-                // 上传失败
-                qWarning() << "FileUploader: 分片" << chunkIndex << "上传失败:" << error;
-                onChunkUploaded(chunkIndex, false);
-            }
-        );
+        if (m_transferMode == BinaryStream) {
+            sendChunkBinary(chunkIndex, payload);
+        } else {
+            sendChunkJson(chunkIndex, payload);
+        }
     });
 
     watcher->setFuture(future);
 }
 
+void FileUploader::sendChunkBinary(int chunkIndex, const ChunkPayload& payload)
+{
+    const ChunkInfo& chunk = m_chunks[chunkIndex];
+
+    QIODevice* device = nullptr;
+    if (payload.mapped) {
+        // 请求体直接引用映射内存；buffer 销毁时释放视图，
+        // lambda 持有 reader 的引用，保证请求结束前映射不被解除
+        QBuffer* buffer = new QBuffer();
+        buffer->setData(payload.data);
+        QSharedPointer<MappedFileReader> reader = m_reader;
+        qint64 offset = chunk.offset;
+        connect(buffer, &QObject::destroyed, [reader, offset]() {
+            reader->release(offset);
+        });
+        device = buffer;
+    } else {
+        device = new FileChunkDevice(m_filePath, chunk.offset, chunk.size);
+    }
+
+    if (!device->open(QIODevice::ReadOnly)) {
+        delete device;
+        qWarning() << "FileUploader: 打开分片" << chunkIndex << "失败";
+        onChunkUploaded(chunkIndex, false);
+        return;
+    }
+
+    // 分片元数据通过请求头传递，请求体为原始字节
+    QMap<QByteArray, QByteArray> headers;
+    headers["X-Task-Id"] = m_uploadId.toUtf8();
+    headers["X-Chunk-Index"] = QByteArray::number(chunkIndex);
+    headers["X-Total-Chunks"] = QByteArray::number(m_chunks.size());
+    headers["X-Chunk-Offset"] = QByteArray::number(chunk.offset);
+
+    m_chunks[chunkIndex].startedAt = m_clock.elapsed();
+
+    QSharedPointer<MappedFileReader> reader = m_reader;
+
+    HttpClient::instance().postStream(
+        "/api/v1/files/upload/chunk/binary",
+        device,
+        headers,
+        [this, chunkIndex, reader](const QJsonObject& response) {
+            if (reader != m_reader) {
+                releaseChunkSlot(); // 上传已取消，归还分片占用的槽位
+                return;
+            }
+            // 上传成功
+            recordSample(chunkIndex, true);
+            onChunkUploaded(chunkIndex, true);
+        },
+        [this, chunkIndex, reader](int statusCode, const QString& error) {
+            if (reader != m_reader) {
+                releaseChunkSlot();
+                return;
+            }
+            handleChunkError(chunkIndex, statusCode, error);
+        }
+    );
+}
+
+void FileUploader::sendChunkJson(int chunkIndex, const ChunkPayload& payload)
+{
+    // 构造上传参数（使用JSON格式）
+    QJsonObject data;
+    data["taskId"] = m_uploadId;
+    data["chunkIndex"] = chunkIndex;
+    data["totalChunks"] = m_chunks.size();
+    data["chunkOffset"] = m_chunks[chunkIndex].offset;
+    data["chunkData"] = QString::fromLatin1(payload.data.toBase64());
+
+    // Base64 已经拷贝了数据，可以立即释放视图
+    if (payload.mapped) {
+        m_reader->release(m_chunks[chunkIndex].offset);
+    }
+
+    m_chunks[chunkIndex].startedAt = m_clock.elapsed();
+
+    QSharedPointer<MappedFileReader> reader = m_reader;
+
+    HttpClient::instance().post(
+        "/api/v1/files/upload/chunk",
+        data,
+        [this, chunkIndex, reader](const QJsonObject& response) {
+            if (reader != m_reader) {
+                releaseChunkSlot(); // 上传已取消，归还分片占用的槽位
+                return;
+            }
+            // 上传成功
+            recordSample(chunkIndex, true);
+            onChunkUploaded(chunkIndex, true);
+        },
+        [this, chunkIndex, reader](int statusCode, const QString& error) {
+            if (reader != m_reader) {
+                releaseChunkSlot();
+                return;
+            }
+            handleChunkError(chunkIndex, statusCode, error);
+        },
+        HttpClient::Bulk    // Base64 分片同样走批量连接池，不挤占 API 请求
+    );
+}
+
+void FileUploader::handleChunkError(int chunkIndex, int statusCode, const QString& error)
+{
+    // 服务端不支持二进制分片接口时，回退到 JSON 接口并重新上传该分片（不计入重试次数）
+    bool unsupported = (statusCode == 404 || statusCode == 405 || statusCode == 415 || statusCode == 501);
+    if (m_transferMode == BinaryStream && unsupported) {
+        qWarning() << "FileUploader: 服务端不支持二进制分片上传，回退到 JSON 接口";
+        m_transferMode = JsonBase64;
+        m_uploadingCount--;
+        m_chunks[chunkIndex].uploading = false;
+        releaseChunkSlot();
+        uploadNextChunk();
+        return;
+    }
+
+    // 上传失败
+    qWarning() << "FileUploader: 分片" << chunkIndex << "上传失败:" << error;
+    recordSample(chunkIndex, false);
+    onChunkUploaded(chunkIndex, false);
+}
+
+void FileUploader::recordSample(int chunkIndex, bool success)
+{
+    if (!m_adaptive || !m_isUploading) {
+        return;
+    }
+
+    const ChunkInfo& chunk = m_chunks[chunkIndex];
+    m_rateController->addSample(chunk.size, m_clock.elapsed() - chunk.startedAt, success);
+}
+
+void FileUploader::releaseChunkSlot()
+{
+    if (m_scheduler) {
+        m_scheduler->releaseSlot(this);
+    }
+}
+
 void FileUploader::onChunkUploaded(int chunkIndex, bool success)
 {
     m_uploadingCount--;
+    m_chunks[chunkIndex].uploading = false;
+
+    if (!m_isUploading) {
+        // 上传已因其他分片失败而结束，之后才返回的分片只归还槽位
+        releaseChunkSlot();
+        return;
+    }
 
     if (success) {
         // 分片上传成功
         m_chunks[chunkIndex].uploaded = true;
         m_completedCount++;
+        m_journal.markConfirmed(chunkIndex);
 
         qint64 chunkSize = m_chunks[chunkIndex].size;
         m_uploadedBytes += chunkSize;
 
-        // 清理分片数据
-        m_chunkData.remove(chunkIndex);
-
         updateProgress();
 
         qDebug() << "FileUploader: 分片" << chunkIndex << "上传成功，进度:"
@@ -257,17 +837,24 @@ void FileUploader::onChunkUploaded(int chunkIndex, bool success)
         if (m_chunks[chunkIndex].retryCount < m_maxRetries) {
             qDebug() << "FileUploader: 分片" << chunkIndex << "重试"
                      << m_chunks[chunkIndex].retryCount << "/" << m_maxRetries;
+
+            // 失败时控制器已调小分片，重试前把这个分片也按新大小拆分
+            splitPendingChunks();
         } else {
             // 超过最大重试次数
             qWarning() << "FileUploader: 分片" << chunkIndex << "上传失败，超过最大重试次数";
             m_isUploading = false;
             m_speedTimer->stop();
+            m_journal.close();
+            releaseChunkSlot();
             emit uploadError("分片上传失败");
             emit uploadFinished(false);
             return;
         }
     }
 
+    releaseChunkSlot();
+
     // 继续上传下一个分片
     uploadNextChunk();
 }
@@ -277,29 +864,43 @@ void FileUploader::mergeChunks()
     qDebug() << "FileUploader: 所有分片上传完成，请求合并文件";
 
     QJsonObject data;
-    data["taskId"] = m_taskId;
+    data["taskId"] = m_uploadId;
     data["fileName"] = QFileInfo(m_filePath).fileName();
     data["totalChunks"] = m_chunks.size();
     data["fileSize"] = m_fileSize;
 
+    // 按去重块的内容哈希组装文件，服务端可直接复用其他任务已上传的块；
+    // 文件哈希是整个文件的 SHA-256，供服务端校验
+    QJsonArray blockHashes;
+    for (const QByteArray& hash : m_blockHashes) {
+        blockHashes.append(QString::fromLatin1(hash));
+    }
+    data["fileHash"] = QString::fromLatin1(m_fileHash);
+    data["blockSize"] = ChunkHashCache::BLOCK_SIZE;
+    data["blockHashes"] = blockHashes;
+
+    QSharedPointer<MappedFileReader> reader = m_reader;
+
     HttpClient::instance().post(
         "/api/v1/files/upload/merge",
         data,
-        [this](const QJsonObject& response) {
+        [this, reader](const QJsonObject& response) {
+            if (reader != m_reader) {
+                return; // 上传已取消
+            }
             // 合并成功
             qDebug() << "FileUploader: 文件上传完成";
             m_isUploading = false;
             m_speedTimer->stop();
-
-            if (m_file) {
-                m_file->close();
-                delete m_file;
-                m_file = nullptr;
-            }
+            m_reader.reset();
+            m_journal.remove();
 
             emit uploadFinished(true);
         },
-        [this](int statusCode, const QString& error) {
+        [this, reader](int statusCode, const QString& error) {
+            if (reader != m_reader) {
+                return;
+            }
             // 合并失败
             qWarning() << "FileUploader: 文件合并失败:" << error;
             m_isUploading = false;
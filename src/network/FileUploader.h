@@ -7,7 +7,14 @@
 #include <QMap>
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QSharedPointer>
 #include <QtConcurrent/QtConcurrent>
+#include "UploadJournal.h"
+#include "ChunkHashCache.h"
+#include "UploadRateController.h"
+
+class MappedFileReader;
+class UploadScheduler;
 
 /**
  * @brief 文件分片上传器
@@ -18,6 +25,12 @@
  * - 上传进度追踪
  * - 并发上传多个分片
  * - 上传失败自动重试
+ * - 二进制流式上传分片（服务端不支持时回退到 JSON/Base64）
+ * - 按内容哈希去重，服务端已有的分片不再上传
+ * - 根据链路状况自适应调整并发数和分片大小
+ *
+ * 由 UploadScheduler 管理时，分片的发送时机由调度器决定，
+ * 多个上传器共享调度器的速率控制器和全局并发预算。
  */
 class FileUploader : public QObject
 {
@@ -29,7 +42,17 @@ public:
         qint64 offset;
         qint64 size;
         bool uploaded;
+        bool uploading;
         int retryCount;
+        qint64 startedAt;  // 开始发送时间（毫秒），用于速率采样
+    };
+
+    /**
+     * @brief 分片传输方式
+     */
+    enum TransferMode {
+        BinaryStream,   // application/octet-stream，分片元数据放在请求头
+        JsonBase64      // 旧接口：Base64 编码后放在 JSON 中
     };
 
     explicit FileUploader(QObject *parent = nullptr);
@@ -39,6 +62,11 @@ public:
      * @brief 开始上传文件
      * @param filePath 本地文件路径
      * @param taskId 任务ID
+     *
+     * 若该文件有未完成的上传日志（崩溃、重启或取消留下的），则沿用原上传会话，
+     * 并向服务端查询已收到的分片，只上传剩余部分。
+     * 上传前计算整个文件和每个去重块（固定 1MB，与分片大小无关）的 SHA-256
+     * （命中本地缓存则跳过），覆盖的块服务端都已有的分片直接视为已上传。
      */
     void startUpload(const QString& filePath, const QString& taskId);
 
@@ -59,24 +87,73 @@ public:
 
     /**
      * @brief 设置分片大小（字节）
+     *
+     * 自适应模式下作为初始值，之后由控制器调整；控制器调小分片时（如超时后），
+     * 进行中的上传把尚未发送的分片按新大小拆分，已发出的分片不变。
+     */
+    void setChunkSize(qint64 size);
+
+    /**
+     * @brief 设置并发上传数（自适应模式下作为初始值）
      */
-    void setChunkSize(qint64 size) { m_chunkSize = size; }
+    void setConcurrency(int count);
 
     /**
-     * @brief 设置并发上传数
+     * @brief 启用/禁用并发数和分片大小自适应（默认启用）
      */
-    void setConcurrency(int count) { m_maxConcurrency = count; }
+    void setAdaptiveEnabled(bool enabled) { m_adaptive = enabled; }
+    bool isAdaptiveEnabled() const { return m_adaptive; }
+
+    /**
+     * @brief 速率控制器
+     */
+    UploadRateController* rateController() const { return m_rateController; }
+
+    /**
+     * @brief 使用外部（共享）的速率控制器替换自带的控制器
+     */
+    void setRateController(UploadRateController* controller);
+
+    /**
+     * @brief 交由调度器分配分片槽位
+     *
+     * 设置后上传器不再自行按并发数发送分片，而是向调度器申请槽位，
+     * 由调度器调用 sendNextChunk() 发送。
+     */
+    void setScheduler(UploadScheduler* scheduler) { m_scheduler = scheduler; }
+
+    /**
+     * @brief 发送下一个待上传的分片（调度器调用）
+     * @return 没有可发送的分片（暂停、未在上传或全部在途）时返回 false
+     */
+    bool sendNextChunk();
 
     /**
      * @brief 设置最大重试次数
      */
     void setMaxRetries(int count) { m_maxRetries = count; }
 
+    /**
+     * @brief 设置分片传输方式（默认二进制流式）
+     */
+    void setTransferMode(TransferMode mode) { m_transferMode = mode; }
+    TransferMode transferMode() const { return m_transferMode; }
+
     /**
      * @brief 是否正在上传
      */
     bool isUploading() const { return m_isUploading; }
 
+    /**
+     * @brief 服务端上传会话 ID（续传时为日志中记录的会话，可能与 startUpload 传入的 taskId 不同）
+     */
+    QString uploadId() const { return m_uploadId; }
+
+    /**
+     * @brief 整个文件的 SHA-256（十六进制），内容哈希计算完成后有效
+     */
+    QByteArray fileHash() const { return m_fileHash; }
+
 signals:
     /**
      * @brief 上传进度
@@ -92,6 +169,14 @@ signals:
      */
     void speedChanged(qint64 bytesPerSecond);
 
+    /**
+     * @brief 自适应控制器的决策变化
+     * @param concurrency 当前并发数
+     * @param chunkSize 下一次上传使用的分片大小
+     * @param bytesPerSecond 估计的链路带宽
+     */
+    void tuningChanged(int concurrency, qint64 chunkSize, qint64 bytesPerSecond);
+
     /**
      * @brief 上传完成
      */
@@ -105,23 +190,90 @@ signals:
 private slots:
     void onChunkUploaded(int chunkIndex, bool success);
     void onSpeedTimerTimeout();
+    void onDecisionChanged(int concurrency, qint64 chunkSize, qint64 bytesPerSecond);
 
 private:
+    /**
+     * @brief 后台读取分片的结果
+     *
+     * mapped 为 true 时 data 是 MappedFileReader 的视图，使用完需 release；
+     * 否则 data 为普通内存（二进制流式回退路径下为空，发送时再从文件读取）。
+     */
+    struct ChunkPayload {
+        QByteArray data;
+        bool mapped = false;
+        bool ok = false;
+    };
+
+    /**
+     * @brief 计算文件一段的 SHA-256（十六进制），失败时返回空
+     */
+    static QByteArray hashRange(const QSharedPointer<MappedFileReader>& reader, qint64 offset, qint64 size);
+
+    /**
+     * @brief 顺序计算整个文件的 SHA-256（十六进制），失败时返回空
+     */
+    static QByteArray hashFile(const QSharedPointer<MappedFileReader>& reader);
+
+    /**
+     * @brief 分片覆盖的第一个/最后一个去重块
+     */
+    static int firstBlock(const ChunkInfo& chunk);
+    static int lastBlock(const ChunkInfo& chunk);
+
     void prepareChunks();
+
+    /**
+     * @brief 按控制器当前的分片大小拆分尚未发送的大分片
+     *
+     * 拆分后原分片保留序号、缩小为第一段，其余部分作为新分片追加在末尾，
+     * 已发出和已确认的分片序号不变；拆分记录写入日志，续传时恢复同样的布局。
+     */
+    void splitPendingChunks();
+    void splitChunk(int chunkIndex, qint64 size);
+    void computeHashes();
+    void onHashesReady();
+    void queryUploadedChunks();
+    void applyUploadedChunks(const QSet<int>& uploadedChunks);
+    void checkExistingChunks();
     void uploadNextChunk();
     void uploadChunk(int chunkIndex);
+    void sendChunkBinary(int chunkIndex, const ChunkPayload& payload);
+    void sendChunkJson(int chunkIndex, const ChunkPayload& payload);
+    void handleChunkError(int chunkIndex, int statusCode, const QString& error);
+    void recordSample(int chunkIndex, bool success);
+
+    /**
+     * @brief 一个分片结束（成功、失败或上传已取消），向调度器归还它占用的槽位
+     *
+     * 每个由 sendNextChunk() 发出的分片在所有结束路径上都恰好调用一次。
+     */
+    void releaseChunkSlot();
+    int currentConcurrency() const;
     void mergeChunks();
     void updateProgress();
     void calculateSpeed();
 
     QString m_filePath;
     QString m_taskId;
-    QFile* m_file;
+    QString m_uploadId;  // 服务端上传会话 ID，续传时沿用日志中记录的值
+    UploadJournal m_journal;
+    bool m_resumed;
+    ChunkHashCache m_hashCache;
+    QVector<QByteArray> m_blockHashes;  // 去重块 SHA-256（十六进制）
+    QByteArray m_fileHash;
+    QSharedPointer<MappedFileReader> m_reader;  // 请求体可能比上传器存活更久，使用共享指针
     qint64 m_fileSize;
 
     qint64 m_chunkSize;
     int m_maxConcurrency;
     int m_maxRetries;
+    TransferMode m_transferMode;
+
+    bool m_adaptive;
+    UploadRateController* m_rateController;
+    UploadScheduler* m_scheduler;
+    QElapsedTimer m_clock;
 
     QVector<ChunkInfo> m_chunks;
     int m_uploadingCount;
@@ -134,6 +286,4 @@ private:
     qint64 m_lastUploadedBytes;
     QTimer* m_speedTimer;
     qint64 m_currentSpeed;
-
-    QMap<int, QByteArray> m_chunkData;
 };
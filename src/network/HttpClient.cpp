@@ -13,8 +13,10 @@ HttpClient& HttpClient::instance()
 }
 
 HttpClient::HttpClient()
-    : m_manager(new QNetworkAccessManager(this))
+    : m_controlManager(new QNetworkAccessManager(this))
+    , m_bulkManager(new QNetworkAccessManager(this))
     , m_timeout(30000)  // 默认30秒超时
+    , m_http2Enabled(true)
 {
 }
 
@@ -51,25 +53,28 @@ void HttpClient::get(const QString& path,
 
     emit requestStarted(url);
 
-    QNetworkReply* reply = m_manager->get(request);
+    QNetworkReply* reply = m_controlManager->get(request);
     handleReply(reply, onSuccess, onError);
 }
 
 void HttpClient::post(const QString& path,
                      const QJsonObject& data,
                      SuccessCallback onSuccess,
-                     ErrorCallback onError)
+                     ErrorCallback onError,
+                     TrafficClass trafficClass)
 {
     QString url = buildUrl(path);
-    QNetworkRequest request = buildRequest(path);
+    QNetworkRequest request = buildRequest(path, trafficClass);
     request.setUrl(QUrl(url));
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
     emit requestStarted(url);
 
     QByteArray jsonData = QJsonDocument(data).toJson();
-    QNetworkReply* reply = m_manager->post(request, jsonData);
-    handleReply(reply, onSuccess, onError);
+    QNetworkReply* reply = networkManager(trafficClass)->post(request, jsonData);
+
+    // 批量请求（Base64 分片）与 postStream 一样按空闲计算超时，慢链路上不会被整体超时中断
+    handleReply(reply, onSuccess, onError, trafficClass == Bulk);
 }
 
 void HttpClient::put(const QString& path,
@@ -85,7 +90,7 @@ void HttpClient::put(const QString& path,
     emit requestStarted(url);
 
     QByteArray jsonData = QJsonDocument(data).toJson();
-    QNetworkReply* reply = m_manager->put(request, jsonData);
+    QNetworkReply* reply = m_controlManager->put(request, jsonData);
     handleReply(reply, onSuccess, onError);
 }
 
@@ -99,10 +104,41 @@ void HttpClient::deleteRequest(const QString& path,
 
     emit requestStarted(url);
 
-    QNetworkReply* reply = m_manager->deleteResource(request);
+    QNetworkReply* reply = m_controlManager->deleteResource(request);
     handleReply(reply, onSuccess, onError);
 }
 
+void HttpClient::postStream(const QString& path,
+                           QIODevice* body,
+                           const QMap<QByteArray, QByteArray>& headers,
+                           SuccessCallback onSuccess,
+                           ErrorCallback onError,
+                           std::function<void(qint64, qint64)> onProgress)
+{
+    QString url = buildUrl(path);
+    QNetworkRequest request = buildRequest(path, Bulk);
+    request.setUrl(QUrl(url));
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/octet-stream");
+    request.setHeader(QNetworkRequest::ContentLengthHeader, body->size());
+
+    for (auto it = headers.begin(); it != headers.end(); ++it) {
+        request.setRawHeader(it.key(), it.value());
+    }
+
+    emit requestStarted(url);
+
+    // 请求体直接从设备流式读取，不经过 JSON 序列化
+    QNetworkReply* reply = m_bulkManager->post(request, body);
+    body->setParent(reply);
+
+    // 进度回调
+    if (onProgress) {
+        connect(reply, &QNetworkReply::uploadProgress, onProgress);
+    }
+
+    handleReply(reply, onSuccess, onError, true);
+}
+
 void HttpClient::uploadFile(const QString& path,
                            const QString& filePath,
                            const QMap<QString, QString>& fields,
@@ -111,7 +147,7 @@ void HttpClient::uploadFile(const QString& path,
                            std::function<void(qint64, qint64)> onProgress)
 {
     QString url = buildUrl(path);
-    QNetworkRequest request = buildRequest(path);
+    QNetworkRequest request = buildRequest(path, Bulk);
     request.setUrl(QUrl(url));
 
     // 创建 multipart 表单
@@ -149,7 +185,7 @@ void HttpClient::uploadFile(const QString& path,
 
     emit requestStarted(url);
 
-    QNetworkReply* reply = m_manager->post(request, multiPart);
+    QNetworkReply* reply = m_bulkManager->post(request, multiPart);
     multiPart->setParent(reply);
 
     // 进度回调
@@ -166,13 +202,16 @@ void HttpClient::downloadFile(const QString& url,
                              std::function<void()> onSuccess,
                              ErrorCallback onError)
 {
-    QUrl requestUrl(url);
+    // 下载地址是完整 URL（可能是其他主机），不带访问令牌
     QNetworkRequest request;
-    request.setUrl(requestUrl);
+    request.setUrl(QUrl(url));
+    request.setRawHeader("User-Agent", "YuntuClient/1.0.0");
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, m_http2Enabled);
+    request.setPriority(QNetworkRequest::LowPriority);
 
     emit requestStarted(url);
 
-    QNetworkReply* reply = m_manager->get(request);
+    QNetworkReply* reply = m_bulkManager->get(request);
 
     // 进度回调
     if (onProgress) {
@@ -208,13 +247,20 @@ void HttpClient::downloadFile(const QString& url,
     });
 }
 
-QNetworkRequest HttpClient::buildRequest(const QString& path)
+QNetworkRequest HttpClient::buildRequest(const QString& path, TrafficClass trafficClass)
 {
     QNetworkRequest request;
 
     // 添加 User-Agent
     request.setRawHeader("User-Agent", "YuntuClient/1.0.0");
 
+    // 允许 HTTP/2：服务端支持时同一主机的请求在一个连接上多路复用
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, m_http2Enabled);
+
+    // 同一连接池内控制请求优先发出
+    request.setPriority(trafficClass == Control ? QNetworkRequest::HighPriority
+                                                : QNetworkRequest::LowPriority);
+
     // 添加 Authorization Token
     if (!m_accessToken.isEmpty()) {
         request.setRawHeader("Authorization",
@@ -226,7 +272,8 @@ QNetworkRequest HttpClient::buildRequest(const QString& path)
 
 void HttpClient::handleReply(QNetworkReply* reply,
                             SuccessCallback onSuccess,
-                            ErrorCallback onError)
+                            ErrorCallback onError,
+                            bool idleTimeout)
 {
     // 超时处理
     QTimer* timer = new QTimer(reply);
@@ -236,6 +283,13 @@ void HttpClient::handleReply(QNetworkReply* reply,
     });
     timer->start(m_timeout);
 
+    // 空闲超时：上传有进展时重新计时
+    if (idleTimeout) {
+        connect(reply, &QNetworkReply::uploadProgress, timer, [timer]() {
+            timer->start();
+        });
+    }
+
     // 请求完成
     connect(reply, &QNetworkReply::finished, [=]() {
         timer->stop();
@@ -18,6 +18,13 @@
  * - JSON 数据自动序列化/反序列化
  * - 错误处理
  * - 请求超时控制
+ * - 控制请求与大数据传输分离
+ *
+ * 控制请求（API 调用、认证刷新、任务列表）和大数据传输（分片上传、文件上传下载）
+ * 使用两个独立的 QNetworkAccessManager，各自有独立的连接池：HTTP/1.1 下每个主机
+ * 最多 6 个连接的限制分别计算，分片上传占满连接时 API 请求不需要排队。
+ * 两类请求都允许 HTTP/2（服务端通过 ALPN 协商支持时生效），同一连接上多路复用，
+ * 分片上传的并发数不再受 6 个连接的限制；控制请求设为高优先级。
  */
 class HttpClient : public QObject
 {
@@ -28,6 +35,14 @@ public:
     using SuccessCallback = std::function<void(const QJsonObject&)>;
     using ErrorCallback = std::function<void(int statusCode, const QString& error)>;
 
+    /**
+     * @brief 流量类别，决定请求使用的连接池
+     */
+    enum TrafficClass {
+        Control,    // API 调用：数据量小，要求低延迟
+        Bulk        // 分片上传、文件上传下载：数据量大，占用带宽
+    };
+
     static HttpClient& instance();
 
     /**
@@ -55,11 +70,15 @@ public:
 
     /**
      * @brief POST 请求
+     * @param trafficClass 流量类别，携带大量数据的 JSON 请求（如 Base64 分片）使用 Bulk
+     *
+     * Bulk 请求与 postStream 一样按空闲计算超时。
      */
     void post(const QString& path,
               const QJsonObject& data,
               SuccessCallback onSuccess = nullptr,
-              ErrorCallback onError = nullptr);
+              ErrorCallback onError = nullptr,
+              TrafficClass trafficClass = Control);
 
     /**
      * @brief PUT 请求
@@ -76,6 +95,20 @@ public:
                       SuccessCallback onSuccess = nullptr,
                       ErrorCallback onError = nullptr);
 
+    /**
+     * @brief POST 原始二进制数据（application/octet-stream）
+     * @param body 请求体设备，必须已打开；请求发出后由 reply 接管其生命周期
+     * @param headers 额外的请求头（如分片元数据）
+     *
+     * 超时按空闲计算：只要上传仍有进展就不会超时，慢链路上的大分片不会被中断。
+     */
+    void postStream(const QString& path,
+                    QIODevice* body,
+                    const QMap<QByteArray, QByteArray>& headers = {},
+                    SuccessCallback onSuccess = nullptr,
+                    ErrorCallback onError = nullptr,
+                    std::function<void(qint64, qint64)> onProgress = nullptr);
+
     /**
      * @brief 上传文件（multipart/form-data）
      */
@@ -100,6 +133,20 @@ public:
      */
     void setTimeout(int timeout) { m_timeout = timeout; }
 
+    /**
+     * @brief 是否允许 HTTP/2（默认允许），只影响之后发出的请求
+     */
+    void setHttp2Enabled(bool enabled) { m_http2Enabled = enabled; }
+    bool http2Enabled() const { return m_http2Enabled; }
+
+    /**
+     * @brief 指定流量类别使用的网络管理器
+     */
+    QNetworkAccessManager* networkManager(TrafficClass trafficClass) const
+    {
+        return trafficClass == Bulk ? m_bulkManager : m_controlManager;
+    }
+
 signals:
     /**
      * @brief 请求开始信号
@@ -117,15 +164,18 @@ private:
     HttpClient(const HttpClient&) = delete;
     HttpClient& operator=(const HttpClient&) = delete;
 
-    QNetworkRequest buildRequest(const QString& path);
+    QNetworkRequest buildRequest(const QString& path, TrafficClass trafficClass = Control);
     void handleReply(QNetworkReply* reply,
                     SuccessCallback onSuccess,
-                    ErrorCallback onError);
+                    ErrorCallback onError,
+                    bool idleTimeout = false);
 
     QString buildUrl(const QString& path, const QMap<QString, QString>& params = {});
 
-    QNetworkAccessManager* m_manager;
+    QNetworkAccessManager* m_controlManager;
+    QNetworkAccessManager* m_bulkManager;
     QString m_baseUrl;
     QString m_accessToken;
     int m_timeout;  // 超时时间（毫秒）
+    bool m_http2Enabled;
 };
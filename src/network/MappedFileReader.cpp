@@ -0,0 +1,106 @@
+#include "MappedFileReader.h"
+#include <QDebug>
+
+MappedFileReader::MappedFileReader(const QString& filePath)
+    : m_file(filePath)
+    , m_size(0)
+    , m_base(nullptr)
+{
+}
+
+MappedFileReader::~MappedFileReader()
+{
+    close();
+}
+
+bool MappedFileReader::open()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_file.isOpen()) {
+        return true;
+    }
+
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    m_size = m_file.size();
+
+    if (m_size > 0) {
+        m_base = m_file.map(0, m_size);
+        if (!m_base) {
+            qDebug() << "MappedFileReader: 无法映射整个文件，改为按分片映射" << m_file.fileName();
+        }
+    }
+
+    return true;
+}
+
+void MappedFileReader::close()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_base) {
+        m_file.unmap(m_base);
+        m_base = nullptr;
+    }
+
+    for (auto it = m_windows.begin(); it != m_windows.end(); ++it) {
+        m_file.unmap(it->address);
+    }
+    m_windows.clear();
+
+    m_file.close();
+}
+
+QByteArray MappedFileReader::view(qint64 offset, qint64 size)
+{
+    if (offset < 0 || size <= 0 || offset + size > m_size) {
+        return QByteArray();
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    if (m_base) {
+        return QByteArray::fromRawData(reinterpret_cast<const char*>(m_base + offset), size);
+    }
+
+    if (!m_file.isOpen()) {
+        return QByteArray();
+    }
+
+    auto it = m_windows.find(offset);
+    if (it == m_windows.end()) {
+        uchar* address = m_file.map(offset, size);
+        if (!address) {
+            return QByteArray();
+        }
+        it = m_windows.insert(offset, Window{address, size, 0});
+    } else if (it->size < size) {
+        // 同一偏移已有更小的映射（去重块与传输分片大小不同），由调用方回退到普通读取
+        return QByteArray();
+    }
+
+    it->refCount++;
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(it->address), size);
+}
+
+void MappedFileReader::release(qint64 offset)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_base) {
+        return;
+    }
+
+    auto it = m_windows.find(offset);
+    if (it == m_windows.end()) {
+        return;
+    }
+
+    if (--it->refCount <= 0) {
+        m_file.unmap(it->address);
+        m_windows.erase(it);
+    }
+}
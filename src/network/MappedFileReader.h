@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QByteArray>
+
+/**
+ * @brief 基于内存映射的文件分片读取器
+ *
+ * 一个文件只打开、映射一次，按分片返回不拥有内存的
+ * QByteArray::fromRawData 视图，哈希计算和网络请求体共用同一份视图，
+ * 不再为每个分片打开文件、分配缓冲区和拷贝数据。
+ *
+ * 优先映射整个文件；地址空间不足时（如 32 位进程）退化为按分片映射，
+ * 分片视图使用引用计数，最后一次 release() 时解除映射。
+ *
+ * 线程安全：view()/release() 可在任意线程调用。
+ */
+class MappedFileReader
+{
+public:
+    explicit MappedFileReader(const QString& filePath);
+    ~MappedFileReader();
+
+    MappedFileReader(const MappedFileReader&) = delete;
+    MappedFileReader& operator=(const MappedFileReader&) = delete;
+
+    /**
+     * @brief 打开文件并尝试映射整个文件
+     */
+    bool open();
+
+    /**
+     * @brief 解除所有映射并关闭文件
+     */
+    void close();
+
+    bool isOpen() const { return m_file.isOpen(); }
+    qint64 size() const { return m_size; }
+    QString fileName() const { return m_file.fileName(); }
+
+    /**
+     * @brief 获取分片视图
+     * @return 不拥有内存的视图；映射失败时返回空 QByteArray，
+     *         调用方应回退到普通文件读取
+     *
+     * 每次成功调用都必须对应一次 release(offset)。
+     */
+    QByteArray view(qint64 offset, qint64 size);
+
+    /**
+     * @brief 释放分片视图（整文件映射时为空操作）
+     */
+    void release(qint64 offset);
+
+private:
+    struct Window {
+        uchar* address;
+        qint64 size;
+        int refCount;
+    };
+
+    QFile m_file;
+    qint64 m_size;
+    uchar* m_base;  // 整文件映射地址，为空表示按分片映射
+    QHash<qint64, Window> m_windows;
+    QMutex m_mutex;
+};
@@ -0,0 +1,198 @@
+#include "UploadJournal.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include <QDebug>
+
+namespace {
+const qint64 FINGERPRINT_BLOCK = 64 * 1024;
+}
+
+UploadJournal::UploadJournal(const QString& directory)
+    : m_directory(directory)
+    , m_chunkSize(0)
+{
+}
+
+UploadJournal::~UploadJournal()
+{
+    close();
+}
+
+QString UploadJournal::defaultDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/uploads";
+}
+
+QByteArray UploadJournal::contentFingerprint(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+
+    qint64 size = file.size();
+    QCryptographicHash hasher(QCryptographicHash::Md5);
+    hasher.addData(QByteArray::number(size));
+    hasher.addData(file.read(FINGERPRINT_BLOCK));
+
+    if (size > FINGERPRINT_BLOCK) {
+        file.seek(qMax(FINGERPRINT_BLOCK, size - FINGERPRINT_BLOCK));
+        hasher.addData(file.read(FINGERPRINT_BLOCK));
+    }
+
+    return hasher.result().toHex();
+}
+
+bool UploadJournal::open(const QString& filePath, qint64 chunkSize, const QString& uploadId)
+{
+    close();
+    m_confirmed.clear();
+    m_splits.clear();
+    m_uploadId = uploadId;
+    m_chunkSize = chunkSize;
+
+    QFileInfo info(filePath);
+    QByteArray fingerprint = contentFingerprint(filePath);
+    if (fingerprint.isEmpty()) {
+        return false;
+    }
+
+    QJsonObject header;
+    header["version"] = 1;
+    header["filePath"] = info.absoluteFilePath();
+    header["fileSize"] = info.size();
+    header["mtime"] = info.lastModified().toMSecsSinceEpoch();
+    header["fingerprint"] = QString::fromLatin1(fingerprint);
+
+    // 键：路径 + 大小 + 修改时间 + 内容指纹
+    // 分片大小不参与，自适应调整分片大小后仍能找到原来的日志
+    QByteArray keySource = info.absoluteFilePath().toUtf8() + '|'
+                         + QByteArray::number(info.size()) + '|'
+                         + QByteArray::number(info.lastModified().toMSecsSinceEpoch()) + '|'
+                         + fingerprint;
+    QString key = QString::fromLatin1(QCryptographicHash::hash(keySource, QCryptographicHash::Sha1).toHex());
+
+    QDir().mkpath(m_directory);
+    m_file.setFileName(m_directory + "/" + key + ".journal");
+
+    bool resumed = false;
+    QByteArray content;
+    if (m_file.exists() && m_file.open(QIODevice::ReadOnly)) {
+        content = m_file.readAll();
+        m_file.close();
+        resumed = load(content);
+    }
+
+    if (resumed) {
+        // 截掉崩溃时写了一半的行，避免与后续追加的记录粘连
+        m_file.resize(content.lastIndexOf('\n') + 1);
+
+        if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            qWarning() << "UploadJournal: 无法打开日志" << m_file.fileName();
+            return false;
+        }
+        qDebug() << "UploadJournal: 恢复上传" << m_uploadId << "已确认分片:" << m_confirmed.size();
+        return true;
+    }
+
+    m_confirmed.clear();
+    m_splits.clear();
+    m_uploadId = uploadId;
+    m_chunkSize = chunkSize;
+    header["uploadId"] = uploadId;
+    header["chunkSize"] = chunkSize;
+
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "UploadJournal: 无法创建日志" << m_file.fileName();
+        return false;
+    }
+    m_file.write(QJsonDocument(header).toJson(QJsonDocument::Compact) + '\n');
+    m_file.flush();
+
+    return false;
+}
+
+bool UploadJournal::load(const QByteArray& content)
+{
+    QList<QByteArray> lines = content.split('\n');
+    if (lines.size() < 2) {
+        return false;
+    }
+
+    QJsonObject header = QJsonDocument::fromJson(lines.first()).object();
+    QString uploadId = header["uploadId"].toString();
+    qint64 chunkSize = header["chunkSize"].toInteger();
+    if (uploadId.isEmpty() || chunkSize <= 0) {
+        return false;
+    }
+
+    // 最后一段要么为空，要么是崩溃时写了一半的行，一律丢弃
+    for (int i = 1; i < lines.size() - 1; ++i) {
+        if (lines[i].startsWith("split ")) {
+            QList<QByteArray> fields = lines[i].split(' ');
+            bool indexOk = false;
+            bool sizeOk = false;
+            Split split;
+            split.chunkIndex = fields.size() == 3 ? fields[1].toInt(&indexOk) : -1;
+            split.size = fields.size() == 3 ? fields[2].toLongLong(&sizeOk) : 0;
+            if (indexOk && sizeOk && split.chunkIndex >= 0 && split.size > 0) {
+                m_splits.append(split);
+            }
+            continue;
+        }
+
+        bool ok = false;
+        int index = lines[i].toInt(&ok);
+        if (ok && index >= 0) {
+            m_confirmed.insert(index);
+        }
+    }
+
+    m_uploadId = uploadId;
+    m_chunkSize = chunkSize;
+    return true;
+}
+
+void UploadJournal::close()
+{
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+}
+
+void UploadJournal::remove()
+{
+    close();
+    if (!m_file.fileName().isEmpty()) {
+        m_file.remove();
+    }
+    m_confirmed.clear();
+    m_splits.clear();
+}
+
+void UploadJournal::markConfirmed(int chunkIndex)
+{
+    if (!m_file.isOpen() || m_confirmed.contains(chunkIndex)) {
+        return;
+    }
+
+    m_confirmed.insert(chunkIndex);
+    m_file.write(QByteArray::number(chunkIndex) + '\n');
+    m_file.flush();
+}
+
+void UploadJournal::markSplit(int chunkIndex, qint64 size)
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    m_splits.append(Split{chunkIndex, size});
+    m_file.write("split " + QByteArray::number(chunkIndex) + ' ' + QByteArray::number(size) + '\n');
+    m_file.flush();
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QFile>
+#include <QSet>
+#include <QVector>
+#include <QString>
+#include <QByteArray>
+
+/**
+ * @brief 断点续传日志
+ *
+ * 每个上传文件对应一个日志文件，以 路径 + 大小 + 修改时间 + 内容指纹 为键，
+ * 记录服务端已确认的分片。客户端崩溃或重启后再次上传同一文件时，
+ * 可据此跳过已完成的分片，并沿用原来的上传会话 ID 和分片大小。
+ *
+ * 上传会话 ID 在创建日志时确定（通常是开始上传的上传任务 ID），之后无论由哪个
+ * 上传任务续传都沿用它：每次启动或提交都会生成新的任务 ID，不能用来找回会话。
+ * 上传完成后日志被删除，之后再提交同一文件会开始新的会话。
+ *
+ * 文件格式（追加写，逐行）：
+ *   第一行：JSON 头（文件信息、分片大小、上传会话 ID）
+ *   之后每行：一个已确认的分片序号，或 "split <序号> <大小>"（分片被拆分）
+ * 每次确认都会立即 flush，进程被杀死时最多丢失正在写的那一行，
+ * 未以换行结尾的残缺行在加载时会被忽略。
+ */
+class UploadJournal
+{
+public:
+    explicit UploadJournal(const QString& directory = defaultDirectory());
+    ~UploadJournal();
+
+    UploadJournal(const UploadJournal&) = delete;
+    UploadJournal& operator=(const UploadJournal&) = delete;
+
+    /**
+     * @brief 打开文件对应的日志
+     * @param filePath 上传文件路径
+     * @param chunkSize 新上传时使用的分片大小；恢复已有日志时以日志记录为准
+     * @param uploadId 新建日志时使用的上传会话 ID；恢复已有日志时以日志记录为准
+     * @return 是否恢复了已有日志
+     */
+    bool open(const QString& filePath, qint64 chunkSize, const QString& uploadId);
+
+    /**
+     * @brief 关闭日志（保留文件，供下次续传）
+     */
+    void close();
+
+    /**
+     * @brief 上传完成后删除日志
+     */
+    void remove();
+
+    /**
+     * @brief 记录分片已被服务端确认
+     */
+    void markConfirmed(int chunkIndex);
+
+    /**
+     * @brief 分片拆分记录：该分片缩小为 size 字节，其余部分按 size 切成新分片追加在末尾
+     */
+    struct Split {
+        int chunkIndex;
+        qint64 size;
+    };
+
+    /**
+     * @brief 记录尚未发送的分片被拆分（自适应调小分片时），续传时按顺序重放以恢复分片布局
+     */
+    void markSplit(int chunkIndex, qint64 size);
+
+    bool isOpen() const { return m_file.isOpen(); }
+    QString journalPath() const { return m_file.fileName(); }
+    QString uploadId() const { return m_uploadId; }
+    qint64 chunkSize() const { return m_chunkSize; }
+    QSet<int> confirmedChunks() const { return m_confirmed; }
+    QVector<Split> splits() const { return m_splits; }
+
+    /**
+     * @brief 默认日志目录（AppData/uploads）
+     */
+    static QString defaultDirectory();
+
+    /**
+     * @brief 内容指纹：文件首尾各 64KB 与文件大小的 MD5
+     *
+     * 防止文件被原地改写但大小和修改时间未变时误用旧日志。
+     */
+    static QByteArray contentFingerprint(const QString& filePath);
+
+private:
+    bool load(const QByteArray& content);
+
+    QString m_directory;
+    QFile m_file;
+    QString m_uploadId;
+    qint64 m_chunkSize;
+    QSet<int> m_confirmed;
+    QVector<Split> m_splits;
+};
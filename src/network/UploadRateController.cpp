@@ -0,0 +1,154 @@
+#include "UploadRateController.h"
+#include <QtMath>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+const qint64 MB = 1024 * 1024;
+const qint64 RATE_WINDOW_MS = 10000;  // 吞吐统计窗口
+const int BANDWIDTH_ROUNDS = 6;       // 瓶颈带宽取最近几轮的最大值
+}
+
+UploadRateController::UploadRateController(QObject *parent)
+    : QObject(parent)
+    , m_concurrency(3)
+    , m_chunkSize(5 * MB)
+    , m_roundSamples(0)
+    , m_roundFailed(false)
+    , m_lastRoundRate(0)
+    , m_bottleneckRate(0)
+    , m_minMsPerMB(0)
+    , m_roundMsPerMB(0.0)
+{
+    m_clock.start();
+}
+
+void UploadRateController::setLimits(const Limits& limits)
+{
+    m_limits = limits;
+    m_concurrency = qBound(m_limits.minConcurrency, m_concurrency, m_limits.maxConcurrency);
+    m_chunkSize = qBound(m_limits.minChunkSize, m_chunkSize, m_limits.maxChunkSize);
+}
+
+void UploadRateController::reset(int concurrency, qint64 chunkSize)
+{
+    m_concurrency = qBound(m_limits.minConcurrency, concurrency, m_limits.maxConcurrency);
+    m_chunkSize = qBound(m_limits.minChunkSize, chunkSize, m_limits.maxChunkSize);
+    m_samples.clear();
+    m_roundRates.clear();
+    m_roundSamples = 0;
+    m_roundFailed = false;
+    m_lastRoundRate = 0;
+    m_bottleneckRate = 0;
+    m_minMsPerMB = 0;
+    m_roundMsPerMB = 0.0;
+}
+
+void UploadRateController::addSample(qint64 bytes, qint64 elapsedMs, bool success)
+{
+    if (!success) {
+        // 失败或超时：立即乘性回退，不等本轮结束
+        int concurrency = qMax(m_limits.minConcurrency, m_concurrency / 2);
+        qint64 chunkSize = quantizeChunkSize(m_chunkSize / 2);
+
+        m_roundSamples = 0;
+        m_roundMsPerMB = 0.0;
+        m_roundFailed = true;
+
+        if (concurrency != m_concurrency || chunkSize != m_chunkSize) {
+            m_concurrency = concurrency;
+            m_chunkSize = chunkSize;
+            qDebug() << "UploadRateController: 上传失败，回退到并发" << m_concurrency
+                     << "分片" << (m_chunkSize / MB) << "MB";
+            emit decisionChanged(m_concurrency, m_chunkSize, m_bottleneckRate);
+        }
+        return;
+    }
+
+    if (bytes <= 0) {
+        return;
+    }
+
+    qint64 now = m_clock.elapsed();
+    m_samples.append(Sample{now, bytes, qMax<qint64>(elapsedMs, 1)});
+    while (!m_samples.isEmpty() && m_samples.first().timestamp < now - RATE_WINDOW_MS) {
+        m_samples.removeFirst();
+    }
+
+    // 单位耗时反映排队程度：并发过高时每个分片都会变慢
+    qint64 msPerMB = qMax<qint64>(elapsedMs, 1) * MB / bytes;
+    if (m_minMsPerMB == 0 || msPerMB < m_minMsPerMB) {
+        m_minMsPerMB = msPerMB;
+    }
+    m_roundMsPerMB += (msPerMB - m_roundMsPerMB) / (m_roundSamples + 1);
+    m_roundSamples++;
+
+    if (m_roundSamples >= m_concurrency) {
+        endRound();
+    }
+}
+
+qint64 UploadRateController::aggregateRate() const
+{
+    if (m_samples.isEmpty()) {
+        return 0;
+    }
+
+    // 窗口起点取最早一个分片的开始发送时间
+    qint64 start = m_samples.first().timestamp - m_samples.first().elapsedMs;
+    qint64 bytes = 0;
+    for (const Sample& sample : m_samples) {
+        start = qMin(start, sample.timestamp - sample.elapsedMs);
+        bytes += sample.bytes;
+    }
+
+    qint64 span = qMax<qint64>(m_samples.last().timestamp - start, 1);
+    return bytes * 1000 / span;
+}
+
+void UploadRateController::endRound()
+{
+    qint64 rate = aggregateRate();
+
+    m_roundRates.append(rate);
+    while (m_roundRates.size() > BANDWIDTH_ROUNDS) {
+        m_roundRates.removeFirst();
+    }
+    m_bottleneckRate = *std::max_element(m_roundRates.begin(), m_roundRates.end());
+
+    // 并发数：吞吐仍在增长则继续探测，吞吐下降且出现排队则回退
+    int concurrency = m_concurrency;
+    bool queueing = m_minMsPerMB > 0 && m_roundMsPerMB > 2.0 * m_minMsPerMB;
+    if (m_lastRoundRate == 0 || rate > m_lastRoundRate * 105 / 100) {
+        if (!m_roundFailed) {
+            concurrency++;
+        }
+    } else if (rate < m_lastRoundRate * 85 / 100 && queueing) {
+        concurrency = concurrency * 3 / 4;
+    }
+    concurrency = qBound(m_limits.minConcurrency, concurrency, m_limits.maxConcurrency);
+
+    // 分片大小：单连接分到的带宽 × 目标耗时，每轮最多变化一倍
+    qint64 perConnection = m_bottleneckRate / concurrency;
+    qint64 ideal = perConnection * m_limits.targetChunkMs / 1000;
+    ideal = qBound(m_chunkSize / 2, ideal, m_chunkSize * 2);
+    qint64 chunkSize = quantizeChunkSize(ideal);
+
+    m_lastRoundRate = rate;
+    m_roundSamples = 0;
+    m_roundMsPerMB = 0.0;
+    m_roundFailed = false;
+
+    m_concurrency = concurrency;
+    m_chunkSize = chunkSize;
+
+    emit decisionChanged(m_concurrency, m_chunkSize, m_bottleneckRate);
+}
+
+qint64 UploadRateController::quantizeChunkSize(qint64 size) const
+{
+    // 取最接近的 2 的整数次幂 MB
+    double megabytes = qMax(1.0, static_cast<double>(size) / MB);
+    qint64 quantized = (1LL << qRound(std::log2(megabytes))) * MB;
+    return qBound(m_limits.minChunkSize, quantized, m_limits.maxChunkSize);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QList>
+
+/**
+ * @brief 上传速率自适应控制器
+ *
+ * 根据每个分片的耗时和吞吐采样，动态调整并发数和分片大小：
+ * - 并发数：加性增、乘性减（AIMD）。每一轮（约等于当前并发数个分片）
+ *   若总吞吐仍在明显增长则并发 +1 继续探测；失败/超时或
+ *   吞吐下降且分片耗时明显变长（排队）时按比例回退。
+ * - 分片大小：参照 BBR 的带宽估计，取近期最大总吞吐作为瓶颈带宽，
+ *   使单连接上一个分片的耗时接近目标值（默认 4 秒），
+ *   慢链路用小分片避免超时，快链路用大分片减少请求开销。
+ *   分片大小取 2 的整数次幂 MB，以免频繁变化影响内容去重命中率。
+ */
+class UploadRateController : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Limits {
+        int minConcurrency = 1;
+        int maxConcurrency = 16;
+        qint64 minChunkSize = 1 * 1024 * 1024;
+        qint64 maxChunkSize = 64 * 1024 * 1024;
+        qint64 targetChunkMs = 4000;
+    };
+
+    explicit UploadRateController(QObject *parent = nullptr);
+
+    void setLimits(const Limits& limits);
+    Limits limits() const { return m_limits; }
+
+    /**
+     * @brief 重置到初始决策（新链路或用户修改设置时调用）
+     */
+    void reset(int concurrency, qint64 chunkSize);
+
+    /**
+     * @brief 记录一个分片的上传结果
+     * @param bytes 分片字节数
+     * @param elapsedMs 从开始发送到服务端确认的耗时
+     * @param success 是否成功（失败/超时触发乘性回退）
+     */
+    void addSample(qint64 bytes, qint64 elapsedMs, bool success);
+
+    int concurrency() const { return m_concurrency; }
+    qint64 chunkSize() const { return m_chunkSize; }
+
+    /**
+     * @brief 近期总吞吐估计（字节/秒）
+     */
+    qint64 throughput() const { return m_bottleneckRate; }
+
+signals:
+    /**
+     * @brief 决策变化
+     * @param concurrency 当前并发数
+     * @param chunkSize 新上传使用的分片大小
+     * @param bytesPerSecond 瓶颈带宽估计
+     */
+    void decisionChanged(int concurrency, qint64 chunkSize, qint64 bytesPerSecond);
+
+private:
+    struct Sample {
+        qint64 timestamp;   // 完成时间（毫秒）
+        qint64 bytes;
+        qint64 elapsedMs;
+    };
+
+    void endRound();
+    qint64 aggregateRate() const;
+    qint64 quantizeChunkSize(qint64 size) const;
+
+    Limits m_limits;
+    int m_concurrency;
+    qint64 m_chunkSize;
+
+    QElapsedTimer m_clock;
+    QList<Sample> m_samples;        // 近期成功采样（滑动窗口）
+    int m_roundSamples;             // 本轮已完成分片数
+    bool m_roundFailed;             // 本轮是否出现失败
+    qint64 m_lastRoundRate;         // 上一轮总吞吐
+    qint64 m_bottleneckRate;        // 近几轮的最大总吞吐
+    QList<qint64> m_roundRates;     // 近几轮总吞吐，用于求最大值
+    qint64 m_minMsPerMB;            // 观测到的最短单位耗时（毫秒/MB），衡量排队
+    double m_roundMsPerMB;          // 本轮平均单位耗时
+};
@@ -0,0 +1,336 @@
+#include "UploadScheduler.h"
+#include "FileUploader.h"
+#include "UploadRateController.h"
+#include <QFileInfo>
+#include <QDebug>
+
+UploadScheduler::UploadScheduler(QObject *parent)
+    : QObject(parent)
+    , m_maxActiveUploads(4)
+    , m_inFlight(0)
+    , m_virtualTime(0.0)
+    , m_sequence(0)
+{
+    // 所有上传器共享一个速率控制器，并发数即全局预算
+    m_rateController = new UploadRateController(this);
+    m_rateController->reset(3, 5 * 1024 * 1024);
+    connect(m_rateController, &UploadRateController::decisionChanged, this, [this](int concurrency, qint64 chunkSize, qint64 bytesPerSecond) {
+        emit tuningChanged(concurrency, chunkSize, bytesPerSecond);
+        dispatch();
+    });
+}
+
+UploadScheduler::~UploadScheduler()
+{
+}
+
+double UploadScheduler::weightOf(int priority)
+{
+    // Low : Normal : High : Urgent = 1 : 2 : 4 : 8
+    return static_cast<double>(1 << qBound(0, priority, 3));
+}
+
+void UploadScheduler::setMaxActiveUploads(int count)
+{
+    m_maxActiveUploads = qMax(1, count);
+    startQueuedJobs();
+}
+
+bool UploadScheduler::contains(const QString& jobId) const
+{
+    for (const Job& job : m_jobs) {
+        if (job.jobId == jobId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QString UploadScheduler::jobForFile(const QString& filePath) const
+{
+    QString canonicalPath = QFileInfo(filePath).canonicalFilePath();
+    if (canonicalPath.isEmpty()) {
+        return QString();
+    }
+
+    for (const Job& job : m_jobs) {
+        if (job.canonicalPath == canonicalPath) {
+            return job.jobId;
+        }
+    }
+    return QString();
+}
+
+UploadScheduler::Job* UploadScheduler::findJob(const QString& jobId)
+{
+    for (Job& job : m_jobs) {
+        if (job.jobId == jobId) {
+            return &job;
+        }
+    }
+    return nullptr;
+}
+
+UploadScheduler::Job* UploadScheduler::findJob(FileUploader* uploader)
+{
+    for (Job& job : m_jobs) {
+        if (job.uploader == uploader) {
+            return &job;
+        }
+    }
+    return nullptr;
+}
+
+void UploadScheduler::enqueue(const QString& jobId, const QString& filePath, int priority)
+{
+    if (contains(jobId)) {
+        qWarning() << "UploadScheduler: 任务已存在" << jobId;
+        return;
+    }
+
+    Job job;
+    job.jobId = jobId;
+    job.filePath = filePath;
+    job.canonicalPath = QFileInfo(filePath).canonicalFilePath();
+    job.priority = priority;
+    job.sequence = m_sequence++;
+    m_jobs.append(job);
+
+    qDebug() << "UploadScheduler: 添加上传任务" << jobId << "优先级" << priority;
+
+    startQueuedJobs();
+}
+
+FileUploader* UploadScheduler::takeIdleUploader()
+{
+    if (!m_idleUploaders.isEmpty()) {
+        return m_idleUploaders.takeFirst();
+    }
+
+    if (m_uploaders.size() >= m_maxActiveUploads) {
+        return nullptr;
+    }
+
+    // 按需创建上传器，信号只连接一次，通过上传器找到当前任务
+    FileUploader* uploader = new FileUploader(this);
+    uploader->setScheduler(this);
+    uploader->setRateController(m_rateController);
+
+    connect(uploader, &FileUploader::progressChanged, this, [this, uploader](int progress, qint64 uploadedBytes, qint64 totalBytes) {
+        if (Job* job = findJob(uploader)) {
+            emit jobProgress(job->jobId, progress, uploadedBytes, totalBytes);
+        }
+    });
+    connect(uploader, &FileUploader::speedChanged, this, [this, uploader](qint64 bytesPerSecond) {
+        if (Job* job = findJob(uploader)) {
+            emit jobSpeedChanged(job->jobId, bytesPerSecond);
+        }
+    });
+    connect(uploader, &FileUploader::uploadError, this, [this, uploader](const QString& error) {
+        if (Job* job = findJob(uploader)) {
+            emit jobError(job->jobId, error);
+        }
+    });
+    connect(uploader, &FileUploader::uploadFinished, this, [this, uploader](bool success) {
+        finishJob(uploader, success);
+    });
+
+    m_uploaders.append(uploader);
+    return uploader;
+}
+
+void UploadScheduler::startQueuedJobs()
+{
+    while (true) {
+        // 排队中优先级最高、最早入队的任务
+        int best = -1;
+        for (int i = 0; i < m_jobs.size(); ++i) {
+            const Job& job = m_jobs[i];
+            if (job.uploader) {
+                continue;
+            }
+            if (best < 0 || job.priority > m_jobs[best].priority
+                || (job.priority == m_jobs[best].priority && job.sequence < m_jobs[best].sequence)) {
+                best = i;
+            }
+        }
+
+        if (best < 0) {
+            return;
+        }
+
+        FileUploader* uploader = takeIdleUploader();
+        if (!uploader) {
+            return;
+        }
+
+        Job& job = m_jobs[best];
+        job.uploader = uploader;
+        job.pass = m_virtualTime;
+        QString jobId = job.jobId;
+        QString filePath = job.filePath;
+
+        qDebug() << "UploadScheduler: 开始上传" << jobId;
+        uploader->startUpload(filePath, jobId);
+
+        // 打开文件失败时 startUpload 只会发出 uploadError，异步结束该任务
+        if (!uploader->isUploading()) {
+            QMetaObject::invokeMethod(this, [this, uploader]() {
+                finishJob(uploader, false);
+            }, Qt::QueuedConnection);
+            return;
+        }
+    }
+}
+
+void UploadScheduler::requestSlot(FileUploader* uploader)
+{
+    Job* job = findJob(uploader);
+    if (!job) {
+        return;
+    }
+
+    if (!job->ready) {
+        job->ready = true;
+        // 空闲后重新就绪的任务不能凭积累的虚拟时间连续占用槽位
+        job->pass = qMax(job->pass, m_virtualTime);
+    }
+
+    dispatch();
+}
+
+void UploadScheduler::releaseSlot(FileUploader* uploader)
+{
+    Job* job = findJob(uploader);
+    if (job && job->inFlight > 0) {
+        job->inFlight--;
+        m_inFlight--;
+        dispatch();
+        return;
+    }
+
+    // 已结束任务的在途分片返回：全部返回后上传器才能交给下一个任务
+    auto draining = m_drainingUploaders.find(uploader);
+    if (draining == m_drainingUploaders.end()) {
+        return;
+    }
+
+    m_inFlight--;
+    if (--draining.value() == 0) {
+        m_drainingUploaders.erase(draining);
+        m_idleUploaders.append(uploader);
+        startQueuedJobs();
+    }
+    dispatch();
+}
+
+void UploadScheduler::dispatch()
+{
+    int budget = m_rateController->concurrency();
+
+    while (m_inFlight < budget) {
+        // 就绪任务中虚拟时间最小者；相同时优先级高者优先
+        Job* next = nullptr;
+        for (Job& job : m_jobs) {
+            if (!job.uploader || !job.ready) {
+                continue;
+            }
+            if (!next || job.pass < next->pass
+                || (job.pass == next->pass && job.priority > next->priority)) {
+                next = &job;
+            }
+        }
+
+        if (!next) {
+            return;
+        }
+
+        if (!next->uploader->sendNextChunk()) {
+            next->ready = false;
+            continue;
+        }
+
+        next->inFlight++;
+        m_inFlight++;
+        m_virtualTime = next->pass;
+        next->pass += 1.0 / weightOf(next->priority);
+    }
+}
+
+void UploadScheduler::finishJob(FileUploader* uploader, bool success)
+{
+    for (int i = 0; i < m_jobs.size(); ++i) {
+        if (m_jobs[i].uploader != uploader) {
+            continue;
+        }
+
+        Job job = m_jobs.takeAt(i);
+        if (job.inFlight > 0) {
+            // 失败或取消时仍有分片在途，槽位在请求返回（releaseSlot）时才归还
+            m_drainingUploaders.insert(uploader, job.inFlight);
+        } else {
+            m_idleUploaders.append(uploader);
+        }
+
+        qDebug() << "UploadScheduler: 上传任务结束" << job.jobId << (success ? "成功" : "失败");
+        if (success) {
+            emit jobUploaded(job.jobId, uploader->uploadId(), QString::fromLatin1(uploader->fileHash()));
+        }
+        emit jobFinished(job.jobId, success);
+
+        startQueuedJobs();
+        dispatch();
+        return;
+    }
+}
+
+void UploadScheduler::cancel(const QString& jobId)
+{
+    Job* job = findJob(jobId);
+    if (!job) {
+        return;
+    }
+
+    if (!job->uploader) {
+        // 还在排队，直接移除
+        for (int i = 0; i < m_jobs.size(); ++i) {
+            if (m_jobs[i].jobId == jobId) {
+                m_jobs.removeAt(i);
+                break;
+            }
+        }
+        emit jobFinished(jobId, false);
+        return;
+    }
+
+    // FileUploader::cancel 会发出 uploadFinished(false)，由 finishJob 回收
+    job->uploader->cancel();
+}
+
+void UploadScheduler::pause(const QString& jobId)
+{
+    Job* job = findJob(jobId);
+    if (job && job->uploader) {
+        job->uploader->pause();
+    }
+}
+
+void UploadScheduler::resume(const QString& jobId)
+{
+    Job* job = findJob(jobId);
+    if (job && job->uploader) {
+        job->uploader->resume();
+    }
+}
+
+void UploadScheduler::setPriority(const QString& jobId, int priority)
+{
+    Job* job = findJob(jobId);
+    if (!job) {
+        return;
+    }
+
+    job->priority = priority;
+    startQueuedJobs();
+    dispatch();
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QList>
+#include <QMap>
+#include <QHash>
+
+class FileUploader;
+class UploadRateController;
+
+/**
+ * @brief 多文件并行上传调度器
+ *
+ * 持有固定数量的 FileUploader，多个上传任务共享一个全局并发预算
+ * （由共享的 UploadRateController 根据链路状况决定）。
+ *
+ * 分片级调度采用带权公平排队（stride scheduling）：
+ * 每个任务按优先级获得权重，每发出一个分片，虚拟时间前进 1/权重，
+ * 空闲槽位总是分给虚拟时间最小的任务。因此 Urgent 任务的分片
+ * 会排在 Low 任务之前发出，但低优先级任务不会被完全饿死。
+ *
+ * 超出上传器数量的任务按优先级排队，等待有上传器空闲后开始。
+ *
+ * 任务失败或取消时可能还有分片请求在途：这些槽位在请求返回前仍计入全局预算，
+ * 上传器等在途分片全部返回后才交给下一个任务。
+ */
+class UploadScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit UploadScheduler(QObject *parent = nullptr);
+    ~UploadScheduler();
+
+    /**
+     * @brief 添加上传任务
+     * @param jobId 任务标识（调用方保证唯一）
+     * @param filePath 本地文件路径
+     * @param priority 优先级，取值同 TaskPriority（0 低 ~ 3 紧急）
+     */
+    void enqueue(const QString& jobId, const QString& filePath, int priority);
+
+    /**
+     * @brief 取消上传任务
+     */
+    void cancel(const QString& jobId);
+
+    /**
+     * @brief 暂停/继续上传任务
+     */
+    void pause(const QString& jobId);
+    void resume(const QString& jobId);
+
+    /**
+     * @brief 修改任务优先级
+     */
+    void setPriority(const QString& jobId, int priority);
+
+    /**
+     * @brief 设置同时进行的上传任务数（上传器数量），默认 4
+     */
+    void setMaxActiveUploads(int count);
+
+    /**
+     * @brief 是否有该上传任务（排队或进行中）
+     */
+    bool contains(const QString& jobId) const;
+
+    /**
+     * @brief 查找正在上传（或排队中）同一文件的任务
+     * @return 任务标识，没有时返回空
+     *
+     * 多个渲染任务共用同一素材时，调用方可直接等待已有任务，避免重复上传。
+     */
+    QString jobForFile(const QString& filePath) const;
+
+    /**
+     * @brief 全局速率控制器
+     */
+    UploadRateController* rateController() const { return m_rateController; }
+
+    // =============== 供 FileUploader 调用 ===============
+
+    /**
+     * @brief 上传器有待发送的分片，申请槽位
+     */
+    void requestSlot(FileUploader* uploader);
+
+    /**
+     * @brief 上传器的一个分片结束（成功、失败或上传已结束后才返回），归还槽位
+     */
+    void releaseSlot(FileUploader* uploader);
+
+signals:
+    void jobProgress(const QString& jobId, int progress, qint64 uploadedBytes, qint64 totalBytes);
+    void jobSpeedChanged(const QString& jobId, qint64 bytesPerSecond);
+    void jobFinished(const QString& jobId, bool success);
+
+    /**
+     * @brief 文件上传并合并成功（在 jobFinished 之前发出）
+     * @param uploadId 服务端上传会话 ID
+     * @param fileHash 文件内容哈希
+     */
+    void jobUploaded(const QString& jobId, const QString& uploadId, const QString& fileHash);
+    void jobError(const QString& jobId, const QString& error);
+
+    /**
+     * @brief 全局并发/分片大小决策变化
+     */
+    void tuningChanged(int concurrency, qint64 chunkSize, qint64 bytesPerSecond);
+
+private:
+    struct Job {
+        QString jobId;
+        QString filePath;
+        QString canonicalPath;
+        int priority = 1;
+        FileUploader* uploader = nullptr;  // 排队中为空
+        int inFlight = 0;                  // 占用的全局槽位
+        bool ready = false;                // 是否有待发送的分片
+        double pass = 0.0;                 // 虚拟时间
+        qint64 sequence = 0;               // 入队顺序，同优先级先进先出
+    };
+
+    static double weightOf(int priority);
+
+    Job* findJob(const QString& jobId);
+    Job* findJob(FileUploader* uploader);
+    FileUploader* takeIdleUploader();
+    void startQueuedJobs();
+    void dispatch();
+    void finishJob(FileUploader* uploader, bool success);
+
+    UploadRateController* m_rateController;
+    QList<FileUploader*> m_uploaders;
+    QList<FileUploader*> m_idleUploaders;
+    QHash<FileUploader*, int> m_drainingUploaders;  // 任务已结束、仍有分片在途的上传器 -> 在途数
+    QList<Job> m_jobs;          // 进行中与排队中的任务
+    int m_maxActiveUploads;
+    int m_inFlight;             // 全局在途分片数
+    double m_virtualTime;       // 最近一次分发时的虚拟时间
+    qint64 m_sequence;
+};
@@ -0,0 +1,175 @@
+#include "AssetResolver.h"
+#include <QDir>
+#include <QRegularExpression>
+#include <QSet>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrent>
+#include <algorithm>
+
+namespace {
+// Windows 文件系统不区分大小写
+#ifdef Q_OS_WIN
+const Qt::CaseSensitivity FILE_NAME_CASE = Qt::CaseInsensitive;
+#else
+const Qt::CaseSensitivity FILE_NAME_CASE = Qt::CaseSensitive;
+#endif
+
+bool fileNameLess(const QString& a, const QString& b)
+{
+    return QString::compare(a, b, FILE_NAME_CASE) < 0;
+}
+
+// <UDIM>、<udim>、# 序列、%04d / %d
+const QRegularExpression& tokenRegex()
+{
+    static const QRegularExpression re("<udim>|#+|%0?(\\d*)d", QRegularExpression::CaseInsensitiveOption);
+    return re;
+}
+
+QString normalizePath(const QString& reference, const QString& baseDirectory)
+{
+    QString path = reference;
+    path.replace('\\', '/');
+    if (QDir::isRelativePath(path)) {
+        path = baseDirectory + "/" + path;
+    }
+    return QDir::cleanPath(path);
+}
+
+// 所在目录；盘符根目录保留结尾的 "/"（"C:" 在 Windows 上表示当前目录）
+QString directoryOf(const QString& path)
+{
+    int slash = path.lastIndexOf('/');
+    if (slash <= 0 || path[slash - 1] == ':') {
+        return path.left(slash + 1);
+    }
+    return path.left(slash);
+}
+
+QString joinPath(const QString& directory, const QString& fileName)
+{
+    return directory.endsWith('/') ? directory + fileName : directory + "/" + fileName;
+}
+}
+
+AssetResolver::AssetResolver(int maxThreads)
+    : m_maxThreads(qMax(1, maxThreads))
+    , m_directoriesListed(0)
+{
+}
+
+void AssetResolver::clearCache()
+{
+    m_directories.clear();
+}
+
+bool AssetResolver::isPattern(const QString& fileName)
+{
+    return tokenRegex().match(fileName).hasMatch();
+}
+
+QString AssetResolver::patternToRegex(const QString& fileName)
+{
+    QString pattern;
+    int position = 0;
+    QRegularExpressionMatchIterator it = tokenRegex().globalMatch(fileName);
+    while (it.hasNext()) {
+        QRegularExpressionMatch match = it.next();
+        pattern += QRegularExpression::escape(fileName.mid(position, match.capturedStart() - position));
+
+        QString token = match.captured(0);
+        if (token.startsWith('<')) {
+            pattern += "\\d{4}";                                   // UDIM: 1001 ~ 1999
+        } else if (token.startsWith('#')) {
+            pattern += token.size() == 1 ? QString("\\d+") : QString("\\d{%1}").arg(token.size());
+        } else if (!match.captured(1).isEmpty() && token.startsWith("%0")) {
+            pattern += QString("\\d{%1}").arg(match.captured(1));  // %04d
+        } else {
+            pattern += "\\d+";                                     // %d
+        }
+        position = match.capturedEnd();
+    }
+    pattern += QRegularExpression::escape(fileName.mid(position));
+    return QRegularExpression::anchoredPattern(pattern);
+}
+
+void AssetResolver::listDirectories(const QStringList& directories)
+{
+    if (directories.isEmpty()) {
+        return;
+    }
+
+    // 每个目录一次列表请求，在网络共享上远比逐个 stat 快
+    QThreadPool pool;
+    pool.setMaxThreadCount(m_maxThreads);
+    QVector<QStringList> listings = QtConcurrent::blockingMapped<QVector<QStringList>>(&pool, directories,
+        [](const QString& directory) {
+            QStringList names = QDir(directory).entryList(QDir::Files | QDir::Hidden | QDir::System, QDir::Unsorted);
+            std::sort(names.begin(), names.end(), fileNameLess);
+            return names;
+        });
+
+    for (int i = 0; i < directories.size(); ++i) {
+        m_directories.insert(directories[i], listings[i]);
+    }
+    m_directoriesListed += directories.size();
+}
+
+QVector<AssetResolution> AssetResolver::resolve(const QStringList& references, const QString& baseDirectory)
+{
+    QVector<AssetResolution> results;
+    results.reserve(references.size());
+
+    // 按目录分组，只列出尚未缓存的目录
+    QStringList pending;
+    QSet<QString> pendingSet;
+    for (const QString& reference : references) {
+        AssetResolution resolution;
+        resolution.reference = reference;
+        resolution.path = normalizePath(reference, baseDirectory);
+        resolution.isPattern = false;
+        results.append(resolution);
+
+        QString directory = directoryOf(resolution.path);
+        if (!m_directories.contains(directory) && !pendingSet.contains(directory)) {
+            pendingSet.insert(directory);
+            pending.append(directory);
+        }
+    }
+    listDirectories(pending);
+
+    QHash<QString, QRegularExpression> patterns;
+    for (AssetResolution& resolution : results) {
+        QString directory = directoryOf(resolution.path);
+        QString fileName = resolution.path.mid(resolution.path.lastIndexOf('/') + 1);
+        const QStringList& names = m_directories[directory];
+
+        QRegularExpressionMatch token = tokenRegex().match(fileName);
+        resolution.isPattern = token.hasMatch();
+
+        if (!resolution.isPattern) {
+            if (std::binary_search(names.begin(), names.end(), fileName, fileNameLess)) {
+                resolution.files.append(resolution.path);
+            }
+            continue;
+        }
+
+        // 先用模式前的固定前缀在有序列表中定位，再逐个正则匹配
+        QString prefix = fileName.left(token.capturedStart());
+        if (!patterns.contains(fileName)) {
+            QRegularExpression::PatternOptions options = FILE_NAME_CASE == Qt::CaseInsensitive
+                ? QRegularExpression::CaseInsensitiveOption : QRegularExpression::NoPatternOption;
+            patterns.insert(fileName, QRegularExpression(patternToRegex(fileName), options));
+        }
+        const QRegularExpression& regex = patterns[fileName];
+
+        auto it = std::lower_bound(names.begin(), names.end(), prefix, fileNameLess);
+        for (; it != names.end() && it->startsWith(prefix, FILE_NAME_CASE); ++it) {
+            if (regex.match(*it).hasMatch()) {
+                resolution.files.append(joinPath(directory, *it));
+            }
+        }
+    }
+
+    return results;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief 素材路径解析结果
+ */
+struct AssetResolution {
+    QString reference;    // 场景中的原始路径
+    QString path;         // 规范化后的查找路径（相对路径已拼接场景目录）
+    QStringList files;    // 实际存在的文件；模式路径可能对应多个文件
+    bool isPattern;       // 文件名中是否含 <UDIM>、#、%04d 等模式
+
+    bool isMissing() const { return files.isEmpty(); }
+};
+
+/**
+ * @brief 批量素材存在性检查
+ *
+ * 逐个 QFile::exists 在网络共享（SMB/NFS）上每次都是一次往返，
+ * 两万个贴图引用需要数分钟。这里先按所在目录分组，每个目录只列一次
+ * （在有界线程池中并行进行），之后全部在内存中查找。
+ *
+ * 目录列表缓存在对象内，同一个 AssetResolver 多次解析时复用。
+ * 文件名中的 <UDIM>/<udim>、#（帧号）和 %04d 会展开为目录中实际匹配的文件。
+ */
+class AssetResolver
+{
+public:
+    /**
+     * @param maxThreads 并行列目录的线程数上限
+     */
+    explicit AssetResolver(int maxThreads = 8);
+
+    /**
+     * @brief 解析素材路径
+     * @param references 场景中的素材路径
+     * @param baseDirectory 相对路径的基准目录（通常是场景所在目录）
+     */
+    QVector<AssetResolution> resolve(const QStringList& references, const QString& baseDirectory);
+
+    /**
+     * @brief 清空目录缓存
+     */
+    void clearCache();
+
+    /**
+     * @brief 已列出的目录数量（统计用）
+     */
+    int directoriesListed() const { return m_directoriesListed; }
+
+    /**
+     * @brief 文件名是否含序列/UDIM 模式
+     */
+    static bool isPattern(const QString& fileName);
+
+    /**
+     * @brief 将模式文件名转换为正则表达式（整名匹配）
+     */
+    static QString patternToRegex(const QString& fileName);
+
+private:
+    void listDirectories(const QStringList& directories);
+
+    int m_maxThreads;
+    int m_directoriesListed;
+    QHash<QString, QStringList> m_directories;  // 目录 -> 已排序的文件名；不存在的目录为空列表
+};
@@ -0,0 +1,288 @@
+#include "FileCrawler.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QFuture>
+#include <QMutex>
+#include <QThread>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <QtConcurrent/QtConcurrent>
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace {
+// Windows 文件系统不区分大小写
+#ifdef Q_OS_WIN
+const Qt::CaseSensitivity FILE_NAME_CASE = Qt::CaseInsensitive;
+#else
+const Qt::CaseSensitivity FILE_NAME_CASE = Qt::CaseSensitive;
+#endif
+
+const int DEFAULT_MAX_DEPTH = 6;
+const int CANCEL_POLL_MS = 50;  // 空闲线程检查外部取消标志的间隔
+
+QString fileNameKey(const QString& name)
+{
+    return FILE_NAME_CASE == Qt::CaseInsensitive ? name.toLower() : name;
+}
+
+struct WorkItem {
+    QString path;
+    int depth;
+};
+
+/**
+ * 每个线程一个队列：自己从尾部取（深度优先，目录缓存更友好），
+ * 其他线程从头部窃取（靠近根的目录，通常包含更多待处理的子树）
+ */
+struct WorkQueue {
+    QMutex mutex;
+    std::deque<WorkItem> items;
+};
+}
+
+struct FileCrawler::CrawlState {
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::atomic<qint64> pending{0};       // 已入队但尚未处理完的目录数
+    std::atomic<bool> stop{false};
+    std::atomic<qint64> visited{0};
+
+    // 空闲线程在此等待新目录入队、全部处理完或停止
+    QMutex idleMutex;
+    QWaitCondition workAvailable;
+    std::atomic<int> idle{0};
+
+    QHash<QString, QString> wanted;       // 文件名键 -> 调用方给出的文件名
+    QMutex resultMutex;
+    QHash<QString, QStringList> results;
+
+    void push(int queue, const QString& path, int depth)
+    {
+        ++pending;
+        WorkQueue& q = *queues[queue];
+        {
+            QMutexLocker locker(&q.mutex);
+            q.items.push_back(WorkItem{path, depth});
+        }
+        if (idle > 0) {
+            QMutexLocker locker(&idleMutex);
+            workAvailable.wakeOne();
+        }
+    }
+
+    void wakeAll()
+    {
+        QMutexLocker locker(&idleMutex);
+        workAvailable.wakeAll();
+    }
+
+    /**
+     * 队列为空时等待新目录入队；所有目录都已处理完、需要停止或被取消时返回 false
+     */
+    bool waitForWork(int self, WorkItem* item, const FileCrawler& crawler)
+    {
+        // 先登记为空闲再检查队列：入队方看到空闲线程才唤醒，登记之后入队的目录不会漏掉
+        QMutexLocker locker(&idleMutex);
+        ++idle;
+
+        bool found = false;
+        while (!stop && !crawler.isCancelled()) {
+            if (pop(self, item) || steal(self, item)) {
+                found = true;
+                break;
+            }
+            // 所有队列为空且没有线程在处理目录时结束
+            if (pending == 0) {
+                break;
+            }
+            // 外部取消标志无法唤醒等待，定时醒来检查
+            workAvailable.wait(&idleMutex, CANCEL_POLL_MS);
+        }
+
+        --idle;
+        return found;
+    }
+
+    bool pop(int self, WorkItem* item)
+    {
+        WorkQueue& q = *queues[self];
+        QMutexLocker locker(&q.mutex);
+        if (q.items.empty()) {
+            return false;
+        }
+        *item = std::move(q.items.back());
+        q.items.pop_back();
+        return true;
+    }
+
+    bool steal(int self, WorkItem* item)
+    {
+        int count = static_cast<int>(queues.size());
+        for (int i = 1; i < count; ++i) {
+            WorkQueue& q = *queues[(self + i) % count];
+            QMutexLocker locker(&q.mutex);
+            if (!q.items.empty()) {
+                *item = std::move(q.items.front());
+                q.items.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+FileCrawler::FileCrawler(int maxThreads)
+    : m_maxThreads(maxThreads > 0 ? maxThreads : QThread::idealThreadCount())
+    , m_maxDepth(DEFAULT_MAX_DEPTH)
+    , m_cancelled(false)
+    , m_cancelFlag(nullptr)
+    , m_directoriesVisited(0)
+    , m_stoppedEarly(false)
+{
+    setSkipDirectories(defaultSkipDirectories());
+}
+
+QStringList FileCrawler::defaultSkipDirectories()
+{
+    // 体积大且不可能包含 Maya 或插件的目录
+    return QStringList()
+        << "$Recycle.Bin" << "System Volume Information" << "Recovery" << "Config.Msi"
+        << "Windows" << "WinSxS" << "Installer" << "Package Cache"
+        << "node_modules" << ".git" << ".svn" << "__pycache__"
+        << "Temp" << "tmp" << "Cache" << "Caches"
+        << "proc" << "sys" << "dev";
+}
+
+void FileCrawler::setSkipDirectories(const QStringList& names)
+{
+    m_skipDirectories.clear();
+    for (const QString& name : names) {
+        m_skipDirectories.insert(name.toLower());
+    }
+}
+
+QStringList FileCrawler::outermostRoots(const QStringList& roots)
+{
+    QStringList cleaned;
+    for (const QString& root : roots) {
+        cleaned.append(QDir::cleanPath(QDir::fromNativeSeparators(root)));
+    }
+    std::sort(cleaned.begin(), cleaned.end(), [](const QString& a, const QString& b) {
+        return QString::compare(a, b, FILE_NAME_CASE) < 0;
+    });
+
+    // 排序后父目录总在其子目录之前
+    QStringList result;
+    for (const QString& root : cleaned) {
+        if (!result.isEmpty()) {
+            const QString& last = result.last();
+            QString prefix = last.endsWith('/') ? last : last + "/";
+            if (root.compare(last, FILE_NAME_CASE) == 0 || root.startsWith(prefix, FILE_NAME_CASE)) {
+                continue;
+            }
+        }
+        result.append(root);
+    }
+    return result;
+}
+
+QHash<QString, QStringList> FileCrawler::find(const QStringList& roots, const QStringList& fileNames)
+{
+    m_directoriesVisited = 0;
+    m_stoppedEarly = false;
+    if (roots.isEmpty() || fileNames.isEmpty()) {
+        return QHash<QString, QStringList>();
+    }
+
+    int threads = qMax(1, m_maxThreads);
+    CrawlState state;
+    for (int i = 0; i < threads; ++i) {
+        state.queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (const QString& name : fileNames) {
+        state.wanted.insert(fileNameKey(name), name);
+    }
+
+    // 根目录轮流分配给各线程
+    QStringList outer = outermostRoots(roots);
+    int next = 0;
+    for (const QString& root : outer) {
+        if (QFileInfo(root).isDir()) {
+            state.push(next++ % threads, root, 0);
+        }
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    QList<QFuture<void>> workers;
+    for (int i = 0; i < threads; ++i) {
+        workers.append(QtConcurrent::run(&pool, [this, &state, i]() { runWorker(state, i); }));
+    }
+    for (QFuture<void>& worker : workers) {
+        worker.waitForFinished();
+    }
+
+    m_directoriesVisited = state.visited;
+    m_stoppedEarly = state.stop && !isCancelled();
+
+    for (QStringList& paths : state.results) {
+        std::sort(paths.begin(), paths.end());
+    }
+    return state.results;
+}
+
+void FileCrawler::runWorker(CrawlState& state, int self)
+{
+    WorkItem item;
+    while (!state.stop && !isCancelled()) {
+        if (!state.pop(self, &item) && !state.steal(self, &item) && !state.waitForWork(self, &item, *this)) {
+            break;
+        }
+
+        visit(state, self, item.path, item.depth);
+        if (--state.pending == 0) {
+            state.wakeAll();    // 全部处理完，让等待中的线程退出
+        }
+    }
+}
+
+void FileCrawler::visit(CrawlState& state, int self, const QString& directory, int depth)
+{
+    ++state.visited;
+
+    QDirIterator it(directory, QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System);
+    while (it.hasNext()) {
+        if (state.stop || isCancelled()) {
+            return;
+        }
+
+        it.next();
+        QFileInfo info = it.fileInfo();
+        QString name = info.fileName();
+
+        if (info.isDir()) {
+            if (depth < m_maxDepth && !info.isSymLink() && !info.isJunction()
+                && !m_skipDirectories.contains(name.toLower())) {
+                state.push(self, info.filePath(), depth + 1);
+            }
+            continue;
+        }
+
+        auto wanted = state.wanted.constFind(fileNameKey(name));
+        if (wanted == state.wanted.constEnd()) {
+            continue;
+        }
+
+        QMutexLocker locker(&state.resultMutex);
+        state.results[wanted.value()].append(info.filePath());
+        if (m_stopCondition && m_stopCondition(state.results)) {
+            state.stop = true;
+            locker.unlock();
+            state.wakeAll();
+            return;
+        }
+    }
+}
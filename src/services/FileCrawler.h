@@ -0,0 +1,102 @@
+#pragma once
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <functional>
+
+/**
+ * @brief 多线程文件搜索
+ *
+ * 一次遍历同时查找多个文件名，代替逐个文件名的递归 QDirIterator。
+ *
+ * - 每个线程有自己的目录队列，优先处理自己最近发现的子目录（深度优先），
+ *   空闲时从其他线程队列的另一端窃取目录，负载自动均衡
+ * - 限制相对搜索根目录的深度，跳过名单中的目录（系统目录、版本库、缓存等），
+ *   不进入符号链接和目录联接，避免环路
+ * - 可在找到足够的结果后提前结束
+ *
+ * 互相嵌套的搜索根目录只遍历外层一次。
+ */
+class FileCrawler
+{
+public:
+    /**
+     * @brief 提前结束条件：每找到一个文件后以当前全部结果调用（持有结果锁，应尽快返回）
+     */
+    typedef std::function<bool(const QHash<QString, QStringList>& results)> StopCondition;
+
+    /**
+     * @param maxThreads 最多使用的线程数，<= 0 时使用 CPU 核数
+     */
+    explicit FileCrawler(int maxThreads = 0);
+
+    /**
+     * @brief 最大搜索深度（根目录下的子目录层数），默认 6
+     */
+    void setMaxDepth(int depth) { m_maxDepth = depth; }
+    int maxDepth() const { return m_maxDepth; }
+
+    /**
+     * @brief 跳过的目录名（不区分大小写），默认为 defaultSkipDirectories()
+     */
+    void setSkipDirectories(const QStringList& names);
+
+    /**
+     * @brief 设置提前结束条件，条件满足后所有线程立即停止；为空时完整遍历
+     */
+    void setStopCondition(const StopCondition& condition) { m_stopCondition = condition; }
+
+    /**
+     * @brief 取消搜索（线程安全），已找到的结果仍然返回
+     */
+    void cancel() { m_cancelled = true; }
+    bool isCancelled() const { return m_cancelled || (m_cancelFlag && *m_cancelFlag); }
+
+    /**
+     * @brief 关联外部取消标志，标志为 true 时与 cancel() 效果相同（调用方保证其生命周期）
+     */
+    void setCancelFlag(const std::atomic<bool>* flag) { m_cancelFlag = flag; }
+
+    /**
+     * @brief 在若干根目录下查找文件
+     * @param roots 搜索根目录（不存在的会被忽略）
+     * @param fileNames 要查找的文件名（Windows 上不区分大小写）
+     * @return 文件名 -> 找到的完整路径（已排序）；未找到的文件名不在结果中
+     */
+    QHash<QString, QStringList> find(const QStringList& roots, const QStringList& fileNames);
+
+    /**
+     * @brief 上一次 find() 遍历的目录数（统计用）
+     */
+    qint64 directoriesVisited() const { return m_directoriesVisited; }
+
+    /**
+     * @brief 上一次 find() 是否因找齐结果提前结束
+     */
+    bool stoppedEarly() const { return m_stoppedEarly; }
+
+    /**
+     * @brief 去掉嵌套在其他根目录下的根目录
+     */
+    static QStringList outermostRoots(const QStringList& roots);
+
+    static QStringList defaultSkipDirectories();
+
+private:
+    struct CrawlState;
+
+    void runWorker(CrawlState& state, int self);
+    void visit(CrawlState& state, int self, const QString& directory, int depth);
+
+    int m_maxThreads;
+    int m_maxDepth;
+    QSet<QString> m_skipDirectories;   // 小写
+    StopCondition m_stopCondition;
+    std::atomic<bool> m_cancelled;
+    const std::atomic<bool>* m_cancelFlag;
+    qint64 m_directoriesVisited;
+    bool m_stoppedEarly;
+};
@@ -0,0 +1,314 @@
+#include "KeywordScanner.h"
+#include <QDebug>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define KEYWORD_SCANNER_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(KEYWORD_SCANNER_X86) && !defined(_MSC_VER)
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_AVX2
+#endif
+
+namespace {
+const int MAX_PREFIXES = 32;
+
+/**
+ * @brief 候选查找所需的前缀表（指向 KeywordScanner 的成员数据）
+ */
+struct PrefixTable {
+    const char* firsts;
+    const char* seconds;
+    int count;
+    const quint32* firstMask;
+    const quint32* secondMask;
+};
+
+typedef const char* (*CandidateFinder)(const PrefixTable& table, const char* p, const char* end);
+
+inline int countTrailingZeros(quint32 value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(value);
+#endif
+}
+
+// 返回第一个前两字节与任一前缀相同的位置，没有则返回 end
+const char* findCandidateScalar(const PrefixTable& table, const char* p, const char* end)
+{
+    for (; end - p >= 2; ++p) {
+        if (table.firstMask[static_cast<uchar>(p[0])] & table.secondMask[static_cast<uchar>(p[1])]) {
+            return p;
+        }
+    }
+    return end;
+}
+
+const char* findFirstOfScalar(const char* p, const char* end, char a, char b)
+{
+    for (; p < end; ++p) {
+        if (*p == a || *p == b) {
+            return p;
+        }
+    }
+    return end;
+}
+
+#ifdef KEYWORD_SCANNER_X86
+TARGET_SSE2 const char* findCandidateSse2(const PrefixTable& table, const char* p, const char* end)
+{
+    __m128i firsts[MAX_PREFIXES];
+    __m128i seconds[MAX_PREFIXES];
+    for (int i = 0; i < table.count; ++i) {
+        firsts[i] = _mm_set1_epi8(table.firsts[i]);
+        seconds[i] = _mm_set1_epi8(table.seconds[i]);
+    }
+
+    // 需要同时读取 p 和 p + 1 开始的 16 字节
+    while (end - p >= 17) {
+        __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1));
+        __m128i hits = _mm_setzero_si128();
+        for (int i = 0; i < table.count; ++i) {
+            hits = _mm_or_si128(hits, _mm_and_si128(_mm_cmpeq_epi8(current, firsts[i]),
+                                                    _mm_cmpeq_epi8(next, seconds[i])));
+        }
+        quint32 mask = static_cast<quint32>(_mm_movemask_epi8(hits));
+        if (mask) {
+            return p + countTrailingZeros(mask);
+        }
+        p += 16;
+    }
+    return findCandidateScalar(table, p, end);
+}
+
+TARGET_AVX2 const char* findCandidateAvx2(const PrefixTable& table, const char* p, const char* end)
+{
+    __m256i firsts[MAX_PREFIXES];
+    __m256i seconds[MAX_PREFIXES];
+    for (int i = 0; i < table.count; ++i) {
+        firsts[i] = _mm256_set1_epi8(table.firsts[i]);
+        seconds[i] = _mm256_set1_epi8(table.seconds[i]);
+    }
+
+    while (end - p >= 33) {
+        __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 1));
+        __m256i hits = _mm256_setzero_si256();
+        for (int i = 0; i < table.count; ++i) {
+            hits = _mm256_or_si256(hits, _mm256_and_si256(_mm256_cmpeq_epi8(current, firsts[i]),
+                                                          _mm256_cmpeq_epi8(next, seconds[i])));
+        }
+        quint32 mask = static_cast<quint32>(_mm256_movemask_epi8(hits));
+        if (mask) {
+            return p + countTrailingZeros(mask);
+        }
+        p += 32;
+    }
+    return findCandidateScalar(table, p, end);
+}
+
+TARGET_SSE2 const char* findFirstOfSse2(const char* p, const char* end, char a, char b)
+{
+    __m128i va = _mm_set1_epi8(a);
+    __m128i vb = _mm_set1_epi8(b);
+    while (end - p >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(block, va), _mm_cmpeq_epi8(block, vb));
+        quint32 mask = static_cast<quint32>(_mm_movemask_epi8(hits));
+        if (mask) {
+            return p + countTrailingZeros(mask);
+        }
+        p += 16;
+    }
+    return findFirstOfScalar(p, end, a, b);
+}
+
+TARGET_AVX2 const char* findFirstOfAvx2(const char* p, const char* end, char a, char b)
+{
+    __m256i va = _mm256_set1_epi8(a);
+    __m256i vb = _mm256_set1_epi8(b);
+    while (end - p >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(block, va), _mm256_cmpeq_epi8(block, vb));
+        quint32 mask = static_cast<quint32>(_mm256_movemask_epi8(hits));
+        if (mask) {
+            return p + countTrailingZeros(mask);
+        }
+        p += 32;
+    }
+    return findFirstOfSse2(p, end, a, b);
+}
+#endif
+
+CandidateFinder candidateFinder(KeywordScanner::InstructionSet isa)
+{
+#ifdef KEYWORD_SCANNER_X86
+    switch (isa) {
+    case KeywordScanner::Avx2: return findCandidateAvx2;
+    case KeywordScanner::Sse2: return findCandidateSse2;
+    default: break;
+    }
+#else
+    Q_UNUSED(isa);
+#endif
+    return findCandidateScalar;
+}
+}
+
+KeywordScanner::KeywordScanner(const QList<QByteArray>& keywords)
+    : m_firstMask(256, 0)
+    , m_secondMask(256, 0)
+    , m_isa(detectInstructionSet())
+{
+    for (const QByteArray& keyword : keywords) {
+        if (keyword.size() < 2) {
+            qWarning() << "KeywordScanner: 关键字过短，已忽略" << keyword;
+            continue;
+        }
+
+        // 相同前缀的关键字共用一个向量比较
+        int prefix = 0;
+        while (prefix < m_firsts.size()
+               && (m_firsts[prefix] != keyword[0] || m_seconds[prefix] != keyword[1])) {
+            ++prefix;
+        }
+        if (prefix == m_firsts.size()) {
+            if (prefix == MAX_PREFIXES) {
+                qWarning() << "KeywordScanner: 前缀数量超过上限，已忽略" << keyword;
+                continue;
+            }
+            m_firsts.append(keyword[0]);
+            m_seconds.append(keyword[1]);
+            m_prefixKeywords.append(QVector<int>());
+            m_firstMask[static_cast<uchar>(keyword[0])] |= 1u << prefix;
+            m_secondMask[static_cast<uchar>(keyword[1])] |= 1u << prefix;
+        }
+
+        m_prefixKeywords[prefix].append(m_keywords.size());
+        m_keywords.append(keyword);
+    }
+}
+
+KeywordScanner::InstructionSet KeywordScanner::detectInstructionSet()
+{
+#ifdef KEYWORD_SCANNER_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+    static const InstructionSet detected = []() {
+        int info[4];
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+        __cpuid(info, 1);
+        bool sse2 = (info[3] & (1 << 26)) != 0;
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        // 操作系统需保存 YMM 寄存器状态
+        bool ymmEnabled = osxsave && avx && (_xgetbv(0) & 0x6) == 0x6;
+        bool avx2 = false;
+        if (maxLeaf >= 7 && ymmEnabled) {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+        return avx2 ? Avx2 : (sse2 ? Sse2 : Scalar);
+    }();
+#else
+    static const InstructionSet detected = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return Avx2;
+        }
+        return __builtin_cpu_supports("sse2") ? Sse2 : Scalar;
+    }();
+#endif
+    return detected;
+#else
+    return Scalar;
+#endif
+}
+
+const char* KeywordScanner::instructionSetName(InstructionSet isa)
+{
+    switch (isa) {
+    case Avx2: return "AVX2";
+    case Sse2: return "SSE2";
+    default: return "Scalar";
+    }
+}
+
+void KeywordScanner::setInstructionSet(InstructionSet isa)
+{
+    m_isa = qMin(isa, detectInstructionSet());
+}
+
+const char* KeywordScanner::findFirstOf(const char* p, const char* end, char a, char b)
+{
+#ifdef KEYWORD_SCANNER_X86
+    static const InstructionSet isa = detectInstructionSet();
+    if (isa == Avx2) {
+        return findFirstOfAvx2(p, end, a, b);
+    }
+    if (isa == Sse2) {
+        return findFirstOfSse2(p, end, a, b);
+    }
+#endif
+    return findFirstOfScalar(p, end, a, b);
+}
+
+int KeywordScanner::matchAt(const char* p, const char* end) const
+{
+    quint32 prefixes = m_firstMask[static_cast<uchar>(p[0])] & m_secondMask[static_cast<uchar>(p[1])];
+    while (prefixes) {
+        int prefix = countTrailingZeros(prefixes);
+        prefixes &= prefixes - 1;
+
+        for (int keyword : m_prefixKeywords[prefix]) {
+            const QByteArray& text = m_keywords[keyword];
+            if (end - p >= text.size() && std::memcmp(p, text.constData(), text.size()) == 0) {
+                return keyword;
+            }
+        }
+    }
+    return -1;
+}
+
+qint64 KeywordScanner::findNext(const char* data, qint64 size, int* keyword) const
+{
+    if (m_firsts.isEmpty()) {
+        return -1;
+    }
+
+    PrefixTable table = {m_firsts.constData(), m_seconds.constData(), static_cast<int>(m_firsts.size()),
+                         m_firstMask.constData(), m_secondMask.constData()};
+    CandidateFinder find = candidateFinder(m_isa);
+
+    const char* end = data + size;
+    const char* p = data;
+    while (p < end) {
+        const char* candidate = find(table, p, end);
+        if (candidate >= end) {
+            break;
+        }
+
+        int matched = matchAt(candidate, end);
+        if (matched >= 0) {
+            if (keyword) {
+                *keyword = matched;
+            }
+            return candidate - data;
+        }
+        p = candidate + 1;
+    }
+    return -1;
+}
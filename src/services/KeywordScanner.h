@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QVector>
+
+/**
+ * @brief 多关键字扫描器
+ *
+ * 在内存缓冲区（通常是内存映射的场景文件）中查找任一关键字第一次出现的位置。
+ * 先用关键字的前两个字节做向量比较筛出候选位置，再用 memcmp 确认整个关键字。
+ * 运行时按 CPU 支持选择 AVX2 / SSE2 / 标量实现，三者结果完全一致。
+ *
+ * 最多支持 32 种不同的两字节前缀，关键字至少 2 个字节。
+ */
+class KeywordScanner
+{
+public:
+    enum InstructionSet {
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    explicit KeywordScanner(const QList<QByteArray>& keywords);
+
+    /**
+     * @brief 查找第一个关键字
+     * @param keyword 输出命中的关键字下标（可为 nullptr）
+     * @return 命中偏移，没有命中返回 -1
+     */
+    qint64 findNext(const char* data, qint64 size, int* keyword = nullptr) const;
+
+    /**
+     * @brief 指定实现（测试用），超出 CPU 支持时自动降级
+     */
+    void setInstructionSet(InstructionSet isa);
+    InstructionSet instructionSet() const { return m_isa; }
+
+    const QList<QByteArray>& keywords() const { return m_keywords; }
+
+    /**
+     * @brief 当前 CPU 支持的最佳实现
+     */
+    static InstructionSet detectInstructionSet();
+    static const char* instructionSetName(InstructionSet isa);
+
+    /**
+     * @brief 查找 [p, end) 中第一个等于 a 或 b 的字节，找不到返回 end
+     *
+     * 相当于一遍完成两次 memchr，供语句跳过等热点使用。
+     */
+    static const char* findFirstOf(const char* p, const char* end, char a, char b);
+
+private:
+    int matchAt(const char* p, const char* end) const;
+
+    QList<QByteArray> m_keywords;
+    QByteArray m_firsts;                      // 每种前缀的第一个字节
+    QByteArray m_seconds;                     // 每种前缀的第二个字节
+    QVector<QVector<int>> m_prefixKeywords;   // 每种前缀对应的关键字下标
+    QVector<quint32> m_firstMask;             // 字节 -> 以该字节开头的前缀位图
+    QVector<quint32> m_secondMask;            // 字节 -> 第二个字节为该字节的前缀位图
+    InstructionSet m_isa;
+};
@@ -2,6 +2,7 @@
 #include "../core/Application.h"
 #include "../core/Config.h"
 #include "../core/Logger.h"
+#include "../core/LogFormat.h"
 #include <QFile>
 #include <QFileInfo>
 #include <QDateTime>
@@ -9,14 +10,30 @@
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QMessageAuthenticationCode>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QTimer>
 #include <QUrl>
 #include <QDebug>
 
+namespace {
+// 每次追加的原始字节数（压缩前）
+const qint64 BLOCK_BYTES = 1024 * 1024;
+// 退避等待上限
+const qint64 MAX_RETRY_DELAY_MS = 60 * 1000;
+}
+
 LogUploader::LogUploader(QObject *parent)
     : QObject(parent)
     , m_networkManager(new QNetworkAccessManager(this))
     , m_uploadCount(0)
     , m_totalCount(0)
+    , m_targetSet(false)
+    , m_maxInFlight(2)
+    , m_maxAttempts(5)
+    , m_baseRetryDelayMs(1000)
 {
 }
 
@@ -48,7 +65,7 @@ QString LogUploader::generateOssSignature(
                          + ossHeaders
                          + resource;
 
-    QString secretKey = Application::instance().config()->ossSecretKey();
+    QString secretKey = m_target.secretKey;
 
     // 使用 HMAC-SHA1 签名
     QByteArray key = secretKey.toUtf8();
@@ -63,127 +80,355 @@ QString LogUploader::generateOssSignature(
     return hash.toBase64();
 }
 
-void LogUploader::uploadToOss(const QString& filePath, const QString& objectName)
+void LogUploader::setTarget(const OssTarget& target)
+{
+    m_target = target;
+    m_targetSet = true;
+}
+
+void LogUploader::setStateFile(const QString& stateFilePath)
+{
+    m_stateFilePath = stateFilePath;
+    loadState();
+}
+
+void LogUploader::setMaxInFlight(int count)
+{
+    m_maxInFlight = qMax(1, count);
+}
+
+void LogUploader::setRetryPolicy(int maxAttempts, int baseDelayMs)
+{
+    m_maxAttempts = qMax(1, maxAttempts);
+    m_baseRetryDelayMs = qMax(0, baseDelayMs);
+}
+
+qint64 LogUploader::uploadedOffset(const QString& logFilePath) const
+{
+    return m_states.value(stateKey(logFilePath)).offset;
+}
+
+QString LogUploader::objectName(const QString& logFilePath) const
+{
+    return m_states.value(stateKey(logFilePath)).objectName;
+}
+
+QString LogUploader::stateKey(const QString& filePath, bool* isArchive)
+{
+    // 归档文件名: <序号>_<原文件名>z
+    static const QRegularExpression archivePattern("^\\d+_(.+)z$");
+    QString fileName = QFileInfo(filePath).fileName();
+    QRegularExpressionMatch match = archivePattern.match(fileName);
+    if (isArchive) {
+        *isArchive = match.hasMatch();
+    }
+    return match.hasMatch() ? match.captured(1) : fileName;
+}
+
+QString LogUploader::newObjectName(const QString& key, bool replacing) const
+{
+    // 格式: logs/YYYY-MM-DD/<原文件名>z（内容是压缩块序列）
+    QDateTime now = QDateTime::currentDateTime();
+    QString name = replacing ? QString("%1_%2").arg(key, now.toString("HHmmsszzz")) : key;
+    return QString("logs/%1/%2z").arg(now.toString("yyyy-MM-dd"), name);
+}
+
+void LogUploader::loadState()
 {
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly)) {
-        qWarning() << "无法打开文件:" << filePath;
-        emit logUploadFailed(filePath, QString::fromUtf8("无法打开文件"));
+    m_states.clear();
+
+    QFile file(m_stateFilePath);
+    if (m_stateFilePath.isEmpty() || !file.open(QIODevice::ReadOnly)) {
+        return;
+    }
 
-        m_uploadCount++;
-        if (m_uploadCount >= m_totalCount) {
-            emit allLogsUploaded();
+    QJsonObject files = QJsonDocument::fromJson(file.readAll()).object()["files"].toObject();
+    for (auto it = files.constBegin(); it != files.constEnd(); ++it) {
+        QJsonObject entry = it.value().toObject();
+        FileState state;
+        state.objectName = entry["object"].toString();
+        state.offset = entry["offset"].toInteger();
+        state.position = entry["position"].toInteger();
+        if (!state.objectName.isEmpty()) {
+            m_states.insert(it.key(), state);
         }
+    }
+}
+
+void LogUploader::saveState()
+{
+    if (m_stateFilePath.isEmpty()) {
         return;
     }
 
-    QByteArray fileData = file.readAll();
-    file.close();
+    QJsonObject files;
+    for (auto it = m_states.constBegin(); it != m_states.constEnd(); ++it) {
+        QJsonObject entry;
+        entry["object"] = it.value().objectName;
+        entry["offset"] = it.value().offset;
+        entry["position"] = it.value().position;
+        files[it.key()] = entry;
+    }
+    QJsonObject root;
+    root["files"] = files;
 
-    // 获取 OSS 配置
-    QString accessKey = Application::instance().config()->ossAccessKey();
-    QString bucket = Application::instance().config()->ossBucket();
-    QString endpoint = Application::instance().config()->ossEndpoint();
+    QSaveFile file(m_stateFilePath);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+        file.commit();
+    }
+}
+
+void LogUploader::startPendingJobs()
+{
+    while (m_jobs.size() < m_maxInFlight && !m_queue.isEmpty()) {
+        QString filePath = m_queue.dequeue();
+        QString error = m_jobs.contains(filePath) ? QString::fromUtf8("正在上传") : startJob(filePath);
+        if (!error.isEmpty()) {
+            qWarning() << "日志上传失败:" << filePath << error;
+            emit logUploadFailed(filePath, error);
+            m_uploadCount++;
+            continue;
+        }
+
+        // 第一块放到下一次事件循环发送，没有新内容时也不会在这里递归完成
+        QTimer::singleShot(0, this, [this, filePath]() {
+            appendNextBlock(filePath);
+        });
+    }
 
-    if (accessKey.isEmpty() || bucket.isEmpty() || endpoint.isEmpty()) {
+    if (m_totalCount > 0 && m_uploadCount >= m_totalCount) {
+        m_uploadCount = 0;
+        m_totalCount = 0;
+        emit allLogsUploaded();
+    }
+}
+
+QString LogUploader::startJob(const QString& filePath)
+{
+    QFileInfo fileInfo(filePath);
+    if (!fileInfo.exists()) {
+        Application::instance().logger()->warning("LogUploader",
+            QString::fromUtf8("日志文件不存在: %1").arg(filePath));
+        return QString::fromUtf8("文件不存在");
+    }
+
+    // 获取 OSS 配置
+    if (!m_targetSet) {
+        Config* config = Application::instance().config();
+        m_target.accessKey = config->ossAccessKey();
+        m_target.secretKey = config->ossSecretKey();
+        m_target.bucket = config->ossBucket();
+        m_target.endpoint = config->ossEndpoint();
+    }
+    if (m_target.accessKey.isEmpty() || m_target.bucket.isEmpty() || m_target.endpoint.isEmpty()) {
         qWarning() << "OSS 配置不完整，accessKey/bucket/endpoint 为空";
-        emit logUploadFailed(filePath, QString::fromUtf8("OSS 配置不完整"));
+        return QString::fromUtf8("OSS 配置不完整");
+    }
 
-        m_uploadCount++;
-        if (m_uploadCount >= m_totalCount) {
-            emit allLogsUploaded();
+    Job job;
+    job.filePath = filePath;
+    job.key = stateKey(filePath, &job.isArchive);
+    if (job.isArchive) {
+        // 归档不会再变化，解压后按原文件的偏移继续
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return QString::fromUtf8("无法打开文件");
         }
-        return;
+        bool complete = false;
+        job.archiveData = LogFormat::decompressBlocks(file.readAll(), &complete);
+        if (!complete) {
+            return QString::fromUtf8("归档已损坏");
+        }
+        job.sourceSize = job.archiveData.size();
+    } else {
+        // 正在写入的文件只上传到开始时的大小，之后的内容下次再传
+        job.sourceSize = fileInfo.size();
     }
 
-    // 构造 OSS URL
-    // 格式: https://{bucket}.{endpoint}/{objectName}
-    QString ossUrl = QString("https://%1.%2/%3")
-                        .arg(bucket)
-                        .arg(endpoint)
-                        .arg(objectName);
+    FileState& state = m_states[job.key];
+    if (state.objectName.isEmpty()) {
+        state = FileState();
+        state.objectName = newObjectName(job.key, false);
+    } else if (state.offset > job.sourceSize) {
+        // 同名文件被替换（比已上传的部分还短）：换一个新对象从头上传
+        state = FileState();
+        state.objectName = newObjectName(job.key, true);
+    }
 
-    qDebug() << "准备上传到 OSS:" << ossUrl;
+    Application::instance().logger()->info("LogUploader",
+        QString::fromUtf8("开始上传日志: %1 -> %2，从 %3 / %4 字节继续")
+            .arg(fileInfo.fileName()).arg(state.objectName).arg(state.offset).arg(job.sourceSize));
 
-    // 生成日期（GMT 格式）
-    QString date = QDateTime::currentDateTimeUtc().toString("ddd, dd MMM yyyy HH:mm:ss 'GMT'");
+    m_jobs.insert(filePath, job);
+    return QString();
+}
+
+void LogUploader::appendNextBlock(const QString& filePath)
+{
+    if (!m_jobs.contains(filePath)) {
+        return;
+    }
+    Job& job = m_jobs[filePath];
+    const FileState& state = m_states[job.key];
 
-    // 内容类型
-    QString contentType = "text/plain";
+    if (state.offset >= job.sourceSize) {
+        finishJob(filePath, true);
+        return;
+    }
 
-    // 资源路径
-    QString resource = QString("/%1/%2").arg(bucket).arg(objectName);
+    // 只读取一块：内存占用与文件大小无关
+    QByteArray block;
+    qint64 blockSize = qMin(BLOCK_BYTES, job.sourceSize - state.offset);
+    if (job.isArchive) {
+        block = job.archiveData.mid(state.offset, blockSize);
+    } else {
+        QFile file(filePath);
+        if (file.open(QIODevice::ReadOnly) && file.seek(state.offset)) {
+            block = file.read(blockSize);
+        }
+    }
+    if (block.isEmpty()) {
+        finishJob(filePath, false, QString::fromUtf8("无法读取文件"));
+        return;
+    }
+    QByteArray body = LogFormat::compressBlock(block);
 
-    // 生成签名
-    QString signature = generateOssSignature("PUT", "", contentType, date, "", resource);
+    // 追加上传: POST /{objectName}?append&position={position}
+    // 带协议的 endpoint 使用路径形式: {endpoint}/{bucket}/{objectName}
+    QString baseUrl = m_target.endpoint.contains("://")
+        ? QString("%1/%2").arg(m_target.endpoint.endsWith('/') ? m_target.endpoint.chopped(1) : m_target.endpoint,
+                               m_target.bucket)
+        : QString("https://%1.%2").arg(m_target.bucket, m_target.endpoint);
+    QUrl url(QString("%1/%2").arg(baseUrl, state.objectName));
+    url.setQuery(QString("append&position=%1").arg(state.position));
 
-    // 构造 Authorization 头
-    QString authorization = QString("OSS %1:%2").arg(accessKey).arg(signature);
+    // 生成日期（GMT 格式）
+    QString date = QDateTime::currentDateTimeUtc().toString("ddd, dd MMM yyyy HH:mm:ss 'GMT'");
+    QString contentType = "application/octet-stream";
+
+    // 资源路径（包含 append 和 position 子资源）
+    QString resource = QString("/%1/%2?append&position=%3")
+        .arg(m_target.bucket, state.objectName).arg(state.position);
 
-    qDebug() << "OSS Authorization:" << authorization;
+    // 生成签名，构造 Authorization 头
+    QString signature = generateOssSignature("POST", "", contentType, date, "", resource);
+    QString authorization = QString("OSS %1:%2").arg(m_target.accessKey).arg(signature);
 
-    // 创建请求
-    QUrl url(ossUrl);
     QNetworkRequest networkRequest(url);
     networkRequest.setHeader(QNetworkRequest::ContentTypeHeader, contentType);
     networkRequest.setRawHeader("Date", date.toUtf8());
     networkRequest.setRawHeader("Authorization", authorization.toUtf8());
 
-    // 发送 PUT 请求
-    QNetworkReply* reply = m_networkManager->put(networkRequest, fileData);
-
-    // 连接完成信号
-    connect(reply, &QNetworkReply::finished, this, [this, reply, filePath, ossUrl]() {
-        if (reply->error() == QNetworkReply::NoError) {
-            qDebug() << "日志上传成功:" << filePath << "到" << ossUrl;
-            Application::instance().logger()->info("LogUploader",
-                QString::fromUtf8("日志上传成功: %1").arg(filePath));
-            emit logUploaded(filePath);
-        } else {
-            QString errorMsg = reply->errorString();
-            QByteArray responseData = reply->readAll();
-            qWarning() << "日志上传失败:" << filePath;
-            qWarning() << "错误:" << errorMsg;
-            qWarning() << "响应:" << responseData;
-
-            Application::instance().logger()->error("LogUploader",
-                QString::fromUtf8("日志上传失败: %1, 错误: %2, 响应: %3")
-                    .arg(filePath).arg(errorMsg).arg(QString::fromUtf8(responseData)));
-
-            emit logUploadFailed(filePath, errorMsg);
+    QNetworkReply* reply = m_networkManager->post(networkRequest, body);
+
+    qint64 position = state.position;
+    qint64 blockBytes = block.size();
+    qint64 bodyBytes = body.size();
+    connect(reply, &QNetworkReply::finished, this, [this, reply, filePath, position, blockBytes, bodyBytes]() {
+        int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        bool hasNext = false;
+        qint64 nextPosition = reply->rawHeader("x-oss-next-append-position").toLongLong(&hasNext);
+        QString error;
+        if (reply->error() != QNetworkReply::NoError) {
+            error = QString("%1 %2").arg(reply->errorString(), QString::fromUtf8(reply->readAll()));
         }
-
         reply->deleteLater();
 
-        m_uploadCount++;
-        if (m_uploadCount >= m_totalCount) {
-            emit allLogsUploaded();
-        }
+        onAppendFinished(filePath, httpStatus, position, hasNext ? nextPosition : -1,
+                         blockBytes, bodyBytes, error);
     });
 }
 
-void LogUploader::uploadLog(const QString& logFilePath)
+void LogUploader::onAppendFinished(const QString& filePath, int httpStatus, qint64 position, qint64 nextPosition,
+                                   qint64 blockBytes, qint64 bodyBytes, const QString& error)
 {
-    QFile logFile(logFilePath);
-    if (!logFile.exists()) {
-        Application::instance().logger()->warning("LogUploader",
-            QString::fromUtf8("日志文件不存在: %1").arg(logFilePath));
-        emit logUploadFailed(logFilePath, QString::fromUtf8("文件不存在"));
+    if (!m_jobs.contains(filePath)) {
         return;
     }
+    Job& job = m_jobs[filePath];
+    FileState& state = m_states[job.key];
 
-    QFileInfo fileInfo(logFilePath);
-    QString fileName = fileInfo.fileName();
+    bool appended = error.isEmpty() && httpStatus >= 200 && httpStatus < 300;
+    // 上一次追加其实已经成功、只是没收到响应：远端长度正好是追加这一块之后的长度
+    if (httpStatus == 409 && nextPosition == position + bodyBytes) {
+        appended = true;
+    }
 
-    // 生成 OSS 对象名称，格式: logs/YYYY-MM-DD/filename.log
-    QString dateFolder = QDateTime::currentDateTime().toString("yyyy-MM-dd");
-    QString objectName = QString("logs/%1/%2").arg(dateFolder).arg(fileName);
+    if (appended) {
+        state.offset += blockBytes;
+        state.position = nextPosition >= 0 ? nextPosition : position + bodyBytes;
+        job.attempts = 0;
+        saveState();
+        appendNextBlock(filePath);
+        return;
+    }
 
-    Application::instance().logger()->info("LogUploader",
-        QString::fromUtf8("开始上传日志: %1 -> %2").arg(fileName).arg(objectName));
+    if (httpStatus == 409) {
+        // 远端对象与记录的进度不一致（被删除、改写或不是追加对象）：换一个新对象从头上传
+        qWarning() << "日志对象位置不一致，改为上传到新对象:" << state.objectName
+                   << "本地" << position << "远端" << nextPosition;
+        state = FileState();
+        state.objectName = newObjectName(job.key, true);
+        saveState();
+    } else if (httpStatus >= 400 && httpStatus < 500 && httpStatus != 408 && httpStatus != 429) {
+        // 签名、权限等错误重试也不会成功
+        finishJob(filePath, false, error);
+        return;
+    }
+
+    retryOrFail(filePath, error.isEmpty() ? QString("HTTP %1").arg(httpStatus) : error);
+}
+
+void LogUploader::retryOrFail(const QString& filePath, const QString& error)
+{
+    Job& job = m_jobs[filePath];
+    job.attempts++;
+    if (job.attempts >= m_maxAttempts) {
+        finishJob(filePath, false, error);
+        return;
+    }
+
+    // 指数退避，期间仍占用一个上传名额
+    qint64 delay = qMin(static_cast<qint64>(m_baseRetryDelayMs) << (job.attempts - 1), MAX_RETRY_DELAY_MS);
+    qDebug() << "LogUploader:" << QFileInfo(filePath).fileName() << "上传失败，" << delay << "ms 后重试"
+             << job.attempts << "/" << m_maxAttempts << error;
 
-    // 上传到 OSS
-    uploadToOss(logFilePath, objectName);
+    QTimer::singleShot(static_cast<int>(delay), this, [this, filePath]() {
+        appendNextBlock(filePath);
+    });
+}
+
+void LogUploader::finishJob(const QString& filePath, bool success, const QString& error)
+{
+    Job job = m_jobs.take(filePath);
+
+    if (success) {
+        if (job.isArchive) {
+            // 原文件已关闭并全部上传，不再需要进度
+            m_states.remove(job.key);
+            saveState();
+        }
+        qDebug() << "日志上传成功:" << filePath;
+        Application::instance().logger()->info("LogUploader",
+            QString::fromUtf8("日志上传成功: %1").arg(filePath));
+        emit logUploaded(filePath);
+    } else {
+        qWarning() << "日志上传失败:" << filePath << "错误:" << error;
+        Application::instance().logger()->error("LogUploader",
+            QString::fromUtf8("日志上传失败: %1, 错误: %2").arg(filePath).arg(error));
+        emit logUploadFailed(filePath, error);
+    }
+
+    m_uploadCount++;
+    startPendingJobs();
+}
+
+void LogUploader::uploadLog(const QString& logFilePath)
+{
+    m_totalCount++;
+    m_queue.enqueue(logFilePath);
+    startPendingJobs();
 }
 
 void LogUploader::uploadAllLogs(const QStringList& logFilePaths)
@@ -194,17 +439,15 @@ void LogUploader::uploadAllLogs(const QStringList& logFilePaths)
         return;
     }
 
-    m_uploadCount = 0;
-    m_totalCount = logFilePaths.size();
-
     Application::instance().logger()->info("LogUploader",
-        QString::fromUtf8("开始上传 %1 个日志文件到 OSS").arg(m_totalCount));
+        QString::fromUtf8("开始上传 %1 个日志文件到 OSS").arg(logFilePaths.size()));
 
     qDebug() << "========== 开始上传日志到 OSS ==========";
-    qDebug() << "总共" << m_totalCount << "个文件";
+    qDebug() << "总共" << logFilePaths.size() << "个文件，同时上传" << m_maxInFlight << "个";
 
-    // 依次上传每个日志文件
+    m_totalCount += logFilePaths.size();
     for (const QString& logPath : logFilePaths) {
-        uploadLog(logPath);
+        m_queue.enqueue(logPath);
     }
+    startPendingJobs();
 }
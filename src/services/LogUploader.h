@@ -3,23 +3,64 @@
 #include <QObject>
 #include <QString>
 #include <QStringList>
+#include <QHash>
+#include <QQueue>
 #include <QNetworkAccessManager>
 
 /**
  * @brief 日志上传服务
  *
- * 负责将本地日志文件直接上传到阿里云 OSS
+ * 把本地日志增量上传到阿里云 OSS。每个原始日志文件对应一个追加对象
+ * （AppendObject，logs/<首次上传日期>/<文件名>z），按文件记录已上传的字节数，
+ * 每次只上传新增的尾部：尾部按块读取，每块压缩成 LogFormat 压缩块后追加，
+ * 远端对象就是原文件的压缩块序列，可以用 YuntuLogDecoder 直接解码。
+ *
+ * 压缩归档（<序号>_<原文件名>z）解压后接着原文件的进度继续上传，
+ * 上传过尾部的文件被归档后不会重复上传。进度保存在状态文件中，中断后从断点继续。
+ *
+ * 同时上传的文件数有上限（每个文件同一时刻只有一个请求）；
+ * 请求失败时按指数退避重试同一块，超过次数后放弃该文件，下次启动再续传。
  */
 class LogUploader : public QObject
 {
     Q_OBJECT
 
 public:
+    /**
+     * @brief OSS 目标
+     */
+    struct OssTarget {
+        QString accessKey;
+        QString secretKey;
+        QString bucket;
+        QString endpoint;   // 域名（https://{bucket}.{endpoint}），或带协议的完整地址（路径形式，用于代理）
+    };
+
     explicit LogUploader(QObject *parent = nullptr);
     ~LogUploader();
 
     /**
-     * @brief 上传指定的日志文件到 OSS
+     * @brief 设置 OSS 目标，未设置时使用 Config 中的 OSS 配置
+     */
+    void setTarget(const OssTarget& target);
+
+    /**
+     * @brief 设置上传进度状态文件并加载已有进度；未设置时进度只保存在内存中
+     */
+    void setStateFile(const QString& stateFilePath);
+
+    /**
+     * @brief 同时上传的文件数上限（默认 2）
+     */
+    void setMaxInFlight(int count);
+
+    /**
+     * @brief 重试策略：每块最多尝试 maxAttempts 次，第 n 次失败后等待 baseDelayMs * 2^(n-1)
+     */
+    void setRetryPolicy(int maxAttempts, int baseDelayMs);
+
+    /**
+     * @brief 上传指定的日志文件到 OSS（只上传新增部分）
      * @param logFilePath 日志文件路径
      */
     void uploadLog(const QString& logFilePath);
@@ -30,6 +71,16 @@ public:
      */
     void uploadAllLogs(const QStringList& logFilePaths);
 
+    /**
+     * @brief 日志文件已上传的字节数（归档按解压后的原文件计算）
+     */
+    qint64 uploadedOffset(const QString& logFilePath) const;
+
+    /**
+     * @brief 日志文件对应的 OSS 对象名，还没上传过时为空
+     */
+    QString objectName(const QString& logFilePath) const;
+
 signals:
     /**
      * @brief 单个日志上传成功
@@ -47,6 +98,27 @@ signals:
     void allLogsUploaded();
 
 private:
+    /**
+     * @brief 一个原始日志文件的上传进度
+     */
+    struct FileState {
+        QString objectName;
+        qint64 offset = 0;      // 已上传的原文件字节数
+        qint64 position = 0;    // 远端对象长度（下一次追加的位置）
+    };
+
+    /**
+     * @brief 正在上传的文件
+     */
+    struct Job {
+        QString filePath;
+        QString key;            // 原始日志文件名（进度状态的键）
+        bool isArchive = false;
+        QByteArray archiveData; // 归档解压后的内容
+        qint64 sourceSize = 0;  // 本次上传到的位置（开始时的文件大小）
+        int attempts = 0;       // 当前块已失败的次数
+    };
+
     /**
      * @brief 生成 OSS 签名
      * @param verb HTTP 方法 (PUT, GET等)
@@ -67,14 +139,60 @@ private:
     );
 
     /**
-     * @brief 上传文件到 OSS
-     * @param filePath 本地文件路径
-     * @param objectName OSS 对象名称
+     * @brief 在上限内开始队列中的文件
+     */
+    void startPendingJobs();
+
+    /**
+     * @brief 准备上传一个文件，返回错误信息（为空表示成功，已加入 m_jobs）
+     */
+    QString startJob(const QString& filePath);
+
+    /**
+     * @brief 读取下一块、压缩并追加到 OSS 对象
+     */
+    void appendNextBlock(const QString& filePath);
+
+    /**
+     * @brief 追加请求完成
+     * @param position 本次追加的位置
+     * @param nextPosition 服务端返回的下一次追加位置，没有返回时为 -1
+     * @param blockBytes 本块原始字节数
+     * @param bodyBytes 本块压缩后（请求体）字节数
+     */
+    void onAppendFinished(const QString& filePath, int httpStatus, qint64 position, qint64 nextPosition,
+                          qint64 blockBytes, qint64 bodyBytes, const QString& error);
+
+    /**
+     * @brief 当前块失败：退避后重试，超过次数时放弃该文件
+     */
+    void retryOrFail(const QString& filePath, const QString& error);
+
+    void finishJob(const QString& filePath, bool success, const QString& error = QString());
+
+    static QString stateKey(const QString& filePath, bool* isArchive = nullptr);
+
+    /**
+     * @brief 新的 OSS 对象名；replacing 为 true 时加上时间，避开已有的同名对象
      */
-    void uploadToOss(const QString& filePath, const QString& objectName);
+    QString newObjectName(const QString& key, bool replacing) const;
+
+    void loadState();
+    void saveState();
 
 private:
     QNetworkAccessManager* m_networkManager;
     int m_uploadCount;
     int m_totalCount;
+
+    OssTarget m_target;
+    bool m_targetSet;
+    QString m_stateFilePath;
+    int m_maxInFlight;
+    int m_maxAttempts;
+    int m_baseRetryDelayMs;
+
+    QHash<QString, FileState> m_states;     // 原始日志文件名 -> 上传进度
+    QQueue<QString> m_queue;                // 等待开始的文件
+    QHash<QString, Job> m_jobs;             // 正在上传的文件
 };
@@ -0,0 +1,446 @@
+#include "MayaAsciiParser.h"
+#include "KeywordScanner.h"
+#include <QFile>
+#include <QDebug>
+#include <cstring>
+
+namespace {
+const qint64 READ_BLOCK_SIZE = 16 * 1024 * 1024;  // 映射失败时分块读取的大小
+const int SETATTR_PROBE_TOKENS = 8;               // setAttr 在前几个 token 内没有 -type "string" 就跳过
+
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline const char* skipSpace(const char* p, const char* end)
+{
+    while (p < end && isSpace(*p)) {
+        ++p;
+    }
+    return p;
+}
+}
+
+bool MayaAsciiParser::Token::equals(const char* text) const
+{
+    int length = static_cast<int>(std::strlen(text));
+    return size == length && std::memcmp(data, text, length) == 0;
+}
+
+QString MayaAsciiParser::Token::toString() const
+{
+    if (!quoted || !std::memchr(data, '\\', size)) {
+        return QString::fromUtf8(data, size);
+    }
+
+    // 处理 MEL 字符串转义
+    QByteArray unescaped;
+    unescaped.reserve(size);
+    for (int i = 0; i < size; ++i) {
+        char c = data[i];
+        if (c == '\\' && i + 1 < size) {
+            char next = data[++i];
+            switch (next) {
+            case 'n': unescaped.append('\n'); break;
+            case 't': unescaped.append('\t'); break;
+            case 'r': unescaped.append('\r'); break;
+            default: unescaped.append(next); break;
+            }
+        } else {
+            unescaped.append(c);
+        }
+    }
+    return QString::fromUtf8(unescaped);
+}
+
+MayaAsciiParser::MayaAsciiParser()
+    : m_headerSeen(false)
+{
+}
+
+void MayaAsciiParser::reset()
+{
+    m_info = SceneInfo();
+    m_info.format = "mayaAscii";
+    m_tokens.clear();
+    m_nodeType.clear();
+    m_nodeName.clear();
+    m_references.clear();
+    m_headerSeen = false;
+}
+
+SceneInfo MayaAsciiParser::parseFile(const QString& filePath)
+{
+    reset();
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "MayaAsciiParser: 无法打开文件" << filePath;
+        return m_info;
+    }
+
+    qint64 size = file.size();
+    uchar* mapped = size > 0 ? file.map(0, size) : nullptr;
+    if (mapped) {
+        parseBuffer(reinterpret_cast<const char*>(mapped), size, true);
+        file.unmap(mapped);
+    } else {
+        // 映射失败（如 32 位进程地址空间不足）时分块读取，未结束的语句留到下一块
+        QByteArray buffer;
+        while (!file.atEnd()) {
+            buffer.append(file.read(READ_BLOCK_SIZE));
+            bool atEnd = file.atEnd();
+            qint64 consumed = parseBuffer(buffer.constData(), buffer.size(), atEnd);
+            buffer.remove(0, consumed);
+        }
+    }
+
+    m_info.bytesParsed = size;
+    return m_info;
+}
+
+SceneInfo MayaAsciiParser::parseData(const QByteArray& data)
+{
+    reset();
+    parseBuffer(data.constData(), data.size(), true);
+    m_info.bytesParsed = data.size();
+    return m_info;
+}
+
+MayaAsciiParser::Keyword MayaAsciiParser::classify(const char* word, qint64 size)
+{
+    switch (size) {
+    case 4:
+        if (std::memcmp(word, "file", 4) == 0) return File;
+        break;
+    case 6:
+        if (std::memcmp(word, "select", 6) == 0) return Select;
+        break;
+    case 7:
+        if (std::memcmp(word, "setAttr", 7) == 0) return SetAttr;
+        break;
+    case 8:
+        if (std::memcmp(word, "requires", 8) == 0) return Requires;
+        if (std::memcmp(word, "fileInfo", 8) == 0) return FileInfo;
+        break;
+    case 10:
+        if (std::memcmp(word, "createNode", 10) == 0) return CreateNode;
+        break;
+    default:
+        break;
+    }
+    return Other;
+}
+
+const char* MayaAsciiParser::skipString(const char* p, const char* end)
+{
+    // p 指向开引号之后，返回闭引号之后的位置；字符串未结束返回 nullptr
+    const char* start = p;
+    while (p < end) {
+        const char* quote = static_cast<const char*>(std::memchr(p, '"', end - p));
+        if (!quote) {
+            return nullptr;
+        }
+
+        // 前面有奇数个反斜杠则是转义的引号
+        int backslashes = 0;
+        for (const char* q = quote - 1; q >= start && *q == '\\'; --q) {
+            ++backslashes;
+        }
+        if (backslashes % 2 == 0) {
+            return quote + 1;
+        }
+        p = quote + 1;
+    }
+    return nullptr;
+}
+
+const char* MayaAsciiParser::skipStatement(const char* p, const char* end, bool* complete)
+{
+    // 一遍向量扫描同时查找分号和引号；遇到引号先跳过整个字符串
+    while (p < end) {
+        const char* hit = KeywordScanner::findFirstOf(p, end, ';', '"');
+        if (hit == end) {
+            break;
+        }
+        if (*hit == ';') {
+            *complete = true;
+            return hit + 1;
+        }
+
+        p = skipString(hit + 1, end);
+        if (!p) {
+            break;
+        }
+    }
+
+    *complete = false;
+    return end;
+}
+
+bool MayaAsciiParser::wantSetAttr() const
+{
+    for (int i = 0; i < m_tokens.size(); ++i) {
+        if (m_tokens[i].equals("-type")) {
+            return i + 1 >= m_tokens.size() || m_tokens[i + 1].equals("string");
+        }
+    }
+    return m_tokens.size() < SETATTR_PROBE_TOKENS;
+}
+
+const char* MayaAsciiParser::tokenizeStatement(Keyword keyword, const char* p, const char* end, bool* complete, bool* skipped)
+{
+    m_tokens.clear();
+    *skipped = false;
+
+    while (true) {
+        p = skipSpace(p, end);
+        if (p >= end) {
+            *complete = false;
+            return end;
+        }
+        if (*p == ';') {
+            *complete = true;
+            return p + 1;
+        }
+
+        Token token;
+        if (*p == '"') {
+            const char* close = skipString(p + 1, end);
+            if (!close) {
+                *complete = false;
+                return end;
+            }
+            token.data = p + 1;
+            token.size = static_cast<int>(close - 1 - token.data);
+            token.quoted = true;
+            p = close;
+        } else {
+            const char* q = p;
+            while (q < end && !isSpace(*q) && *q != ';' && *q != '"') {
+                ++q;
+            }
+            token.data = p;
+            token.size = static_cast<int>(q - p);
+            token.quoted = false;
+            p = q;
+        }
+        m_tokens.append(token);
+
+        // 非字符串 setAttr（顶点、矩阵等数值数据）不需要逐个 token 解析
+        if (keyword == SetAttr && !wantSetAttr()) {
+            *skipped = true;
+            return skipStatement(p, end, complete);
+        }
+    }
+}
+
+qint64 MayaAsciiParser::parseBuffer(const char* data, qint64 size, bool atEnd)
+{
+    const char* p = data;
+    const char* end = data + size;
+
+    while (true) {
+        p = skipSpace(p, end);
+        if (p >= end) {
+            return size;
+        }
+
+        const char* start = p;
+
+        // 注释（文件头的 //Maya ASCII 2024 scene 等）
+        if (end - p >= 2 && p[0] == '/' && p[1] == '/') {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (!eol && !atEnd) {
+                return start - data;
+            }
+            handleComment(p + 2, eol ? eol : end);
+            p = eol ? eol + 1 : end;
+            continue;
+        }
+
+        const char* wordEnd = p;
+        while (wordEnd < end && !isSpace(*wordEnd) && *wordEnd != ';' && *wordEnd != '"') {
+            ++wordEnd;
+        }
+        if (wordEnd == end && !atEnd) {
+            return start - data;
+        }
+
+        Keyword keyword = classify(p, wordEnd - p);
+        bool complete = false;
+        bool skipped = true;
+        if (keyword == Other) {
+            p = skipStatement(wordEnd, end, &complete);
+        } else {
+            p = tokenizeStatement(keyword, wordEnd, end, &complete, &skipped);
+        }
+
+        if (!complete && !atEnd) {
+            return start - data;
+        }
+        if (!skipped) {
+            handleStatement(keyword);
+        }
+    }
+}
+
+void MayaAsciiParser::handleComment(const char* begin, const char* end)
+{
+    if (m_headerSeen) {
+        return;
+    }
+    m_headerSeen = true;
+
+    // 第一行: //Maya ASCII 2024 scene
+    QString header = QString::fromUtf8(begin, end - begin).trimmed();
+    if (header.startsWith("Maya ASCII")) {
+        m_info.isValid = true;
+        if (m_info.mayaVersion.isEmpty()) {
+            m_info.mayaVersion = SceneInfo::majorVersion(header);
+        }
+    }
+}
+
+void MayaAsciiParser::handleStatement(Keyword keyword)
+{
+    switch (keyword) {
+    case Requires:   handleRequires(); break;
+    case FileInfo:   handleFileInfo(); break;
+    case File:       handleFile(); break;
+    case CreateNode: handleCreateNode(); break;
+    case Select:     handleSelect(); break;
+    case SetAttr:    handleSetAttr(); break;
+    default: break;
+    }
+}
+
+void MayaAsciiParser::handleRequires()
+{
+    // requires maya "2024";
+    // requires -nodeType "aiOptions" -dataType "aiCustomData" "mtoa" "5.3.0";
+    QStringList positional;
+    for (int i = 0; i < m_tokens.size(); ++i) {
+        const Token& token = m_tokens[i];
+        if (token.isFlag()) {
+            if (token.equals("-nodeType") || token.equals("-nt") || token.equals("-dataType") || token.equals("-dt")) {
+                ++i;
+            }
+            continue;
+        }
+        positional << token.toString();
+    }
+
+    if (positional.isEmpty()) {
+        return;
+    }
+
+    QString name = positional[0];
+    QString version = positional.value(1);
+    if (name == "maya") {
+        m_info.isValid = true;
+        m_info.mayaVersion = SceneInfo::majorVersion(version);
+        return;
+    }
+
+    m_info.addPlugin(name, version);
+}
+
+void MayaAsciiParser::handleFileInfo()
+{
+    // fileInfo "product" "Maya 2024";
+    if (m_tokens.size() >= 2) {
+        m_info.fileInfo.insert(m_tokens[0].toString(), m_tokens[1].toString());
+    }
+}
+
+void MayaAsciiParser::handleFile()
+{
+    // file -rdi 1 -ns "chr" -rfn "chrRN" -typ "mayaAscii" "D:/assets/chr.ma";
+    if (m_tokens.isEmpty() || !m_tokens[0].isFlag() || m_tokens[0].data[1] != 'r') {
+        return;
+    }
+
+    for (int i = m_tokens.size() - 1; i >= 0; --i) {
+        if (m_tokens[i].quoted) {
+            QString path = m_tokens[i].toString();
+            if (!path.isEmpty() && !m_references.contains(path)) {
+                m_references.insert(path);
+                m_info.references.append(path);
+            }
+            return;
+        }
+    }
+}
+
+void MayaAsciiParser::handleCreateNode()
+{
+    // createNode file -n "file1" -p "parent";
+    m_nodeType.clear();
+    m_nodeName.clear();
+
+    for (int i = 0; i < m_tokens.size(); ++i) {
+        const Token& token = m_tokens[i];
+        if (token.isFlag()) {
+            if ((token.equals("-n") || token.equals("-name")) && i + 1 < m_tokens.size()) {
+                m_nodeName = m_tokens[++i].toString();
+            } else if (token.equals("-p") || token.equals("-parent")) {
+                ++i;
+            }
+            continue;
+        }
+        if (m_nodeType.isEmpty()) {
+            m_nodeType = token.toString();
+        }
+    }
+}
+
+void MayaAsciiParser::handleSelect()
+{
+    // select -ne :defaultRenderGlobals;
+    m_nodeType.clear();
+    m_nodeName.clear();
+
+    for (int i = m_tokens.size() - 1; i >= 0; --i) {
+        if (!m_tokens[i].isFlag()) {
+            m_nodeName = m_tokens[i].toString();
+            return;
+        }
+    }
+}
+
+void MayaAsciiParser::handleSetAttr()
+{
+    // setAttr ".ftn" -type "string" "D:/textures/wood.jpg";
+    int attributeIndex = -1;
+    int typeIndex = -1;
+    for (int i = 0; i < m_tokens.size(); ++i) {
+        if (m_tokens[i].equals("-type")) {
+            typeIndex = i;
+            break;
+        }
+        if (attributeIndex < 0 && m_tokens[i].quoted) {
+            attributeIndex = i;
+        }
+    }
+
+    if (attributeIndex < 0 || typeIndex < 0 || typeIndex + 2 >= m_tokens.size()
+        || !m_tokens[typeIndex + 1].equals("string") || !m_tokens[typeIndex + 2].quoted) {
+        return;
+    }
+
+    QString attribute = m_tokens[attributeIndex].toString();
+    QString value = m_tokens[typeIndex + 2].toString();
+
+    // 当前渲染器
+    if ((attribute == ".ren" || attribute == ".currentRenderer")
+        && (m_nodeName.endsWith("defaultRenderGlobals") || m_nodeType == "renderGlobals")) {
+        m_info.currentRenderer = value;
+        return;
+    }
+
+    if (SceneInfo::isFileAttribute(attribute, value)) {
+        m_info.fileAttributes.append(SceneFileAttribute{m_nodeType, m_nodeName, attribute, value});
+    }
+}
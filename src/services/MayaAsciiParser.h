@@ -0,0 +1,89 @@
+#pragma once
+
+#include <QByteArray>
+#include <QSet>
+#include <QString>
+#include <QVector>
+#include "SceneInfo.h"
+
+/**
+ * @brief Maya ASCII (.ma) 场景解析器
+ *
+ * 单遍扫描整个文件（内存映射，映射失败时分块读取），按语句切分 token，
+ * 不把文件内容转换成 QString。只解析关心的语句：
+ * requires、fileInfo、file（引用）、createNode、select 和字符串类型的 setAttr；
+ * 其余语句（大量的数值 setAttr、connectAttr 等）只查找语句结尾直接跳过。
+ *
+ * 语句以分号结束，字符串内的分号和转义引号会被正确跳过。
+ */
+class MayaAsciiParser
+{
+public:
+    MayaAsciiParser();
+
+    /**
+     * @brief 解析场景文件
+     */
+    SceneInfo parseFile(const QString& filePath);
+
+    /**
+     * @brief 解析内存中的场景内容
+     */
+    SceneInfo parseData(const QByteArray& data);
+
+private:
+    enum Keyword {
+        Other,
+        Requires,
+        FileInfo,
+        File,
+        CreateNode,
+        Select,
+        SetAttr
+    };
+
+    /**
+     * @brief 指向缓冲区的 token，需要时才转换为 QString
+     */
+    struct Token {
+        const char* data;
+        int size;
+        bool quoted;
+
+        bool equals(const char* text) const;
+        bool isFlag() const { return !quoted && size > 1 && data[0] == '-'; }
+        QString toString() const;
+    };
+
+    void reset();
+
+    /**
+     * @brief 解析缓冲区中的完整语句
+     * @param atEnd 是否为文件末尾（末尾不完整的语句也会被处理）
+     * @return 已处理的字节数，剩余部分需与后续数据拼接后再解析
+     */
+    qint64 parseBuffer(const char* data, qint64 size, bool atEnd);
+
+    const char* tokenizeStatement(Keyword keyword, const char* p, const char* end, bool* complete, bool* skipped);
+    bool wantSetAttr() const;
+
+    void handleComment(const char* begin, const char* end);
+    void handleStatement(Keyword keyword);
+    void handleRequires();
+    void handleFileInfo();
+    void handleFile();
+    void handleCreateNode();
+    void handleSelect();
+    void handleSetAttr();
+
+    static Keyword classify(const char* word, qint64 size);
+    static const char* skipStatement(const char* p, const char* end, bool* complete);
+    static const char* skipString(const char* p, const char* end);
+
+    SceneInfo m_info;
+    QVector<Token> m_tokens;
+    QString m_nodeType;
+    QString m_nodeName;
+    QSet<QString> m_references;
+    bool m_headerSeen;
+};
@@ -0,0 +1,470 @@
+#include "MayaBatchRunner.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QProcess>
+#include <QPromise>
+#include <QThread>
+#include <QTimer>
+#include <QDebug>
+#include <deque>
+#include <memory>
+
+namespace {
+const int DEFAULT_START_TIMEOUT = 120000;      // Maya 冷启动通常 20~40 秒
+const int DEFAULT_QUERY_TIMEOUT = 60000;
+const int DEFAULT_IDLE_TIMEOUT = 10 * 60 * 1000;
+const int MAX_FRAME_SIZE = 64 * 1024 * 1024;
+
+const QByteArray REQUEST_TYPE = "YTQ";
+const QByteArray RESPONSE_TYPE = "YTR";
+
+/**
+ * 常驻进程中运行的 Python 脚本（兼容 Maya 自带的 Python 2 / 3）：
+ * 初始化 Maya 后发送 ready，然后循环读取请求帧，执行 MEL，
+ * 通过命令输出回调收集 print 的内容作为响应。
+ */
+const char BOOTSTRAP_SCRIPT[] = R"PY(
+import sys
+
+def _stream(s):
+    return getattr(s, 'buffer', s)
+
+_in = _stream(sys.stdin)
+_out = _stream(sys.__stdout__)
+
+def _send(qid, status, text):
+    data = text.encode('utf-8')
+    _out.write(('\nYTR %s %s %d\n' % (qid, status, len(data))).encode('ascii'))
+    _out.write(data)
+    _out.flush()
+
+try:
+    try:
+        import maya.cmds
+        maya.cmds.about(version=True)
+    except Exception:
+        import maya.standalone
+        maya.standalone.initialize(name='python')
+    import maya.mel
+    import maya.OpenMaya as om
+except Exception as e:
+    _send(0, 'error', str(e))
+    sys.exit(1)
+
+_captured = []
+
+def _capture(message, messageType, clientData):
+    _captured.append(message)
+
+_callback = om.MCommandMessage.addCommandOutputCallback(_capture)
+_send(0, 'ready', '')
+
+while True:
+    header = _in.readline()
+    if not header:
+        break
+    parts = header.decode('ascii', 'replace').split()
+    if len(parts) != 4 or parts[0] != 'YTQ':
+        continue
+    body = _in.read(int(parts[3])).decode('utf-8')
+    del _captured[:]
+    status = 'ok'
+    try:
+        maya.mel.eval(body)
+    except Exception as e:
+        status = 'error'
+        _captured.append(str(e))
+    _send(parts[1], status, ''.join(_captured))
+
+om.MMessage.removeCallback(_callback)
+)PY";
+}
+
+struct MayaBatchRunner::Query {
+    quint64 id;
+    QString melCommand;
+    std::shared_ptr<QPromise<MayaBatchResult>> promise;
+};
+
+struct MayaBatchRunner::Worker {
+    QString key;
+    QProcess* process;
+    QTimer* timer;          // 启动 / 查询超时
+    QTimer* idleTimer;
+    QByteArray buffer;
+    bool ready;
+    bool busy;
+    Query current;
+    std::deque<Query> queue;
+};
+
+namespace {
+void finishQuery(const std::shared_ptr<QPromise<MayaBatchResult>>& promise, bool success,
+                 const QString& output, const QString& error)
+{
+    MayaBatchResult result;
+    result.success = success;
+    result.output = output;
+    result.error = error;
+    promise->addResult(result);
+    promise->finish();
+}
+}
+
+namespace {
+std::atomic<bool> s_instanceCreated(false);
+}
+
+MayaBatchRunner& MayaBatchRunner::instance()
+{
+    static MayaBatchRunner instance;
+    return instance;
+}
+
+void MayaBatchRunner::shutdownIfStarted()
+{
+    if (s_instanceCreated) {
+        instance().shutdown();
+    }
+}
+
+MayaBatchRunner::MayaBatchRunner()
+    : m_thread(new QThread)
+    , m_shutdown(false)
+    , m_startTimeout(DEFAULT_START_TIMEOUT)
+    , m_queryTimeout(DEFAULT_QUERY_TIMEOUT)
+    , m_idleTimeout(DEFAULT_IDLE_TIMEOUT)
+    , m_runningWorkers(0)
+    , m_workersStarted(0)
+    , m_nextId(1)
+{
+    // 进程和定时器都在专用线程中管理，调用方线程无需事件循环
+    m_thread->setObjectName("MayaBatchRunner");
+    moveToThread(m_thread);
+    m_thread->start();
+    s_instanceCreated = true;
+}
+
+MayaBatchRunner::~MayaBatchRunner()
+{
+    shutdown();
+    delete m_thread;
+}
+
+QFuture<MayaBatchResult> MayaBatchRunner::execute(const QString& mayaExecutablePath, const QString& melCommand)
+{
+    Query query;
+    query.id = m_nextId++;
+    query.melCommand = melCommand;
+    query.promise = std::make_shared<QPromise<MayaBatchResult>>();
+    query.promise->start();
+    QFuture<MayaBatchResult> future = query.promise->future();
+
+    QMutexLocker locker(&m_mutex);
+    if (m_shutdown) {
+        finishQuery(query.promise, false, QString(), QString::fromUtf8("Maya 批处理已关闭"));
+        return future;
+    }
+    QString key = QDir::cleanPath(mayaExecutablePath);
+    QMetaObject::invokeMethod(this, [this, key, query]() { enqueue(key, query); }, Qt::QueuedConnection);
+    return future;
+}
+
+void MayaBatchRunner::setWorkerProgram(const QString& mayaExecutablePath, const QString& program,
+                                       const QStringList& arguments)
+{
+    QMutexLocker locker(&m_mutex);
+    m_programs.insert(QDir::cleanPath(mayaExecutablePath), qMakePair(program, arguments));
+}
+
+void MayaBatchRunner::shutdown()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_shutdown) {
+            return;
+        }
+        m_shutdown = true;
+    }
+
+    if (QThread::currentThread() == m_thread) {
+        stopAllWorkers();
+    } else {
+        QMetaObject::invokeMethod(this, [this]() { stopAllWorkers(); }, Qt::BlockingQueuedConnection);
+    }
+    m_thread->quit();
+    m_thread->wait();
+}
+
+QByteArray MayaBatchRunner::encodeFrame(const QByteArray& type, quint64 id, const QByteArray& status,
+                                        const QByteArray& payload)
+{
+    // 帧前的换行保证帧头从新的一行开始（之前可能有未换行的 Maya 输出）
+    return "\n" + type + " " + QByteArray::number(id) + " " + status + " "
+        + QByteArray::number(payload.size()) + "\n" + payload;
+}
+
+bool MayaBatchRunner::takeFrame(QByteArray* buffer, Frame* frame)
+{
+    int lineStart = 0;
+    while (true) {
+        int lineEnd = buffer->indexOf('\n', lineStart);
+        if (lineEnd < 0) {
+            buffer->remove(0, lineStart);
+            return false;
+        }
+
+        QList<QByteArray> parts = buffer->mid(lineStart, lineEnd - lineStart).trimmed().split(' ');
+        bool idOk = false;
+        bool sizeOk = false;
+        if (parts.size() == 4 && (parts[0] == REQUEST_TYPE || parts[0] == RESPONSE_TYPE)) {
+            quint64 id = parts[1].toULongLong(&idOk);
+            int size = parts[3].toInt(&sizeOk);
+            if (idOk && sizeOk && size >= 0 && size <= MAX_FRAME_SIZE) {
+                if (buffer->size() - (lineEnd + 1) < size) {
+                    // 帧内容尚未收全，从帧头开始保留
+                    buffer->remove(0, lineStart);
+                    return false;
+                }
+                frame->type = parts[0];
+                frame->id = id;
+                frame->status = parts[2];
+                frame->payload = buffer->mid(lineEnd + 1, size);
+                buffer->remove(0, lineEnd + 1 + size);
+                return true;
+            }
+        }
+
+        // 不是帧头的输出，丢弃
+        lineStart = lineEnd + 1;
+    }
+}
+
+QString MayaBatchRunner::bootstrapScriptPath()
+{
+    QByteArray script(BOOTSTRAP_SCRIPT);
+    QByteArray hash = QCryptographicHash::hash(script, QCryptographicHash::Sha1).toHex().left(8);
+    QString path = QDir::tempPath() + "/yuntu_maya_batch_" + QString::fromLatin1(hash) + ".py";
+    if (!QFile::exists(path)) {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly) || file.write(script) != script.size()) {
+            qWarning() << "MayaBatchRunner: 无法写入启动脚本" << path;
+            return QString();
+        }
+    }
+    return path;
+}
+
+QPair<QString, QStringList> MayaBatchRunner::workerCommand(const QString& mayaExecutablePath)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_programs.constFind(mayaExecutablePath);
+        if (it != m_programs.constEnd()) {
+            return it.value();
+        }
+    }
+
+    QString script = bootstrapScriptPath();
+    if (script.isEmpty()) {
+        return QPair<QString, QStringList>();
+    }
+
+    // 优先使用同目录下的 mayapy，启动更快且不加载界面相关模块
+    QFileInfo maya(mayaExecutablePath);
+    QString mayapy = maya.absolutePath() + "/mayapy" + (maya.suffix().isEmpty() ? QString() : "." + maya.suffix());
+    if (QFile::exists(mayapy)) {
+        return qMakePair(mayapy, QStringList() << script);
+    }
+
+    QString command = QString("python(\"exec(open(r'%1').read())\")").arg(script);
+    return qMakePair(mayaExecutablePath, QStringList() << "-batch" << "-noAutoloadPlugins" << "-command" << command);
+}
+
+void MayaBatchRunner::enqueue(const QString& key, const Query& query)
+{
+    Worker* worker = m_workers.value(key);
+    if (!worker) {
+        worker = startWorker(key);
+        if (!worker) {
+            finishQuery(query.promise, false, QString(), QString::fromUtf8("无法启动 Maya 进程: %1").arg(key));
+            return;
+        }
+    }
+    worker->queue.push_back(query);
+    pump(worker);
+}
+
+MayaBatchRunner::Worker* MayaBatchRunner::startWorker(const QString& key)
+{
+    QPair<QString, QStringList> command = workerCommand(key);
+    if (command.first.isEmpty()) {
+        return nullptr;
+    }
+
+    Worker* worker = new Worker;
+    worker->key = key;
+    worker->ready = false;
+    worker->busy = false;
+    worker->process = new QProcess(this);
+    worker->timer = new QTimer(worker->process);
+    worker->timer->setSingleShot(true);
+    worker->idleTimer = new QTimer(worker->process);
+    worker->idleTimer->setSingleShot(true);
+
+    connect(worker->process, &QProcess::readyReadStandardOutput, this, [this, worker]() { readOutput(worker); });
+    QProcess* process = worker->process;
+    connect(process, &QProcess::readyReadStandardError, process, [process]() {
+        // 错误输出只需读走，避免管道写满阻塞 Maya
+        process->readAllStandardError();
+    });
+    connect(worker->process, &QProcess::finished, this, [this, worker](int exitCode) {
+        qWarning() << "MayaBatchRunner: Maya 进程退出" << worker->key << "exitCode:" << exitCode;
+        // 启动阶段就退出时不再重试，避免反复启动失败的进程
+        stopWorker(worker, QString::fromUtf8("Maya 进程意外退出 (exitCode %1)").arg(exitCode), worker->ready);
+    });
+    connect(worker->process, &QProcess::errorOccurred, this, [this, worker](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            stopWorker(worker, QString::fromUtf8("Maya 进程启动失败: %1").arg(worker->process->errorString()), false);
+        }
+    });
+    connect(worker->timer, &QTimer::timeout, this, [this, worker]() { onTimeout(worker); });
+    connect(worker->idleTimer, &QTimer::timeout, this, [this, worker]() {
+        qDebug() << "MayaBatchRunner: 空闲退出" << worker->key;
+        stopWorker(worker, QString(), false);
+    });
+
+    m_workers.insert(key, worker);
+    ++m_runningWorkers;
+    ++m_workersStarted;
+
+    qDebug() << "MayaBatchRunner: 启动常驻进程" << command.first << command.second;
+    worker->timer->start(m_startTimeout);
+    worker->process->start(command.first, command.second);
+
+    // 启动失败可能在 start() 中同步报告，此时 worker 已被清理
+    if (m_workers.value(key) != worker) {
+        return nullptr;
+    }
+    return worker;
+}
+
+void MayaBatchRunner::readOutput(Worker* worker)
+{
+    worker->buffer += worker->process->readAllStandardOutput();
+
+    Frame frame;
+    while (m_workers.value(worker->key) == worker && takeFrame(&worker->buffer, &frame)) {
+        if (frame.type != RESPONSE_TYPE) {
+            continue;
+        }
+
+        if (frame.id == 0) {
+            if (frame.status == "ready") {
+                qDebug() << "MayaBatchRunner: Maya 已就绪" << worker->key;
+                worker->ready = true;
+                worker->timer->stop();
+                pump(worker);
+            } else {
+                stopWorker(worker, QString::fromUtf8("Maya 初始化失败: %1").arg(QString::fromUtf8(frame.payload)), false);
+                return;
+            }
+            continue;
+        }
+
+        if (worker->busy && frame.id == worker->current.id) {
+            worker->timer->stop();
+            worker->busy = false;
+            bool success = frame.status == "ok";
+            QString payload = QString::fromUtf8(frame.payload);
+            finishQuery(worker->current.promise, success, success ? payload : QString(), success ? QString() : payload);
+            worker->current = Query();
+            pump(worker);
+        }
+    }
+}
+
+void MayaBatchRunner::pump(Worker* worker)
+{
+    if (!worker->ready || worker->busy) {
+        return;
+    }
+
+    if (worker->queue.empty()) {
+        worker->idleTimer->start(m_idleTimeout);
+        return;
+    }
+
+    worker->idleTimer->stop();
+    worker->current = worker->queue.front();
+    worker->queue.pop_front();
+    worker->busy = true;
+
+    // maya.mel.eval 在全局作用域执行，顶层声明的变量（如 string $allPlugins[];）会一直留在
+    // 常驻进程中，下次同样的查询会接着往里追加；包在块中使它们成为本次查询的局部变量
+    QByteArray body = "{\n" + worker->current.melCommand.toUtf8() + "\n}";
+    worker->process->write(encodeFrame(REQUEST_TYPE, worker->current.id, "mel", body));
+    worker->timer->start(m_queryTimeout);
+}
+
+void MayaBatchRunner::onTimeout(Worker* worker)
+{
+    if (!worker->ready) {
+        stopWorker(worker, QString::fromUtf8("Maya 启动超时"), false);
+    } else {
+        // 卡住的查询：结束进程，排队的查询交给新进程
+        stopWorker(worker, QString::fromUtf8("MEL 命令执行超时"), true);
+    }
+}
+
+void MayaBatchRunner::stopWorker(Worker* worker, const QString& error, bool requeue)
+{
+    if (m_workers.value(worker->key) != worker) {
+        return;
+    }
+    m_workers.remove(worker->key);
+    --m_runningWorkers;
+
+    worker->timer->stop();
+    worker->idleTimer->stop();
+    worker->process->disconnect(this);
+    worker->timer->disconnect(this);
+    worker->idleTimer->disconnect(this);
+
+    // 正常退出时先关闭输入让脚本自行结束
+    if (worker->process->state() != QProcess::NotRunning) {
+        worker->process->closeWriteChannel();
+        if (!error.isEmpty() || !worker->process->waitForFinished(3000)) {
+            worker->process->kill();
+            worker->process->waitForFinished(3000);
+        }
+    }
+    worker->process->deleteLater();
+
+    if (worker->busy) {
+        finishQuery(worker->current.promise, false, QString(), error);
+    }
+
+    std::deque<Query> pending;
+    pending.swap(worker->queue);
+    QString key = worker->key;
+    delete worker;
+
+    for (const Query& query : pending) {
+        if (requeue) {
+            enqueue(key, query);
+        } else {
+            finishQuery(query.promise, false, QString(), error.isEmpty() ? QString::fromUtf8("Maya 进程已停止") : error);
+        }
+    }
+}
+
+void MayaBatchRunner::stopAllWorkers()
+{
+    const QList<Worker*> workers = m_workers.values();
+    for (Worker* worker : workers) {
+        stopWorker(worker, QString::fromUtf8("Maya 批处理已关闭"), false);
+    }
+}
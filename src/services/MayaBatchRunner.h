@@ -0,0 +1,147 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFuture>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+
+class QThread;
+
+/**
+ * @brief Maya 批处理查询结果
+ */
+struct MayaBatchResult {
+    bool success;
+    QString output;     // MEL print 的输出
+    QString error;      // 失败原因
+
+    MayaBatchResult()
+        : success(false) {}
+};
+
+/**
+ * @brief 常驻 Maya 批处理进程池
+ *
+ * 每次 `maya -batch -command` 都要冷启动 Maya（20~40 秒）。这里为每个 Maya 版本
+ * 启动一个常驻的 mayapy 进程（没有 mayapy 时使用 maya -batch），通过标准输入输出
+ * 发送 MEL 命令，结果以 QFuture 异步返回；同一版本的查询排队依次执行。
+ *
+ * 帧格式（两个方向相同）：
+ *   "\n" + "<类型> <id> <状态> <长度>\n" + <长度字节的 UTF-8 内容>
+ * 请求类型为 YTQ、状态为 mel，内容为包在 { } 块中的 MEL；
+ * 响应类型为 YTR、状态为 ok / error / ready（id 0 表示启动完成）。
+ * 帧头之外的输出（Maya 启动日志等）会被忽略。
+ *
+ * 进程崩溃或查询超时时当前查询失败，进程被结束，排队中的查询由新进程继续执行；
+ * 空闲超过一定时间的进程自动退出。所有进程在独立线程中管理，可从任意线程调用。
+ */
+class MayaBatchRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 协议帧
+     */
+    struct Frame {
+        QByteArray type;
+        quint64 id;
+        QByteArray status;
+        QByteArray payload;
+    };
+
+    static MayaBatchRunner& instance();
+
+    /**
+     * @brief 执行 MEL 命令（线程安全）
+     * @param mayaExecutablePath maya 可执行文件路径，同一路径共用一个常驻进程
+     * @param melCommand MEL 命令
+     *
+     * 命令包在 { } 块中执行，其中声明的变量是局部变量，不会作为全局变量
+     * 残留到同一进程之后的查询；因此命令中不能定义 proc。
+     */
+    QFuture<MayaBatchResult> execute(const QString& mayaExecutablePath, const QString& melCommand);
+
+    /**
+     * @brief 为指定 Maya 替换常驻进程的启动命令（测试用的模拟 Maya 等）
+     */
+    void setWorkerProgram(const QString& mayaExecutablePath, const QString& program, const QStringList& arguments);
+
+    /**
+     * @brief 超时设置（毫秒）：启动、单个查询、空闲退出
+     */
+    void setStartTimeout(int ms) { m_startTimeout = ms; }
+    void setQueryTimeout(int ms) { m_queryTimeout = ms; }
+    void setIdleTimeout(int ms) { m_idleTimeout = ms; }
+
+    /**
+     * @brief 当前运行的进程数
+     */
+    int runningWorkers() const { return m_runningWorkers; }
+
+    /**
+     * @brief 累计启动的进程数（统计用）
+     */
+    int workersStarted() const { return m_workersStarted; }
+
+    /**
+     * @brief 结束所有进程并停止管理线程，未完成的查询返回失败
+     */
+    void shutdown();
+
+    /**
+     * @brief 程序退出时调用：已创建实例时执行 shutdown()，否则什么也不做
+     */
+    static void shutdownIfStarted();
+
+    /**
+     * @brief 编码一帧
+     */
+    static QByteArray encodeFrame(const QByteArray& type, quint64 id, const QByteArray& status, const QByteArray& payload);
+
+    /**
+     * @brief 从缓冲区取出一个完整帧，跳过帧头之外的输出
+     * @return 缓冲区中没有完整帧时返回 false，未处理的数据保留在缓冲区
+     */
+    static bool takeFrame(QByteArray* buffer, Frame* frame);
+
+private:
+    struct Query;
+    struct Worker;
+
+    MayaBatchRunner();
+    ~MayaBatchRunner();
+    MayaBatchRunner(const MayaBatchRunner&) = delete;
+    MayaBatchRunner& operator=(const MayaBatchRunner&) = delete;
+
+    // 以下均在管理线程中执行
+    void enqueue(const QString& key, const Query& query);
+    Worker* startWorker(const QString& key);
+    void readOutput(Worker* worker);
+    void pump(Worker* worker);
+    void onTimeout(Worker* worker);
+    void stopWorker(Worker* worker, const QString& error, bool requeue);
+    void stopAllWorkers();
+
+    QPair<QString, QStringList> workerCommand(const QString& mayaExecutablePath);
+    static QString bootstrapScriptPath();
+
+    QThread* m_thread;
+    QHash<QString, Worker*> m_workers;      // maya 可执行文件路径 -> 常驻进程
+
+    QMutex m_mutex;                          // 保护 m_programs、m_shutdown
+    QHash<QString, QPair<QString, QStringList>> m_programs;
+    bool m_shutdown;
+
+    std::atomic<int> m_startTimeout;
+    std::atomic<int> m_queryTimeout;
+    std::atomic<int> m_idleTimeout;
+    std::atomic<int> m_runningWorkers;
+    std::atomic<int> m_workersStarted;
+    std::atomic<quint64> m_nextId;
+};
@@ -0,0 +1,237 @@
+#include "MayaBinaryParser.h"
+#include <QHash>
+#include <QtEndian>
+#include <QDebug>
+
+namespace {
+const int MAX_GROUP_DEPTH = 64;                      // 防止损坏文件导致过深递归
+const qint64 MAX_INTERESTING_CHUNK = 16 * 1024 * 1024;  // 超过此大小的字符串块视为异常，跳过
+}
+
+MayaBinaryParser::MayaBinaryParser()
+    : m_is64(false)
+{
+}
+
+bool MayaBinaryParser::isGroupTag(const QByteArray& tag)
+{
+    return tag == "FOR4" || tag == "FOR8" || tag == "LIS4" || tag == "LIS8"
+        || tag == "CAT4" || tag == "CAT8" || tag == "PRO4" || tag == "PRO8";
+}
+
+bool MayaBinaryParser::isInterestingTag(const QByteArray& tag)
+{
+    return tag == "VERS" || tag == "PLUG" || tag == "FINF" || tag == "FREF"
+        || tag == "CREA" || tag == "SLCT" || tag == "STR ";
+}
+
+QList<QByteArray> MayaBinaryParser::splitStrings(const QByteArray& data, int offset)
+{
+    // 以 '\0' 结尾的字符串序列
+    QList<QByteArray> strings;
+    int start = offset;
+    while (start < data.size()) {
+        int end = data.indexOf('\0', start);
+        if (end < 0) {
+            end = data.size();
+        }
+        strings.append(data.mid(start, end - start));
+        start = end + 1;
+    }
+    return strings;
+}
+
+qint64 MayaBinaryParser::align(qint64 offset) const
+{
+    qint64 alignment = m_is64 ? 8 : 4;
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+bool MayaBinaryParser::readHeader(ChunkHeader* header)
+{
+    int headerSize = m_is64 ? 16 : 8;
+    QByteArray raw = m_file.read(headerSize);
+    if (raw.size() != headerSize) {
+        return false;
+    }
+
+    const uchar* bytes = reinterpret_cast<const uchar*>(raw.constData());
+    header->tag = raw.left(4);
+    if (m_is64) {
+        header->size = static_cast<qint64>(qFromBigEndian<quint64>(bytes + 8));
+    } else {
+        header->size = static_cast<qint64>(qFromBigEndian<quint32>(bytes + 4));
+    }
+    header->dataOffset = m_file.pos();
+    return header->size >= 0;
+}
+
+SceneInfo MayaBinaryParser::parseFile(const QString& filePath)
+{
+    m_info = SceneInfo();
+    m_info.format = "mayaBinary";
+    m_nodeType.clear();
+    m_nodeName.clear();
+    m_references.clear();
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "MayaBinaryParser: 无法打开文件" << filePath;
+        return m_info;
+    }
+
+    QByteArray magic = m_file.peek(4);
+    if (magic != "FOR4" && magic != "FOR8") {
+        qWarning() << "MayaBinaryParser: 不是 Maya Binary 文件" << filePath;
+        m_file.close();
+        return m_info;
+    }
+    m_is64 = (magic == "FOR8");
+
+    ChunkHeader root;
+    if (readHeader(&root)) {
+        QByteArray formType = m_file.read(m_is64 ? 8 : 4).left(4);
+        if (formType == "Maya") {
+            m_info.isValid = true;
+            qint64 end = qMin(root.dataOffset + root.size, m_file.size());
+            if (!parseGroup(formType, end, 0)) {
+                qWarning() << "MayaBinaryParser: 文件结构损坏，已解析到偏移" << m_file.pos();
+            }
+        }
+    }
+
+    m_info.bytesParsed = m_file.size();
+    m_file.close();
+    return m_info;
+}
+
+bool MayaBinaryParser::parseGroup(const QByteArray& formType, qint64 end, int depth)
+{
+    int headerSize = m_is64 ? 16 : 8;
+
+    while (m_file.pos() + headerSize <= end) {
+        ChunkHeader header;
+        if (!readHeader(&header)) {
+            return false;
+        }
+
+        qint64 chunkEnd = header.dataOffset + header.size;
+        if (chunkEnd > end) {
+            return false;
+        }
+
+        if (isGroupTag(header.tag)) {
+            if (depth < MAX_GROUP_DEPTH) {
+                QByteArray childType = m_file.read(m_is64 ? 8 : 4).left(4);
+                if (!parseGroup(childType, chunkEnd, depth + 1)) {
+                    return false;
+                }
+            }
+        } else if (isInterestingTag(header.tag) && header.size <= MAX_INTERESTING_CHUNK) {
+            handleChunk(header.tag, formType, m_file.read(header.size));
+        }
+
+        // 其余块（网格、曲线等数据）不读取，直接跳到下一个块
+        if (!m_file.seek(qMin(align(chunkEnd), end))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void MayaBinaryParser::handleChunk(const QByteArray& tag, const QByteArray& formType, const QByteArray& data)
+{
+    if (tag == "VERS") {
+        // Maya 版本: "2024"
+        QList<QByteArray> strings = splitStrings(data);
+        if (!strings.isEmpty()) {
+            m_info.mayaVersion = SceneInfo::majorVersion(QString::fromUtf8(strings[0]));
+        }
+    } else if (tag == "PLUG") {
+        // requires: 插件名\0版本\0
+        QList<QByteArray> strings = splitStrings(data);
+        if (!strings.isEmpty() && !strings[0].isEmpty()) {
+            m_info.addPlugin(QString::fromUtf8(strings[0]), QString::fromUtf8(strings.value(1)));
+        }
+    } else if (tag == "FINF") {
+        // fileInfo: 键\0值\0
+        QList<QByteArray> strings = splitStrings(data);
+        if (strings.size() >= 2) {
+            m_info.fileInfo.insert(QString::fromUtf8(strings[0]), QString::fromUtf8(strings[1]));
+        }
+    } else if (tag == "FREF") {
+        // 引用：取其中的场景文件路径
+        const QList<QByteArray> strings = splitStrings(data);
+        for (int i = strings.size() - 1; i >= 0; --i) {
+            QString path = QString::fromUtf8(strings[i]);
+            if (path.endsWith(".ma", Qt::CaseInsensitive) || path.endsWith(".mb", Qt::CaseInsensitive)) {
+                if (!m_references.contains(path)) {
+                    m_references.insert(path);
+                    m_info.references.append(path);
+                }
+                break;
+            }
+        }
+    } else if (tag == "CREA") {
+        handleCreateNode(formType, data);
+    } else if (tag == "SLCT") {
+        handleSelect(data);
+    } else if (tag == "STR ") {
+        handleStringAttribute(data);
+    }
+}
+
+void MayaBinaryParser::handleCreateNode(const QByteArray& formType, const QByteArray& data)
+{
+    // 节点组的类型即节点类型码；CREA 数据为 1 字节标志 + 节点名\0 [+ 父节点名\0]
+    int offset = (!data.isEmpty() && static_cast<uchar>(data[0]) < 0x20) ? 1 : 0;
+    QList<QByteArray> strings = splitStrings(data, offset);
+
+    // 常见节点映射回 .ma 中的类型名，与 ASCII 解析结果一致；其余保留类型码
+    static const QHash<QByteArray, QString> knownTypes = {
+        {"FILE", "file"}, {"MESH", "mesh"}, {"XFRM", "transform"}
+    };
+    m_nodeType = knownTypes.value(formType, QString::fromLatin1(formType).trimmed());
+    m_nodeName = strings.isEmpty() ? QString() : QString::fromUtf8(strings[0]);
+}
+
+void MayaBinaryParser::handleSelect(const QByteArray& data)
+{
+    int offset = (!data.isEmpty() && static_cast<uchar>(data[0]) < 0x20) ? 1 : 0;
+    QList<QByteArray> strings = splitStrings(data, offset);
+
+    m_nodeType.clear();
+    m_nodeName = strings.isEmpty() ? QString() : QString::fromUtf8(strings[0]);
+}
+
+void MayaBinaryParser::handleStringAttribute(const QByteArray& data)
+{
+    // 属性名\0 + 1 字节标志 + 字符串值\0
+    int nameEnd = data.indexOf('\0');
+    if (nameEnd <= 0) {
+        return;
+    }
+
+    int valueStart = nameEnd + 1;
+    if (valueStart < data.size() && static_cast<uchar>(data[valueStart]) < 0x20) {
+        ++valueStart;
+    }
+    QList<QByteArray> strings = splitStrings(data, valueStart);
+    if (strings.isEmpty()) {
+        return;
+    }
+
+    QString attribute = "." + QString::fromUtf8(data.constData(), nameEnd);
+    QString value = QString::fromUtf8(strings[0]);
+
+    // 当前渲染器
+    if ((attribute == ".ren" || attribute == ".currentRenderer") && m_nodeName.endsWith("defaultRenderGlobals")) {
+        m_info.currentRenderer = value;
+        return;
+    }
+
+    if (SceneInfo::isFileAttribute(attribute, value)) {
+        m_info.fileAttributes.append(SceneFileAttribute{m_nodeType, m_nodeName, attribute, value});
+    }
+}
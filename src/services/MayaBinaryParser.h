@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QSet>
+#include <QString>
+#include "SceneInfo.h"
+
+/**
+ * @brief Maya Binary (.mb) 场景解析器
+ *
+ * .mb 是 IFF 格式：FOR4（32 位，块按 4 字节对齐）或 FOR8（64 位，按 8 字节对齐）。
+ * 块头为 4 字节类型 + 长度（FOR8 中类型后有 4 字节填充，长度为 8 字节），
+ * 组块（FORx/LISx/CATx/PROx）的数据以 4 字节组类型开头（FOR8 中同样补齐到 8 字节）。
+ *
+ * 逐块流式遍历，只读取关心的小块：
+ * VERS（Maya 版本）、PLUG（requires）、FINF（fileInfo）、FREF（引用）、
+ * CREA/SLCT（当前节点）和 "STR "（字符串属性）；
+ * 网格、动画曲线等大块直接 seek 跳过，不读入内存。
+ */
+class MayaBinaryParser
+{
+public:
+    MayaBinaryParser();
+
+    /**
+     * @brief 解析场景文件
+     */
+    SceneInfo parseFile(const QString& filePath);
+
+private:
+    struct ChunkHeader {
+        QByteArray tag;
+        qint64 dataOffset;
+        qint64 size;
+    };
+
+    bool readHeader(ChunkHeader* header);
+    bool parseGroup(const QByteArray& formType, qint64 end, int depth);
+    void handleChunk(const QByteArray& tag, const QByteArray& formType, const QByteArray& data);
+    void handleCreateNode(const QByteArray& formType, const QByteArray& data);
+    void handleSelect(const QByteArray& data);
+    void handleStringAttribute(const QByteArray& data);
+
+    qint64 align(qint64 offset) const;
+
+    static bool isGroupTag(const QByteArray& tag);
+    static bool isInterestingTag(const QByteArray& tag);
+    static QList<QByteArray> splitStrings(const QByteArray& data, int offset = 0);
+
+    QFile m_file;
+    bool m_is64;
+    SceneInfo m_info;
+    QString m_nodeType;
+    QString m_nodeName;
+    QSet<QString> m_references;
+};
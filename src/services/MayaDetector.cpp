@@ -1,4 +1,10 @@
 #include "MayaDetector.h"
+#include "MayaBinaryParser.h"
+#include "MayaInstallIndex.h"
+#include "FileCrawler.h"
+#include "MayaBatchRunner.h"
+#include "../core/Application.h"
+#include "../core/Config.h"
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
@@ -8,94 +14,401 @@
 #include <QStringConverter>
 #include <QMap>
 #include <QDirIterator>
-#include <QProcess>
+#include <QPair>
+#include <QSet>
+#include <QStandardPaths>
+
+#include <algorithm>
 
 #ifdef Q_OS_WIN
 #include <Windows.h>
 #include <QSettings>
 #endif
 
+namespace {
+// 暴力搜索的深度限制（相对搜索根目录）
+// 插件: Autodesk/ApplicationPlugins/MtoA/Contents/plug-ins/mtoa.mll
+// Maya: Program Files/Autodesk/Maya2024/bin/maya.exe
+const int PLUGIN_SEARCH_DEPTH = 6;
+const int MAYA_SEARCH_DEPTH = 5;
+
+// 通过 Maya 命令查询时只关心渲染器相关插件
+bool isRendererPluginName(const QString &pluginName)
+{
+    return pluginName.contains("mtoa", Qt::CaseInsensitive) ||
+           pluginName.contains("vray", Qt::CaseInsensitive) ||
+           pluginName.contains("redshift", Qt::CaseInsensitive) ||
+           pluginName.contains("arnold", Qt::CaseInsensitive) ||
+           pluginName.contains("yeti", Qt::CaseInsensitive) ||
+           pluginName.contains("miarmy", Qt::CaseInsensitive);
+}
+
+// 渲染器检测的来源，数值即合并时的优先顺序；备用检测只在前三者都没有结果时执行
+enum RendererSource {
+    COMMAND_SOURCE = 0,     // Maya 命令
+    PREFS_SOURCE,           // 插件配置文件
+    SCAN_SOURCE,            // 插件目录扫描
+    RENDERER_SOURCE_COUNT,
+    FALLBACK_SOURCE = RENDERER_SOURCE_COUNT
+};
+}
+
+/**
+ * @brief 单个 Maya 安装的检测状态（由 DetectionRun::mutex 保护）
+ */
+struct MayaDetector::InstallJob {
+    MayaSoftwareInfo info;
+    int order = 0;                                      // 候选路径顺序
+    QList<RendererInfo> sources[RENDERER_SOURCE_COUNT];
+    int rendererSourcesLeft = RENDERER_SOURCE_COUNT;
+    bool renderersDone = false;
+    bool pluginsDone = false;
+    QSet<QString> reportedRenderers;                    // 已发出 rendererDetected 的渲染器
+};
+
+/**
+ * @brief 一次异步检测的状态，由该次检测的所有阶段共享
+ */
+struct MayaDetector::DetectionRun {
+    bool forceRescan = false;
+    QStringList indexCandidates;                        // 仅由发现阶段写入
+    std::atomic<int> pendingStages{0};                  // 已提交但尚未结束的阶段数
+
+    QMutex mutex;                                       // 保护以下成员
+    bool fromIndex = false;
+    int progress = 0;
+    int candidateCount = 0;
+    int candidatesChecked = 0;
+    int installsFound = 0;
+    bool bruteForceStarted = false;
+    QList<QPair<int, MayaSoftwareInfo>> completed;     // 候选路径顺序 -> 检测完成的 Maya
+};
+
+MayaDetector::CacheSettings MayaDetector::CacheSettings::fromConfig()
+{
+    CacheSettings settings;
+    Config *config = Application::instance().config();
+    settings.cachePath = config ? config->cachePath()
+                                : QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    settings.maxSize = config ? config->cacheMaxSize() : 0;
+    return settings;
+}
+
 MayaDetector::MayaDetector(QObject *parent)
+    : MayaDetector(CacheSettings::fromConfig(), parent)
+{
+}
+
+MayaDetector::MayaDetector(const CacheSettings &cacheSettings, QObject *parent)
     : QObject(parent)
+    , m_cacheSettings(cacheSettings)
+    , m_sceneCache(cacheSettings.cachePath + "/scene-info", cacheSettings.maxSize)
+    , m_detecting(false)
+    , m_detectionCancelled(false)
 {
+    // 场景解析进度（工作线程中回调，信号跨线程排队发送）
+    m_sceneScanner.setProgressCallback([this](qint64 scannedBytes, qint64 totalBytes) {
+        int progress = totalBytes > 0 ? static_cast<int>(scannedBytes * 100 / totalBytes) : 100;
+        emit detectProgress(progress, QString::fromUtf8("正在解析场景文件 (%1 / %2 MB)")
+            .arg(scannedBytes / 1024 / 1024).arg(totalBytes / 1024 / 1024));
+    });
 }
 
 MayaDetector::~MayaDetector()
 {
+    // 检测阶段引用本对象，必须全部结束后才能析构
+    m_detectionCancelled = true;
+    m_detectPool.waitForDone();
 }
 
-QVector<MayaSoftwareInfo> MayaDetector::detectAllMayaVersions()
+QVector<MayaSoftwareInfo> MayaDetector::detectAllMayaVersions(bool forceRescan)
 {
-    QVector<MayaSoftwareInfo> results;
-    QStringList mayaPaths;
+    startDetection(forceRescan);
+    waitForDetection();
 
-    emit detectProgress(10, "正在扫描 Maya 安装路径...");
+    QMutexLocker locker(&m_resultsMutex);
+    return m_lastResults;
+}
 
+void MayaDetector::startDetection(bool forceRescan)
+{
+    if (m_detecting) {
+        cancelDetection();
+        waitForDetection();
+    }
+
+    m_detectionCancelled = false;
+    m_detecting = true;
+    {
+        QMutexLocker locker(&m_resultsMutex);
+        m_lastResults.clear();
+    }
+
+    std::shared_ptr<DetectionRun> run = std::make_shared<DetectionRun>();
+    run->forceRescan = forceRescan;
+    runStage(run, [this, run]() { discoverStage(run); });
+}
+
+void MayaDetector::cancelDetection()
+{
+    m_detectionCancelled = true;
+}
+
+void MayaDetector::waitForDetection()
+{
+    m_detectPool.waitForDone();
+}
+
+void MayaDetector::runStage(const std::shared_ptr<DetectionRun> &run, const std::function<void()> &stage)
+{
+    ++run->pendingStages;
+    m_detectPool.start([this, run, stage]() {
+        if (!m_detectionCancelled) {
+            stage();
+        }
+        // 阶段总是先提交后续阶段再返回，计数归零说明整个检测已结束
+        if (--run->pendingStages == 0) {
+            finishDetection(run);
+        }
+    });
+}
+
+void MayaDetector::discoverStage(const std::shared_ptr<DetectionRun> &run)
+{
+    // 注册表和环境变量读取开销很小，作为索引校验的一部分：
+    // 其中任何路径变化都说明安装环境变了
+    QStringList registryPaths;
 #ifdef Q_OS_WIN
-    // Windows: 从注册表读取
-    mayaPaths.append(readMayaPathsFromRegistry());
+    registryPaths = readMayaPathsFromRegistry();
 #endif
+    run->indexCandidates = registryPaths + getPluginPathsFromEnvironment();
 
-    // 扫描常用安装目录
-    mayaPaths.append(scanCommonInstallPaths());
+    MayaInstallIndex index(m_cacheSettings.cachePath + "/maya-index.json");
+    if (!run->forceRescan && index.load() && index.isUpToDate(run->indexCandidates)) {
+        qDebug() << "Maya 安装索引未变化，直接使用:" << index.filePath();
+        QVector<MayaSoftwareInfo> installs = index.installs();
 
-    // 去重
+        QMutexLocker locker(&run->mutex);
+        run->fromIndex = true;
+        for (int i = 0; i < installs.size(); ++i) {
+            emit mayaVersionFound(installs[i]);
+            emit mayaVersionDetected(installs[i]);
+            run->completed.append(qMakePair(i, installs[i]));
+        }
+        return;
+    }
+
+    // 完整扫描时插件搜索结果也要重新获取
+    {
+        QMutexLocker locker(&m_pluginSearchMutex);
+        m_pluginSearchCache.clear();
+    }
+
+    emit detectProgress(10, "正在扫描 Maya 安装路径...");
+
+    // Windows: 从注册表读取（非 Windows 为空），再扫描常用安装目录
+    QStringList mayaPaths = registryPaths;
+    mayaPaths.append(scanCommonInstallPaths());
     mayaPaths.removeDuplicates();
 
     qDebug() << "常规方法找到" << mayaPaths.size() << "个可能的 Maya 路径，开始验证...";
-    emit detectProgress(30, QString("找到 %1 个可能的 Maya 安装路径，正在验证...").arg(mayaPaths.size()));
-
-    // 验证每个路径
-    int currentProgress = 30;
-    int step = mayaPaths.isEmpty() ? 0 : (50 / mayaPaths.size());
-
-    for (const QString &path : mayaPaths) {
-        qDebug() << "验证路径:" << path;
-        if (isValidMayaInstall(path)) {
-            MayaSoftwareInfo info = detectMayaAtPath(path);
-            if (info.isValid) {
-                results.append(info);
-                qDebug() << "✓ 检测到有效 Maya:" << info.version << "安装路径:" << info.installPath;
-            } else {
-                qDebug() << "✗ 路径无效（版本号或 maya.exe 不存在）:" << path;
-            }
-        } else {
-            qDebug() << "✗ 路径验证失败（maya.exe 不存在）:" << path;
+
+    QMutexLocker locker(&run->mutex);
+    run->progress = 30;
+    run->candidateCount = mayaPaths.size();
+    emit detectProgress(run->progress, QString("找到 %1 个可能的 Maya 安装路径，正在验证...").arg(mayaPaths.size()));
+
+    if (mayaPaths.isEmpty()) {
+        run->bruteForceStarted = true;
+        runStage(run, [this, run]() { bruteForceStage(run); });
+        return;
+    }
+
+    // 每个候选路径独立验证
+    for (int i = 0; i < mayaPaths.size(); ++i) {
+        QString path = mayaPaths[i];
+        runStage(run, [this, run, path, i]() { validateStage(run, path, i, false); });
+    }
+}
+
+void MayaDetector::validateStage(const std::shared_ptr<DetectionRun> &run, const QString &path, int order, bool bruteForce)
+{
+    qDebug() << "验证路径:" << path;
+
+    MayaSoftwareInfo info;
+    if (isValidMayaInstall(path)) {
+        info = basicMayaInfo(path);
+        if (!info.isValid) {
+            qDebug() << "✗ 路径无效（版本号或 maya.exe 不存在）:" << path;
         }
+    } else {
+        qDebug() << "✗ 路径验证失败（maya.exe 不存在）:" << path;
+    }
+
+    QMutexLocker locker(&run->mutex);
 
-        currentProgress += step;
-        emit detectProgress(currentProgress, QString("验证: %1").arg(path));
+    if (info.isValid) {
+        qDebug() << (bruteForce ? "✓ 暴力搜索检测到 Maya:" : "✓ 检测到有效 Maya:")
+                 << info.version << "安装路径:" << info.installPath;
+        emit mayaVersionFound(info);
+        ++run->installsFound;
+
+        std::shared_ptr<InstallJob> job = std::make_shared<InstallJob>();
+        job->info = info;
+        job->order = order;
+
+        // 渲染器的三个来源和插件检测互不依赖，并行执行
+        const QString version = info.version;
+        runStage(run, [this, run, job, version]() {
+            rendererStage(run, job, COMMAND_SOURCE, getPluginsFromMayaCommands(version));
+        });
+        runStage(run, [this, run, job, version]() {
+            rendererStage(run, job, PREFS_SOURCE, readPluginsFromPrefs(version));
+        });
+        runStage(run, [this, run, job, version]() {
+            rendererStage(run, job, SCAN_SOURCE, scanAllPluginDirectories(version));
+        });
+        runStage(run, [this, run, job, info]() {
+            QStringList plugins = detectPlugins(info);
+            QMutexLocker jobLocker(&run->mutex);
+            job->info.plugins = plugins;
+            job->pluginsDone = true;
+            completeInstallIfReady(run, job);
+        });
+    }
+
+    if (bruteForce) {
+        return;
     }
 
+    ++run->candidatesChecked;
+    run->progress = qMax(run->progress, 30 + 30 * run->candidatesChecked / run->candidateCount);
+    emit detectProgress(run->progress, QString("验证: %1").arg(path));
+
     // 如果常规方法没有找到任何有效的 Maya，启动暴力搜索
-    if (results.isEmpty()) {
-        qDebug() << "========================================";
-        qDebug() << "常规方法未找到有效 Maya，启动暴力搜索...";
-        qDebug() << "========================================";
-        emit detectProgress(80, "启动全盘搜索 Maya...");
-
-        QStringList bruteForcePaths = bruteForceSearchMaya();
-        qDebug() << "暴力搜索找到" << bruteForcePaths.size() << "个 Maya 路径";
-
-        for (const QString &path : bruteForcePaths) {
-            if (isValidMayaInstall(path)) {
-                MayaSoftwareInfo info = detectMayaAtPath(path);
-                if (info.isValid) {
-                    results.append(info);
-                    qDebug() << "✓ 暴力搜索检测到 Maya:" << info.version << "安装路径:" << info.installPath;
-                }
-            }
+    if (run->candidatesChecked == run->candidateCount && run->installsFound == 0 && !run->bruteForceStarted) {
+        run->bruteForceStarted = true;
+        runStage(run, [this, run]() { bruteForceStage(run); });
+    }
+}
+
+void MayaDetector::bruteForceStage(const std::shared_ptr<DetectionRun> &run)
+{
+    qDebug() << "========================================";
+    qDebug() << "常规方法未找到有效 Maya，启动暴力搜索...";
+    qDebug() << "========================================";
+    emit detectProgress(60, "启动全盘搜索 Maya...");
+
+    QStringList bruteForcePaths = bruteForceSearchMaya();
+    qDebug() << "暴力搜索找到" << bruteForcePaths.size() << "个 Maya 路径";
+
+    QMutexLocker locker(&run->mutex);
+    int base = run->candidateCount;
+    for (int i = 0; i < bruteForcePaths.size(); ++i) {
+        QString path = bruteForcePaths[i];
+        runStage(run, [this, run, path, base, i]() { validateStage(run, path, base + i, true); });
+    }
+}
+
+void MayaDetector::rendererStage(const std::shared_ptr<DetectionRun> &run, const std::shared_ptr<InstallJob> &job,
+                                 int source, const QList<RendererInfo> &renderers)
+{
+    QMutexLocker locker(&run->mutex);
+
+    // 同一渲染器可能由多个来源找到，只通知一次
+    for (const RendererInfo &renderer : renderers) {
+        if (!job->reportedRenderers.contains(renderer.name)) {
+            job->reportedRenderers.insert(renderer.name);
+            emit rendererDetected(job->info.installPath, renderer);
         }
     }
 
-    emit detectProgress(100, "Maya 检测完成");
+    if (source == FALLBACK_SOURCE) {
+        finishRenderers(run, job, renderers);
+        return;
+    }
+
+    job->sources[source] = renderers;
+    if (--job->rendererSourcesLeft > 0) {
+        return;
+    }
+
+    QList<RendererInfo> merged = mergeRendererPlugins(job->sources[COMMAND_SOURCE],
+                                                      job->sources[PREFS_SOURCE],
+                                                      job->sources[SCAN_SOURCE]);
+    if (!merged.isEmpty()) {
+        finishRenderers(run, job, merged);
+        return;
+    }
+
+    // 完整检测没有找到任何插件，使用备用检测方法
+    MayaSoftwareInfo info = job->info;
+    runStage(run, [this, run, job, info]() {
+        rendererStage(run, job, FALLBACK_SOURCE, detectFallbackRenderers(info));
+    });
+}
+
+void MayaDetector::finishRenderers(const std::shared_ptr<DetectionRun> &run, const std::shared_ptr<InstallJob> &job,
+                                   const QVector<RendererInfo> &renderers)
+{
+    for (const RendererInfo &renderer : renderers) {
+        job->info.renderers.append(QString("%1 %2").arg(renderer.name).arg(renderer.version));
+    }
+    job->renderersDone = true;
+    completeInstallIfReady(run, job);
+}
+
+void MayaDetector::completeInstallIfReady(const std::shared_ptr<DetectionRun> &run, const std::shared_ptr<InstallJob> &job)
+{
+    if (!job->renderersDone || !job->pluginsDone) {
+        return;
+    }
+
+    run->completed.append(qMakePair(job->order, job->info));
+    run->progress = qMax(run->progress, 60 + 35 * run->completed.size() / qMax(1, run->installsFound));
+    emit detectProgress(run->progress, QString("Maya %1 检测完成").arg(job->info.version));
+    emit mayaVersionDetected(job->info);
+}
+
+void MayaDetector::finishDetection(const std::shared_ptr<DetectionRun> &run)
+{
+    if (m_detectionCancelled) {
+        qDebug() << "Maya 检测已取消";
+        m_detecting = false;
+        emit detectionCancelled();
+        return;
+    }
+
+    // 各阶段完成顺序不定，按候选路径顺序输出
+    std::sort(run->completed.begin(), run->completed.end(),
+              [](const QPair<int, MayaSoftwareInfo> &a, const QPair<int, MayaSoftwareInfo> &b) {
+        return a.first < b.first;
+    });
+    QVector<MayaSoftwareInfo> results;
+    for (const QPair<int, MayaSoftwareInfo> &item : run->completed) {
+        results.append(item.second);
+    }
+
+    if (!run->fromIndex) {
+        // 保存索引，下次检测只需校验来源路径的修改时间
+        MayaInstallIndex index(m_cacheSettings.cachePath + "/maya-index.json");
+        index.update(results, run->indexCandidates, installIndexSources(results));
+        index.save();
+    }
+
+    {
+        QMutexLocker locker(&m_resultsMutex);
+        m_lastResults = results;
+    }
+    m_detecting = false;
+
+    emit detectProgress(100, run->fromIndex ? "Maya 检测完成（使用已保存的安装索引）" : "Maya 检测完成");
     qDebug() << "最终检测到" << results.size() << "个有效 Maya 安装";
     emit detectFinished();
-
-    return results;
+    emit detectionCompleted(results);
 }
 
-MayaSoftwareInfo MayaDetector::detectMayaAtPath(const QString &installPath)
+MayaSoftwareInfo MayaDetector::basicMayaInfo(const QString &installPath)
 {
     MayaSoftwareInfo info;
     info.installPath = installPath;
@@ -107,15 +420,6 @@ MayaSoftwareInfo MayaDetector::detectMayaAtPath(const QString &installPath)
     // 获取可执行文件路径
     info.executablePath = getMayaExecutablePath(installPath);
 
-    // 检测渲染器
-    QVector<RendererInfo> renderers = detectRenderers(info);
-    for (const RendererInfo &renderer : renderers) {
-        info.renderers.append(QString("%1 %2").arg(renderer.name).arg(renderer.version));
-    }
-
-    // 检测插件
-    info.plugins = detectPlugins(info);
-
     // 验证有效性
     info.isValid = !info.version.isEmpty() && QFile::exists(info.executablePath);
 
@@ -130,6 +434,22 @@ MayaSoftwareInfo MayaDetector::detectMayaAtPath(const QString &installPath)
     return info;
 }
 
+MayaSoftwareInfo MayaDetector::detectMayaAtPath(const QString &installPath)
+{
+    MayaSoftwareInfo info = basicMayaInfo(installPath);
+
+    // 检测渲染器
+    QVector<RendererInfo> renderers = detectRenderers(info);
+    for (const RendererInfo &renderer : renderers) {
+        info.renderers.append(QString("%1 %2").arg(renderer.name).arg(renderer.version));
+    }
+
+    // 检测插件
+    info.plugins = detectPlugins(info);
+
+    return info;
+}
+
 QVector<RendererInfo> MayaDetector::detectRenderers(const MayaSoftwareInfo &mayaInfo)
 {
     QVector<RendererInfo> renderers;
@@ -146,7 +466,17 @@ QVector<RendererInfo> MayaDetector::detectRenderers(const MayaSoftwareInfo &maya
     
     // 如果完整检测没有找到任何插件，则使用原有的检测方法作为备用
     if (renderers.isEmpty()) {
-        qDebug() << "完整检测未找到插件，使用备用检测方法...";
+        renderers = detectFallbackRenderers(mayaInfo);
+    }
+
+    return renderers;
+}
+
+QVector<RendererInfo> MayaDetector::detectFallbackRenderers(const MayaSoftwareInfo &mayaInfo)
+{
+    QVector<RendererInfo> renderers;
+
+    qDebug() << "完整检测未找到插件，使用备用检测方法...";
 
 #ifdef Q_OS_WIN
     // 优先从 pluginPrefs.mel 读取渲染器插件信息
@@ -308,7 +638,6 @@ QVector<RendererInfo> MayaDetector::detectRenderers(const MayaSoftwareInfo &maya
     }
 
     qDebug() << "========== 渲染器检测完成，共找到" << renderers.size() << "个 ==========\n";
-    } // 备用检测方法的结束
 
     return renderers;
 }
@@ -325,6 +654,19 @@ QStringList MayaDetector::detectPlugins(const MayaSoftwareInfo &mayaInfo)
     if (!pluginPrefsMap.isEmpty()) {
         qDebug() << "从 pluginPrefs.mel 找到" << pluginPrefsMap.size() << "个已注册插件";
 
+        // 根据平台确定插件扩展名
+        QStringList pluginExtensions;
+#ifdef Q_OS_WIN
+        pluginExtensions << ".mll" << ".dll" << ".py";
+#elif defined(Q_OS_MAC)
+        pluginExtensions << ".bundle" << ".py";
+#elif defined(Q_OS_LINUX)
+        pluginExtensions << ".so" << ".py";
+#endif
+
+        // 常规路径找不到的插件：plugins 中的位置 -> (插件名, 显示名称)
+        QMap<int, QPair<QString, QString>> unresolvedPlugins;
+
         for (auto it = pluginPrefsMap.constBegin(); it != pluginPrefsMap.constEnd(); ++it) {
             QString pluginName = it.key();
             QString pluginPath = it.value();
@@ -332,16 +674,6 @@ QStringList MayaDetector::detectPlugins(const MayaSoftwareInfo &mayaInfo)
             // 检查插件文件是否存在
             QString fullPluginPath;
 
-            // 根据平台确定插件扩展名
-            QStringList pluginExtensions;
-#ifdef Q_OS_WIN
-            pluginExtensions << ".mll" << ".dll" << ".py";
-#elif defined(Q_OS_MAC)
-            pluginExtensions << ".bundle" << ".py";
-#elif defined(Q_OS_LINUX)
-            pluginExtensions << ".so" << ".py";
-#endif
-
             // 如果有明确路径，先尝试
             if (!pluginPath.isEmpty()) {
                 for (const QString &ext : pluginExtensions) {
@@ -429,17 +761,32 @@ QStringList MayaDetector::detectPlugins(const MayaSoftwareInfo &mayaInfo)
                 qDebug() << "  ✓" << formattedName << "(" << pluginPath << ")";
                 plugins << formattedName + " [已加载]";
             } else {
-                // 如果所有方法都找不到，使用暴力搜索作为最后手段
-                qDebug() << "  ?" << pluginName << "未在常规路径找到，尝试暴力搜索...";
+                // 所有方法都找不到，稍后统一暴力搜索
+                qDebug() << "  ?" << pluginName << "未在常规路径找到，稍后暴力搜索...";
+                unresolvedPlugins.insert(plugins.size(), qMakePair(pluginName, formattedName));
+                plugins << formattedName + " [已注册，但文件未找到]";
+            }
+        }
 
-                // 尝试所有可能的扩展名进行暴力搜索
+        // 最后手段：所有未找到的插件（含各种扩展名）合并为一次暴力搜索
+        if (!unresolvedPlugins.isEmpty()) {
+            QStringList fileNames;
+            for (const QPair<QString, QString> &plugin : unresolvedPlugins) {
+                for (const QString &ext : pluginExtensions) {
+                    fileNames << plugin.first + ext;
+                }
+            }
+
+            QHash<QString, QStringList> bruteSearchResults = bruteForceSearchPlugins(fileNames, mayaInfo.version);
+
+            for (auto it = unresolvedPlugins.constBegin(); it != unresolvedPlugins.constEnd(); ++it) {
+                const QString &pluginName = it.value().first;
                 bool foundByBruteForce = false;
                 for (const QString &ext : pluginExtensions) {
-                    QStringList bruteSearchResults = bruteForceSearchPlugin(pluginName + ext, mayaInfo.version);
-                    if (!bruteSearchResults.isEmpty()) {
-                        fullPluginPath = bruteSearchResults.first();
-                        qDebug() << "  ✓✓✓ 通过暴力搜索找到:" << fullPluginPath;
-                        plugins << formattedName + " [暴力搜索找到]";
+                    QStringList paths = bruteSearchResults.value(pluginName + ext);
+                    if (!paths.isEmpty()) {
+                        qDebug() << "  ✓✓✓ 通过暴力搜索找到:" << paths.first();
+                        plugins[it.key()] = it.value().second + " [暴力搜索找到]";
                         foundByBruteForce = true;
                         break;
                     }
@@ -447,7 +794,6 @@ QStringList MayaDetector::detectPlugins(const MayaSoftwareInfo &mayaInfo)
 
                 if (!foundByBruteForce) {
                     qDebug() << "  ✗ 暴力搜索也未找到" << pluginName;
-                    plugins << formattedName + " [已注册，但文件未找到]";
                 }
             }
         }
@@ -538,131 +884,82 @@ QStringList MayaDetector::detectPlugins(const MayaSoftwareInfo &mayaInfo)
 
 QString MayaDetector::extractMayaVersionFromScene(const QString &sceneFilePath)
 {
-    QFileInfo fileInfo(sceneFilePath);
-    QString suffix = fileInfo.suffix().toLower();
-
-    QString content;
-    if (suffix == "ma") {
-        // ASCII 场景文件
-        content = readMayaAsciiScene(sceneFilePath);
-    } else if (suffix == "mb") {
-        // 二进制场景文件
-        content = parseMayaBinaryScene(sceneFilePath);
-    } else {
-        return QString();
-    }
+    return parseScene(sceneFilePath).resolvedMayaVersion();
+}
 
-    // 从文件头提取版本信息
-    // 示例: //Maya 2024 Scene File
-    QRegularExpression re("Maya\\s+(\\d{4})");
-    QRegularExpressionMatch match = re.match(content);
-    if (match.hasMatch()) {
-        return match.captured(1);
+QString MayaDetector::extractRendererFromScene(const QString &sceneFilePath)
+{
+    SceneInfo info = parseScene(sceneFilePath);
+    if (info.format.isEmpty()) {
+        return QString();  // 不支持的文件类型
     }
-
-    return QString();
+    return info.rendererName();
 }
 
-QString MayaDetector::extractRendererFromScene(const QString &sceneFilePath)
+SceneInfo MayaDetector::parseScene(const QString &sceneFilePath)
 {
     QFileInfo fileInfo(sceneFilePath);
     QString suffix = fileInfo.suffix().toLower();
+    if (suffix != "ma" && suffix != "mb") {
+        return SceneInfo();
+    }
+
+    // 场景未修改时直接使用上次的分析结果
+    SceneInfo info;
+    if (m_sceneCache.lookup(sceneFilePath, &info)) {
+        emit detectProgress(100, QString::fromUtf8("使用缓存的场景分析结果"));
+        return info;
+    }
 
-    QString content;
     if (suffix == "ma") {
-        content = readMayaAsciiScene(sceneFilePath);
-    } else if (suffix == "mb") {
-        content = parseMayaBinaryScene(sceneFilePath);
+        // ASCII 场景文件：按语句边界切分后多线程解析
+        info = m_sceneScanner.scanFile(sceneFilePath);
     } else {
-        return QString();
+        // 二进制场景文件 (IFF)
+        MayaBinaryParser parser;
+        info = parser.parseFile(sceneFilePath);
     }
 
-    // 检测渲染器
-    if (content.contains("mtoa", Qt::CaseInsensitive) ||
-        content.contains("aiStandard", Qt::CaseInsensitive)) {
-        return "Arnold";
-    } else if (content.contains("vray", Qt::CaseInsensitive)) {
-        return "V-Ray";
-    } else if (content.contains("redshift", Qt::CaseInsensitive)) {
-        return "Redshift";
-    } else if (content.contains("renderman", Qt::CaseInsensitive)) {
-        return "RenderMan";
-    }
-
-    return "Maya Software"; // 默认渲染器
+    if (info.isValid && !isCancelled()) {
+        m_sceneCache.store(sceneFilePath, info);
+    }
+    return info;
 }
 
 QStringList MayaDetector::scanSceneAssets(const QString &sceneFilePath)
 {
-    QStringList assets;
-
-    QString content;
-    QFileInfo fileInfo(sceneFilePath);
-    if (fileInfo.suffix().toLower() == "ma") {
-        content = readMayaAsciiScene(sceneFilePath);
-    } else {
-        content = parseMayaBinaryScene(sceneFilePath);
-    }
-
-    // 提取纹理路径
-    // 示例: setAttr ".fileTextureName" -type "string" "D:/textures/wood.jpg";
-    QRegularExpression texRe("fileTextureName.*?\"([^\"]+)\"");
-    QRegularExpressionMatchIterator it = texRe.globalMatch(content);
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        QString path = match.captured(1);
-        if (!path.isEmpty()) {
-            assets.append(path);
-        }
-    }
-
-    // 提取 IES 文件
-    QRegularExpression iesRe("iesProfile.*?\"([^\"]+)\"");
-    it = iesRe.globalMatch(content);
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        QString path = match.captured(1);
-        if (!path.isEmpty()) {
-            assets.append(path);
-        }
-    }
+    return parseScene(sceneFilePath).assetPaths();
+}
 
-    // 提取缓存文件 (Alembic, GPU Cache等)
-    QRegularExpression cacheRe("cacheFile.*?\"([^\"]+)\"");
-    it = cacheRe.globalMatch(content);
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        QString path = match.captured(1);
-        if (!path.isEmpty()) {
-            assets.append(path);
-        }
-    }
+void MayaDetector::cancel()
+{
+    m_sceneScanner.cancel();
+}
 
-    assets.removeDuplicates();
-    return assets;
+bool MayaDetector::isCancelled() const
+{
+    return m_sceneScanner.isCancelled();
 }
 
 QStringList MayaDetector::detectMissingAssets(const QString &sceneFilePath)
 {
-    QStringList missingAssets;
-    QStringList allAssets = scanSceneAssets(sceneFilePath);
-
-    QDir sceneDir = QFileInfo(sceneFilePath).dir();
+    return detectMissingAssets(parseScene(sceneFilePath), sceneFilePath);
+}
 
-    for (const QString &assetPath : allAssets) {
-        // 绝对路径
-        if (QFile::exists(assetPath)) {
-            continue;
-        }
+QStringList MayaDetector::detectMissingAssets(const SceneInfo &sceneInfo, const QString &sceneFilePath)
+{
+    QStringList missingAssets;
+    if (isCancelled()) {
+        return missingAssets;
+    }
 
-        // 相对路径（相对于场景文件）
-        QString relativePath = sceneDir.absoluteFilePath(assetPath);
-        if (QFile::exists(relativePath)) {
-            continue;
+    // 按目录批量检查（绝对路径原样查找，相对路径相对于场景文件），模式路径至少匹配一个文件
+    QString sceneDir = QFileInfo(sceneFilePath).absolutePath();
+    const QVector<AssetResolution> resolutions = m_assetResolver.resolve(sceneInfo.assetPaths(), sceneDir);
+    for (const AssetResolution &resolution : resolutions) {
+        if (resolution.isMissing()) {
+            missingAssets.append(resolution.reference);
         }
-
-        // 文件不存在
-        missingAssets.append(assetPath);
     }
 
     return missingAssets;
@@ -749,6 +1046,66 @@ QStringList MayaDetector::scanCommonInstallPaths()
     return paths;
 }
 
+QStringList MayaDetector::installIndexSources(const QVector<MayaSoftwareInfo> &installs)
+{
+    QStringList sources;
+
+    // 安装根目录：新装或卸载 Maya 时修改时间变化
+#ifdef Q_OS_WIN
+    QFileInfoList drives = QDir::drives();
+    for (const QFileInfo &drive : drives) {
+        QString driveLetter = drive.absolutePath();
+        sources << driveLetter + "Program Files/Autodesk";
+        sources << driveLetter + "Program Files (x86)/Autodesk";
+        sources << driveLetter + "Autodesk";
+
+        // 全盘搜索的起点（只记录顶层，更深层的新安装需要手动刷新）
+        sources << driveLetter + "Program Files";
+        sources << driveLetter + "Program Files (x86)";
+
+        // 系统级模块目录
+        sources << driveLetter + "ProgramData/Autodesk/ApplicationPlugins";
+        sources << driveLetter + "Program Files/Common Files/Autodesk Shared/Modules/maya";
+    }
+#elif defined(Q_OS_MAC)
+    sources << "/Applications/Autodesk";
+#elif defined(Q_OS_LINUX)
+    sources << "/usr/autodesk";
+    sources << "/opt/autodesk";
+#endif
+
+    QString userMayaDir = QDir::homePath() + "/Documents/maya";
+    sources << userMayaDir << userMayaDir + "/modules";
+
+    for (const MayaSoftwareInfo &info : installs) {
+        // 安装目录本身及其插件目录（渲染器、插件增删）
+        const QString &installPath = info.installPath;
+        sources << QFileInfo(installPath).absolutePath();
+        sources << installPath;
+        sources << installPath + "/bin";
+        sources << installPath + "/bin/plug-ins";
+        sources << installPath + "/plug-ins";
+        sources << installPath + "/modules";
+
+        // 用户配置：Maya.env、pluginPrefs.mel 和用户级插件/模块
+        QString userDir = userMayaDir + "/" + info.version;
+        sources << userDir;
+        sources << userDir + "/Maya.env";
+        sources << userDir + "/prefs";
+        sources << userDir + "/prefs/pluginPrefs.mel";
+        sources << userDir + "/plug-ins";
+        sources << userDir + "/modules";
+
+#ifdef Q_OS_WIN
+        for (const QFileInfo &drive : drives) {
+            sources << drive.absolutePath() + "Program Files/Common Files/Autodesk Shared/Modules/maya/" + info.version;
+        }
+#endif
+    }
+
+    return sources;
+}
+
 QString MayaDetector::extractVersionFromPath(const QString &path)
 {
     // 从路径中提取版本号
@@ -783,44 +1140,6 @@ bool MayaDetector::isValidMayaInstall(const QString &path)
     return QFile::exists(exePath);
 }
 
-QString MayaDetector::readMayaAsciiScene(const QString &sceneFilePath)
-{
-    QFile file(sceneFilePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return QString();
-    }
-
-    QTextStream in(&file);
-    in.setEncoding(QStringConverter::Utf8);
-
-    // 只读取前10000行（场景文件可能很大）
-    QString content;
-    int lineCount = 0;
-    while (!in.atEnd() && lineCount < 10000) {
-        content += in.readLine() + "\n";
-        lineCount++;
-    }
-
-    file.close();
-    return content;
-}
-
-QString MayaDetector::parseMayaBinaryScene(const QString &sceneFilePath)
-{
-    // Maya 二进制文件(.mb) 解析比较复杂
-    // 这里简化处理：只读取文件头部信息
-    QFile file(sceneFilePath);
-    if (!file.open(QIODevice::ReadOnly)) {
-        return QString();
-    }
-
-    QByteArray header = file.read(1024); // 读取前1KB
-    file.close();
-
-    // 将二进制转为字符串（部分信息是可读的）
-    return QString::fromLatin1(header);
-}
-
 RendererInfo MayaDetector::detectArnold(const QString &mayaPath)
 {
     RendererInfo info;
@@ -1002,9 +1321,10 @@ RendererInfo MayaDetector::detectArnold(const QString &mayaPath)
 
     // 5. 最后尝试暴力搜索（如果前面都没找到）
     qDebug() << "尝试暴力搜索 Arnold 插件...";
-    QStringList bruteForceResults = bruteForceSearchPlugin("mtoa.mll", mayaVersion);
+    QHash<QString, QStringList> bruteForceMatches = bruteForceSearchPlugins(QStringList() << "mtoa.mll" << "mtoa.dll", mayaVersion);
+    QStringList bruteForceResults = bruteForceMatches.value("mtoa.mll");
     if (bruteForceResults.isEmpty()) {
-        bruteForceResults = bruteForceSearchPlugin("mtoa.dll", mayaVersion);
+        bruteForceResults = bruteForceMatches.value("mtoa.dll");
     }
     
     if (!bruteForceResults.isEmpty()) {
@@ -1474,117 +1794,126 @@ QStringList MayaDetector::scanThirdPartyPluginRegistry(const QString &mayaVersio
     return paths;
 }
 
-QStringList MayaDetector::bruteForceSearchPlugin(const QString &pluginFileName, const QString &mayaVersion)
+QHash<QString, QStringList> MayaDetector::bruteForceSearchPlugins(const QStringList &pluginFileNames, const QString &mayaVersion)
 {
-    QStringList foundPaths;
+    QHash<QString, QStringList> foundPaths;
 
 #ifdef Q_OS_WIN
-    qDebug() << "========== 开始暴力搜索插件:" << pluginFileName << "==========";
-
-    // 获取所有可用驱动器
-    QFileInfoList drives = QDir::drives();
-    qDebug() << "可用驱动器:" << drives.size() << "个";
-
-    for (const QFileInfo &drive : drives) {
-        QString driveLetter = drive.absolutePath();  // 例如 "C:/", "D:/"
-        qDebug() << "\n正在搜索驱动器:" << driveLetter;
-
-        // 定义常见的搜索路径（优先级从高到低）
-        QStringList searchPaths;
-
-        // 1. Program Files 下的 Autodesk 目录
-        searchPaths << driveLetter + "Program Files/Autodesk";
-        searchPaths << driveLetter + "Program Files (x86)/Autodesk";
-
-        // 2. Arnold 的标准安装位置（更全面的路径）
-        searchPaths << driveLetter + "Program Files/Autodesk/Arnold";
-        searchPaths << driveLetter + "Program Files (x86)/Autodesk/Arnold";
-        searchPaths << driveLetter + "solidangle";
-        searchPaths << driveLetter + "Program Files/solidangle";
-        searchPaths << driveLetter + "Program Files (x86)/solidangle";
-        searchPaths << driveLetter + "Arnold";
-        searchPaths << driveLetter + "Program Files/Arnold";
-        searchPaths << driveLetter + "Program Files (x86)/Arnold";
-
-        // 3. Yeti 的标准安装位置
-        searchPaths << driveLetter + "Program Files/Peregrine Labs";
-        searchPaths << driveLetter + "Peregrine Labs";
-
-        // 4. V-Ray 位置
-        searchPaths << driveLetter + "Program Files/Chaos Group";
-
-        // 5. Redshift 位置
-        searchPaths << driveLetter + "ProgramData/Redshift";
-
-        // 6. 通用插件位置
-        searchPaths << driveLetter + "ProgramData/Autodesk";
-
-        // 递归搜索每个路径
-        for (const QString &basePath : searchPaths) {
-            QDir baseDir(basePath);
-            if (!baseDir.exists()) {
-                continue;
+    qDebug() << "========== 开始暴力搜索插件:" << pluginFileNames << "==========";
+
+    // 同一检测过程中已搜索过的文件名直接复用
+    // （并行的检测阶段可能同时搜索同一文件名，结果相同，不额外加锁等待）
+    QStringList pendingNames;
+    {
+        QMutexLocker locker(&m_pluginSearchMutex);
+        for (const QString &fileName : pluginFileNames) {
+            if (!m_pluginSearchCache.contains(mayaVersion + "|" + fileName)) {
+                pendingNames << fileName;
             }
+        }
+    }
 
-            qDebug() << "  搜索基础路径:" << basePath;
-
-            // 对于Arnold插件，使用更智能的搜索策略
-            if (pluginFileName.contains("mtoa", Qt::CaseInsensitive)) {
-                // Arnold插件特殊处理：优先搜索特定目录结构
-                QStringList arnoldSpecificPaths;
-                arnoldSpecificPaths << basePath + "/maya" + mayaVersion + "/plug-ins";
-                arnoldSpecificPaths << basePath + "/mtoadeploy/" + mayaVersion + "/plug-ins";
-                arnoldSpecificPaths << basePath + "/plug-ins";
-                arnoldSpecificPaths << basePath + "/bin/plug-ins";
-                
-                for (const QString &arnoldPath : arnoldSpecificPaths) {
-                    QDir arnoldDir(arnoldPath);
-                    if (arnoldDir.exists()) {
-                        QStringList filters;
-                        filters << "mtoa.mll" << "mtoa.dll";
-                        QFileInfoList files = arnoldDir.entryInfoList(filters, QDir::Files);
-                        
-                        for (const QFileInfo &file : files) {
-                            QString foundPath = file.absoluteFilePath();
-                            qDebug() << "    ✓✓✓ Arnold专用搜索找到!" << foundPath;
-                            foundPaths.prepend(foundPath);  // Arnold专用搜索的结果优先级最高
+    if (!pendingNames.isEmpty()) {
+        // 定义常见的搜索路径（嵌套的路径只遍历一次）
+        QStringList searchPaths;
+        QFileInfoList drives = QDir::drives();
+        for (const QFileInfo &drive : drives) {
+            QString driveLetter = drive.absolutePath();  // 例如 "C:/", "D:/"
+
+            // 1. Autodesk 目录（含 Arnold 的标准安装位置）
+            searchPaths << driveLetter + "Program Files/Autodesk";
+            searchPaths << driveLetter + "Program Files (x86)/Autodesk";
+
+            // 2. Arnold 的其他安装位置
+            searchPaths << driveLetter + "solidangle";
+            searchPaths << driveLetter + "Program Files/solidangle";
+            searchPaths << driveLetter + "Program Files (x86)/solidangle";
+            searchPaths << driveLetter + "Arnold";
+            searchPaths << driveLetter + "Program Files/Arnold";
+            searchPaths << driveLetter + "Program Files (x86)/Arnold";
+
+            // 3. Yeti 的标准安装位置
+            searchPaths << driveLetter + "Program Files/Peregrine Labs";
+            searchPaths << driveLetter + "Peregrine Labs";
+
+            // 4. V-Ray 位置
+            searchPaths << driveLetter + "Program Files/Chaos Group";
+
+            // 5. Redshift 位置
+            searchPaths << driveLetter + "ProgramData/Redshift";
+
+            // 6. 通用插件位置
+            searchPaths << driveLetter + "ProgramData/Autodesk";
+        }
+
+        // 调用方会为同一插件给出多个候选扩展名（如 mtoa.mll / mtoa.dll），按插件名分组，
+        // 每个插件任一候选文件找到与当前 Maya 版本匹配的路径即可
+        QHash<QString, QStringList> pluginGroups;
+        for (const QString &fileName : pendingNames) {
+            pluginGroups[QFileInfo(fileName).completeBaseName().toLower()] << fileName;
+        }
+
+        // 所有文件名一次遍历；每个插件都找到与当前 Maya 版本匹配的文件后提前结束
+        FileCrawler crawler;
+        crawler.setMaxDepth(PLUGIN_SEARCH_DEPTH);
+        crawler.setCancelFlag(&m_detectionCancelled);
+        crawler.setStopCondition([&pluginGroups, &mayaVersion](const QHash<QString, QStringList> &results) {
+            for (const QStringList &candidates : pluginGroups) {
+                bool matched = false;
+                for (const QString &fileName : candidates) {
+                    for (const QString &path : results.value(fileName)) {
+                        if (path.contains(mayaVersion, Qt::CaseInsensitive)) {
+                            matched = true;
+                            break;
                         }
                     }
+                    if (matched) {
+                        break;
+                    }
                 }
-            }
-
-            // 使用 QDirIterator 递归搜索（限制深度避免太慢）
-            QDirIterator it(basePath,
-                           QStringList() << pluginFileName,
-                           QDir::Files,
-                           QDirIterator::Subdirectories);
-
-            while (it.hasNext()) {
-                QString foundPath = it.next();
-                qDebug() << "    ✓✓✓ 找到!" << foundPath;
-
-                // 检查是否与 Maya 版本匹配
-                if (foundPath.contains(mayaVersion, Qt::CaseInsensitive) ||
-                    foundPath.contains("maya" + mayaVersion, Qt::CaseInsensitive)) {
-                    qDebug() << "      [版本匹配] 添加到结果列表（优先级高）";
-                    foundPaths.prepend(foundPath);  // 版本匹配的放在前面
-                } else {
-                    qDebug() << "      添加到结果列表";
-                    foundPaths.append(foundPath);
+                if (!matched) {
+                    return false;
                 }
             }
+            return true;
+        });
+
+        QHash<QString, QStringList> crawled = crawler.find(searchPaths, pendingNames);
+        qDebug() << "  遍历了" << crawler.directoriesVisited() << "个目录"
+                 << (crawler.stoppedEarly() ? "（已全部找到，提前结束）" : "");
+
+        // 检测被取消时结果不完整，不放入缓存
+        if (!crawler.isCancelled()) {
+            QMutexLocker locker(&m_pluginSearchMutex);
+            for (const QString &fileName : pendingNames) {
+                m_pluginSearchCache.insert(mayaVersion + "|" + fileName, crawled.value(fileName));
+            }
         }
     }
 
-    if (foundPaths.isEmpty()) {
-        qDebug() << "========== 未找到" << pluginFileName << "==========\n";
-    } else {
-        qDebug() << "========== 找到" << foundPaths.size() << "个" << pluginFileName << "文件 ==========";
-        for (const QString &path : foundPaths) {
-            qDebug() << "  -" << path;
+    for (const QString &fileName : pluginFileNames) {
+        // 与 Maya 版本匹配的路径优先
+        QStringList paths;
+        {
+            QMutexLocker locker(&m_pluginSearchMutex);
+            paths = m_pluginSearchCache.value(mayaVersion + "|" + fileName);
         }
-        qDebug() << "==========\n";
+        std::stable_partition(paths.begin(), paths.end(), [&mayaVersion](const QString &path) {
+            return path.contains(mayaVersion, Qt::CaseInsensitive);
+        });
+
+        if (paths.isEmpty()) {
+            qDebug() << "  未找到" << fileName;
+            continue;
+        }
+
+        qDebug() << "  找到" << paths.size() << "个" << fileName << "文件:";
+        for (const QString &path : paths) {
+            qDebug() << "    -" << path;
+        }
+        foundPaths.insert(fileName, paths);
     }
+    qDebug() << "========== 暴力搜索插件完成 ==========\n";
 #endif
 
     return foundPaths;
@@ -1597,56 +1926,39 @@ QStringList MayaDetector::bruteForceSearchMaya()
 #ifdef Q_OS_WIN
     qDebug() << "========== 开始暴力搜索 Maya 安装 ==========";
 
-    // 获取所有可用驱动器
+    // 每个驱动器从根目录搜索（Program Files 在其中，不再重复遍历）
+    // 例如: D:/Program Files/Autodesk/Maya2022/bin/maya.exe (深度4层)
+    QStringList searchPaths;
     QFileInfoList drives = QDir::drives();
-    qDebug() << "可用驱动器:" << drives.size() << "个";
-
     for (const QFileInfo &drive : drives) {
-        QString driveLetter = drive.absolutePath();  // 例如 "C:/", "D:/"
-        qDebug() << "\n正在搜索驱动器:" << driveLetter;
-
-        // 定义要搜索的基础路径
-        QStringList searchBasePaths;
-        searchBasePaths << driveLetter + "Program Files";
-        searchBasePaths << driveLetter + "Program Files (x86)";
-        searchBasePaths << driveLetter;  // 有些用户直接安装在根目录
-
-        for (const QString &basePath : searchBasePaths) {
-            QDir baseDir(basePath);
-            if (!baseDir.exists()) {
-                continue;
-            }
-
-            qDebug() << "  搜索基础路径:" << basePath;
-
-            // 使用 QDirIterator 递归搜索 maya.exe
-            // 限制深度为3层避免搜索太深太慢
-            // 例如: D:/Program Files/Autodesk/Maya2022/bin/maya.exe (深度4层)
-            QDirIterator it(basePath,
-                           QStringList() << "maya.exe",
-                           QDir::Files,
-                           QDirIterator::Subdirectories);
-
-            while (it.hasNext()) {
-                QString mayaExePath = it.next();
-                qDebug() << "    ✓✓✓ 找到 maya.exe:" << mayaExePath;
-
-                // 从 maya.exe 路径推导出安装路径
-                // maya.exe 在 {安装路径}/bin/maya.exe
-                QFileInfo fileInfo(mayaExePath);
-                QDir binDir = fileInfo.dir();  // bin 目录
-                if (binDir.dirName().toLower() == "bin") {
-                    binDir.cdUp();  // 回到安装目录
-                    QString mayaInstallPath = binDir.absolutePath();
-
-                    // 验证这是一个合法的 Maya 安装目录（应该包含版本号）
-                    if (mayaInstallPath.contains(QRegularExpression("Maya\\d{4}", QRegularExpression::CaseInsensitiveOption))) {
-                        qDebug() << "      [有效 Maya 安装] 添加:" << mayaInstallPath;
-                        mayaPaths.append(mayaInstallPath);
-                    } else {
-                        qDebug() << "      [跳过] 路径不包含版本号:" << mayaInstallPath;
-                    }
-                }
+        searchPaths << drive.absolutePath();  // 例如 "C:/", "D:/"
+    }
+    qDebug() << "搜索驱动器:" << searchPaths;
+
+    FileCrawler crawler;
+    crawler.setMaxDepth(MAYA_SEARCH_DEPTH);
+    crawler.setSkipDirectories(FileCrawler::defaultSkipDirectories() << "AppData");
+    crawler.setCancelFlag(&m_detectionCancelled);
+    QStringList found = crawler.find(searchPaths, QStringList() << "maya.exe").value("maya.exe");
+    qDebug() << "遍历了" << crawler.directoriesVisited() << "个目录";
+
+    for (const QString &mayaExePath : found) {
+        qDebug() << "    ✓✓✓ 找到 maya.exe:" << mayaExePath;
+
+        // 从 maya.exe 路径推导出安装路径
+        // maya.exe 在 {安装路径}/bin/maya.exe
+        QFileInfo fileInfo(mayaExePath);
+        QDir binDir = fileInfo.dir();  // bin 目录
+        if (binDir.dirName().toLower() == "bin") {
+            binDir.cdUp();  // 回到安装目录
+            QString mayaInstallPath = binDir.absolutePath();
+
+            // 验证这是一个合法的 Maya 安装目录（应该包含版本号）
+            if (mayaInstallPath.contains(QRegularExpression("Maya\\d{4}", QRegularExpression::CaseInsensitiveOption))) {
+                qDebug() << "      [有效 Maya 安装] 添加:" << mayaInstallPath;
+                mayaPaths.append(mayaInstallPath);
+            } else {
+                qDebug() << "      [跳过] 路径不包含版本号:" << mayaInstallPath;
             }
         }
     }
@@ -2419,19 +2731,23 @@ QList<RendererInfo> MayaDetector::scanAllPluginDirectories(const QString &mayaVe
 
 QList<RendererInfo> MayaDetector::getAllMayaPlugins(const QString &mayaVersion)
 {
-    QList<RendererInfo> allPlugins;
-    
     qDebug() << "========== 获取 Maya 所有插件信息 ==========";
     qDebug() << "Maya 版本:" << mayaVersion;
     
     // 方法1: 通过 Maya 命令获取插件信息（最准确的方法）
-    QList<RendererInfo> mayaCommandPlugins = getPluginsFromMayaCommands(mayaVersion);
-    for (const RendererInfo &plugin : mayaCommandPlugins) {
-        allPlugins.append(plugin);
-    }
-    
     // 方法2: 从配置文件读取已加载插件（备用方法）
-    QList<RendererInfo> prefsPlugins = readPluginsFromPrefs(mayaVersion);
+    // 方法3: 扫描所有插件目录（最后的备用方法）
+    return mergeRendererPlugins(getPluginsFromMayaCommands(mayaVersion),
+                                readPluginsFromPrefs(mayaVersion),
+                                scanAllPluginDirectories(mayaVersion));
+}
+
+QList<RendererInfo> MayaDetector::mergeRendererPlugins(const QList<RendererInfo> &commandPlugins,
+                                                       const QList<RendererInfo> &prefsPlugins,
+                                                       const QList<RendererInfo> &scannedPlugins)
+{
+    QList<RendererInfo> allPlugins = commandPlugins;
+    
     for (const RendererInfo &plugin : prefsPlugins) {
         // 检查是否已经存在
         bool alreadyExists = false;
@@ -2447,8 +2763,6 @@ QList<RendererInfo> MayaDetector::getAllMayaPlugins(const QString &mayaVersion)
         }
     }
     
-    // 方法3: 扫描所有插件目录（最后的备用方法）
-    QList<RendererInfo> scannedPlugins = scanAllPluginDirectories(mayaVersion);
     for (const RendererInfo &scannedPlugin : scannedPlugins) {
         // 检查是否已经存在
         bool alreadyExists = false;
@@ -2466,7 +2780,7 @@ QList<RendererInfo> MayaDetector::getAllMayaPlugins(const QString &mayaVersion)
     }
     
     qDebug() << "总计找到" << allPlugins.size() << "个插件";
-    qDebug() << "  - Maya 命令检测:" << mayaCommandPlugins.size() << "个";
+    qDebug() << "  - Maya 命令检测:" << commandPlugins.size() << "个";
     qDebug() << "  - 配置文件检测:" << prefsPlugins.size() << "个";
     qDebug() << "  - 目录扫描检测:" << scannedPlugins.size() << "个";
     qDebug() << "========== 所有插件信息获取完成 ==========";
@@ -2479,47 +2793,23 @@ QString MayaDetector::executeMayaMelCommand(const QString &mayaExecutablePath, c
     qDebug() << "========== 执行 Maya MEL 命令 ==========";
     qDebug() << "Maya 路径:" << mayaExecutablePath;
     qDebug() << "MEL 命令:" << melCommand;
-    
+
     if (!QFile::exists(mayaExecutablePath)) {
         qDebug() << "Maya 可执行文件不存在:" << mayaExecutablePath;
         return QString();
     }
-    
-    QProcess mayaProcess;
-    
-    // 构建完整的命令
-    QStringList arguments;
-    arguments << "-batch";           // 批处理模式
-    arguments << "-noAutoloadPlugins"; // 不自动加载插件（加快启动）
-    arguments << "-command";         // 执行命令
-    arguments << melCommand;         // MEL 命令
-    
-    qDebug() << "执行命令:" << mayaExecutablePath << arguments.join(" ");
-    
-    mayaProcess.start(mayaExecutablePath, arguments);
-    
-    if (!mayaProcess.waitForStarted(30000)) { // 30秒超时
-        qDebug() << "Maya 进程启动失败";
-        return QString();
-    }
-    
-    if (!mayaProcess.waitForFinished(60000)) { // 60秒超时
-        qDebug() << "Maya 进程执行超时";
-        mayaProcess.kill();
+
+    // 由常驻 Maya 进程执行，只有第一次查询需要等待 Maya 启动
+    MayaBatchResult result = MayaBatchRunner::instance().execute(mayaExecutablePath, melCommand).result();
+    if (!result.success) {
+        qDebug() << "MEL 命令执行失败:" << result.error;
         return QString();
     }
-    
-    QString output = mayaProcess.readAllStandardOutput();
-    QString error = mayaProcess.readAllStandardError();
-    
-    qDebug() << "标准输出:" << output;
-    if (!error.isEmpty()) {
-        qDebug() << "错误输出:" << error;
-    }
-    
+
+    qDebug() << "标准输出:" << result.output;
     qDebug() << "========== Maya MEL 命令执行完成 ==========";
-    
-    return output;
+
+    return result.output;
 }
 
 QList<RendererInfo> MayaDetector::getPluginsFromMayaCommands(const QString &mayaVersion)
@@ -2545,48 +2835,9 @@ QList<RendererInfo> MayaDetector::getPluginsFromMayaCommands(const QString &maya
         }
     )";
     
-    QString loadedOutput = executeMayaMelCommand(mayaExecutablePath, loadedPluginsCommand);
-    QStringList loadedPluginNames = loadedOutput.split('\n', Qt::SkipEmptyParts);
-    
-    qDebug() << "已加载插件数量:" << loadedPluginNames.size();
-    for (const QString &pluginName : loadedPluginNames) {
-        qDebug() << "  已加载:" << pluginName;
-        
-        // 只处理渲染器相关插件
-        if (pluginName.contains("mtoa", Qt::CaseInsensitive) ||
-            pluginName.contains("vray", Qt::CaseInsensitive) ||
-            pluginName.contains("redshift", Qt::CaseInsensitive) ||
-            pluginName.contains("arnold", Qt::CaseInsensitive) ||
-            pluginName.contains("yeti", Qt::CaseInsensitive) ||
-            pluginName.contains("miarmy", Qt::CaseInsensitive)) {
-            
-            // 获取插件详细信息
-            QString pluginInfoCommand = QString(R"(
-                string $plugin = "%1";
-                string $version = `pluginInfo $plugin -query -version`;
-                string $path = `pluginInfo $plugin -query -path`;
-                string $vendor = `pluginInfo $plugin -query -vendor`;
-                print("PLUGIN_INFO:" + $plugin + "|" + $version + "|" + $path + "|" + $vendor + "\n");
-            )").arg(pluginName);
-            
-            QString pluginInfoOutput = executeMayaMelCommand(mayaExecutablePath, pluginInfoCommand);
-            
-            // 解析插件信息
-            QRegularExpression infoRegex(R"(PLUGIN_INFO:([^|]+)\|([^|]+)\|([^|]+)\|([^|]+))");
-            QRegularExpressionMatch match = infoRegex.match(pluginInfoOutput);
-            
-            if (match.hasMatch()) {
-                RendererInfo renderer;
-                renderer.name = match.captured(1);
-                renderer.version = match.captured(2);
-                renderer.pluginPath = match.captured(3);
-                renderer.isLoaded = true;
-                
-                plugins.append(renderer);
-                qDebug() << "    插件信息:" << renderer.name << "版本:" << renderer.version << "路径:" << renderer.pluginPath;
-            }
-        }
-    }
+    // 所有查询发给同一个常驻 Maya 进程，先全部提交再依次取结果
+    MayaBatchRunner &runner = MayaBatchRunner::instance();
+    QFuture<MayaBatchResult> loadedFuture = runner.execute(mayaExecutablePath, loadedPluginsCommand);
     
     // 方法2: 获取所有可用的插件（包括未加载的）
     QString allPluginsCommand = R"(
@@ -2623,60 +2874,103 @@ QList<RendererInfo> MayaDetector::getPluginsFromMayaCommands(const QString &maya
         }
     )";
     
-    QString allPluginsOutput = executeMayaMelCommand(mayaExecutablePath, allPluginsCommand);
+    QFuture<MayaBatchResult> allPluginsFuture = runner.execute(mayaExecutablePath, allPluginsCommand);
+
+    QString loadedOutput = loadedFuture.result().output;
+    QStringList loadedPluginNames = loadedOutput.split('\n', Qt::SkipEmptyParts);
+
+    qDebug() << "已加载插件数量:" << loadedPluginNames.size();
+    QList<QFuture<MayaBatchResult>> pluginInfoFutures;
+    for (const QString &pluginName : loadedPluginNames) {
+        qDebug() << "  已加载:" << pluginName;
+
+        // 只处理渲染器相关插件
+        if (isRendererPluginName(pluginName)) {
+            // 获取插件详细信息
+            QString pluginInfoCommand = QString(R"(
+                string $plugin = "%1";
+                string $version = `pluginInfo $plugin -query -version`;
+                string $path = `pluginInfo $plugin -query -path`;
+                string $vendor = `pluginInfo $plugin -query -vendor`;
+                print("PLUGIN_INFO:" + $plugin + "|" + $version + "|" + $path + "|" + $vendor + "\n");
+            )").arg(pluginName.trimmed());
+
+            pluginInfoFutures.append(runner.execute(mayaExecutablePath, pluginInfoCommand));
+        }
+    }
+
+    // 解析插件信息
+    QRegularExpression infoRegex(R"(PLUGIN_INFO:([^|]+)\|([^|]+)\|([^|]+)\|([^|\n]+))");
+    for (QFuture<MayaBatchResult> &future : pluginInfoFutures) {
+        QRegularExpressionMatch match = infoRegex.match(future.result().output);
+
+        if (match.hasMatch()) {
+            RendererInfo renderer;
+            renderer.name = match.captured(1);
+            renderer.version = match.captured(2);
+            renderer.pluginPath = match.captured(3);
+            renderer.isLoaded = true;
+
+            plugins.append(renderer);
+            qDebug() << "    插件信息:" << renderer.name << "版本:" << renderer.version << "路径:" << renderer.pluginPath;
+        }
+    }
+
+    QString allPluginsOutput = allPluginsFuture.result().output;
     QStringList allPluginLines = allPluginsOutput.split('\n', Qt::SkipEmptyParts);
     
     qDebug() << "所有可用插件数量:" << allPluginLines.size();
-    
+
+    QList<QFuture<MayaBatchResult>> pluginPathFutures;
+    QSet<QString> queriedPlugins;
     for (const QString &line : allPluginLines) {
         if (line.startsWith("AVAILABLE_PLUGIN:")) {
-            QString pluginName = line.mid(17); // 移除 "AVAILABLE_PLUGIN:" 前缀
-            
+            QString pluginName = line.mid(17).trimmed(); // 移除 "AVAILABLE_PLUGIN:" 前缀
+
             // 只处理渲染器相关插件
-            if (pluginName.contains("mtoa", Qt::CaseInsensitive) ||
-                pluginName.contains("vray", Qt::CaseInsensitive) ||
-                pluginName.contains("redshift", Qt::CaseInsensitive) ||
-                pluginName.contains("arnold", Qt::CaseInsensitive) ||
-                pluginName.contains("yeti", Qt::CaseInsensitive) ||
-                pluginName.contains("miarmy", Qt::CaseInsensitive)) {
-                
-                // 检查是否已经在已加载列表中
-                bool alreadyLoaded = false;
-                for (const RendererInfo &existingPlugin : plugins) {
-                    if (existingPlugin.name == pluginName) {
-                        alreadyLoaded = true;
-                        break;
-                    }
-                }
-                
-                if (!alreadyLoaded) {
-                    // 获取插件路径信息
-                    QString pluginPathCommand = QString(R"(
-                        string $plugin = "%1";
-                        string $path = `pluginInfo $plugin -query -path`;
-                        print("PLUGIN_PATH:" + $plugin + "|" + $path + "\n");
-                    )").arg(pluginName);
-                    
-                    QString pathOutput = executeMayaMelCommand(mayaExecutablePath, pluginPathCommand);
-                    
-                    QRegularExpression pathRegex(R"(PLUGIN_PATH:([^|]+)\|([^|]+))");
-                    QRegularExpressionMatch pathMatch = pathRegex.match(pathOutput);
-                    
-                    if (pathMatch.hasMatch()) {
-                        RendererInfo renderer;
-                        renderer.name = pathMatch.captured(1);
-                        renderer.pluginPath = pathMatch.captured(2);
-                        renderer.version = "Unknown";
-                        renderer.isLoaded = false;
-                        
-                        plugins.append(renderer);
-                        qDebug() << "    可用插件:" << renderer.name << "路径:" << renderer.pluginPath;
-                    }
+            if (!isRendererPluginName(pluginName) || queriedPlugins.contains(pluginName)) {
+                continue;
+            }
+
+            // 检查是否已经在已加载列表中
+            bool alreadyLoaded = false;
+            for (const RendererInfo &existingPlugin : plugins) {
+                if (existingPlugin.name == pluginName) {
+                    alreadyLoaded = true;
+                    break;
                 }
             }
+
+            if (!alreadyLoaded) {
+                // 获取插件路径信息
+                QString pluginPathCommand = QString(R"(
+                    string $plugin = "%1";
+                    string $path = `pluginInfo $plugin -query -path`;
+                    print("PLUGIN_PATH:" + $plugin + "|" + $path + "\n");
+                )").arg(pluginName);
+
+                queriedPlugins.insert(pluginName);
+                pluginPathFutures.append(runner.execute(mayaExecutablePath, pluginPathCommand));
+            }
         }
     }
-    
+
+    QRegularExpression pathRegex(R"(PLUGIN_PATH:([^|]+)\|([^|\n]+))");
+    for (QFuture<MayaBatchResult> &future : pluginPathFutures) {
+        QRegularExpressionMatch pathMatch = pathRegex.match(future.result().output);
+
+        if (pathMatch.hasMatch()) {
+            RendererInfo renderer;
+            renderer.name = pathMatch.captured(1);
+            renderer.pluginPath = pathMatch.captured(2);
+            renderer.version = "Unknown";
+            renderer.isLoaded = false;
+
+            plugins.append(renderer);
+            qDebug() << "    可用插件:" << renderer.name << "路径:" << renderer.pluginPath;
+        }
+    }
+
     qDebug() << "通过 Maya 命令共找到" << plugins.size() << "个渲染器插件";
     qDebug() << "========== Maya 命令插件检测完成 ==========";
     
@@ -1,9 +1,19 @@
 #pragma once
 
+#include <QHash>
+#include <QMutex>
 #include <QObject>
 #include <QString>
 #include <QStringList>
+#include <QThreadPool>
 #include <QVector>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include "SceneInfo.h"
+#include "ParallelSceneScanner.h"
+#include "SceneInfoCache.h"
+#include "AssetResolver.h"
 
 /**
  * @brief Maya 软件信息结构体
@@ -46,14 +56,78 @@ class MayaDetector : public QObject
     Q_OBJECT
 
 public:
+    /**
+     * @brief 本地缓存设置（场景分析缓存、Maya 安装索引）
+     *
+     * Config 基于 QSettings，不能在工作线程中读取；在 GUI 线程用 fromConfig() 读取后传入。
+     */
+    struct CacheSettings {
+        QString cachePath;      // 缓存根目录
+        qint64 maxSize = 0;     // 场景分析缓存总大小上限（字节），<= 0 时使用默认值
+
+        /**
+         * @brief 从 Config 读取（只能在 GUI 线程调用）
+         */
+        static CacheSettings fromConfig();
+    };
+
+    /**
+     * @brief 在 GUI 线程创建时使用，缓存设置从 Config 读取
+     */
     explicit MayaDetector(QObject *parent = nullptr);
+
+    /**
+     * @brief 在工作线程创建时使用，缓存设置由调用方在 GUI 线程读取后传入
+     */
+    explicit MayaDetector(const CacheSettings &cacheSettings, QObject *parent = nullptr);
     ~MayaDetector();
 
     /**
      * @brief 扫描系统中安装的所有 Maya 版本
+     *
+     * 检测结果保存在本地安装索引中（见 MayaInstallIndex）。索引的来源目录
+     * 未发生变化时只做 stat 校验并直接返回索引内容，不再重新扫描。
+     *
+     * @param forceRescan 为 true 时忽略索引，执行完整扫描（用户手动刷新）
      * @return Maya 软件信息列表
      */
-    QVector<MayaSoftwareInfo> detectAllMayaVersions();
+    QVector<MayaSoftwareInfo> detectAllMayaVersions(bool forceRescan = false);
+
+    /**
+     * @brief 异步扫描所有 Maya 版本（立即返回）
+     *
+     * 检测拆分为互相独立的阶段，在本对象的线程池中并行执行：
+     * 1. 读取注册表和环境变量，校验安装索引
+     * 2. 逐个验证候选安装路径
+     * 3. 每个 Maya 版本的渲染器检测（Maya 命令、插件配置文件、插件目录扫描，
+     *    都没有结果时再执行备用检测）和插件检测
+     *
+     * 每确认一个 Maya 版本发出 mayaVersionFound，每找到一个渲染器发出 rendererDetected，
+     * 一个版本全部检测完成发出 mayaVersionDetected，最后发出 detectionCompleted。
+     * 信号在工作线程中发出，接收者位于界面线程时自动排队，不会阻塞界面。
+     * 已有检测在进行时先取消并等待其结束。
+     *
+     * @param forceRescan 为 true 时忽略索引，执行完整扫描
+     */
+    void startDetection(bool forceRescan = false);
+
+    /**
+     * @brief 取消异步检测（线程安全，立即返回）
+     *
+     * 正在执行的阶段结束后不再提交新阶段，全部结束时发出 detectionCancelled
+     * 而不是 detectionCompleted。需要等待时再调用 waitForDetection()。
+     */
+    void cancelDetection();
+
+    /**
+     * @brief 等待异步检测结束
+     */
+    void waitForDetection();
+
+    /**
+     * @brief 是否有异步检测正在进行
+     */
+    bool isDetecting() const { return m_detecting; }
 
     /**
      * @brief 检测指定路径的 Maya 安装信息
@@ -90,10 +164,21 @@ public:
      */
     QString extractRendererFromScene(const QString &sceneFilePath);
 
+    /**
+     * @brief 解析场景文件（版本、渲染器、依赖插件、文件属性、引用）
+     *
+     * 结果按文件指纹缓存在本地，场景未修改时不再重新解析。
+     * .ma 文件多线程解析，通过 detectProgress 汇报进度，可在其他线程调用 cancel() 取消。
+     *
+     * @param sceneFilePath 场景文件路径
+     * @return 解析结果，无法解析或已取消时 isValid 为 false
+     */
+    SceneInfo parseScene(const QString &sceneFilePath);
+
     /**
      * @brief 扫描场景文件的纹理和素材依赖
      * @param sceneFilePath 场景文件路径
-     * @return 素材文件路径列表
+     * @return 素材文件路径列表（含引用的场景文件，不递归展开）
      */
     QStringList scanSceneAssets(const QString &sceneFilePath);
 
@@ -104,6 +189,26 @@ public:
      */
     QStringList detectMissingAssets(const QString &sceneFilePath);
 
+    /**
+     * @brief 根据已解析的场景信息检测缺失的素材文件
+     * @param sceneInfo parseScene() 的结果
+     * @param sceneFilePath 场景文件路径（用于解析相对路径）
+     * @return 缺失的文件路径列表
+     */
+    QStringList detectMissingAssets(const SceneInfo &sceneInfo, const QString &sceneFilePath);
+
+    /**
+     * @brief 取消正在进行的场景解析（线程安全）
+     *
+     * 取消后本对象上的场景解析立即返回，需要重新检测时应创建新的 MayaDetector。
+     */
+    void cancel();
+
+    /**
+     * @brief 是否已取消
+     */
+    bool isCancelled() const;
+
 signals:
     /**
      * @brief 检测进度信号
@@ -117,7 +222,67 @@ signals:
      */
     void detectFinished();
 
+    /**
+     * @brief 确认了一个有效的 Maya 安装（版本号、路径已知，渲染器和插件尚未检测）
+     */
+    void mayaVersionFound(const MayaSoftwareInfo &info);
+
+    /**
+     * @brief 为某个 Maya 安装找到一个渲染器
+     * @param installPath Maya 安装路径
+     * @param renderer 渲染器信息
+     */
+    void rendererDetected(const QString &installPath, const RendererInfo &renderer);
+
+    /**
+     * @brief 一个 Maya 安装的渲染器和插件检测全部完成
+     */
+    void mayaVersionDetected(const MayaSoftwareInfo &info);
+
+    /**
+     * @brief 异步检测完成
+     * @param results 全部 Maya 安装（按候选路径顺序）
+     */
+    void detectionCompleted(const QVector<MayaSoftwareInfo> &results);
+
+    /**
+     * @brief 异步检测被取消，所有阶段已结束
+     */
+    void detectionCancelled();
+
 private:
+    struct DetectionRun;
+    struct InstallJob;
+
+    // 检测流水线的各阶段（在 m_detectPool 中执行）
+    void runStage(const std::shared_ptr<DetectionRun> &run, const std::function<void()> &stage);
+    void discoverStage(const std::shared_ptr<DetectionRun> &run);
+    void validateStage(const std::shared_ptr<DetectionRun> &run, const QString &path, int order, bool bruteForce);
+    void bruteForceStage(const std::shared_ptr<DetectionRun> &run);
+    void rendererStage(const std::shared_ptr<DetectionRun> &run, const std::shared_ptr<InstallJob> &job,
+                       int source, const QList<RendererInfo> &renderers);
+    void finishRenderers(const std::shared_ptr<DetectionRun> &run, const std::shared_ptr<InstallJob> &job,
+                         const QVector<RendererInfo> &renderers);
+    void completeInstallIfReady(const std::shared_ptr<DetectionRun> &run, const std::shared_ptr<InstallJob> &job);
+    void finishDetection(const std::shared_ptr<DetectionRun> &run);
+
+    /**
+     * @brief 读取 Maya 安装的基本信息（版本号、可执行文件），不检测渲染器和插件
+     */
+    MayaSoftwareInfo basicMayaInfo(const QString &installPath);
+
+    /**
+     * @brief 合并三种来源的渲染器插件（Maya 命令优先，按名称/路径去重）
+     */
+    QList<RendererInfo> mergeRendererPlugins(const QList<RendererInfo> &commandPlugins,
+                                             const QList<RendererInfo> &prefsPlugins,
+                                             const QList<RendererInfo> &scannedPlugins);
+
+    /**
+     * @brief 备用渲染器检测：pluginPrefs.mel 和 Maya 安装目录（完整检测没有结果时使用）
+     */
+    QVector<RendererInfo> detectFallbackRenderers(const MayaSoftwareInfo &mayaInfo);
+
     /**
      * @brief 从注册表读取 Maya 安装信息 (Windows)
      * @return Maya 安装路径列表
@@ -130,6 +295,13 @@ private:
      */
     QStringList scanCommonInstallPaths();
 
+    /**
+     * @brief 安装索引依赖的目录和文件
+     * @param installs 检测到的 Maya 安装
+     * @return 需要记录修改时间的路径列表
+     */
+    QStringList installIndexSources(const QVector<MayaSoftwareInfo> &installs);
+
     /**
      * @brief 从路径提取 Maya 版本号
      * @param path 路径字符串
@@ -151,20 +323,6 @@ private:
      */
     bool isValidMayaInstall(const QString &path);
 
-    /**
-     * @brief 读取 Maya 场景文件的文本内容 (.ma文件)
-     * @param sceneFilePath 场景文件路径
-     * @return 文件内容
-     */
-    QString readMayaAsciiScene(const QString &sceneFilePath);
-
-    /**
-     * @brief 解析 Maya 二进制场景文件 (.mb文件)
-     * @param sceneFilePath 场景文件路径
-     * @return 解析的文本内容
-     */
-    QString parseMayaBinaryScene(const QString &sceneFilePath);
-
     /**
      * @brief 检测 Arnold 渲染器
      * @param mayaPath Maya 安装路径
@@ -215,15 +373,19 @@ private:
     QStringList scanThirdPartyPluginRegistry(const QString &mayaVersion);
 
     /**
-     * @brief 暴力搜索特定插件文件（全盘扫描）
-     * @param pluginFileName 插件文件名 (如 "mtoa.mll", "pgYetiMaya.mll")
-     * @param mayaVersion Maya 版本号（用于优先搜索）
-     * @return 找到的插件完整路径列表
+     * @brief 暴力搜索插件文件（多线程，所有文件名一次遍历）
+     *
+     * 每个文件名都找到与 mayaVersion 匹配的路径后提前结束；
+     * 结果按 Maya 版本 + 文件名缓存在本对象中，重复查询不再遍历磁盘。
+     *
+     * @param pluginFileNames 插件文件名 (如 "mtoa.mll", "pgYetiMaya.mll")
+     * @param mayaVersion Maya 版本号（版本匹配的路径排在前面）
+     * @return 文件名 -> 找到的插件完整路径列表；未找到的文件名不在结果中
      */
-    QStringList bruteForceSearchPlugin(const QString &pluginFileName, const QString &mayaVersion);
+    QHash<QString, QStringList> bruteForceSearchPlugins(const QStringList &pluginFileNames, const QString &mayaVersion);
 
     /**
-     * @brief 暴力搜索 Maya 可执行文件（全盘扫描）
+     * @brief 暴力搜索 Maya 可执行文件（各驱动器多线程限深搜索）
      * @return 找到的 Maya 安装路径列表
      */
     QStringList bruteForceSearchMaya();
@@ -300,10 +462,24 @@ private:
     QList<RendererInfo> getPluginsFromMayaCommands(const QString &mayaVersion);
 
     /**
-     * @brief 执行Maya MEL命令获取插件信息
+     * @brief 执行Maya MEL命令获取插件信息（由 MayaBatchRunner 的常驻进程执行，阻塞等待结果）
      * @param mayaExecutablePath Maya可执行文件路径
      * @param melCommand MEL命令
      * @return 命令输出结果
      */
     QString executeMayaMelCommand(const QString &mayaExecutablePath, const QString &melCommand);
+
+private:
+    CacheSettings m_cacheSettings;
+    ParallelSceneScanner m_sceneScanner;
+    SceneInfoCache m_sceneCache;
+    AssetResolver m_assetResolver;
+    QMutex m_pluginSearchMutex;                       // 保护 m_pluginSearchCache（检测阶段并行执行）
+    QHash<QString, QStringList> m_pluginSearchCache;  // "Maya 版本|文件名" -> 暴力搜索结果
+
+    QThreadPool m_detectPool;                         // 检测流水线线程池
+    std::atomic<bool> m_detecting;
+    std::atomic<bool> m_detectionCancelled;           // 同时用于中止暴力搜索
+    QMutex m_resultsMutex;
+    QVector<MayaSoftwareInfo> m_lastResults;          // 最近一次完成的异步检测结果
 };
@@ -0,0 +1,183 @@
+#include "MayaInstallIndex.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+// 检测规则或索引格式变化时递增，旧索引自动失效
+const int INDEX_FORMAT_VERSION = 1;
+
+QJsonObject installToJson(const MayaSoftwareInfo& info)
+{
+    QJsonObject obj;
+    obj["name"] = info.name;
+    obj["version"] = info.version;
+    obj["fullVersion"] = info.fullVersion;
+    obj["installPath"] = info.installPath;
+    obj["executablePath"] = info.executablePath;
+    obj["renderers"] = QJsonArray::fromStringList(info.renderers);
+    obj["plugins"] = QJsonArray::fromStringList(info.plugins);
+    obj["isValid"] = info.isValid;
+    return obj;
+}
+
+QStringList toStringList(const QJsonValue& value)
+{
+    QStringList list;
+    for (const QJsonValue& item : value.toArray()) {
+        list.append(item.toString());
+    }
+    return list;
+}
+
+MayaSoftwareInfo installFromJson(const QJsonObject& obj)
+{
+    MayaSoftwareInfo info;
+    info.name = obj["name"].toString();
+    info.version = obj["version"].toString();
+    info.fullVersion = obj["fullVersion"].toString();
+    info.installPath = obj["installPath"].toString();
+    info.executablePath = obj["executablePath"].toString();
+    info.renderers = toStringList(obj["renderers"]);
+    info.plugins = toStringList(obj["plugins"]);
+    info.isValid = obj["isValid"].toBool();
+    return info;
+}
+}
+
+MayaInstallIndex::MayaInstallIndex(const QString& filePath)
+    : m_filePath(filePath)
+    , m_loaded(false)
+{
+}
+
+qint64 MayaInstallIndex::stamp(const QString& path)
+{
+    QFileInfo info(path);
+    return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+QStringList MayaInstallIndex::normalized(const QStringList& paths)
+{
+    QStringList result;
+    for (const QString& path : paths) {
+        result.append(QDir::cleanPath(QDir::fromNativeSeparators(path)));
+    }
+    result.removeDuplicates();
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+bool MayaInstallIndex::load()
+{
+    m_loaded = false;
+    m_installs.clear();
+    m_candidates.clear();
+    m_stamps.clear();
+
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root["version"].toInt() != INDEX_FORMAT_VERSION) {
+        return false;
+    }
+
+    for (const QJsonValue& value : root["installs"].toArray()) {
+        m_installs.append(installFromJson(value.toObject()));
+    }
+    m_candidates = toStringList(root["candidates"]);
+
+    QJsonObject sources = root["sources"].toObject();
+    for (const QString& path : sources.keys()) {
+        m_stamps.insert(path, sources.value(path).toInteger());
+    }
+
+    // 没有任何来源记录的索引无法校验，视为无效
+    m_loaded = !m_stamps.isEmpty();
+    return m_loaded;
+}
+
+bool MayaInstallIndex::save() const
+{
+    QJsonArray installs;
+    for (const MayaSoftwareInfo& info : m_installs) {
+        installs.append(installToJson(info));
+    }
+
+    QJsonObject sources;
+    for (auto it = m_stamps.constBegin(); it != m_stamps.constEnd(); ++it) {
+        sources[it.key()] = it.value();
+    }
+
+    QJsonObject root;
+    root["version"] = INDEX_FORMAT_VERSION;
+    root["updatedAt"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["installs"] = installs;
+    root["candidates"] = QJsonArray::fromStringList(m_candidates);
+    root["sources"] = sources;
+
+    QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "MayaInstallIndex: 无法写入索引" << m_filePath;
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    if (!file.commit()) {
+        qWarning() << "MayaInstallIndex: 无法写入索引" << m_filePath;
+        return false;
+    }
+    return true;
+}
+
+bool MayaInstallIndex::isUpToDate(const QStringList& candidates) const
+{
+    if (!m_loaded) {
+        return false;
+    }
+
+    if (normalized(candidates) != m_candidates) {
+        qDebug() << "MayaInstallIndex: 候选安装路径已变化";
+        return false;
+    }
+
+    for (auto it = m_stamps.constBegin(); it != m_stamps.constEnd(); ++it) {
+        if (stamp(it.key()) != it.value()) {
+            qDebug() << "MayaInstallIndex: 来源已变化" << it.key();
+            return false;
+        }
+    }
+    return true;
+}
+
+void MayaInstallIndex::update(const QVector<MayaSoftwareInfo>& installs, const QStringList& candidates,
+                              const QStringList& sources)
+{
+    m_installs = installs;
+    m_candidates = normalized(candidates);
+    m_stamps.clear();
+    for (const QString& path : normalized(sources)) {
+        m_stamps.insert(path, stamp(path));
+    }
+    m_loaded = !m_stamps.isEmpty();
+}
+
+void MayaInstallIndex::clear()
+{
+    m_loaded = false;
+    m_installs.clear();
+    m_candidates.clear();
+    m_stamps.clear();
+    QFile::remove(m_filePath);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "MayaDetector.h"
+
+/**
+ * @brief Maya 安装索引（持久化）
+ *
+ * 完整检测需要读注册表、遍历安装目录和插件目录，找不到时还会全盘搜索，
+ * 每次打开检测窗口都重来一遍代价很高。这里把检测结果（Maya 安装、渲染器、插件）
+ * 连同检测时依据的目录/文件的修改时间一起保存到缓存目录下的 maya-index.json。
+ *
+ * 下次检测时只需对这些路径逐个 stat 并比较候选安装路径列表：
+ * 全部一致则直接使用索引；任何一个新增、删除或修改都会触发完整重新扫描。
+ * 目录的修改时间在其中增删条目时变化，安装/卸载 Maya 或插件都能被发现。
+ *
+ * 会在检测工作线程中创建，不读取 Config：索引文件路径由调用方传入。
+ */
+class MayaInstallIndex
+{
+public:
+    /**
+     * @param filePath 索引文件路径
+     */
+    explicit MayaInstallIndex(const QString& filePath);
+
+    /**
+     * @brief 从磁盘读取索引
+     * @return 文件不存在、格式版本不符或内容损坏时返回 false
+     */
+    bool load();
+
+    /**
+     * @brief 写入磁盘
+     */
+    bool save() const;
+
+    /**
+     * @brief 仅通过 stat 校验索引是否仍然有效
+     * @param candidates 当前的候选安装路径（注册表等低成本来源）
+     */
+    bool isUpToDate(const QStringList& candidates) const;
+
+    /**
+     * @brief 用完整检测的结果更新索引，并记录各来源路径当前的修改时间
+     * @param installs 检测到的 Maya 安装
+     * @param candidates 本次检测使用的候选安装路径
+     * @param sources 检测结果依赖的目录和文件（不存在的路径也会记录）
+     */
+    void update(const QVector<MayaSoftwareInfo>& installs, const QStringList& candidates, const QStringList& sources);
+
+    /**
+     * @brief 清空索引并删除索引文件
+     */
+    void clear();
+
+    bool isLoaded() const { return m_loaded; }
+    const QVector<MayaSoftwareInfo>& installs() const { return m_installs; }
+    QString filePath() const { return m_filePath; }
+
+    /**
+     * @brief 路径的时间戳：修改时间（毫秒），不存在时为 -1
+     */
+    static qint64 stamp(const QString& path);
+
+private:
+    static QStringList normalized(const QStringList& paths);
+
+    QString m_filePath;
+    bool m_loaded;
+    QVector<MayaSoftwareInfo> m_installs;
+    QStringList m_candidates;
+    QHash<QString, qint64> m_stamps;   // 来源路径 -> 修改时间
+};
@@ -0,0 +1,150 @@
+#include "ParallelSceneScanner.h"
+#include "MayaAsciiParser.h"
+#include "KeywordScanner.h"
+#include <QFile>
+#include <QSet>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrent>
+#include <QDebug>
+
+namespace {
+const qint64 MIN_PIECE_SIZE = 8 * 1024 * 1024;    // 小于此大小的段不值得切分
+const qint64 MAX_PIECE_SIZE = 64 * 1024 * 1024;   // 段越小，进度和取消越及时
+const int PIECES_PER_THREAD = 4;
+}
+
+ParallelSceneScanner::ParallelSceneScanner(int maxThreads)
+    : m_maxThreads(maxThreads > 0 ? maxThreads : QThread::idealThreadCount())
+    , m_cancelled(false)
+{
+}
+
+SceneInfo ParallelSceneScanner::scanFile(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "ParallelSceneScanner: 无法打开文件" << filePath;
+        SceneInfo info;
+        info.format = "mayaAscii";
+        return info;
+    }
+
+    qint64 size = file.size();
+    uchar* mapped = size > 0 ? file.map(0, size) : nullptr;
+    if (!mapped) {
+        // 映射失败时退回单线程分块解析
+        file.close();
+        MayaAsciiParser parser;
+        return parser.parseFile(filePath);
+    }
+
+    SceneInfo info = scanData(reinterpret_cast<const char*>(mapped), size);
+    file.unmap(mapped);
+    return info;
+}
+
+SceneInfo ParallelSceneScanner::scanData(const char* data, qint64 size)
+{
+    int threads = qMax(1, m_maxThreads);
+    qint64 pieceSize = qBound(MIN_PIECE_SIZE, size / (threads * PIECES_PER_THREAD) + 1, MAX_PIECE_SIZE);
+    QVector<QPair<qint64, qint64>> pieces = split(data, size, pieceSize);
+
+    std::atomic<qint64> scanned(0);
+    auto scanPiece = [this, data, size, &scanned](const QPair<qint64, qint64>& piece) -> SceneInfo {
+        if (m_cancelled) {
+            return SceneInfo();
+        }
+
+        MayaAsciiParser parser;
+        SceneInfo info = parser.parseData(QByteArray::fromRawData(data + piece.first, piece.second - piece.first));
+
+        qint64 done = scanned += piece.second - piece.first;
+        if (m_progressCallback) {
+            m_progressCallback(done, size);
+        }
+        return info;
+    };
+
+    QVector<SceneInfo> parts;
+    if (pieces.size() == 1 || threads == 1) {
+        for (const QPair<qint64, qint64>& piece : pieces) {
+            parts.append(scanPiece(piece));
+        }
+    } else {
+        // 独立线程池，不占用上传哈希等使用的全局线程池
+        QThreadPool pool;
+        pool.setMaxThreadCount(threads);
+        parts = QtConcurrent::blockingMapped<QVector<SceneInfo>>(&pool, pieces, scanPiece);
+    }
+
+    if (m_cancelled) {
+        SceneInfo info;
+        info.format = "mayaAscii";
+        return info;
+    }
+
+    SceneInfo info = merge(parts);
+    info.bytesParsed = size;
+    return info;
+}
+
+QVector<QPair<qint64, qint64>> ParallelSceneScanner::split(const char* data, qint64 size, qint64 pieceSize)
+{
+    // 顶层语句从行首开始，createNode / select 之前没有需要延续的节点上下文
+    static const KeywordScanner boundaries({"\ncreateNode ", "\nselect "});
+
+    QVector<QPair<qint64, qint64>> pieces;
+    qint64 start = 0;
+    while (size - start > pieceSize) {
+        qint64 target = start + pieceSize;
+        qint64 found = boundaries.findNext(data + target, size - target);
+        if (found < 0) {
+            break;
+        }
+
+        qint64 boundary = target + found + 1;
+        pieces.append(qMakePair(start, boundary));
+        start = boundary;
+    }
+    pieces.append(qMakePair(start, size));
+    return pieces;
+}
+
+SceneInfo ParallelSceneScanner::merge(const QVector<SceneInfo>& parts)
+{
+    SceneInfo merged;
+    QSet<QString> references;
+
+    for (const SceneInfo& part : parts) {
+        merged.isValid = merged.isValid || part.isValid;
+        if (merged.format.isEmpty()) {
+            merged.format = part.format;
+        }
+
+        // 与单线程解析一致：后出现的语句覆盖先出现的
+        if (!part.mayaVersion.isEmpty()) {
+            merged.mayaVersion = part.mayaVersion;
+        }
+        if (!part.currentRenderer.isEmpty()) {
+            merged.currentRenderer = part.currentRenderer;
+        }
+        for (auto it = part.fileInfo.constBegin(); it != part.fileInfo.constEnd(); ++it) {
+            merged.fileInfo.insert(it.key(), it.value());
+        }
+
+        for (const ScenePluginRequirement& plugin : part.plugins) {
+            merged.addPlugin(plugin.name, plugin.version);
+        }
+        merged.fileAttributes += part.fileAttributes;
+        for (const QString& reference : part.references) {
+            if (!references.contains(reference)) {
+                references.insert(reference);
+                merged.references.append(reference);
+            }
+        }
+        merged.bytesParsed += part.bytesParsed;
+    }
+
+    return merged;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include "SceneInfo.h"
+
+/**
+ * @brief 多线程 .ma 场景扫描
+ *
+ * 将内存映射的文件在 createNode / select 语句的行首切成若干段，
+ * 这两种语句会重置当前节点上下文，因此每段可以由独立的 MayaAsciiParser 并行解析，
+ * 最后按顺序合并各段结果，与单线程解析完全一致。
+ *
+ * 段数多于线程数，便于汇报进度和及时响应取消。
+ */
+class ParallelSceneScanner
+{
+public:
+    /**
+     * @brief 进度回调（在工作线程中调用）
+     */
+    typedef std::function<void(qint64 scannedBytes, qint64 totalBytes)> ProgressCallback;
+
+    /**
+     * @param maxThreads 最多使用的线程数，<= 0 时使用 CPU 核数
+     */
+    explicit ParallelSceneScanner(int maxThreads = 0);
+
+    void setProgressCallback(const ProgressCallback& callback) { m_progressCallback = callback; }
+
+    /**
+     * @brief 取消扫描（线程安全），扫描返回 isValid 为 false 的结果
+     */
+    void cancel() { m_cancelled = true; }
+    bool isCancelled() const { return m_cancelled; }
+
+    /**
+     * @brief 扫描 .ma 文件
+     */
+    SceneInfo scanFile(const QString& filePath);
+
+    /**
+     * @brief 扫描内存中的场景内容
+     */
+    SceneInfo scanData(const char* data, qint64 size);
+
+    /**
+     * @brief 在语句边界切分
+     * @return 各段的 [起始偏移, 结束偏移)
+     */
+    static QVector<QPair<qint64, qint64>> split(const char* data, qint64 size, qint64 pieceSize);
+
+    /**
+     * @brief 按文件顺序合并各段结果
+     */
+    static SceneInfo merge(const QVector<SceneInfo>& parts);
+
+private:
+    int m_maxThreads;
+    std::atomic<bool> m_cancelled;
+    ProgressCallback m_progressCallback;
+};
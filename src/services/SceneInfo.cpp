@@ -0,0 +1,186 @@
+#include "SceneInfo.h"
+#include <QJsonArray>
+#include <QRegularExpression>
+#include <QSet>
+
+namespace {
+// 已知的文件路径属性（小写，不含节点名和前导点）
+const QSet<QString>& knownFileAttributes()
+{
+    static const QSet<QString> attributes = {
+        "ftn", "filetexturename",       // file
+        "fn", "filename",               // aiImage, imagePlane, VRayMesh 等
+        "cfn", "cachefilename",         // cacheFile
+        "iesprofile", "aifilename",     // 光域网
+        "dso",                          // aiStandIn
+        "abc_file", "abcfile"           // AlembicNode
+    };
+    return attributes;
+}
+
+bool looksLikeFilePath(const QString& value)
+{
+    if (!value.contains('/') && !value.contains('\\')) {
+        return false;
+    }
+    int slash = qMax(value.lastIndexOf('/'), value.lastIndexOf('\\'));
+    int dot = value.lastIndexOf('.');
+    int extensionLength = value.size() - dot - 1;
+    return dot > slash + 1 && extensionLength >= 1 && extensionLength <= 5;
+}
+}
+
+QString SceneInfo::rendererName() const
+{
+    QString renderer = currentRenderer.toLower();
+    if (renderer == "arnold") {
+        return "Arnold";
+    } else if (renderer == "vray") {
+        return "V-Ray";
+    } else if (renderer == "redshift") {
+        return "Redshift";
+    } else if (renderer.startsWith("renderman")) {
+        return "RenderMan";
+    } else if (renderer == "mayahardware2") {
+        return "Maya Hardware 2.0";
+    } else if (renderer == "mayasoftware") {
+        return "Maya Software";
+    }
+
+    // 未设置当前渲染器时按依赖插件推断
+    for (const ScenePluginRequirement& plugin : plugins) {
+        QString name = plugin.name.toLower();
+        if (name == "mtoa") {
+            return "Arnold";
+        } else if (name.startsWith("vray")) {
+            return "V-Ray";
+        } else if (name.startsWith("redshift")) {
+            return "Redshift";
+        } else if (name.startsWith("renderman")) {
+            return "RenderMan";
+        }
+    }
+
+    return "Maya Software"; // 默认渲染器
+}
+
+QStringList SceneInfo::assetPaths() const
+{
+    QStringList paths;
+    QSet<QString> seen;
+
+    for (const SceneFileAttribute& attribute : fileAttributes) {
+        if (!attribute.path.isEmpty() && !seen.contains(attribute.path)) {
+            seen.insert(attribute.path);
+            paths.append(attribute.path);
+        }
+    }
+    for (const QString& reference : references) {
+        if (!seen.contains(reference)) {
+            seen.insert(reference);
+            paths.append(reference);
+        }
+    }
+
+    return paths;
+}
+
+QJsonObject SceneInfo::toJson() const
+{
+    QJsonObject info;
+    for (auto it = fileInfo.constBegin(); it != fileInfo.constEnd(); ++it) {
+        info[it.key()] = it.value();
+    }
+
+    // 用数组而非对象保存每条记录，素材多的场景缓存文件小很多
+    QJsonArray pluginArray;
+    for (const ScenePluginRequirement& plugin : plugins) {
+        pluginArray.append(QJsonArray{plugin.name, plugin.version});
+    }
+
+    QJsonArray attributeArray;
+    for (const SceneFileAttribute& attribute : fileAttributes) {
+        attributeArray.append(QJsonArray{attribute.nodeType, attribute.nodeName, attribute.attribute, attribute.path});
+    }
+
+    QJsonObject json;
+    json["isValid"] = isValid;
+    json["format"] = format;
+    json["mayaVersion"] = mayaVersion;
+    json["currentRenderer"] = currentRenderer;
+    json["fileInfo"] = info;
+    json["plugins"] = pluginArray;
+    json["fileAttributes"] = attributeArray;
+    json["references"] = QJsonArray::fromStringList(references);
+    json["bytesParsed"] = bytesParsed;
+    return json;
+}
+
+SceneInfo SceneInfo::fromJson(const QJsonObject& json)
+{
+    SceneInfo info;
+    info.isValid = json["isValid"].toBool();
+    info.format = json["format"].toString();
+    info.mayaVersion = json["mayaVersion"].toString();
+    info.currentRenderer = json["currentRenderer"].toString();
+    info.bytesParsed = json["bytesParsed"].toInteger();
+
+    QJsonObject fileInfoObject = json["fileInfo"].toObject();
+    for (auto it = fileInfoObject.constBegin(); it != fileInfoObject.constEnd(); ++it) {
+        info.fileInfo.insert(it.key(), it.value().toString());
+    }
+
+    for (const QJsonValue& value : json["plugins"].toArray()) {
+        QJsonArray plugin = value.toArray();
+        info.plugins.append(ScenePluginRequirement{plugin.at(0).toString(), plugin.at(1).toString()});
+    }
+    for (const QJsonValue& value : json["fileAttributes"].toArray()) {
+        QJsonArray attribute = value.toArray();
+        info.fileAttributes.append(SceneFileAttribute{attribute.at(0).toString(), attribute.at(1).toString(),
+                                                      attribute.at(2).toString(), attribute.at(3).toString()});
+    }
+    for (const QJsonValue& value : json["references"].toArray()) {
+        info.references.append(value.toString());
+    }
+    return info;
+}
+
+QString SceneInfo::resolvedMayaVersion() const
+{
+    if (!mayaVersion.isEmpty()) {
+        return mayaVersion;
+    }
+    return majorVersion(fileInfo.value("product"));
+}
+
+void SceneInfo::addPlugin(const QString& name, const QString& version)
+{
+    for (const ScenePluginRequirement& plugin : plugins) {
+        if (plugin.name == name) {
+            return;
+        }
+    }
+    plugins.append(ScenePluginRequirement{name, version});
+}
+
+QString SceneInfo::majorVersion(const QString& version)
+{
+    static const QRegularExpression re("(\\d{4})");
+    QRegularExpressionMatch match = re.match(version);
+    return match.hasMatch() ? match.captured(1) : version;
+}
+
+bool SceneInfo::isFileAttribute(const QString& attribute, const QString& value)
+{
+    if (value.isEmpty()) {
+        return false;
+    }
+
+    QString name = attribute.mid(attribute.lastIndexOf('.') + 1).toLower();
+    if (knownFileAttributes().contains(name)) {
+        return true;
+    }
+
+    // 其他插件的路径属性：值带目录且有扩展名
+    return looksLikeFilePath(value);
+}
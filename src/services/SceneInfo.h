@@ -0,0 +1,85 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMap>
+#include <QJsonObject>
+
+/**
+ * @brief 场景依赖的插件（requires 语句）
+ */
+struct ScenePluginRequirement {
+    QString name;       // 插件名 (mtoa, vrayformaya 等)
+    QString version;    // 插件版本
+};
+
+/**
+ * @brief 场景中引用外部文件的字符串属性
+ */
+struct SceneFileAttribute {
+    QString nodeType;   // 节点类型 (file, aiImage, cacheFile 等)
+    QString nodeName;   // 节点名
+    QString attribute;  // 属性名 (.ftn, .filename 等)
+    QString path;       // 文件路径（保持场景中的原样）
+};
+
+/**
+ * @brief 场景文件解析结果
+ *
+ * .ma 与 .mb 解析器输出同一结构，供版本检测、渲染器检测和素材扫描共用。
+ */
+struct SceneInfo {
+    bool isValid;
+    QString format;                             // mayaAscii / mayaBinary
+    QString mayaVersion;                        // requires maya 的版本 (如 "2024")
+    QString currentRenderer;                    // defaultRenderGlobals.currentRenderer 原始值
+    QMap<QString, QString> fileInfo;            // fileInfo 键值 (product, cutIdentifier 等)
+    QVector<ScenePluginRequirement> plugins;    // 依赖插件（requires 语句）
+    QVector<SceneFileAttribute> fileAttributes; // 文件属性
+    QStringList references;                     // 引用的场景文件
+    qint64 bytesParsed;
+
+    SceneInfo()
+        : isValid(false), bytesParsed(0) {}
+
+    /**
+     * @brief 渲染器显示名称 (Arnold, V-Ray, Redshift, RenderMan, Maya Software)
+     *
+     * 优先使用渲染设置中的当前渲染器，没有时根据依赖插件推断。
+     */
+    QString rendererName() const;
+
+    /**
+     * @brief Maya 主版本号，文件头和 requires 缺少版本时退回 fileInfo "product"（如 "Maya 2024"）
+     */
+    QString resolvedMayaVersion() const;
+
+    /**
+     * @brief 所有依赖文件路径（文件属性 + 引用场景，去重）
+     */
+    QStringList assetPaths() const;
+
+    /**
+     * @brief 添加依赖插件（同名插件只保留第一条）
+     */
+    void addPlugin(const QString& name, const QString& version);
+
+    /**
+     * @brief 序列化（场景分析缓存使用）
+     */
+    QJsonObject toJson() const;
+    static SceneInfo fromJson(const QJsonObject& json);
+
+    /**
+     * @brief 从版本字符串中取出主版本号 ("2024", "Maya 2024", "2020ff" -> "2020")
+     */
+    static QString majorVersion(const QString& version);
+
+    /**
+     * @brief 是否为引用外部文件的属性
+     * @param attribute 属性名（短名或长名，带前导点）
+     * @param value 属性值
+     */
+    static bool isFileAttribute(const QString& attribute, const QString& value);
+};
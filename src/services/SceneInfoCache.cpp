@@ -0,0 +1,121 @@
+#include "SceneInfoCache.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QDebug>
+
+namespace {
+// 解析结果格式或解析规则变化时递增，旧缓存自动失效
+const int CACHE_FORMAT_VERSION = 1;
+const qint64 PARTIAL_HASH_BLOCK = 64 * 1024;
+const qint64 DEFAULT_MAX_SIZE = 256 * 1024 * 1024;
+}
+
+SceneInfoCache::SceneInfoCache(const QString& directory, qint64 maxSize)
+    : m_directory(directory)
+    , m_maxSize(maxSize > 0 ? maxSize : DEFAULT_MAX_SIZE)
+{
+}
+
+QString SceneInfoCache::entryPath(const QString& sceneFilePath) const
+{
+    QByteArray key = QCryptographicHash::hash(QFileInfo(sceneFilePath).absoluteFilePath().toUtf8(),
+                                              QCryptographicHash::Sha1).toHex();
+    return m_directory + "/" + QString::fromLatin1(key) + ".json";
+}
+
+QByteArray SceneInfoCache::partialHash(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+
+    // 只读三块：覆盖文件头（版本、requires）和常见的追加/截断修改
+    qint64 size = file.size();
+    QCryptographicHash hasher(QCryptographicHash::Sha1);
+    const qint64 offsets[] = {0, size / 2 - PARTIAL_HASH_BLOCK / 2, size - PARTIAL_HASH_BLOCK};
+    for (qint64 offset : offsets) {
+        file.seek(qMax<qint64>(0, offset));
+        hasher.addData(file.read(PARTIAL_HASH_BLOCK));
+    }
+    return hasher.result().toHex();
+}
+
+bool SceneInfoCache::lookup(const QString& sceneFilePath, SceneInfo* info) const
+{
+    QString path = entryPath(sceneFilePath);
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    file.close();
+
+    // 先比较大小和修改时间，一致后再读文件内容计算部分哈希
+    QFileInfo sceneInfo(sceneFilePath);
+    if (root["version"].toInt() != CACHE_FORMAT_VERSION
+        || root["size"].toInteger() != sceneInfo.size()
+        || root["mtime"].toInteger() != sceneInfo.lastModified().toMSecsSinceEpoch()
+        || root["partialHash"].toString().toLatin1() != partialHash(sceneFilePath)) {
+        return false;
+    }
+
+    *info = SceneInfo::fromJson(root["info"].toObject());
+
+    // 刷新最近使用时间
+    QFile touch(path);
+    if (touch.open(QIODevice::ReadWrite)) {
+        touch.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    }
+    return true;
+}
+
+void SceneInfoCache::store(const QString& sceneFilePath, const SceneInfo& info)
+{
+    QFileInfo sceneInfo(sceneFilePath);
+
+    QJsonObject root;
+    root["version"] = CACHE_FORMAT_VERSION;
+    root["filePath"] = sceneInfo.absoluteFilePath();
+    root["size"] = sceneInfo.size();
+    root["mtime"] = sceneInfo.lastModified().toMSecsSinceEpoch();
+    root["partialHash"] = QString::fromLatin1(partialHash(sceneFilePath));
+    root["info"] = info.toJson();
+
+    QDir().mkpath(m_directory);
+
+    // 多个检测可能同时写同一场景，先写临时文件再替换
+    QSaveFile file(entryPath(sceneFilePath));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "SceneInfoCache: 无法写入缓存" << file.fileName();
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qWarning() << "SceneInfoCache: 无法写入缓存" << file.fileName();
+        return;
+    }
+
+    evict();
+}
+
+void SceneInfoCache::evict() const
+{
+    // 按修改时间从新到旧，累计超出上限的条目全部删除
+    QFileInfoList entries = QDir(m_directory).entryInfoList(QStringList() << "*.json", QDir::Files, QDir::Time);
+
+    qint64 total = 0;
+    for (const QFileInfo& entry : entries) {
+        total += entry.size();
+        if (total > m_maxSize) {
+            QFile::remove(entry.absoluteFilePath());
+        }
+    }
+}
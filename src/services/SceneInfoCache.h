@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include "SceneInfo.h"
+
+/**
+ * @brief 场景分析结果本地缓存
+ *
+ * 以场景绝对路径为键，记录文件指纹（大小 + 修改时间 + 部分内容哈希）和解析结果。
+ * 指纹一致时直接返回缓存结果，未修改的大场景重新打开无需再次解析。
+ *
+ * 每个场景一个 JSON 文件，存放在缓存目录（通常为 Config::cachePath()/scene-info）下；
+ * 缓存文件的修改时间作为最近使用时间，总大小超过上限时按 LRU 删除。
+ *
+ * 会在检测工作线程中创建，不读取 Config：目录和上限由调用方在 GUI 线程读取后传入。
+ */
+class SceneInfoCache
+{
+public:
+    /**
+     * @param directory 缓存目录
+     * @param maxSize 缓存总大小上限（字节），<= 0 时使用默认值（256MB）
+     */
+    SceneInfoCache(const QString& directory, qint64 maxSize);
+
+    /**
+     * @brief 查找缓存，命中时刷新最近使用时间
+     */
+    bool lookup(const QString& sceneFilePath, SceneInfo* info) const;
+
+    /**
+     * @brief 写入缓存，并在超出上限时淘汰最久未使用的条目
+     */
+    void store(const QString& sceneFilePath, const SceneInfo& info);
+
+    /**
+     * @brief 部分内容哈希：文件开头、中间、结尾各 64KB 的 SHA-1
+     */
+    static QByteArray partialHash(const QString& filePath);
+
+private:
+    QString entryPath(const QString& sceneFilePath) const;
+    void evict() const;
+
+    QString m_directory;
+    qint64 m_maxSize;
+};
@@ -0,0 +1,236 @@
+#include "ScenePackager.h"
+#include "MayaDetector.h"
+#include "AssetResolver.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QSet>
+#include <QDebug>
+#include <functional>
+
+namespace {
+const int PROJECT_SEARCH_DEPTH = 3;  // 向上查找 workspace.mel 的层数
+
+bool isSceneFile(const QString& path)
+{
+    QString suffix = QFileInfo(path).suffix().toLower();
+    return suffix == "ma" || suffix == "mb";
+}
+}
+
+QString ScenePackager::findProjectRoot(const QString& sceneDir)
+{
+    // Maya 工程目录下有 workspace.mel，场景通常在 <工程>/scenes 中
+    QDir dir(sceneDir);
+    for (int i = 0; i <= PROJECT_SEARCH_DEPTH; ++i) {
+        if (dir.exists("workspace.mel")) {
+            return dir.absolutePath();
+        }
+        if (!dir.cdUp()) {
+            break;
+        }
+    }
+    return sceneDir;
+}
+
+QVector<QStringList> ScenePackager::resolveReferences(AssetResolver& resolver, const QStringList& references,
+                                                     const QString& sceneDir, const QString& rootPath)
+{
+    QVector<QStringList> files(references.size());
+
+    // 每一轮只为尚未找到的引用生成候选路径，整批交给 AssetResolver 解析
+    auto resolveRound = [&](const std::function<QString(const QString& path, const QString& fileName)>& candidate,
+                            const QString& baseDirectory) {
+        QStringList candidates;
+        QVector<int> indices;
+        for (int i = 0; i < references.size(); ++i) {
+            if (!files[i].isEmpty()) {
+                continue;
+            }
+            QString path = QDir::fromNativeSeparators(references[i].trimmed());
+            QString value = candidate(path, QFileInfo(path).fileName());
+            if (!value.isEmpty()) {
+                candidates << value;
+                indices << i;
+            }
+        }
+        if (candidates.isEmpty()) {
+            return;
+        }
+
+        const QVector<AssetResolution> resolutions = resolver.resolve(candidates, baseDirectory);
+        for (int k = 0; k < resolutions.size(); ++k) {
+            files[indices[k]] = resolutions[k].files;
+        }
+    };
+
+    resolveRound([](const QString& path, const QString&) { return path; }, sceneDir);
+    resolveRound([](const QString& path, const QString&) {
+        return QDir::isRelativePath(path) ? path : QString();
+    }, rootPath);
+    // 其他机器上保存的绝对路径，按惯例在工程目录中查找同名文件
+    resolveRound([](const QString&, const QString& fileName) { return "sourceimages/" + fileName; }, rootPath);
+    resolveRound([](const QString&, const QString& fileName) { return fileName; }, sceneDir);
+
+    return files;
+}
+
+QString ScenePackager::mapRelativePath(const QString& localPath, const QString& rootPath)
+{
+    QString relative = QDir(rootPath).relativeFilePath(localPath);
+    if (!relative.startsWith("../") && !QDir::isAbsolutePath(relative)) {
+        return relative;
+    }
+
+    // 包外文件：按所在目录分组，同名文件不会互相覆盖
+    QFileInfo info(localPath);
+    QByteArray dirHash = QCryptographicHash::hash(info.absolutePath().toUtf8(), QCryptographicHash::Sha1).toHex().left(8);
+    return QString("external/%1/%2").arg(QString::fromLatin1(dirHash), info.fileName());
+}
+
+ScenePackage ScenePackager::collect(const QString& sceneFilePath, const MayaDetector::CacheSettings& cacheSettings)
+{
+    ScenePackage package;
+
+    QFileInfo sceneInfo(sceneFilePath);
+    QString scenePath = sceneInfo.canonicalFilePath();
+    if (scenePath.isEmpty()) {
+        return package;
+    }
+
+    package.rootPath = findProjectRoot(sceneInfo.absolutePath());
+    package.scene.localPath = scenePath;
+    package.scene.relativePath = mapRelativePath(scenePath, package.rootPath);
+    package.scene.size = sceneInfo.size();
+    package.totalBytes = package.scene.size;
+
+    MayaDetector detector(cacheSettings);
+    AssetResolver resolver;     // 目录列表在整个依赖闭包中复用
+    QSet<QString> seen;
+    QSet<QString> missing;
+    seen.insert(scenePath);
+
+    // 广度优先展开引用场景
+    QStringList pendingScenes;
+    pendingScenes << scenePath;
+
+    while (!pendingScenes.isEmpty()) {
+        QString current = pendingScenes.takeFirst();
+        QString currentDir = QFileInfo(current).absolutePath();
+
+        const QStringList references = detector.scanSceneAssets(current);
+        const QVector<QStringList> resolved = resolveReferences(resolver, references, currentDir, package.rootPath);
+        for (int i = 0; i < references.size(); ++i) {
+            const QString& reference = references[i];
+            if (resolved[i].isEmpty()) {
+                if (!missing.contains(reference)) {
+                    missing.insert(reference);
+                    package.missing.append(reference);
+                }
+                continue;
+            }
+
+            // UDIM / 序列引用展开为多个文件，清单中共用同一个原始路径
+            for (const QString& resolvedPath : resolved[i]) {
+                const QString localPath = QFileInfo(resolvedPath).canonicalFilePath();
+                if (localPath.isEmpty() || seen.contains(localPath)) {
+                    continue;
+                }
+                seen.insert(localPath);
+
+                ScenePackageFile asset;
+                asset.reference = reference;
+                asset.localPath = localPath;
+                asset.relativePath = mapRelativePath(localPath, package.rootPath);
+                asset.size = QFileInfo(localPath).size();
+                package.assets.append(asset);
+                package.totalBytes += asset.size;
+
+                if (isSceneFile(localPath)) {
+                    pendingScenes << localPath;
+                }
+            }
+        }
+    }
+
+    qDebug() << "ScenePackager: 场景依赖" << package.assets.size() << "个文件，共"
+             << (package.totalBytes / 1024 / 1024) << "MB，缺失" << package.missing.size() << "个";
+
+    return package;
+}
+
+QJsonObject ScenePackager::buildManifest(const ScenePackage& package, const QMap<QString, QJsonObject>& uploads)
+{
+    auto fileEntry = [&uploads](const ScenePackageFile& file) {
+        QJsonObject entry = uploads.value(file.localPath);
+        entry["path"] = file.relativePath;
+        entry["size"] = file.size;
+        if (!file.reference.isEmpty()) {
+            entry["reference"] = file.reference;
+        }
+        return entry;
+    };
+
+    QJsonArray files;
+    for (const ScenePackageFile& asset : package.assets) {
+        files.append(fileEntry(asset));
+    }
+
+    QJsonObject manifest;
+    manifest["version"] = 1;
+    manifest["scene"] = fileEntry(package.scene);
+    manifest["files"] = files;
+    manifest["missing"] = QJsonArray::fromStringList(package.missing);
+    manifest["totalBytes"] = package.totalBytes;
+    return manifest;
+}
+
+QJsonObject ScenePackager::packageToJson(const ScenePackage& package)
+{
+    auto fileToJson = [](const ScenePackageFile& file) {
+        QJsonObject json;
+        json["reference"] = file.reference;
+        json["localPath"] = file.localPath;
+        json["relativePath"] = file.relativePath;
+        json["size"] = file.size;
+        return json;
+    };
+
+    QJsonArray assets;
+    for (const ScenePackageFile& asset : package.assets) {
+        assets.append(fileToJson(asset));
+    }
+
+    QJsonObject json;
+    json["rootPath"] = package.rootPath;
+    json["scene"] = fileToJson(package.scene);
+    json["assets"] = assets;
+    json["missing"] = QJsonArray::fromStringList(package.missing);
+    json["totalBytes"] = package.totalBytes;
+    return json;
+}
+
+ScenePackage ScenePackager::packageFromJson(const QJsonObject& json)
+{
+    auto fileFromJson = [](const QJsonObject& object) {
+        ScenePackageFile file;
+        file.reference = object["reference"].toString();
+        file.localPath = object["localPath"].toString();
+        file.relativePath = object["relativePath"].toString();
+        file.size = object["size"].toInteger();
+        return file;
+    };
+
+    ScenePackage package;
+    package.rootPath = json["rootPath"].toString();
+    package.scene = fileFromJson(json["scene"].toObject());
+    for (const QJsonValue& value : json["assets"].toArray()) {
+        package.assets.append(fileFromJson(value.toObject()));
+    }
+    for (const QJsonValue& value : json["missing"].toArray()) {
+        package.missing.append(value.toString());
+    }
+    package.totalBytes = json["totalBytes"].toInteger();
+    return package;
+}
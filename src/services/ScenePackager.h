@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMap>
+#include <QJsonObject>
+#include "MayaDetector.h"
+
+class AssetResolver;
+
+/**
+ * @brief 场景包中的一个文件（场景本身或依赖素材）
+ */
+struct ScenePackageFile {
+    QString reference;      // 场景中记录的原始路径（场景本身为空）
+    QString localPath;      // 本地规范化绝对路径
+    QString relativePath;   // 上传后相对于包根目录的路径
+    qint64 size;
+
+    ScenePackageFile()
+        : size(0) {}
+};
+
+/**
+ * @brief 场景依赖闭包
+ */
+struct ScenePackage {
+    QString rootPath;                  // 包根目录（Maya 工程目录或场景所在目录）
+    ScenePackageFile scene;            // 主场景文件
+    QVector<ScenePackageFile> assets;  // 依赖素材（已去重，包括引用场景及其素材）
+    QStringList missing;               // 找不到的素材引用
+    qint64 totalBytes;
+
+    ScenePackage()
+        : totalBytes(0) {}
+};
+
+/**
+ * @brief 场景打包
+ *
+ * 从主场景出发，用 MayaDetector::scanSceneAssets 收集纹理、IES、缓存
+ * 和引用场景，递归展开引用场景的依赖，得到渲染所需的完整文件集合。
+ *
+ * 素材路径通过 AssetResolver 批量解析（按目录列表查找，不逐个 stat），
+ * UDIM（<UDIM>）和序列帧（#、%04d）引用展开为全部实际存在的文件。
+ *
+ * 多个场景引用同一素材时只保留一份（按规范化路径去重）。
+ * 包根目录内的文件保持原有相对路径，包外的文件放到
+ * external/<目录哈希>/ 下，避免同名文件冲突。
+ * 服务端按清单将场景中的原始路径重映射到上传后的相对路径。
+ */
+class ScenePackager
+{
+public:
+    /**
+     * @brief 收集场景依赖闭包（阻塞，需在后台线程调用）
+     * @param sceneFilePath 主场景文件路径
+     * @param cacheSettings 场景分析缓存设置（在 GUI 线程用 MayaDetector::CacheSettings::fromConfig() 读取）
+     */
+    static ScenePackage collect(const QString& sceneFilePath, const MayaDetector::CacheSettings& cacheSettings);
+
+    /**
+     * @brief 生成上传清单
+     * @param package 场景包
+     * @param uploads 本地路径 -> 上传结果（uploadId、fileHash）
+     */
+    static QJsonObject buildManifest(const ScenePackage& package, const QMap<QString, QJsonObject>& uploads);
+
+    /**
+     * @brief 场景包与 JSON 互相转换（保存未完成的上传，重启后不必重新收集依赖）
+     */
+    static QJsonObject packageToJson(const ScenePackage& package);
+    static ScenePackage packageFromJson(const QJsonObject& json);
+
+private:
+    static QString findProjectRoot(const QString& sceneDir);
+    /**
+     * @brief 批量解析一个场景中的素材引用
+     * @return 与 references 一一对应的实际文件列表（模式引用可能有多个，找不到时为空）
+     *
+     * 依次尝试：相对场景目录、相对工程目录、工程 sourceimages 下的同名文件、
+     * 场景目录下的同名文件（其他机器上保存的绝对路径）。每一轮只处理上一轮没找到的引用。
+     */
+    static QVector<QStringList> resolveReferences(AssetResolver& resolver, const QStringList& references,
+                                                  const QString& sceneDir, const QString& rootPath);
+    static QString mapRelativePath(const QString& localPath, const QString& rootPath);
+};
@@ -11,22 +11,77 @@
  */
 
 #include <QCoreApplication>
+#include <QApplication>
+#include <QListView>
+#include <QScrollBar>
+#include <QStyleOptionViewItem>
 #include <QTimer>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QCryptographicHash>
+#include <QBuffer>
+#include <QTemporaryDir>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QEventLoop>
+#include <QUrlQuery>
+#include <QRandomGenerator>
+#include <QFileInfo>
+#include <QDir>
+#include <QDirIterator>
+#include <QRegularExpression>
+#include <QTextStream>
+#include <QStandardPaths>
+#include <QThread>
+#include <QMutex>
+#include <QSet>
+#include <QtEndian>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <iostream>
 
 #ifdef Q_OS_WIN
 #include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
 #endif
 
 #include "core/Application.h"
 #include "core/Config.h"
 #include "core/Logger.h"
+#include "core/LogFormat.h"
 #include "services/MayaDetector.h"
 #include "network/HttpClient.h"
 #include "network/WebSocketClient.h"
 #include "network/FileUploader.h"
 #include "network/ApiService.h"
+#include "network/FileChunkDevice.h"
+#include "network/MappedFileReader.h"
+#include "network/UploadJournal.h"
+#include "network/ChunkHashCache.h"
+#include "network/UploadScheduler.h"
+#include "network/UploadRateController.h"
+#include "services/MayaAsciiParser.h"
+#include "services/MayaBinaryParser.h"
+#include "services/KeywordScanner.h"
+#include "services/ParallelSceneScanner.h"
+#include "services/SceneInfoCache.h"
+#include "services/AssetResolver.h"
+#include "services/MayaInstallIndex.h"
+#include "services/FileCrawler.h"
+#include "services/LogUploader.h"
+#include "services/MayaBatchRunner.h"
+#include "models/Task.h"
+#include "models/TaskListModel.h"
+#include "managers/TaskUpdateCoalescer.h"
+#include "ui/components/TaskItemDelegate.h"
 
 void printSeparator(const QString& title = QString())
 {
@@ -43,6 +98,26 @@ void printLine(const QString& text)
     std::cout << text.toUtf8().constData() << "\n";
 }
 
+/**
+ * @brief 测试结果：逐项输出检查结果，最后输出是否通过
+ */
+struct TestResult
+{
+    bool passed = true;
+
+    void check(bool condition, const QString& what)
+    {
+        qDebug() << (condition ? "  ✓" : "  ✗") << what;
+        passed = passed && condition;
+    }
+
+    bool report() const
+    {
+        qDebug() << (passed ? "✓ 通过" : "✗ 失败");
+        return passed;
+    }
+};
+
 /**
  * @brief 测试 Maya 环境检测
  */
@@ -58,6 +133,16 @@ void testMayaDetector()
             qDebug() << QString("[%1%] %2").arg(progress).arg(message);
         });
 
+    // 检测流水线逐个返回的结果（在工作线程中直接回调）
+    QObject::connect(&detector, &MayaDetector::mayaVersionFound,
+        [](const MayaSoftwareInfo &info) {
+            qDebug() << "  发现 Maya" << info.version << info.installPath;
+        });
+    QObject::connect(&detector, &MayaDetector::rendererDetected,
+        [](const QString &installPath, const RendererInfo &renderer) {
+            qDebug() << "  渲染器" << renderer.name << renderer.version << "(" << installPath << ")";
+        });
+
     // 检测所有 Maya 版本
     qDebug() << "\n开始检测系统中的 Maya 版本...";
     QVector<MayaSoftwareInfo> mayaVersions = detector.detectAllMayaVersions();
@@ -152,6 +237,745 @@ void testLogger()
     qDebug() << "\n日志文件位置: AppData/Roaming/YunTu/logs/";
 }
 
+/**
+ * @brief 日志基准测试：多线程写日志的吞吐量和调用方延迟
+ *
+ * 与原实现（调用线程格式化、加锁写入并逐行 flush）对比，两者写入临时目录。
+ */
+bool benchmarkLogger(int threadCount, int linesPerThread)
+{
+    printSeparator(QString::fromUtf8("日志基准测试"));
+
+    TestResult result;
+
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        qDebug() << "无法创建临时目录";
+        return false;
+    }
+
+    // 每个线程记录每次调用的耗时，最后合并统计
+    auto run = [&](const QString& name, const std::function<void(int, int)>& writeLine,
+                   const std::function<void()>& finish) {
+        QVector<QVector<qint64>> latencies(threadCount);
+        QList<QThread*> threads;
+        QElapsedTimer total;
+        total.start();
+        for (int t = 0; t < threadCount; ++t) {
+            QThread* thread = QThread::create([&, t]() {
+                QVector<qint64>& samples = latencies[t];
+                samples.reserve(linesPerThread);
+                QElapsedTimer timer;
+                for (int i = 0; i < linesPerThread; ++i) {
+                    timer.start();
+                    writeLine(t, i);
+                    samples.append(timer.nsecsElapsed());
+                }
+            });
+            threads.append(thread);
+            thread->start();
+        }
+        for (QThread* thread : threads) {
+            thread->wait();
+            delete thread;
+        }
+        finish();
+        qint64 elapsedMs = qMax<qint64>(total.elapsed(), 1);
+
+        QVector<qint64> all;
+        for (const QVector<qint64>& samples : latencies) {
+            all += samples;
+        }
+        std::sort(all.begin(), all.end());
+        qint64 lines = static_cast<qint64>(threadCount) * linesPerThread;
+        qDebug().noquote() << QString::fromUtf8("%1: %2 行 %3 ms，%4 行/秒；调用耗时 p50 %5 us，p99 %6 us，最大 %7 us")
+            .arg(name).arg(lines).arg(elapsedMs).arg(lines * 1000 / elapsedMs)
+            .arg(all[all.size() / 2] / 1000.0, 0, 'f', 2)
+            .arg(all[static_cast<int>(all.size() * 0.99)] / 1000.0, 0, 'f', 2)
+            .arg(all.last() / 1000.0, 0, 'f', 2);
+        return all[static_cast<int>(all.size() * 0.99)];
+    };
+
+    // 原实现：调用线程格式化，加锁写入并 flush
+    QFile syncFile(tempDir.filePath("sync.log"));
+    syncFile.open(QIODevice::WriteOnly | QIODevice::Text);
+    QTextStream syncStream(&syncFile);
+    QMutex syncMutex;
+    qint64 syncP99 = run(QString::fromUtf8("同步写入"), [&](int t, int i) {
+        QString logMessage = QString("[%1] [%2] [%3] %4")
+            .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss"))
+            .arg("INFO ")
+            .arg("Bench")
+            .arg(QString::fromUtf8("线程 %1 第 %2 行").arg(t).arg(i));
+        QMutexLocker locker(&syncMutex);
+        syncStream << logMessage << "\n";
+        syncStream.flush();
+    }, []() {});
+    syncFile.close();
+
+    Logger logger;
+    logger.setConsoleOutput(false);
+    logger.initialize(tempDir.filePath("async"));
+    Logger::RotationPolicy noRotation;
+    noRotation.maxFileBytes = 1LL << 40;    // 基准测试只检查一个文件
+    logger.setRotationPolicy(noRotation);
+    Logger::Stats before = logger.stats();
+    qint64 asyncP99 = run(QString::fromUtf8("异步写入"), [&](int t, int i) {
+        logger.infof("Bench", "线程 %1 第 %2 行", t, i);
+    }, [&]() {
+        logger.flush();
+    });
+    Logger::Stats after = logger.stats();
+    qDebug().noquote() << QString::fromUtf8("写线程: 写入 %1 批，队列满等待 %2 次")
+        .arg(after.batches - before.batches).arg(after.queueFullWaits - before.queueFullWaits);
+
+    // flush 后文件中应有全部日志行
+    qint64 expected = static_cast<qint64>(threadCount) * linesPerThread;
+    qint64 benchLines = 0;
+    LogFormat::decodeFile(logger.currentLogFilePath(), [&](const LogEntry& entry) {
+        if (entry.category == "Bench") {
+            ++benchLines;
+        }
+    });
+    qDebug().noquote() << QString::fromUtf8("文件大小: 同步文本 %1 KB，结构化 %2 KB")
+        .arg(QFileInfo(syncFile.fileName()).size() / 1024)
+        .arg(QFileInfo(logger.currentLogFilePath()).size() / 1024);
+    result.check(after.linesWritten - before.linesWritten == expected, "写线程统计到全部日志");
+    result.check(benchLines == expected, QString::fromUtf8("flush 后文件包含全部 %1 行").arg(expected));
+    result.check(asyncP99 < syncP99, "调用方 p99 延迟低于同步写入");
+
+    // 崩溃路径同步写出
+    logger.info("Bench", "before crash");
+    logger.logCrash("benchmark crash marker");
+    bool sawBeforeCrash = false;
+    bool sawCrash = false;
+    LogFormat::decodeFile(logger.currentLogFilePath(), [&](const LogEntry& entry) {
+        sawBeforeCrash = sawBeforeCrash || entry.message() == "before crash";
+        sawCrash = sawCrash || (entry.isText && entry.message().contains("benchmark crash marker"));
+    });
+    result.check(sawBeforeCrash && sawCrash, "logCrash 同步写出之前的日志和崩溃信息");
+
+    return result.report();
+}
+
+/**
+ * @brief 结构化日志格式测试：编码解码往返、截断和损坏数据、与文本日志的大小对比
+ */
+bool testLogFormat()
+{
+    printSeparator(QString::fromUtf8("结构化日志格式测试"));
+
+    TestResult result;
+
+    // 模拟典型日志：少量模板和分类，大量参数变化
+    const char* templates[] = {
+        "分片上传完成: %1 第 %2 片，%3 字节",
+        "任务进度更新: %1 -> %2%",
+        "请求失败: %1, 错误: %2",
+    };
+    const QString categories[] = {"UploadScheduler", "TaskManager", "HttpClient"};
+    const qint64 start = QDateTime::currentMSecsSinceEpoch();
+    const int count = 20000;
+
+    LogSegmentWriter writer;
+    QByteArray encoded;
+    QStringList expectedText;
+    qint64 textBytes = 0;
+    for (int i = 0; i < count; ++i) {
+        qint64 timestamp = start + i * 3 - (i % 5);   // 多线程时时间戳可能轻微乱序
+        int kind = i % 3;
+        LogArg args[3];
+        int argCount = 0;
+        if (kind == 0) {
+            args[0] = LogArg(QString("local_%1").arg(i / 100));
+            args[1] = LogArg(i % 100);
+            args[2] = LogArg(static_cast<qint64>(8) * 1024 * 1024 + i);
+            argCount = 3;
+        } else if (kind == 1) {
+            args[0] = LogArg(QString("task_%1").arg(i % 50));
+            args[1] = LogArg(i % 101);
+            argCount = 2;
+        } else {
+            args[0] = LogArg(QString("/api/v1/tasks/%1").arg(i));
+            args[1] = LogArg(QString::fromUtf8("连接超时"));
+            argCount = 2;
+        }
+        writer.addRecord(timestamp, kind == 2 ? Logger::Error : Logger::Info, categories[kind], templates[kind], args, argCount);
+
+        LogEntry entry;
+        entry.timestamp = timestamp;
+        entry.level = kind == 2 ? Logger::Error : Logger::Info;
+        entry.category = categories[kind];
+        entry.templ = QString::fromUtf8(templates[kind]);
+        for (int a = 0; a < argCount; ++a) {
+            entry.args.append(args[a]);
+        }
+        QString line = LogFormat::formatText(entry);
+        expectedText << line;
+        textBytes += line.toUtf8().size() + 1;
+
+        if (writer.size() >= 64 * 1024) {
+            encoded += writer.takeSegment();
+        }
+    }
+    writer.addText(start + count * 3, QString::fromUtf8("原样文本\n第二行"));
+    expectedText << QString::fromUtf8("原样文本\n第二行");
+    encoded += writer.takeSegment();
+
+    qDebug().noquote() << QString::fromUtf8("%1 条日志: 文本 %2 KB，结构化 %3 KB（%4%）")
+        .arg(count).arg(textBytes / 1024).arg(encoded.size() / 1024)
+        .arg(encoded.size() * 100 / qMax<qint64>(textBytes, 1));
+
+    QStringList decodedText;
+    bool complete = false;
+    int decoded = LogFormat::decode(encoded, [&](const LogEntry& entry) {
+        decodedText << LogFormat::formatText(entry);
+    }, &complete);
+    result.check(decoded == count + 1 && complete, QString::fromUtf8("解码全部 %1 条").arg(decoded));
+    result.check(decodedText == expectedText, "解码后的文本与直接格式化一致");
+    result.check(encoded.size() < textBytes / 2, "结构化日志不到文本日志的一半");
+
+    // 末尾写了一半的段：之前的段照常解码
+    QByteArray truncated = encoded.left(encoded.size() - 10);
+    int truncatedCount = LogFormat::decode(truncated, [](const LogEntry&) {}, &complete);
+    result.check(!complete && truncatedCount > 0 && truncatedCount < count, "截断的最后一段被忽略");
+
+    // 中间损坏：跳到下一个段头继续
+    QByteArray damaged = encoded;
+    int firstSegmentEnd = damaged.indexOf(QByteArray(LogFormat::Magic, 4), 4);
+    if (firstSegmentEnd > 0) {
+        for (int i = 8; i < 40; ++i) {
+            damaged[i] = static_cast<char>(0xFF);
+        }
+    }
+    int damagedCount = LogFormat::decode(damaged, [](const LogEntry&) {}, &complete);
+    result.check(firstSegmentEnd > 0 && damagedCount > 0 && damagedCount <= count, "损坏的段之后继续解码");
+
+    // JSON 输出保留模板和参数
+    QByteArray firstJson;
+    LogFormat::decode(encoded, [&](const LogEntry& entry) {
+        if (firstJson.isEmpty()) {
+            firstJson = LogFormat::formatJson(entry);
+        }
+    });
+    qDebug().noquote() << "JSON:" << firstJson;
+    QJsonObject jsonEntry = QJsonDocument::fromJson(firstJson).object();
+    result.check(jsonEntry["template"].toString() == QString::fromUtf8(templates[0])
+                 && jsonEntry["args"].toArray().size() == 3, "JSON 包含模板和参数");
+
+    return result.report();
+}
+
+/**
+ * @brief 日志轮转测试：按大小轮转、后台压缩归档、保留预算、上传水位线
+ */
+bool testLogRotation()
+{
+    printSeparator(QString::fromUtf8("日志轮转测试"));
+
+    TestResult result;
+
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        qDebug() << "无法创建临时目录";
+        return false;
+    }
+    const QString logDir = tempDir.filePath("logs");
+
+    // 上次运行留下的日志和前一天的 qDebug 文本日志
+    QDir().mkpath(logDir);
+    {
+        LogSegmentWriter writer;
+        writer.addText(QDateTime::currentMSecsSinceEpoch(), "leftover from last run");
+        QFile leftover(logDir + "/2000-01-01_000000.ylog");
+        leftover.open(QIODevice::WriteOnly);
+        leftover.write(writer.takeSegment());
+        QFile oldText(logDir + "/2000-01-01.log");
+        oldText.open(QIODevice::WriteOnly);
+        oldText.write("old qDebug output\n");
+    }
+
+    const int lines = 60000;
+    qint64 archivedLines = 0;
+    QStringList firstPending;
+    {
+        Logger logger;
+        logger.setConsoleOutput(false);
+        logger.initialize(logDir);
+        Logger::RotationPolicy policy;
+        policy.maxFileBytes = 64 * 1024;
+        logger.setRotationPolicy(policy);
+
+        for (int i = 0; i < lines; ++i) {
+            logger.infof("Rotate", "第 %1 行，随机数 %2", i, QRandomGenerator::global()->generate());
+        }
+        logger.flush();
+        result.check(logger.waitForArchiving(10000), "后台归档完成");
+
+        firstPending = logger.pendingUploads();
+        qint64 activeLines = 0;
+        LogFormat::decodeFile(logger.currentLogFilePath(), [&](const LogEntry& entry) {
+            activeLines += entry.category == "Rotate" ? 1 : 0;
+        });
+        bool allDecoded = true;
+        bool sawLeftover = false;
+        qint64 archiveBytes = 0;
+        for (const QString& path : firstPending) {
+            archiveBytes += QFileInfo(path).size();
+            if (!path.endsWith(LogFormat::ArchiveSuffix)) {
+                continue;
+            }
+            bool complete = false;
+            LogFormat::decodeFile(path, [&](const LogEntry& entry) {
+                archivedLines += entry.category == "Rotate" ? 1 : 0;
+                sawLeftover = sawLeftover || entry.message() == "leftover from last run";
+            }, &complete);
+            allDecoded = allDecoded && complete;
+        }
+        qDebug().noquote() << QString::fromUtf8("%1 个归档，共 %2 KB，当前文件 %3 KB")
+            .arg(firstPending.size()).arg(archiveBytes / 1024)
+            .arg(QFileInfo(logger.currentLogFilePath()).size() / 1024);
+
+        result.check(firstPending.size() > 3, "超过大小后轮转并归档");
+        result.check(QFileInfo(logger.currentLogFilePath()).size() < policy.maxFileBytes + 64 * 1024, "当前文件不超过轮转大小");
+        result.check(allDecoded && archivedLines + activeLines == lines, "归档和当前文件包含全部日志");
+        result.check(sawLeftover, "上次运行留下的日志被归档");
+        result.check(!QFile::exists(logDir + "/2000-01-01_000000.ylog") && !QFile::exists(logDir + "/2000-01-01.log"),
+                     "遗留文件归档后删除");
+
+        // 上传前两个和第四个：水位线只推进到连续上传的第二个
+        logger.markUploaded(firstPending[0]);
+        logger.markUploaded(firstPending[1]);
+        logger.markUploaded(firstPending[3]);
+        QStringList pending = logger.pendingUploads();
+        result.check(pending.size() == firstPending.size() - 3 && pending.first() == firstPending[2],
+                     "本次运行中已上传的归档不再待上传");
+        result.check(logger.uploadWatermark() == QFileInfo(firstPending[1]).fileName().section('_', 0, 0).toLongLong(),
+                     "水位线停在第一个未上传的归档之前");
+
+        // 保证退出时当前文件不为空，下次启动归档
+        logger.info("Rotate", "last line");
+    }
+
+    {
+        // 重新启动：水位线之后的归档（包括未连续的第四个）重新待上传，新归档序号继续递增
+        Logger logger;
+        logger.setConsoleOutput(false);
+        logger.initialize(logDir);
+        logger.waitForArchiving(10000);
+        QStringList pending = logger.pendingUploads();
+        result.check(!pending.isEmpty() && pending.first() == firstPending[2], "重启后从水位线之后继续");
+        result.check(pending.size() == firstPending.size() - 2 + 1, "上次运行的当前文件也被归档");
+
+        // 保留预算：只保留最新的归档
+        Logger::RotationPolicy policy;
+        policy.maxArchiveBytes = QFileInfo(pending.last()).size() + 1;
+        logger.setRotationPolicy(policy);
+        logger.waitForArchiving(10000);
+        result.check(logger.pendingUploads() == QStringList() << pending.last(), "超出保留预算的旧归档被删除");
+
+        logger.markUploaded(pending.last());
+        result.check(logger.pendingUploads().isEmpty(), "水位线越过已删除的归档");
+    }
+
+    return result.report();
+}
+
+/**
+ * @brief 本地 HTTP/1.1 服务：解析请求后延迟一段时间再响应，统计同时进行的请求数
+ */
+class LocalHttpServer : public QTcpServer
+{
+public:
+    struct Request {
+        QByteArray method;
+        QByteArray target;
+        QList<QByteArray> headers;  // 小写的 "name: value"
+        QByteArray body;
+
+        QByteArray header(const QByteArray& name) const
+        {
+            for (const QByteArray& line : headers) {
+                if (line.startsWith(name + ":")) {
+                    return line.mid(name.size() + 1).trimmed();
+                }
+            }
+            return QByteArray();
+        }
+    };
+
+    int responseDelayMs = 20;
+    int requests = 0;
+    int inFlight = 0;
+    int maxInFlight = 0;
+
+protected:
+    virtual int delayFor(const Request&) { return responseDelayMs; }
+    virtual void respond(QTcpSocket* socket, const Request& request) = 0;
+
+    static void writeResponse(QTcpSocket* socket, int status, const QByteArray& extraHeaders = QByteArray(),
+                              const QByteArray& body = QByteArray())
+    {
+        socket->write("HTTP/1.1 " + QByteArray::number(status) + (status == 200 ? " OK" : " Error")
+                      + "\r\nContent-Length: " + QByteArray::number(body.size()) + "\r\n"
+                      + extraHeaders + "\r\n" + body);
+    }
+
+    void incomingConnection(qintptr descriptor) override
+    {
+        QTcpSocket* socket = new QTcpSocket(this);
+        socket->setSocketDescriptor(descriptor);
+        QByteArray* buffer = new QByteArray();
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QObject::destroyed, this, [buffer]() { delete buffer; });
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket, buffer]() {
+            buffer->append(socket->readAll());
+            for (;;) {
+                int headerEnd = buffer->indexOf("\r\n\r\n");
+                if (headerEnd < 0) {
+                    return;
+                }
+                Request request;
+                QList<QByteArray> lines = buffer->left(headerEnd).split('\n');
+                QList<QByteArray> requestLine = lines.takeFirst().trimmed().split(' ');
+                request.method = requestLine.value(0);
+                request.target = requestLine.value(1);
+                for (const QByteArray& line : lines) {
+                    request.headers.append(line.trimmed().toLower());
+                }
+                qint64 contentLength = request.header("content-length").toLongLong();
+                if (buffer->size() < headerEnd + 4 + contentLength) {
+                    return;
+                }
+                request.body = buffer->mid(headerEnd + 4, contentLength);
+                buffer->remove(0, headerEnd + 4 + contentLength);
+
+                ++requests;
+                maxInFlight = qMax(maxInFlight, ++inFlight);
+                QTimer::singleShot(delayFor(request), socket, [this, socket, request]() {
+                    --inFlight;
+                    respond(socket, request);
+                });
+            }
+        });
+    }
+};
+
+/**
+ * @brief 本地 OSS 替身：只实现追加上传（POST /bucket/object?append&position=N）
+ *
+ * 可以让接下来的若干请求返回 503，或者执行追加后不返回响应（模拟响应丢失）。
+ */
+class FakeOssServer : public LocalHttpServer
+{
+public:
+    QHash<QString, QByteArray> objects;     // 路径 -> 内容
+    int failNext = 0;
+    bool dropNextResponse = false;
+    int unsignedRequests = 0;
+    qint64 bodyBytes = 0;
+
+protected:
+    void respond(QTcpSocket* socket, const Request& request) override
+    {
+        QUrl url("http://oss" + QString::fromUtf8(request.target));
+        QUrlQuery query(url);
+        int status = 200;
+        qint64 next = -1;
+        unsignedRequests += request.header("authorization").startsWith("oss ") ? 0 : 1;
+
+        if (failNext > 0) {
+            --failNext;
+            status = 503;
+        } else if (request.method != "POST" || !query.hasQueryItem("append")) {
+            status = 400;
+        } else {
+            QByteArray& object = objects[url.path()];
+            qint64 position = query.queryItemValue("position").toLongLong();
+            if (position != object.size()) {
+                status = 409;
+            } else {
+                object += request.body;
+                bodyBytes += request.body.size();
+            }
+            next = object.size();
+        }
+
+        if (dropNextResponse && status == 200) {
+            dropNextResponse = false;
+            socket->abort();
+            return;
+        }
+
+        writeResponse(socket, status,
+                      next >= 0 ? "x-oss-next-append-position: " + QByteArray::number(next) + "\r\n" : QByteArray());
+    }
+};
+
+/**
+ * @brief 日志上传测试：增量追加、压缩、断点续传、并发上限和退避重试（本地 OSS 替身）
+ */
+bool testLogUpload()
+{
+    printSeparator(QString::fromUtf8("日志上传测试"));
+
+    TestResult result;
+
+    QTemporaryDir tempDir;
+    FakeOssServer server;
+    if (!tempDir.isValid() || !server.listen(QHostAddress::LocalHost)) {
+        qDebug() << "无法创建临时目录或启动本地服务";
+        return false;
+    }
+
+    // 追加若干结构化日志段
+    auto appendLog = [](const QString& path, int records) {
+        LogSegmentWriter writer;
+        QFile file(path);
+        file.open(QIODevice::WriteOnly | QIODevice::Append);
+        qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+        for (int i = 0; i < records; ++i) {
+            LogArg args[2] = {LogArg(QString("task_%1").arg(QRandomGenerator::global()->bounded(100000))),
+                              LogArg(QRandomGenerator::global()->bounded(100))};
+            writer.addRecord(timestamp + i, Logger::Info, "TaskManager", "任务进度更新: %1 -> %2%", args, 2);
+            if (writer.size() >= 64 * 1024) {
+                file.write(writer.takeSegment());
+            }
+        }
+        file.write(writer.takeSegment());
+    };
+    auto readFile = [](const QString& path) {
+        QFile file(path);
+        file.open(QIODevice::ReadOnly);
+        return file.readAll();
+    };
+    auto remote = [&](LogUploader& uploader, const QString& path) {
+        return LogFormat::decompressBlocks(server.objects.value("/bucket/" + uploader.objectName(path)));
+    };
+
+    LogUploader::OssTarget target;
+    target.accessKey = "test-ak";
+    target.secretKey = "test-sk";
+    target.bucket = "bucket";
+    target.endpoint = QString("http://127.0.0.1:%1").arg(server.serverPort());
+    const QString stateFile = tempDir.filePath("upload.offsets");
+
+    // 每轮用新的上传器，和每次启动一样从状态文件恢复进度
+    QStringList uploaded;
+    QStringList failed;
+    auto runUpload = [&](const QStringList& files, const std::function<void(LogUploader&)>& inspect) {
+        LogUploader uploader;
+        uploader.setTarget(target);
+        uploader.setStateFile(stateFile);
+        uploader.setMaxInFlight(2);
+        uploader.setRetryPolicy(4, 50);
+        uploaded.clear();
+        failed.clear();
+        QObject::connect(&uploader, &LogUploader::logUploaded, [&](const QString& path) { uploaded << path; });
+        QObject::connect(&uploader, &LogUploader::logUploadFailed, [&](const QString& path, const QString&) { failed << path; });
+
+        QEventLoop loop;
+        QObject::connect(&uploader, &LogUploader::allLogsUploaded, &loop, &QEventLoop::quit);
+        QTimer::singleShot(30000, &loop, &QEventLoop::quit);
+        uploader.uploadAllLogs(files);
+        loop.exec();
+        inspect(uploader);
+    };
+
+    QStringList files;
+    for (int i = 0; i < 3; ++i) {
+        files << tempDir.filePath(QString("2026-01-0%1_000000.ylog").arg(i + 1));
+        appendLog(files.last(), 40000 * (i + 1));
+    }
+    qint64 sourceBytes = 0;
+    for (const QString& path : files) {
+        sourceBytes += QFileInfo(path).size();
+    }
+
+    // 1. 首次上传：前两个请求失败，退避后重试；同时最多 2 个请求
+    server.failNext = 2;
+    runUpload(files, [&](LogUploader& uploader) {
+        bool allMatch = true;
+        for (const QString& path : files) {
+            allMatch = allMatch && remote(uploader, path) == readFile(path);
+        }
+        result.check(uploaded.size() == 3 && failed.isEmpty(), "全部上传成功（503 后退避重试）");
+        result.check(allMatch, "远端对象解压后与本地文件一致");
+        result.check(server.maxInFlight <= 2 && server.maxInFlight >= 1,
+                     QString::fromUtf8("同时进行的请求不超过上限（最多 %1 个）").arg(server.maxInFlight));
+        result.check(server.unsignedRequests == 0, "请求都带签名");
+    });
+    qDebug().noquote() << QString::fromUtf8("原始 %1 KB，上传 %2 KB，%3 个请求")
+        .arg(sourceBytes / 1024).arg(server.bodyBytes / 1024).arg(server.requests);
+    result.check(server.bodyBytes < sourceBytes, "上传数据经过压缩");
+
+    // 2. 文件继续写入：只上传新增的尾部
+    qint64 sizeBefore = QFileInfo(files[0]).size();
+    appendLog(files[0], 2000);
+    qint64 tailBytes = QFileInfo(files[0]).size() - sizeBefore;
+    qint64 sentBefore = server.bodyBytes;
+    runUpload(files, [&](LogUploader& uploader) {
+        result.check(uploaded.size() == 3 && remote(uploader, files[0]) == readFile(files[0]), "追加后远端对象仍与本地一致");
+        result.check(uploader.uploadedOffset(files[0]) == QFileInfo(files[0]).size(), "记录的偏移等于文件大小");
+    });
+    result.check(server.bodyBytes - sentBefore <= tailBytes,
+                 QString::fromUtf8("只上传新增部分（%1 字节 -> %2 字节）").arg(tailBytes).arg(server.bodyBytes - sentBefore));
+
+    // 3. 文件归档：解压后接着原文件的进度，只上传归档前新写入的部分
+    appendLog(files[1], 2000);
+    QString archivePath = tempDir.filePath("00000001_" + QFileInfo(files[1]).fileName() + "z");
+    {
+        QByteArray content = readFile(files[1]);
+        QFile archive(archivePath);
+        archive.open(QIODevice::WriteOnly);
+        for (qint64 offset = 0; offset < content.size(); offset += 1024 * 1024) {
+            archive.write(LogFormat::compressBlock(content.mid(offset, 1024 * 1024)));
+        }
+        QFile::remove(files[1]);
+        sentBefore = server.bodyBytes;
+        runUpload(QStringList() << archivePath, [&](LogUploader&) {});
+        LogUploader stateReader;
+        stateReader.setStateFile(stateFile);
+        result.check(uploaded == QStringList() << archivePath && stateReader.objectName(archivePath).isEmpty(),
+                     "归档上传完成后不再保留进度");
+        QString objectPath;
+        for (auto it = server.objects.constBegin(); it != server.objects.constEnd(); ++it) {
+            if (it.key().endsWith(QFileInfo(files[1]).fileName() + "z")) {
+                objectPath = it.key();
+            }
+        }
+        result.check(LogFormat::decompressBlocks(server.objects.value(objectPath)) == content,
+                     "归档接着原文件的对象继续追加");
+        result.check(server.bodyBytes - sentBefore < LogFormat::compressBlock(content).size() / 4, "归档只上传剩余部分");
+    }
+
+    // 4. 响应丢失：追加已生效但客户端没收到响应，重试时按 409 的位置确认成功
+    appendLog(files[2], 2000);
+    server.dropNextResponse = true;
+    runUpload(QStringList() << files[2], [&](LogUploader& uploader) {
+        result.check(uploaded.size() == 1 && remote(uploader, files[2]) == readFile(files[2]), "响应丢失后不重复追加");
+    });
+
+    // 5. 远端对象被删除：位置不一致时换新对象从头上传
+    LogUploader stateReader;
+    stateReader.setStateFile(stateFile);
+    QString oldObject = stateReader.objectName(files[0]);
+    server.objects.remove("/bucket/" + oldObject);
+    appendLog(files[0], 100);
+    runUpload(QStringList() << files[0], [&](LogUploader& uploader) {
+        result.check(uploaded.size() == 1 && uploader.objectName(files[0]) != oldObject
+                     && remote(uploader, files[0]) == readFile(files[0]), "远端对象丢失后上传到新对象");
+    });
+
+    // 6. 服务一直失败：超过重试次数后放弃，进度保留到下次
+    server.failNext = 1000;
+    appendLog(files[0], 100);
+    runUpload(QStringList() << files[0], [&](LogUploader& uploader) {
+        result.check(failed.size() == 1 && uploader.uploadedOffset(files[0]) < QFileInfo(files[0]).size(),
+                     "超过重试次数后放弃");
+    });
+    server.failNext = 0;
+    runUpload(QStringList() << files[0], [&](LogUploader& uploader) {
+        result.check(uploaded.size() == 1 && remote(uploader, files[0]) == readFile(files[0]), "服务恢复后从断点继续");
+    });
+
+    return result.report();
+}
+
+/**
+ * @brief 本地 API 替身：/slow 延迟响应（模拟占满链路的分片上传），其他路径立即响应
+ */
+class SlowPathServer : public LocalHttpServer
+{
+public:
+    int slowDelayMs = 1500;
+
+protected:
+    int delayFor(const Request& request) override
+    {
+        return request.target.startsWith("/slow") ? slowDelayMs : 0;
+    }
+
+    void respond(QTcpSocket* socket, const Request&) override
+    {
+        writeResponse(socket, 200, "Content-Type: application/json\r\n", "{}");
+    }
+};
+
+/**
+ * @brief HTTP 连接池测试：分片上传占满连接时，控制请求的延迟
+ *
+ * HTTP/1.1 下每个 QNetworkAccessManager 对同一主机最多 6 个连接。
+ * 先用 12 个慢的控制请求占满控制连接池作为对照（共用连接池时的情况），
+ * 再用 12 个慢的分片上传占满传输连接池，比较其后一个控制请求的耗时。
+ */
+bool testHttpPools()
+{
+    printSeparator(QString::fromUtf8("HTTP 连接池测试"));
+
+    TestResult result;
+
+    SlowPathServer server;
+    if (!server.listen(QHostAddress::LocalHost)) {
+        qDebug() << "无法启动本地服务";
+        return false;
+    }
+
+    HttpClient& client = HttpClient::instance();
+    client.setBaseUrl(QString("http://127.0.0.1:%1").arg(server.serverPort()));
+    const int slowRequests = 12;
+
+    // 发出慢请求后测量一个控制请求的耗时，并等待全部完成
+    auto measure = [&](const std::function<void(int, const std::function<void()>&)>& startSlow) {
+        QEventLoop loop;
+        int pending = slowRequests + 1;
+        auto done = [&]() {
+            if (--pending == 0) {
+                loop.quit();
+            }
+        };
+        for (int i = 0; i < slowRequests; ++i) {
+            startSlow(i, done);
+        }
+
+        qint64 controlMs = -1;
+        QElapsedTimer timer;
+        QTimer::singleShot(100, [&]() {
+            timer.start();
+            client.get("/fast", {}, [&](const QJsonObject&) {
+                controlMs = timer.elapsed();
+                done();
+            }, [&](int, const QString&) { done(); });
+        });
+        QTimer::singleShot(30000, &loop, &QEventLoop::quit);
+        loop.exec();
+        return controlMs;
+    };
+
+    // 对照：慢请求和控制请求共用一个连接池
+    qint64 sharedMs = measure([&](int i, const std::function<void()>& done) {
+        client.get(QString("/slow?i=%1").arg(i), {}, [done](const QJsonObject&) { done(); },
+                   [done](int, const QString&) { done(); });
+    });
+
+    // 分片上传走传输连接池
+    qint64 separateMs = measure([&](int i, const std::function<void()>& done) {
+        QBuffer* body = new QBuffer();
+        body->setData(QByteArray(256 * 1024, static_cast<char>(i)));
+        body->open(QIODevice::ReadOnly);
+        client.postStream(QString("/slow?chunk=%1").arg(i), body, {},
+                          [done](const QJsonObject&) { done(); }, [done](int, const QString&) { done(); });
+    });
+
+    qDebug().noquote() << QString::fromUtf8("控制请求耗时: 共用连接池 %1 ms，分开连接池 %2 ms（慢请求 %3 ms）")
+        .arg(sharedMs).arg(separateMs).arg(server.slowDelayMs);
+    result.check(sharedMs >= server.slowDelayMs / 2, "共用连接池时控制请求排在慢请求之后");
+    result.check(separateMs >= 0 && separateMs < server.slowDelayMs / 4, "分片上传占满连接时控制请求不排队");
+    result.check(client.networkManager(HttpClient::Control) != client.networkManager(HttpClient::Bulk), "两类请求使用不同的管理器");
+
+    return result.report();
+}
+
 /**
  * @brief 测试 HTTP 请求（需要后端服务器）
  */
@@ -226,74 +1050,2421 @@ void testWebSocket()
 }
 
 /**
- * @brief 显示功能菜单
+ * @brief 获取进程峰值内存占用（字节）
  */
-void showMenu()
+qint64 peakRssBytes()
 {
-    printSeparator(QString::fromUtf8("盛世云图客户端 - 功能测试"));
-
-    printLine(QString::fromUtf8("可用测试项:"));
-    printLine(QString::fromUtf8("  1. Maya 环境检测"));
-    printLine(QString::fromUtf8("  2. 配置管理"));
-    printLine(QString::fromUtf8("  3. 日志系统"));
-    printLine(QString::fromUtf8("  4. HTTP 客户端（需要后端）"));
-    printLine(QString::fromUtf8("  5. WebSocket 客户端（需要后端）"));
-    printLine(QString::fromUtf8("  0. 退出"));
-    std::cout << QString::fromUtf8("\n选择测试项 (0-5): ").toUtf8().constData();
-    std::cout.flush();
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return static_cast<qint64>(pmc.PeakWorkingSetSize);
+    }
+    return -1;
+#else
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return -1;
+    }
+    while (!status.atEnd()) {
+        QByteArray line = status.readLine();
+        if (line.startsWith("VmHWM:")) {
+            return line.mid(6).trimmed().split(' ').first().toLongLong() * 1024;
+        }
+    }
+    return -1;
+#endif
 }
 
-int main(int argc, char *argv[])
+/**
+ * @brief 分片上传基准测试：二进制流式 / 内存映射视图 / JSON+Base64
+ *
+ * 不依赖后端，只测量客户端构造请求体的开销（读取、哈希、编码、序列化），
+ * 发送过程用从设备/缓冲区逐块读出代替。
+ * 峰值内存是单调的，按占用从低到高的顺序运行各路径。
+ * 注意映射页计入 RSS，但属于可回收的页缓存，而非堆内存。
+ */
+void benchmarkChunkUpload(const QString& filePath)
 {
-#ifdef Q_OS_WIN
-    // 设置 Windows 控制台为 UTF-8 编码
-    SetConsoleOutputCP(CP_UTF8);
-    SetConsoleCP(CP_UTF8);
-    // 启用 ANSI 转义序列支持（用于彩色输出）
-    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
-    DWORD dwMode = 0;
-    GetConsoleMode(hOut, &dwMode);
-    dwMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
-    SetConsoleMode(hOut, dwMode);
-#endif
+    printSeparator(QString::fromUtf8("分片上传基准测试"));
 
-    QCoreApplication app(argc, argv);
+    const qint64 chunkSize = 5 * 1024 * 1024;
+    const int concurrency = 3;
 
-    // 设置应用信息
-    QCoreApplication::setOrganizationName("YunTu");
-    QCoreApplication::setOrganizationDomain("yuntu.com");
-    QCoreApplication::setApplicationName("盛世云图客户端");
-    QCoreApplication::setApplicationVersion("1.0.0");
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "无法打开文件:" << filePath;
+        return;
+    }
+    const qint64 fileSize = file.size();
+    file.close();
 
-    // 初始化应用程序
-    Application::instance().initialize();
+    const int totalChunks = static_cast<int>((fileSize + chunkSize - 1) / chunkSize);
+    qDebug() << "文件:" << filePath << "大小:" << fileSize << "字节, 分片数:" << totalChunks;
+    qDebug() << "基线峰值内存:" << peakRssBytes() / 1024 / 1024 << "MB";
 
-    printSeparator(QString::fromUtf8("盛世云图客户端 - 测试程序"));
-    printLine(QString::fromUtf8("版本: 1.0.0-alpha"));
-    printLine(QString::fromUtf8("测试模式: 控制台"));
-    printLine(QString::fromUtf8("\n已实现的功能:"));
-    printLine(QString::fromUtf8("  ✓ 核心模块 (Application, Config, Logger)"));
-    printLine(QString::fromUtf8("  ✓ Maya 环境检测"));
-    printLine(QString::fromUtf8("  ✓ 网络层 (HTTP, WebSocket, FileUploader)"));
-    printLine(QString::fromUtf8("\n待实现的功能:"));
-    printLine(QString::fromUtf8("  ○ 数据模型"));
-    printLine(QString::fromUtf8("  ○ UI 界面"));
-    printLine(QString::fromUtf8("  ○ 任务管理"));
+    // 二进制流式路径
+    {
+        QElapsedTimer timer;
+        timer.start();
+        qint64 wireBytes = 0;
+        QList<FileChunkDevice*> inFlight;
+        QByteArray block(64 * 1024, Qt::Uninitialized);
 
-    // 命令行参数模式
-    if (argc > 1) {
-        QString arg = argv[1];
+        for (int i = 0; i < totalChunks; ++i) {
+            qint64 offset = i * chunkSize;
+            qint64 size = qMin(chunkSize, fileSize - offset);
 
-        if (arg == "--maya" || arg == "-m") {
-            testMayaDetector();
-        } else if (arg == "--config" || arg == "-c") {
-            testConfig();
-        } else if (arg == "--log" || arg == "-l") {
-            testLogger();
-        } else if (arg == "--http" || arg == "-h") {
-            testHttpClient();
-        } else if (arg == "--ws" || arg == "-w") {
-            testWebSocket();
+            FileChunkDevice hashDevice(filePath, offset, size);
+            hashDevice.open(QIODevice::ReadOnly);
+            QCryptographicHash hasher(QCryptographicHash::Md5);
+            hasher.addData(&hashDevice);
+
+            FileChunkDevice* body = new FileChunkDevice(filePath, offset, size);
+            body->open(QIODevice::ReadOnly);
+            inFlight.append(body);
+
+            if (inFlight.size() >= concurrency || i == totalChunks - 1) {
+                for (FileChunkDevice* device : inFlight) {
+                    qint64 n;
+                    while ((n = device->read(block.data(), block.size())) > 0) {
+                        wireBytes += n;
+                    }
+                }
+                qDeleteAll(inFlight);
+                inFlight.clear();
+            }
+        }
+
+        double seconds = qMax<qint64>(timer.elapsed(), 1) / 1000.0;
+        qDebug() << "\n[二进制流式]";
+        qDebug() << "  传输字节:" << wireBytes;
+        qDebug() << "  吞吐:" << QString::number(fileSize / seconds / 1024 / 1024, 'f', 1) << "MB/s";
+        qDebug() << "  峰值内存:" << peakRssBytes() / 1024 / 1024 << "MB";
+    }
+
+    // 内存映射视图路径：哈希与请求体共用同一视图
+    {
+        QElapsedTimer timer;
+        timer.start();
+        qint64 wireBytes = 0;
+        QByteArray block(64 * 1024, Qt::Uninitialized);
+
+        MappedFileReader reader(filePath);
+        reader.open();
+
+        for (int i = 0; i < totalChunks; ++i) {
+            qint64 offset = i * chunkSize;
+            qint64 size = qMin(chunkSize, fileSize - offset);
+
+            QByteArray view = reader.view(offset, size);
+            QCryptographicHash::hash(view, QCryptographicHash::Md5);
+
+            QBuffer body;
+            body.setData(view);
+            body.open(QIODevice::ReadOnly);
+            qint64 n;
+            while ((n = body.read(block.data(), block.size())) > 0) {
+                wireBytes += n;
+            }
+            body.close();
+            reader.release(offset);
+        }
+
+        double seconds = qMax<qint64>(timer.elapsed(), 1) / 1000.0;
+        qDebug() << "\n[内存映射视图]";
+        qDebug() << "  传输字节:" << wireBytes;
+        qDebug() << "  吞吐:" << QString::number(fileSize / seconds / 1024 / 1024, 'f', 1) << "MB/s";
+        qDebug() << "  峰值内存:" << peakRssBytes() / 1024 / 1024 << "MB";
+    }
+
+    // JSON/Base64 路径
+    {
+        QElapsedTimer timer;
+        timer.start();
+        qint64 wireBytes = 0;
+        QList<QByteArray> inFlight;
+
+        QFile source(filePath);
+        source.open(QIODevice::ReadOnly);
+
+        for (int i = 0; i < totalChunks; ++i) {
+            source.seek(i * chunkSize);
+            QByteArray chunkData = source.read(chunkSize);
+            QByteArray hash = QCryptographicHash::hash(chunkData, QCryptographicHash::Md5).toHex();
+
+            QJsonObject data;
+            data["taskId"] = "bench";
+            data["chunkIndex"] = i;
+            data["totalChunks"] = totalChunks;
+            data["chunkHash"] = QString::fromLatin1(hash);
+            data["chunkData"] = QString::fromLatin1(chunkData.toBase64());
+            inFlight.append(QJsonDocument(data).toJson());
+
+            if (inFlight.size() >= concurrency || i == totalChunks - 1) {
+                for (const QByteArray& body : inFlight) {
+                    wireBytes += body.size();
+                }
+                inFlight.clear();
+            }
+        }
+
+        double seconds = qMax<qint64>(timer.elapsed(), 1) / 1000.0;
+        qDebug() << "\n[JSON/Base64]";
+        qDebug() << "  传输字节:" << wireBytes;
+        qDebug() << "  吞吐:" << QString::number(fileSize / seconds / 1024 / 1024, 'f', 1) << "MB/s";
+        qDebug() << "  峰值内存:" << peakRssBytes() / 1024 / 1024 << "MB";
+    }
+}
+
+/**
+ * @brief 断点续传日志测试：在随机时刻"杀死"上传，检查重传字节数
+ *
+ * 模拟 concurrency 个并发槽位以随机顺序完成分片，在随机时刻丢弃日志对象
+ * （相当于进程被杀），并在日志末尾写入半行模拟写到一半的记录。
+ * 重启后依据日志续传。被杀时在途的分片最多 concurrency 个，
+ * 因此每次重启后的重传量不应超过 concurrency 个分片。
+ *
+ * @return 是否通过
+ */
+/**
+ * @brief 本地上传服务替身：实现分片上传用到的接口（已上传分片查询、去重查询、二进制分片、合并）
+ *
+ * 请求头在 LocalHttpServer 中被转成小写，任务 ID 应使用小写。
+ * failTasks 中的任务的分片请求一律返回 500，failOnce 中的任务只有第一个分片请求返回 500。
+ * 合并时检查各分片按偏移拼接后恰好覆盖整个文件。
+ * 收到的内容按去重块记录在 blocks 中，跨会话的去重查询和合并据此判断。
+ */
+class FakeUploadServer : public LocalHttpServer
+{
+public:
+    QHash<QString, QSet<int>> sessions;     // 任务 ID -> 已收到的分片
+    QHash<QString, int> chunkRequests;      // 任务 ID -> 分片请求数
+    QHash<QString, QMap<qint64, qint64>> ranges;  // 任务 ID -> 已收到分片的偏移和大小
+    QSet<QByteArray> blocks;                // 已收到的去重块 SHA-256
+    QStringList mergedTasks;
+    QSet<QString> failTasks;
+    QSet<QString> failOnce;
+    int chunksInFlight = 0;                 // 服务端同时处理中的分片请求数
+    int maxChunksInFlight = 0;
+
+protected:
+    static bool isChunkRequest(const Request& request)
+    {
+        return request.target.startsWith("/api/v1/files/upload/chunk/binary");
+    }
+
+    // 分片起点落在块边界上时，按块记录收到的内容（不足一块的只有文件末尾的块）
+    void recordBlocks(const Request& request)
+    {
+        const qint64 blockSize = ChunkHashCache::BLOCK_SIZE;
+        qint64 offset = request.header("x-chunk-offset").toLongLong();
+        bool last = request.header("x-chunk-index").toInt() + 1 == request.header("x-total-chunks").toInt();
+        if (offset % blockSize != 0) {
+            return;
+        }
+        for (qint64 pos = 0; pos < request.body.size(); pos += blockSize) {
+            QByteArray block = request.body.mid(pos, blockSize);
+            if (block.size() == blockSize || last) {
+                blocks.insert(QCryptographicHash::hash(block, QCryptographicHash::Sha256).toHex());
+            }
+        }
+    }
+
+    // 分片按偏移首尾相接，恰好覆盖整个文件
+    bool coversFile(const QString& taskId, qint64 fileSize) const
+    {
+        qint64 end = 0;
+        const QMap<qint64, qint64> received = ranges.value(taskId);
+        for (auto it = received.begin(); it != received.end(); ++it) {
+            if (it.key() != end) {
+                return false;
+            }
+            end += it.value();
+        }
+        return end == fileSize;
+    }
+
+    // 合并请求中的去重块服务端都已有时，不需要本会话上传过分片
+    bool hasAllBlocks(const QJsonObject& body) const
+    {
+        QJsonArray hashes = body["blockHashes"].toArray();
+        for (const QJsonValue& hash : hashes) {
+            if (!blocks.contains(hash.toString().toLatin1())) {
+                return false;
+            }
+        }
+        return !hashes.isEmpty();
+    }
+
+    int delayFor(const Request& request) override
+    {
+        if (isChunkRequest(request)) {
+            maxChunksInFlight = qMax(maxChunksInFlight, ++chunksInFlight);
+        }
+        return responseDelayMs;
+    }
+
+    void respond(QTcpSocket* socket, const Request& request) override
+    {
+        QUrl url("http://api" + QString::fromUtf8(request.target));
+        QString path = url.path();
+        QJsonObject response;
+        int status = 200;
+
+        if (path == "/api/v1/files/upload/chunks") {
+            QJsonArray uploaded;
+            for (int index : sessions.value(QUrlQuery(url).queryItemValue("taskId"))) {
+                uploaded.append(index);
+            }
+            response["uploadedChunks"] = uploaded;
+        } else if (path == "/api/v1/files/chunks/check") {
+            QJsonArray existing;
+            for (const QJsonValue& hash : QJsonDocument::fromJson(request.body).object()["hashes"].toArray()) {
+                if (blocks.contains(hash.toString().toLatin1())) {
+                    existing.append(hash);
+                }
+            }
+            response["fileExists"] = false;
+            response["existing"] = existing;
+        } else if (isChunkRequest(request)) {
+            QString taskId = QString::fromUtf8(request.header("x-task-id"));
+            chunkRequests[taskId]++;
+            --chunksInFlight;
+            if (failTasks.contains(taskId) || failOnce.remove(taskId)) {
+                status = 500;
+            } else {
+                sessions[taskId].insert(request.header("x-chunk-index").toInt());
+                ranges[taskId][request.header("x-chunk-offset").toLongLong()] = request.body.size();
+                recordBlocks(request);
+            }
+        } else if (path == "/api/v1/files/upload/merge") {
+            QJsonObject body = QJsonDocument::fromJson(request.body).object();
+            QString taskId = body["taskId"].toString();
+            bool complete = sessions.value(taskId).size() == body["totalChunks"].toInt()
+                            && coversFile(taskId, body["fileSize"].toInteger());
+            if (complete || hasAllBlocks(body)) {
+                mergedTasks.append(taskId);
+            } else {
+                status = 400;
+            }
+        } else {
+            status = 404;
+        }
+
+        writeResponse(socket, status, "Content-Type: application/json\r\n",
+                      QJsonDocument(response).toJson(QJsonDocument::Compact));
+    }
+};
+
+bool testUploadResume()
+{
+    printSeparator(QString::fromUtf8("断点续传日志测试"));
+
+    const qint64 chunkSize = 64 * 1024;
+    const int totalChunks = 200;
+    const int concurrency = 3;
+    const qint64 fileSize = chunkSize * totalChunks - 123;
+
+    QTemporaryDir dir;
+    QString filePath = dir.path() + "/scene.mb";
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "无法创建测试文件";
+        return false;
+    }
+    QByteArray block(chunkSize, Qt::Uninitialized);
+    for (qint64 written = 0; written < fileSize; written += block.size()) {
+        QRandomGenerator::global()->fillRange(reinterpret_cast<quint32*>(block.data()), block.size() / 4);
+        file.write(block.constData(), qMin<qint64>(block.size(), fileSize - written));
+    }
+    file.close();
+
+    quint32 seed = QRandomGenerator::global()->generate();
+    QRandomGenerator rng(seed);
+    qDebug() << "随机种子:" << seed;
+
+    auto chunkBytes = [&](int index) {
+        return qMin(chunkSize, fileSize - index * chunkSize);
+    };
+
+    QVector<int> sendCount(totalChunks, 0);
+    qint64 totalSent = 0;
+    qint64 maxResent = 0;
+    int kills = 0;
+    TestResult result;
+
+    while (true) {
+        UploadJournal journal(dir.path() + "/journal");
+        bool resumed = journal.open(filePath, chunkSize, "upload_0");
+        if (kills > 0 && (!resumed || journal.uploadId() != "upload_0")) {
+            qDebug() << "✗ 重启后未恢复原上传会话";
+            result.passed = false;
+            break;
+        }
+
+        QList<int> pending;
+        for (int i = 0; i < totalChunks; ++i) {
+            if (!journal.confirmedChunks().contains(i)) {
+                pending.append(i);
+            }
+        }
+
+        if (pending.isEmpty()) {
+            journal.remove();
+            break;
+        }
+
+        int killAfter = rng.bounded(1, static_cast<int>(pending.size()) + concurrency + 1);
+        int events = 0;
+        bool killed = false;
+        qint64 resent = 0;
+        QList<int> inFlight;
+
+        while (!pending.isEmpty() || !inFlight.isEmpty()) {
+            while (inFlight.size() < concurrency && !pending.isEmpty()) {
+                int index = pending.takeFirst();
+                if (sendCount[index] > 0) {
+                    resent += chunkBytes(index);
+                }
+                sendCount[index]++;
+                totalSent += chunkBytes(index);
+                inFlight.append(index);
+            }
+
+            if (++events >= killAfter) {
+                killed = true;
+                break;
+            }
+
+            int done = inFlight.takeAt(rng.bounded(static_cast<int>(inFlight.size())));
+            journal.markConfirmed(done);
+        }
+
+        maxResent = qMax(maxResent, resent);
+        if (resent > concurrency * chunkSize) {
+            qDebug() << "✗ 重启后重传" << resent << "字节，超过" << concurrency << "个分片";
+            result.passed = false;
+        }
+
+        if (killed) {
+            // 模拟被杀时写了一半的记录
+            QString journalPath = journal.journalPath();
+            journal.close();
+            QFile torn(journalPath);
+            if (torn.open(QIODevice::WriteOnly | QIODevice::Append)) {
+                torn.write(QByteArray::number(rng.bounded(totalChunks)));
+            }
+            kills++;
+        }
+    }
+
+    qDebug() << "被杀次数:" << kills;
+    qDebug() << "文件大小:" << fileSize << "字节, 实际发送:" << totalSent << "字节";
+    qDebug() << "单次重启最大重传:" << maxResent << "字节（上限" << concurrency * chunkSize << "）";
+
+    // 重启后上传任务 ID 变了，仍沿用日志中的上传会话
+    {
+        UploadJournal journal(dir.path() + "/journal");
+        journal.open(filePath, chunkSize, "upload_0");
+        journal.markConfirmed(0);
+        journal.close();
+        bool resumed = journal.open(filePath, chunkSize, "upload_1");
+        result.check(resumed && journal.confirmedChunks().contains(0) && journal.uploadId() == "upload_0",
+                     "以新的上传任务 ID 打开时沿用原上传会话");
+        journal.remove();
+    }
+
+    // 驱动 FileUploader：上传中途被杀，重启后以新的上传任务 ID 提交时续传
+    FakeUploadServer server;
+    if (!server.listen(QHostAddress::LocalHost)) {
+        qDebug() << "无法启动本地服务";
+        return false;
+    }
+    HttpClient::instance().setBaseUrl(QString("http://127.0.0.1:%1").arg(server.serverPort()));
+
+    // 日志和哈希缓存写到测试目录，不影响真实数据
+    QStandardPaths::setTestModeEnabled(true);
+    QDir(UploadJournal::defaultDirectory()).removeRecursively();
+
+    const int cancelAfter = 10;
+
+    // 上传到第 cancelAt 个分片被确认时取消（为 0 时上传到结束），返回是否上传成功
+    // 每次都用新的上传器，相当于重启后重新提交
+    QString uploadId;
+    auto runUploader = [&](const QString& taskId, int cancelAt) {
+        FileUploader* uploader = new FileUploader();
+        uploader->setAdaptiveEnabled(false);
+        uploader->setChunkSize(chunkSize);
+        uploader->setConcurrency(concurrency);
+
+        QEventLoop loop;
+        bool success = false;
+        qint64 lastUploaded = 0;
+        QObject::connect(uploader, &FileUploader::progressChanged, [&](int, qint64 uploadedBytes, qint64) {
+            if (cancelAt > 0 && lastUploaded < cancelAt * chunkSize && uploadedBytes >= cancelAt * chunkSize) {
+                uploader->cancel();
+            }
+            lastUploaded = uploadedBytes;
+        });
+        QObject::connect(uploader, &FileUploader::uploadFinished, &loop, [&](bool ok) {
+            success = ok;
+            loop.quit();
+        });
+        QTimer::singleShot(60000, &loop, &QEventLoop::quit);
+        uploader->startUpload(filePath, taskId);
+        loop.exec();
+        uploadId = uploader->uploadId();
+
+        // 在途请求的回调会访问上传器，等它们返回后再销毁
+        QEventLoop drain;
+        QTimer::singleShot(500, &drain, &QEventLoop::quit);
+        drain.exec();
+        delete uploader;
+        return success;
+    };
+
+    bool finished = runUploader("local_1", cancelAfter);
+    QString firstSession = uploadId;
+    int sent = server.chunkRequests.value(firstSession);
+    int received = server.sessions.value(firstSession).size();
+    result.check(!finished && received >= cancelAfter, "第一次上传中途中断");
+
+    finished = runUploader("local_2", 0);
+    int resent = server.chunkRequests.value(firstSession) - sent;
+    qDebug() << "中断前服务端已收到" << received << "个分片，重启后发送" << resent << "个";
+    result.check(finished && uploadId == firstSession && server.mergedTasks.contains(firstSession),
+                 "重启后以新的上传任务 ID 提交，沿用原上传会话完成上传");
+    result.check(!server.chunkRequests.contains("local_2"), "没有以新的上传任务 ID 开始新会话");
+    result.check(resent == totalChunks - received, "重启后只上传剩余分片");
+    result.check(QDir(UploadJournal::defaultDirectory()).entryList(QDir::Files).isEmpty(), "上传完成后日志已删除");
+
+    // 上传完成后日志已删除，再次提交同一文件开始新的会话
+    finished = runUploader("local_3", 0);
+    result.check(finished && uploadId == "local_3" && server.mergedTasks.contains("local_3"),
+                 "上传完成后再次提交，开始新的上传会话");
+
+    // 自适应分片：第一个分片失败后控制器把分片减半，未发送的分片（包括失败的那个）按新大小拆分；
+    // 中途取消后重新提交，按日志重放拆分，续传时分片序号与服务端一致
+    const qint64 MB = 1024 * 1024;
+    const qint64 splitFileSize = 8 * MB + 123;
+    QString splitPath = dir.path() + "/split.mb";
+    {
+        // 随机内容，避免相同的块被去重跳过
+        QByteArray data(splitFileSize, Qt::Uninitialized);
+        QRandomGenerator::global()->fillRange(reinterpret_cast<quint32*>(data.data()), data.size() / 4);
+        QFile splitFile(splitPath);
+        if (splitFile.open(QIODevice::WriteOnly)) {
+            splitFile.write(data);
+        }
+    }
+    server.failOnce.insert("split_1");
+
+    auto runSplitUploader = [&](const QString& taskId, bool adaptive, qint64 cancelAtBytes) {
+        FileUploader* uploader = new FileUploader();
+        UploadRateController::Limits limits;
+        limits.maxConcurrency = 1;
+        uploader->rateController()->setLimits(limits);
+        uploader->setConcurrency(1);
+        uploader->setChunkSize(4 * MB);
+        uploader->setAdaptiveEnabled(adaptive);
+
+        QEventLoop loop;
+        bool success = false;
+        QObject::connect(uploader, &FileUploader::progressChanged, [&](int, qint64 uploadedBytes, qint64) {
+            if (cancelAtBytes > 0 && uploadedBytes >= cancelAtBytes && uploader->isUploading()) {
+                uploader->cancel();
+            }
+        });
+        QObject::connect(uploader, &FileUploader::uploadFinished, &loop, [&](bool ok) {
+            success = ok;
+            loop.quit();
+        });
+        QTimer::singleShot(60000, &loop, &QEventLoop::quit);
+        uploader->startUpload(splitPath, taskId);
+        loop.exec();
+        uploadId = uploader->uploadId();
+
+        QEventLoop drain;
+        QTimer::singleShot(500, &drain, &QEventLoop::quit);
+        drain.exec();
+        delete uploader;
+        return success;
+    };
+
+    finished = runSplitUploader("split_1", true, 4 * MB);
+    QMap<qint64, qint64> splitRanges = server.ranges.value("split_1");
+    qint64 largest = 0;
+    for (qint64 size : splitRanges) {
+        largest = qMax(largest, size);
+    }
+    qDebug() << "失败后收到的分片:" << splitRanges.size() << "个，最大" << largest << "字节";
+    result.check(!finished && !splitRanges.isEmpty() && largest <= 2 * MB, "超时重试后按减半的分片大小发送");
+
+    finished = runSplitUploader("split_2", false, 0);
+    qDebug() << "合并时分片数:" << server.sessions.value("split_1").size();
+    result.check(finished && uploadId == "split_1" && server.mergedTasks.contains("split_1"),
+                 "拆分后中断，重新提交时按日志恢复分片布局完成上传");
+    result.check(server.sessions.value("split_1").size() == 5, "4MB 分片拆成 2MB 后共 5 个分片");
+
+    return result.report();
+}
+
+/**
+ * @brief 内容哈希缓存测试：命中、未命中、文件修改后失效、过期和超限清理，
+ * 以及不同分片大小上传同一文件时哈希一致、服务端已有的块不再上传
+ */
+bool testChunkHashCache()
+{
+    printSeparator(QString::fromUtf8("内容哈希缓存测试"));
+
+    TestResult result;
+
+    QTemporaryDir dir;
+    const QString cacheDir = dir.path() + "/cache";
+    const qint64 blockSize = ChunkHashCache::BLOCK_SIZE;
+
+    auto writeFile = [&](const QString& name, qint64 size) {
+        QString filePath = dir.path() + "/" + name;
+        QFile file(filePath);
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(QByteArray(size, name.at(0).toLatin1()));
+        }
+        return filePath;
+    };
+    auto hashesFor = [](const QString& seed, int blocks) {
+        QVector<QByteArray> hashes;
+        for (int i = 0; i < blocks; ++i) {
+            hashes.append(QCryptographicHash::hash(seed.toUtf8() + QByteArray::number(i), QCryptographicHash::Sha256).toHex());
+        }
+        return hashes;
+    };
+    auto entryCount = [&]() {
+        return QDir(cacheDir).entryList(QStringList() << "*.json", QDir::Files).size();
+    };
+
+    ChunkHashCache cache(cacheDir);
+    const qint64 sceneSize = 3 * blockSize + 100;
+    QString scene = writeFile("scene.mb", sceneSize);
+    QVector<QByteArray> hashes = hashesFor("scene", ChunkHashCache::blockCount(sceneSize));
+    QByteArray fileHash = QCryptographicHash::hash("scene", QCryptographicHash::Sha256).toHex();
+
+    QVector<QByteArray> cachedHashes;
+    QByteArray cachedFileHash;
+    result.check(hashes.size() == 4, "不足一块的文件末尾单独成块");
+    result.check(!cache.lookup(scene, &cachedHashes, &cachedFileHash), "写入前未命中");
+
+    cache.store(scene, hashes, fileHash);
+    result.check(cache.lookup(scene, &cachedHashes, &cachedFileHash)
+                 && cachedHashes == hashes && cachedFileHash == fileHash, "写入后命中，内容一致");
+
+    cache.store(scene, hashesFor("scene", 3), fileHash);
+    result.check(!cache.lookup(scene, &cachedHashes, &cachedFileHash), "块数量与文件大小不一致时未命中");
+
+    // 修改文件：大小和修改时间变化后失效，重新写入覆盖同一条目
+    cache.store(scene, hashes, fileHash);
+    {
+        QFile file(scene);
+        if (file.open(QIODevice::Append)) {
+            file.write(QByteArray(blockSize, 'x'));
+            file.close();
+        }
+        if (file.open(QIODevice::ReadWrite)) {
+            file.setFileTime(QDateTime::currentDateTime().addSecs(10), QFileDevice::FileModificationTime);
+        }
+    }
+    result.check(!cache.lookup(scene, &cachedHashes, &cachedFileHash), "文件修改后失效");
+    QVector<QByteArray> newHashes = hashesFor("scene-v2", ChunkHashCache::blockCount(sceneSize + blockSize));
+    cache.store(scene, newHashes, fileHash);
+    result.check(cache.lookup(scene, &cachedHashes, &cachedFileHash) && cachedHashes == newHashes,
+                 "重新写入后命中新结果");
+    result.check(entryCount() == 1, "文件修改后重新写入不留旧条目");
+
+    // 过期：最近使用时间超过保留天数的条目在下一次写入时删除
+    {
+        QFile entry(QDir(cacheDir).entryInfoList(QStringList() << "*.json", QDir::Files).first().absoluteFilePath());
+        if (entry.open(QIODevice::ReadWrite)) {
+            entry.setFileTime(QDateTime::currentDateTime().addDays(-31), QFileDevice::FileModificationTime);
+        }
+    }
+    QVector<QByteArray> smallHashes = hashesFor("small", 1);
+    QString other = writeFile("other.mb", 4096);
+    cache.store(other, smallHashes, fileHash);
+    result.check(!cache.lookup(scene, &cachedHashes, &cachedFileHash)
+                 && cache.lookup(other, &cachedHashes, &cachedFileHash), "过期条目在写入时删除");
+
+    // 超限：只保留最近使用的条目
+    QFileInfo otherEntry(QDir(cacheDir).entryInfoList(QStringList() << "*.json", QDir::Files).first());
+    ChunkHashCache small(cacheDir, otherEntry.size() * 5 / 2);
+    QStringList files;
+    for (int i = 0; i < 5; ++i) {
+        files << writeFile(QString("f%1.mb").arg(i), 4096);
+        small.store(files.last(), smallHashes, fileHash);
+        QThread::msleep(20);    // 区分修改时间
+    }
+    qDebug() << "超限后剩余条目:" << entryCount();
+    result.check(entryCount() == 2, "超出总大小上限时只保留最近的条目");
+    result.check(small.lookup(files[4], &cachedHashes, &cachedFileHash)
+                 && !small.lookup(files[0], &cachedHashes, &cachedFileHash), "按最近使用时间淘汰");
+
+    // 驱动 FileUploader：同一文件先按 2MB 分片上传，再按 1MB 分片提交
+    FakeUploadServer server;
+    if (!server.listen(QHostAddress::LocalHost)) {
+        qDebug() << "无法启动本地服务";
+        return false;
+    }
+    server.responseDelayMs = 0;
+    HttpClient::instance().setBaseUrl(QString("http://127.0.0.1:%1").arg(server.serverPort()));
+
+    QStandardPaths::setTestModeEnabled(true);
+    QDir(UploadJournal::defaultDirectory()).removeRecursively();
+    QDir(ChunkHashCache::defaultDirectory()).removeRecursively();
+
+    const qint64 uploadSize = 6 * blockSize + 123;
+    QString upload = dir.path() + "/upload.mb";
+    {
+        QFile file(upload);
+        if (file.open(QIODevice::WriteOnly)) {
+            QByteArray data(uploadSize, Qt::Uninitialized);
+            QRandomGenerator::global()->fillRange(reinterpret_cast<quint32*>(data.data()), data.size() / 4);
+            file.write(data);
+        }
+    }
+    QByteArray expectedHash;
+    {
+        QFile file(upload);
+        if (file.open(QIODevice::ReadOnly)) {
+            expectedHash = QCryptographicHash::hash(file.readAll(), QCryptographicHash::Sha256).toHex();
+        }
+    }
+
+    QByteArray uploadedHash;
+    auto runUploader = [&](const QString& taskId, qint64 chunkSize) {
+        FileUploader* uploader = new FileUploader();
+        uploader->setAdaptiveEnabled(false);
+        uploader->setChunkSize(chunkSize);
+
+        QEventLoop loop;
+        bool success = false;
+        QObject::connect(uploader, &FileUploader::uploadFinished, &loop, [&](bool ok) {
+            success = ok;
+            loop.quit();
+        });
+        QTimer::singleShot(60000, &loop, &QEventLoop::quit);
+        uploader->startUpload(upload, taskId);
+        loop.exec();
+        uploadedHash = uploader->fileHash();
+        delete uploader;
+        return success;
+    };
+
+    bool finished = runUploader("dedup_1", 2 * blockSize);
+    result.check(finished && server.chunkRequests.value("dedup_1") == 4, "按 2MB 分片上传完成");
+    result.check(uploadedHash == expectedHash, "文件哈希是整个文件的 SHA-256");
+
+    QByteArray firstHash = uploadedHash;
+    finished = runUploader("dedup_2", blockSize);
+    result.check(uploadedHash == firstHash, "不同分片大小得到相同的文件哈希");
+    result.check(finished && server.mergedTasks.contains("dedup_2") && !server.chunkRequests.contains("dedup_2"),
+                 "换一种分片大小再次提交，服务端已有全部块，不再上传分片");
+    result.check(QDir(ChunkHashCache::defaultDirectory()).entryList(QDir::Files).size() == 1,
+                 "缓存条目与分片大小无关");
+
+    return result.report();
+}
+
+/**
+ * @brief 上传调度器测试：任务失败或取消时仍有分片在途，全局并发上限不被突破、槽位不泄漏
+ */
+bool testUploadScheduler()
+{
+    printSeparator(QString::fromUtf8("上传调度器测试"));
+
+    TestResult result;
+
+    const qint64 chunkSize = 1024 * 1024;
+    const int chunksPerFile = 8;
+    const int cap = 2;
+
+    QTemporaryDir dir;
+    auto writeFile = [&](const QString& name) {
+        QString filePath = dir.path() + "/" + name + ".mb";
+        QFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly)) {
+            return QString();
+        }
+        QByteArray block(chunkSize, Qt::Uninitialized);
+        for (int i = 0; i < chunksPerFile; ++i) {
+            QRandomGenerator::global()->fillRange(reinterpret_cast<quint32*>(block.data()), block.size() / 4);
+            file.write(block);
+        }
+        return filePath;
+    };
+
+    FakeUploadServer server;
+    server.responseDelayMs = 100;
+    server.failTasks.insert("job_fail");
+    if (!server.listen(QHostAddress::LocalHost)) {
+        qDebug() << "无法启动本地服务";
+        return false;
+    }
+    HttpClient::instance().setBaseUrl(QString("http://127.0.0.1:%1").arg(server.serverPort()));
+
+    // 日志和哈希缓存写到测试目录，不影响真实数据
+    QStandardPaths::setTestModeEnabled(true);
+    QDir(UploadJournal::defaultDirectory()).removeRecursively();
+
+    // 固定全局并发和分片大小，不让自适应调整干扰上限检查
+    UploadScheduler scheduler;
+    UploadRateController::Limits limits;
+    limits.minConcurrency = cap;
+    limits.maxConcurrency = cap;
+    limits.minChunkSize = chunkSize;
+    limits.maxChunkSize = chunkSize;
+    scheduler.rateController()->setLimits(limits);
+    scheduler.rateController()->reset(cap, chunkSize);
+
+    QHash<QString, int> finishCount;
+    QHash<QString, bool> results;
+    QEventLoop* waiting = nullptr;
+    QObject::connect(&scheduler, &UploadScheduler::jobFinished, [&](const QString& jobId, bool success) {
+        finishCount[jobId]++;
+        results[jobId] = success;
+        if (waiting) {
+            waiting->quit();
+        }
+    });
+
+    // 第一个分片确认后取消（此时另一个槽位上通常还有该任务的分片在途）
+    bool cancelRequested = false;
+    QObject::connect(&scheduler, &UploadScheduler::jobProgress, [&](const QString& jobId, int, qint64 uploadedBytes, qint64) {
+        if (jobId == "job_cancel" && uploadedBytes > 0 && !cancelRequested) {
+            cancelRequested = true;
+            QTimer::singleShot(0, &scheduler, [&]() { scheduler.cancel("job_cancel"); });
+        }
+    });
+
+    // 等待任务结束，超时返回 false
+    auto waitForJobs = [&](const QStringList& jobIds) {
+        QElapsedTimer timer;
+        timer.start();
+        auto finished = [&]() {
+            for (const QString& jobId : jobIds) {
+                if (!results.contains(jobId)) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        while (!finished() && timer.elapsed() < 60000) {
+            QEventLoop loop;
+            waiting = &loop;
+            QTimer::singleShot(1000, &loop, &QEventLoop::quit);
+            loop.exec();
+            waiting = nullptr;
+        }
+        return finished();
+    };
+
+    QStringList jobIds = QStringList() << "job_cancel" << "job_fail" << "job_ok1" << "job_ok2";
+    for (const QString& jobId : jobIds) {
+        QString filePath = writeFile(jobId);
+        if (filePath.isEmpty()) {
+            qDebug() << "无法创建测试文件";
+            return false;
+        }
+        // 被取消的任务优先级最高，几乎占满槽位
+        scheduler.enqueue(jobId, filePath, jobId == "job_cancel" ? 3 : 1);
+    }
+
+    result.check(waitForJobs(jobIds), "所有任务都已结束");
+    result.check(results.value("job_cancel", true) == false, "取消的任务以失败结束");
+    result.check(results.value("job_fail", true) == false, "分片持续失败的任务以失败结束");
+    result.check(results.value("job_ok1") && results.value("job_ok2"), "其他任务上传成功");
+    bool finishedOnce = true;
+    for (const QString& jobId : jobIds) {
+        finishedOnce = finishedOnce && finishCount.value(jobId) == 1;
+    }
+    result.check(finishedOnce, "每个任务只结束一次");
+
+    // 等已结束任务的在途分片全部返回后，槽位应当全部归还，新任务仍能用满并发
+    QEventLoop drain;
+    QTimer::singleShot(500, &drain, &QEventLoop::quit);
+    drain.exec();
+    result.check(server.chunksInFlight == 0, "服务端没有未完成的分片请求");
+
+    QString filePath = writeFile("job_after");
+    scheduler.enqueue("job_after", filePath, 1);
+    result.check(waitForJobs(QStringList() << "job_after") && results.value("job_after"), "之后提交的任务上传成功（槽位未泄漏）");
+
+    qDebug() << "服务端最大同时分片请求数:" << server.maxChunksInFlight << "（上限" << cap << "）";
+    result.check(server.maxChunksInFlight <= cap, "在途分片数始终不超过全局并发上限");
+
+    return result.report();
+}
+
+/**
+ * @brief 生成合成 .ma 场景
+ *
+ * 结构接近生产场景：大部分体积是网格顶点等数值 setAttr，
+ * 中间穿插 file 节点（纹理路径），字符串中带分号和转义引号。
+ *
+ * @return 写入的纹理路径数量
+ */
+int writeSyntheticAsciiScene(const QString& filePath, qint64 targetBytes)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return -1;
+    }
+
+    QByteArray buffer;
+    buffer.reserve(8 * 1024 * 1024);
+    buffer += "//Maya ASCII 2024 scene\n"
+              "//Name: synthetic.ma\n"
+              "//Codeset: UTF-8\n"
+              "requires maya \"2024\";\n"
+              "requires -nodeType \"aiOptions\" -nodeType \"aiAOVDriver\" \"mtoa\" \"5.3.0\";\n"
+              "requires \"stereoCamera\" \"10.0\";\n"
+              "file -rdi 1 -ns \"chr\" -rfn \"chrRN\" -typ \"mayaAscii\" \"D:/assets/chr/chr_rig.ma\";\n"
+              "currentUnit -l centimeter -a degree -t film;\n"
+              "fileInfo \"application\" \"maya\";\n"
+              "fileInfo \"product\" \"Maya 2024\";\n"
+              "select -ne :defaultRenderGlobals;\n"
+              "\tsetAttr \".ren\" -type \"string\" \"arnold\";\n";
+
+    // 一个网格块约 64KB 数值数据
+    QByteArray vertices;
+    for (int i = 0; i < 1000; ++i) {
+        vertices += QByteArray::number(i * 0.001, 'f', 6) + " "
+                  + QByteArray::number(i * 0.002, 'f', 6) + " "
+                  + QByteArray::number(i * 0.003, 'f', 6) + "\n\t\t";
+    }
+
+    int textures = 0;
+    qint64 written = 0;
+    for (int block = 0; written + buffer.size() < targetBytes; ++block) {
+        buffer += "createNode mesh -n \"meshShape" + QByteArray::number(block) + "\" -p \"mesh" + QByteArray::number(block) + "\";\n"
+                  "\tsetAttr -k off \".v\";\n"
+                  "\tsetAttr -s 1000 \".vt[0:999]\"  " + vertices + ";\n"
+                  "\tsetAttr \".notes\" -type \"string\" \"uv; set \\\"main\\\"\";\n"
+                  "connectAttr \"mesh" + QByteArray::number(block) + ".iog\" \":initialShadingGroup.dsm\" -na;\n";
+
+        buffer += "createNode file -n \"file" + QByteArray::number(block) + "\";\n"
+                  "\tsetAttr \".ftn\" -type \"string\" \"sourceimages/tex_" + QByteArray::number(block) + ".<UDIM>.exr\";\n"
+                  "\tsetAttr \".cs\" -type \"string\" \"ACEScg\";\n";
+        textures++;
+
+        if (buffer.size() >= 4 * 1024 * 1024) {
+            file.write(buffer);
+            written += buffer.size();
+            buffer.clear();
+        }
+    }
+
+    buffer += "// End of synthetic.ma\n";
+    file.write(buffer);
+    return textures;
+}
+
+/**
+ * @brief .ma 解析基准测试：合成场景上的吞吐，并与原先的前 10000 行正则扫描对比
+ */
+void benchmarkSceneParser(qint64 sizeMB)
+{
+    printSeparator(QString::fromUtf8("Maya ASCII 解析基准测试"));
+
+    QTemporaryDir dir;
+    QString filePath = dir.path() + "/synthetic.ma";
+
+    QElapsedTimer timer;
+    timer.start();
+    int expectedTextures = writeSyntheticAsciiScene(filePath, sizeMB * 1024 * 1024);
+    if (expectedTextures < 0) {
+        qDebug() << "无法创建测试文件";
+        return;
+    }
+    qint64 fileSize = QFileInfo(filePath).size();
+    qDebug() << "生成场景:" << fileSize / 1024 / 1024 << "MB, 纹理" << expectedTextures << "个, 耗时" << timer.elapsed() << "ms";
+
+    // 新解析器（第二遍在页缓存热的情况下测量）
+    for (int pass = 0; pass < 2; ++pass) {
+        timer.restart();
+        MayaAsciiParser parser;
+        SceneInfo info = parser.parseFile(filePath);
+        double seconds = qMax<qint64>(timer.elapsed(), 1) / 1000.0;
+
+        int textures = 0;
+        for (const SceneFileAttribute& attribute : info.fileAttributes) {
+            if (attribute.nodeType == "file") {
+                textures++;
+            }
+        }
+
+        qDebug() << (pass == 0 ? "\n[MayaAsciiParser 冷]" : "\n[MayaAsciiParser 热]");
+        qDebug() << "  吞吐:" << QString::number(fileSize / seconds / 1024 / 1024, 'f', 1) << "MB/s";
+        qDebug() << "  版本:" << info.mayaVersion << "渲染器:" << info.rendererName()
+                 << "插件:" << info.plugins.size() << "引用:" << info.references.size();
+        qDebug() << "  纹理:" << textures << "/" << expectedTextures << (textures == expectedTextures ? "✓" : "✗");
+        qDebug() << "  峰值内存:" << peakRssBytes() / 1024 / 1024 << "MB";
+    }
+
+    // 多线程切分解析：与单线程结果比较，统计加速比
+    {
+        MayaAsciiParser parser;
+        SceneInfo reference = parser.parseFile(filePath);
+        double baseline = 0;
+
+        for (int threads = 1; threads <= 8; threads *= 2) {
+            ParallelSceneScanner scanner(threads);
+            int progressCalls = 0;
+            scanner.setProgressCallback([&progressCalls](qint64, qint64) { progressCalls++; });
+
+            timer.restart();
+            SceneInfo info = scanner.scanFile(filePath);
+            double seconds = qMax<qint64>(timer.elapsed(), 1) / 1000.0;
+            if (threads == 1) {
+                baseline = seconds;
+            }
+
+            bool same = info.isValid == reference.isValid
+                && info.mayaVersion == reference.mayaVersion
+                && info.currentRenderer == reference.currentRenderer
+                && info.references == reference.references
+                && info.plugins.size() == reference.plugins.size()
+                && info.fileAttributes.size() == reference.fileAttributes.size();
+            for (int i = 0; same && i < info.fileAttributes.size(); ++i) {
+                same = info.fileAttributes[i].nodeName == reference.fileAttributes[i].nodeName
+                    && info.fileAttributes[i].path == reference.fileAttributes[i].path;
+            }
+
+            qDebug() << QString("\n[ParallelSceneScanner %1 线程]").arg(threads);
+            qDebug() << "  吞吐:" << QString::number(fileSize / seconds / 1024 / 1024, 'f', 1) << "MB/s"
+                     << "加速比:" << QString::number(baseline / seconds, 'f', 2);
+            qDebug() << "  进度回调:" << progressCalls << "次, 结果与单线程一致:" << (same ? "✓" : "✗");
+        }
+
+        // 解析开始后立即取消
+        ParallelSceneScanner scanner(4);
+        scanner.setProgressCallback([&scanner](qint64, qint64) { scanner.cancel(); });
+        timer.restart();
+        SceneInfo cancelled = scanner.scanFile(filePath);
+        qDebug() << "\n[取消]" << timer.elapsed() << "ms 返回, 结果无效:" << (!cancelled.isValid ? "✓" : "✗");
+    }
+
+    // 原实现：逐行拼接前 10000 行，再逐个正则全文匹配
+    {
+        timer.restart();
+        QFile file(filePath);
+        file.open(QIODevice::ReadOnly | QIODevice::Text);
+        QTextStream in(&file);
+        QString content;
+        for (int line = 0; !in.atEnd() && line < 10000; ++line) {
+            content += in.readLine() + "\n";
+        }
+
+        int textures = 0;
+        const QStringList patterns = {"fileTextureName.*?\"([^\"]+)\"", "iesProfile.*?\"([^\"]+)\"", "cacheFile.*?\"([^\"]+)\""};
+        for (const QString& pattern : patterns) {
+            QRegularExpressionMatchIterator it = QRegularExpression(pattern).globalMatch(content);
+            while (it.hasNext()) {
+                it.next();
+                textures++;
+            }
+        }
+        double seconds = qMax<qint64>(timer.elapsed(), 1) / 1000.0;
+
+        qDebug() << "\n[原实现: 前 10000 行 + 正则]";
+        qDebug() << "  读取:" << content.size() * 2 / 1024 << "KB, 耗时" << QString::number(seconds, 'f', 3) << "s";
+        qDebug() << "  纹理:" << textures << "/" << expectedTextures << "(短名 .ftn 不匹配，且只看前 10000 行)";
+    }
+}
+
+/**
+ * @brief 场景分析缓存测试：命中耗时、指纹失效和 LRU 淘汰
+ * @return 是否通过
+ */
+bool testSceneInfoCache(qint64 sizeMB)
+{
+    printSeparator(QString::fromUtf8("场景分析缓存测试"));
+
+    QTemporaryDir dir;
+    TestResult result;
+
+    QString scenePath = dir.path() + "/scene.ma";
+    writeSyntheticAsciiScene(scenePath, sizeMB * 1024 * 1024);
+    SceneInfoCache cache(dir.path() + "/cache", 64 * 1024 * 1024);
+
+    QElapsedTimer timer;
+    timer.start();
+    SceneInfo parsed = ParallelSceneScanner().scanFile(scenePath);
+    qint64 parseMs = timer.elapsed();
+    cache.store(scenePath, parsed);
+
+    timer.restart();
+    SceneInfo cached;
+    bool hit = cache.lookup(scenePath, &cached);
+    qint64 lookupMs = timer.elapsed();
+    qDebug() << "场景" << QFileInfo(scenePath).size() / 1024 / 1024 << "MB, 解析" << parseMs << "ms, 缓存命中" << lookupMs << "ms";
+
+    result.check(hit, "未修改的场景命中缓存");
+    result.check(cached.mayaVersion == parsed.mayaVersion && cached.rendererName() == parsed.rendererName()
+                 && cached.plugins.size() == parsed.plugins.size() && cached.assetPaths() == parsed.assetPaths(),
+                 QString("缓存结果与解析结果一致（素材 %1 个）").arg(cached.assetPaths().size()));
+
+    // 内容修改但大小和修改时间不变：由部分哈希发现
+    QFile scene(scenePath);
+    QDateTime modified = QFileInfo(scenePath).lastModified();
+    scene.open(QIODevice::ReadWrite);
+    scene.seek(2);
+    scene.write("X");
+    scene.setFileTime(modified, QFileDevice::FileModificationTime);
+    scene.close();
+    result.check(!cache.lookup(scenePath, &cached), "内容修改（大小、时间不变）后失效");
+
+    // 追加内容
+    cache.store(scenePath, parsed);
+    scene.open(QIODevice::Append);
+    scene.write("// appended\n");
+    scene.close();
+    result.check(!cache.lookup(scenePath, &cached), "追加内容后失效");
+
+    // LRU：上限只够放两条，最近访问过的保留
+    QString lruDirectory = dir.path() + "/lru";
+    QStringList scenes;
+    for (int i = 0; i < 3; ++i) {
+        scenes << dir.path() + QString("/small%1.ma").arg(i);
+        writeSyntheticAsciiScene(scenes.last(), 256 * 1024);
+    }
+    // 先写一条测得条目大小，上限设为 2.5 条
+    SceneInfoCache(lruDirectory, 1024 * 1024).store(scenes[0], ParallelSceneScanner().scanFile(scenes[0]));
+    qint64 entrySize = QDir(lruDirectory).entryInfoList(QDir::Files).value(0).size();
+    SceneInfoCache lru(lruDirectory, entrySize * 5 / 2);
+
+    QThread::msleep(50);
+    lru.store(scenes[1], ParallelSceneScanner().scanFile(scenes[1]));
+    QThread::msleep(50);
+    lru.lookup(scenes[0], &cached);
+    QThread::msleep(50);
+    lru.store(scenes[2], ParallelSceneScanner().scanFile(scenes[2]));
+
+    result.check(lru.lookup(scenes[0], &cached) && !lru.lookup(scenes[1], &cached) && lru.lookup(scenes[2], &cached),
+                 "超出上限时淘汰最久未使用的条目");
+
+    return result.report();
+}
+
+/**
+ * @brief 模拟 Maya 常驻进程（--fake-maya），供 MayaBatchRunner 测试使用
+ *
+ * 按 MayaBatchRunner 的帧协议读写标准输入输出，对插件查询返回固定内容。
+ * 与 maya.mel.eval 一样，没有包在 { } 块中的查询声明的变量留在全局作用域：
+ * 可用插件查询的 $allPlugins 会跨查询累积。
+ * 特殊命令：FAKE_CRASH 立即退出，FAKE_SLEEP <毫秒> 延迟响应，FAKE_ERROR 返回错误。
+ * @param startupMs 模拟的冷启动耗时
+ */
+int runFakeMaya(int startupMs)
+{
+    auto send = [](quint64 id, const QByteArray& status, const QString& text) {
+        // 帧前故意输出一段不换行的日志，验证接收方能跳过
+        QByteArray data = "// fake maya log" + MayaBatchRunner::encodeFrame("YTR", id, status, text.toUtf8());
+        std::fwrite(data.constData(), 1, data.size(), stdout);
+        std::fflush(stdout);
+    };
+
+    std::fputs("Fake Maya 2024 starting...\n", stdout);
+    std::fflush(stdout);
+    QThread::msleep(startupMs);
+    send(0, "ready", QString());
+
+    QRegularExpression pluginRegex("string \\$plugin = \"([^\"]+)\"");
+    QStringList globalPlugins;
+    char header[256];
+    while (std::fgets(header, sizeof(header), stdin)) {
+        QList<QByteArray> parts = QByteArray(header).trimmed().split(' ');
+        if (parts.size() != 4 || parts[0] != "YTQ") {
+            continue;
+        }
+
+        quint64 id = parts[1].toULongLong();
+        QByteArray body(parts[3].toInt(), '\0');
+        if (!body.isEmpty() && std::fread(body.data(), 1, body.size(), stdin) != size_t(body.size())) {
+            break;
+        }
+
+        QString mel = QString::fromUtf8(body);
+        bool scoped = mel.startsWith("{\n") && mel.endsWith("\n}");
+        if (scoped) {
+            mel = mel.mid(2, mel.size() - 4);
+        }
+        QString plugin = pluginRegex.match(mel).captured(1);
+        if (mel.contains("FAKE_CRASH")) {
+            std::exit(3);
+        } else if (mel.startsWith("FAKE_SLEEP")) {
+            QThread::msleep(mel.section(' ', 1, 1).toInt());
+            send(id, "ok", "slept\n");
+        } else if (mel.contains("FAKE_ERROR")) {
+            send(id, "error", "// Error: fake error");
+        } else if (mel.contains("PLUGIN_INFO")) {
+            send(id, "ok", QString("PLUGIN_INFO:%1|9.9.9|C:/fake/%1.mll|Fake Vendor\n").arg(plugin));
+        } else if (mel.contains("PLUGIN_PATH")) {
+            send(id, "ok", QString("PLUGIN_PATH:%1|C:/fake/%1.mll\n").arg(plugin));
+        } else if (mel.contains("AVAILABLE_PLUGIN")) {
+            QStringList localPlugins;
+            QStringList& allPlugins = scoped ? localPlugins : globalPlugins;
+            allPlugins << "mtoa" << "vrayformaya";
+            QString output;
+            for (const QString& name : allPlugins) {
+                output += "AVAILABLE_PLUGIN:" + name + "\n";
+            }
+            send(id, "ok", output);
+        } else if (mel.contains("pluginInfo -query -list")) {
+            send(id, "ok", "mtoa\nredshift4maya\nfbxmaya\n");
+        } else {
+            send(id, "ok", "echo:" + mel);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Maya 常驻批处理进程测试：帧协议、冷启动与常驻查询耗时、并发、崩溃/超时恢复、空闲退出
+ * @return 是否通过
+ */
+bool testMayaBatchRunner(int startupMs)
+{
+    printSeparator(QString::fromUtf8("Maya 常驻批处理进程测试"));
+
+    TestResult result;
+
+    // 帧编解码：跳过噪声、拆分到达
+    QByteArray stream = "Maya log line\n// partial" + MayaBatchRunner::encodeFrame("YTR", 7, "ok", "a\nYTR 1 ok 3\nb")
+                      + MayaBatchRunner::encodeFrame("YTR", 8, "error", "");
+    QByteArray buffer;
+    QList<MayaBatchRunner::Frame> frames;
+    for (char c : stream) {
+        buffer.append(c);
+        MayaBatchRunner::Frame frame;
+        while (MayaBatchRunner::takeFrame(&buffer, &frame)) {
+            frames.append(frame);
+        }
+    }
+    result.check(frames.size() == 2 && frames[0].id == 7 && frames[0].payload == "a\nYTR 1 ok 3\nb"
+                 && frames[1].id == 8 && frames[1].status == "error" && frames[1].payload.isEmpty(),
+                 "逐字节到达时正确拆帧，内容中的伪帧头不影响");
+
+    MayaBatchRunner& runner = MayaBatchRunner::instance();
+    QString fakeMaya = "C:/Program Files/Autodesk/Maya2024/bin/fake-maya.exe";
+    runner.setWorkerProgram(fakeMaya, QCoreApplication::applicationFilePath(),
+                            QStringList() << "--fake-maya" << QString::number(startupMs));
+    runner.setQueryTimeout(2000);
+
+    QElapsedTimer timer;
+    timer.start();
+    MayaBatchResult first = runner.execute(fakeMaya, "pluginInfo -query -list").result();
+    qint64 coldMs = timer.elapsed();
+    result.check(first.success && first.output == "mtoa\nredshift4maya\nfbxmaya\n", "首次查询（含启动）结果正确");
+
+    // 同一进程中执行两次相同的查询：查询中声明的变量不残留到下一次
+    const QString availableCommand = "string $allPlugins[];\n$allPlugins[size($allPlugins)] = \"mtoa\";\n// AVAILABLE_PLUGIN";
+    MayaBatchResult available = runner.execute(fakeMaya, availableCommand).result();
+    MayaBatchResult availableAgain = runner.execute(fakeMaya, availableCommand).result();
+    result.check(available.success && available.output == "AVAILABLE_PLUGIN:mtoa\nAVAILABLE_PLUGIN:vrayformaya\n"
+                 && availableAgain.output == available.output, "两次相同的查询输出相同，变量不跨查询累积");
+
+    const int queries = 20;
+    timer.restart();
+    for (int i = 0; i < queries; ++i) {
+        runner.execute(fakeMaya, QString("string $plugin = \"p%1\"; PLUGIN_INFO").arg(i)).waitForFinished();
+    }
+    qint64 warmMs = timer.elapsed();
+    qDebug() << "冷启动查询:" << coldMs << "ms, 常驻进程" << queries << "次查询:" << warmMs << "ms";
+    qDebug() << "每次启动新进程（旧方式）至少需要:" << (queries + 1) * startupMs << "ms";
+    result.check(runner.workersStarted() == 1, "所有查询共用一个进程");
+
+    // 多线程同时提交，结果与请求一一对应
+    QList<QFuture<MayaBatchResult>> futures;
+    QList<QThread*> threads;
+    QMutex futuresMutex;
+    for (int t = 0; t < 4; ++t) {
+        QThread* thread = QThread::create([&, t]() {
+            for (int i = t; i < 64; i += 4) {
+                QFuture<MayaBatchResult> future = runner.execute(fakeMaya, QString("query %1").arg(i));
+                QMutexLocker locker(&futuresMutex);
+                futures.append(future);
+            }
+        });
+        threads << thread;
+        thread->start();
+    }
+    for (QThread* thread : threads) {
+        thread->wait();
+        delete thread;
+    }
+    QSet<QString> outputs;
+    for (QFuture<MayaBatchResult>& future : futures) {
+        outputs.insert(future.result().output);
+    }
+    int matched = 0;
+    for (int i = 0; i < 64; ++i) {
+        matched += outputs.contains(QString("echo:query %1").arg(i)) ? 1 : 0;
+    }
+    result.check(matched == 64, QString("并发提交 64 个查询全部返回（%1）").arg(matched));
+
+    MayaBatchResult error = runner.execute(fakeMaya, "FAKE_ERROR").result();
+    result.check(!error.success && error.error.contains("fake error"), "MEL 错误作为失败结果返回");
+
+    // 崩溃：当前查询失败，排队的查询由新进程执行
+    QFuture<MayaBatchResult> crash = runner.execute(fakeMaya, "FAKE_CRASH");
+    QFuture<MayaBatchResult> afterCrash = runner.execute(fakeMaya, "after crash");
+    result.check(!crash.result().success && afterCrash.result().output == "echo:after crash" && runner.workersStarted() == 2,
+                 "进程崩溃后排队查询由新进程完成");
+
+    // 超时
+    timer.restart();
+    MayaBatchResult slow = runner.execute(fakeMaya, "FAKE_SLEEP 10000").result();
+    result.check(!slow.success && timer.elapsed() < 8000, QString("查询超时（%1 ms）").arg(timer.elapsed()));
+    result.check(runner.execute(fakeMaya, "after timeout").result().output == "echo:after timeout", "超时后自动重启");
+
+    // 启动失败
+    MayaBatchResult missing = runner.execute("/nonexistent/maya/bin/maya", "pluginInfo -query -list").result();
+    result.check(!missing.success, QString("Maya 不存在时返回失败: %1").arg(missing.error));
+
+    // 空闲退出
+    runner.setIdleTimeout(300);
+    runner.execute(fakeMaya, "idle").waitForFinished();
+    QThread::msleep(1500);
+    result.check(runner.runningWorkers() == 0, "空闲进程自动退出");
+
+    runner.shutdown();
+    result.check(!runner.execute(fakeMaya, "after shutdown").result().success, "关闭后查询直接失败");
+
+    return result.report();
+}
+
+/**
+ * @brief Maya 安装索引测试：保存/读取、stat 校验耗时，以及各类变化后失效
+ * @return 是否通过
+ */
+bool testMayaInstallIndex()
+{
+    printSeparator(QString::fromUtf8("Maya 安装索引测试"));
+
+    QTemporaryDir dir;
+    TestResult result;
+
+    auto touchFile = [](const QString& path) {
+        QFile file(path);
+        file.open(QIODevice::WriteOnly);
+        file.write("x");
+    };
+
+    // 模拟安装目录
+    QString root = dir.path() + "/Autodesk";
+    QString installPath = root + "/Maya2024";
+    QDir().mkpath(installPath + "/bin");
+    QDir().mkpath(installPath + "/plug-ins");
+    touchFile(installPath + "/bin/maya.exe");
+    touchFile(installPath + "/plug-ins/mtoa.mll");
+
+    MayaSoftwareInfo info;
+    info.name = "Maya";
+    info.version = "2024";
+    info.fullVersion = "2024";
+    info.installPath = installPath;
+    info.executablePath = installPath + "/bin/maya.exe";
+    info.renderers << "Arnold 5.3.0";
+    info.plugins << "mtoa" << "bifrostGraph";
+    info.isValid = true;
+
+    QStringList candidates;
+    candidates << installPath;
+    QStringList sources;
+    sources << root << installPath << installPath + "/bin" << installPath + "/plug-ins"
+            << installPath + "/modules" << dir.path() + "/prefs/pluginPrefs.mel";
+
+    QString indexPath = dir.path() + "/maya-index.json";
+    MayaInstallIndex index(indexPath);
+    index.update(QVector<MayaSoftwareInfo>() << info, candidates, sources);
+    result.check(index.save(), "写入索引");
+
+    MayaInstallIndex loaded(indexPath);
+    QElapsedTimer timer;
+    timer.start();
+    bool upToDate = loaded.load() && loaded.isUpToDate(candidates);
+    qDebug() << "读取并校验索引耗时" << timer.nsecsElapsed() / 1000 << "us";
+    result.check(upToDate, "未变化时索引有效");
+    result.check(loaded.installs().size() == 1 && loaded.installs()[0].installPath == installPath
+                 && loaded.installs()[0].renderers == info.renderers && loaded.installs()[0].plugins == info.plugins
+                 && loaded.installs()[0].isValid, "索引内容与检测结果一致");
+
+    result.check(loaded.isUpToDate(QStringList() << QDir::toNativeSeparators(installPath) << installPath),
+                 "候选路径分隔符和重复项不影响校验");
+    result.check(!loaded.isUpToDate(candidates + QStringList(root + "/Maya2025")), "注册表新增安装后失效");
+
+    // 目录修改时间精度可能较粗，修改前稍作等待
+    auto expectChanged = [&](const std::function<void()>& change, const QString& what) {
+        index.save();
+        QThread::msleep(1100);
+        change();
+        MayaInstallIndex reloaded(indexPath);
+        result.check(reloaded.load() && !reloaded.isUpToDate(candidates), what);
+        index.update(QVector<MayaSoftwareInfo>() << info, candidates, sources);
+    };
+
+    expectChanged([&]() { touchFile(installPath + "/plug-ins/redshift4maya.mll"); }, "插件目录新增文件后失效");
+    expectChanged([&]() { QDir().mkpath(installPath + "/modules"); }, "原本不存在的目录出现后失效");
+    expectChanged([&]() {
+        QDir().mkpath(dir.path() + "/prefs");
+        touchFile(dir.path() + "/prefs/pluginPrefs.mel");
+    }, "pluginPrefs.mel 新建后失效");
+    expectChanged([&]() { QDir().mkpath(root + "/Maya2025"); }, "安装根目录新增 Maya 后失效");
+    expectChanged([&]() { QFile::remove(installPath + "/bin/maya.exe"); }, "卸载（可执行文件删除）后失效");
+
+    // 格式损坏
+    QFile corrupt(indexPath);
+    corrupt.open(QIODevice::WriteOnly);
+    corrupt.write("{ not json");
+    corrupt.close();
+    MayaInstallIndex broken(indexPath);
+    result.check(!broken.load() && !broken.isUpToDate(candidates), "索引文件损坏时视为无效");
+
+    broken.clear();
+    result.check(!QFile::exists(indexPath), "clear() 删除索引文件");
+
+    return result.report();
+}
+
+/**
+ * @brief 素材解析测试：UDIM / 序列模式展开、相对路径，以及与逐个 QFile::exists 的耗时对比
+ * @return 是否通过
+ */
+bool testAssetResolver(int referenceCount)
+{
+    printSeparator(QString::fromUtf8("素材解析测试"));
+
+    QTemporaryDir dir;
+    TestResult result;
+
+    auto touch = [](const QString& path) {
+        QDir().mkpath(QFileInfo(path).absolutePath());
+        QFile file(path);
+        file.open(QIODevice::WriteOnly);
+    };
+
+    QString root = dir.path();
+    for (int tile = 1001; tile <= 1010; ++tile) {
+        touch(root + QString("/sourceimages/wood.%1.exr").arg(tile));
+    }
+    for (int frame = 1; frame <= 5; ++frame) {
+        touch(root + QString("/cache/smoke.%1.vdb").arg(frame, 4, 10, QChar('0')));
+    }
+    touch(root + "/sourceimages/metal.png");
+
+    QStringList references = {
+        root + "/sourceimages/metal.png",       // 绝对路径
+        "sourceimages/metal.png",               // 相对路径
+        "sourceimages\\metal.png",              // Windows 分隔符
+        "sourceimages/wood.<UDIM>.exr",
+        "sourceimages/wood.<udim>.exr",
+        "cache/smoke.####.vdb",
+        "cache/smoke.%04d.vdb",
+        "sourceimages/missing.png",
+        "sourceimages/stone.<UDIM>.exr",        // 模式无匹配
+        "nowhere/file.png"                      // 目录不存在
+    };
+
+    AssetResolver resolver;
+    QVector<AssetResolution> results = resolver.resolve(references, root);
+
+    result.check(!results[0].isMissing() && !results[1].isMissing() && !results[2].isMissing(), "普通路径（绝对、相对、反斜杠）");
+    result.check(results[3].isPattern && results[3].files.size() == 10 && results[4].files.size() == 10, "<UDIM> / <udim> 展开为 10 个 tile");
+    result.check(results[5].files.size() == 5 && results[6].files.size() == 5, "#### / %04d 展开为 5 帧");
+    result.check(results[7].isMissing() && results[8].isMissing() && results[9].isMissing(), "缺失文件、无匹配模式、不存在的目录");
+    result.check(resolver.directoriesListed() == 3, QString("按目录分组，只列出 %1 个目录").arg(resolver.directoriesListed()));
+
+    // 大量引用：逐个 QFile::exists 与按目录批量对比
+    const int directories = 20;
+    for (int d = 0; d < directories; ++d) {
+        for (int i = 0; i < 50; ++i) {
+            touch(root + QString("/big/dir%1/tex_%2.tx").arg(d).arg(i));
+        }
+    }
+    QStringList many;
+    for (int i = 0; i < referenceCount; ++i) {
+        many << QString("big/dir%1/tex_%2.tx").arg(i % directories).arg(i % 100);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    int serialMissing = 0;
+    QDir sceneDir(root);
+    for (const QString& reference : many) {
+        if (!QFile::exists(reference) && !QFile::exists(sceneDir.absoluteFilePath(reference))) {
+            serialMissing++;
+        }
+    }
+    qint64 serialMs = timer.elapsed();
+
+    timer.restart();
+    AssetResolver batch;
+    int batchMissing = 0;
+    for (const AssetResolution& resolution : batch.resolve(many, root)) {
+        batchMissing += resolution.isMissing() ? 1 : 0;
+    }
+    qint64 batchMs = timer.elapsed();
+
+    qDebug() << "\n" << referenceCount << "个引用:";
+    qDebug() << "  逐个 QFile::exists:" << serialMs << "ms, 缺失" << serialMissing;
+    qDebug() << "  按目录批量:" << batchMs << "ms, 缺失" << batchMissing << ", 列目录" << batch.directoriesListed() << "次";
+    result.check(serialMissing == batchMissing, "两种方式结果一致");
+
+    return result.report();
+}
+
+/**
+ * @brief 文件搜索基准测试：逐个文件名递归 QDirIterator 与 FileCrawler 单次多线程遍历对比
+ *
+ * 在临时目录生成约 dirCount 个目录的树（每层 8 个子目录，每个目录若干普通文件），
+ * 在深处放置 4 种插件文件，另有一个跳过名单中的 node_modules 子树放置诱饵文件。
+ * @return 是否通过
+ */
+bool benchmarkFileCrawler(int dirCount)
+{
+    printSeparator(QString::fromUtf8("文件搜索基准测试"));
+
+    QTemporaryDir dir;
+    TestResult result;
+
+    auto touch = [](const QString& path) {
+        QFile file(path);
+        file.open(QIODevice::WriteOnly);
+    };
+
+    const QStringList pluginNames = {"mtoa.mll", "pgYetiMaya.mll", "vray.mll", "redshift4maya.mll"};
+    const int fanout = 8;
+    QString root = dir.path() + "/tree";
+
+    // 广度优先生成目录树
+    QStringList level;
+    level << root;
+    QDir().mkpath(root);
+    QStringList allDirs;
+    while (allDirs.size() < dirCount && !level.isEmpty()) {
+        QStringList nextLevel;
+        for (const QString& parent : level) {
+            for (int i = 0; i < fanout && allDirs.size() < dirCount; ++i) {
+                QString child = parent + QString("/d%1").arg(i);
+                QDir().mkdir(child);
+                for (int f = 0; f < 4; ++f) {
+                    touch(child + QString("/file%1.dat").arg(f));
+                }
+                allDirs << child;
+                nextLevel << child;
+            }
+        }
+        level = nextLevel;
+    }
+
+    // 插件放在最深的几层，每种两份
+    QHash<QString, QStringList> planted;
+    for (int i = 0; i < pluginNames.size(); ++i) {
+        for (int copy = 0; copy < 2; ++copy) {
+            QString target = allDirs[allDirs.size() - 1 - (i * 2 + copy) * 97 % (allDirs.size() / 2)];
+            touch(target + "/" + pluginNames[i]);
+            planted[pluginNames[i]] << target + "/" + pluginNames[i];
+        }
+    }
+
+    // 应被跳过的大目录
+    QString decoyRoot = root + "/node_modules";
+    for (int i = 0; i < dirCount / 4; ++i) {
+        QDir().mkpath(decoyRoot + QString("/pkg%1/lib").arg(i));
+        touch(decoyRoot + QString("/pkg%1/lib/index.js").arg(i));
+    }
+    touch(decoyRoot + "/pkg0/lib/mtoa.mll");
+
+    qDebug() << "生成目录" << allDirs.size() << "个 + node_modules" << dirCount / 4 << "个";
+
+    // 预热目录缓存
+    for (QDirIterator warm(root, QDir::AllEntries | QDir::NoDotAndDotDot, QDirIterator::Subdirectories); warm.hasNext();) {
+        warm.next();
+    }
+
+    // 旧方式：每个文件名各遍历一次
+    QElapsedTimer timer;
+    timer.start();
+    QHash<QString, QStringList> serial;
+    for (const QString& name : pluginNames) {
+        QDirIterator it(root, QStringList() << name, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            serial[name] << it.next();
+        }
+    }
+    qint64 serialMs = timer.elapsed();
+    qDebug() << "逐个文件名 QDirIterator:" << serialMs << "ms";
+
+    for (auto it = planted.begin(); it != planted.end(); ++it) {
+        std::sort(it.value().begin(), it.value().end());
+    }
+
+    for (int threads : {1, 2, 4, 8}) {
+        FileCrawler crawler(threads);
+        timer.restart();
+        QHash<QString, QStringList> found = crawler.find(QStringList() << root, pluginNames);
+        qint64 ms = timer.elapsed();
+        qDebug() << "FileCrawler" << threads << "线程:" << ms << "ms, 遍历目录" << crawler.directoriesVisited()
+                 << QString("(%1x)").arg(ms > 0 ? double(serialMs) / ms : 0.0, 0, 'f', 1);
+        result.check(found == planted, QString("%1 线程结果正确（node_modules 被跳过）").arg(threads));
+    }
+    result.check(serial["mtoa.mll"].size() == 3, "旧方式会进入 node_modules");
+
+    // 深度限制
+    FileCrawler shallow;
+    shallow.setMaxDepth(2);
+    result.check(shallow.find(QStringList() << root, pluginNames).isEmpty(), "深度限制内没有插件时结果为空");
+
+    // 嵌套根目录只遍历一次
+    FileCrawler nested;
+    QHash<QString, QStringList> nestedFound = nested.find(QStringList() << root << root + "/d0" << root + "/", pluginNames);
+    result.check(nestedFound == planted, QString("嵌套根目录不重复（遍历 %1 个目录）").arg(nested.directoriesVisited()));
+
+    // 提前结束：每种插件找到一份即停止
+    FileCrawler early;
+    early.setStopCondition([&pluginNames](const QHash<QString, QStringList>& results) {
+        return results.size() == pluginNames.size();
+    });
+    timer.restart();
+    QHash<QString, QStringList> earlyFound = early.find(QStringList() << root, pluginNames);
+    qDebug() << "提前结束:" << timer.elapsed() << "ms, 遍历目录" << early.directoriesVisited();
+    result.check(early.stoppedEarly() && earlyFound.size() == pluginNames.size(), "找齐后提前结束");
+
+    return result.report();
+}
+
+/**
+ * @brief 统计绘制次数的任务委托（验证只绘制可见行）
+ */
+class CountingTaskDelegate : public TaskItemDelegate
+{
+public:
+    mutable int paintCount = 0;
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override
+    {
+        ++paintCount;
+        TaskItemDelegate::paint(painter, option, index);
+    }
+};
+
+/**
+ * @brief 任务列表基准测试：大量任务时的模型填充、首次显示和逐帧滚动耗时
+ *
+ * 需要 QApplication，在 main 中先于 QCoreApplication 处理；无显示环境时使用 offscreen 平台。
+ */
+bool benchmarkTaskList(int taskCount)
+{
+    printSeparator(QString::fromUtf8("任务列表基准测试"));
+
+    TestResult result;
+
+    qint64 rssBefore = peakRssBytes();
+
+    // 生成任务
+    QElapsedTimer timer;
+    timer.start();
+    QList<Task*> tasks;
+    tasks.reserve(taskCount);
+    QDateTime now = QDateTime::currentDateTime();
+    const TaskStatus statuses[] = {TaskStatus::Queued, TaskStatus::Rendering, TaskStatus::Paused,
+                                   TaskStatus::Completed, TaskStatus::Failed, TaskStatus::Cancelled};
+    for (int i = 0; i < taskCount; ++i) {
+        Task *task = new Task();
+        task->setTaskId(QString("bench_task_%1").arg(i));
+        task->setTaskName(QString::fromUtf8("渲染任务 %1 - 场景 %2").arg(i).arg(i % 97));
+        task->setStatus(statuses[i % 6]);
+        task->setProgress(i % 101);
+        task->setStartFrame(1);
+        task->setEndFrame(100 + i % 200);
+        task->setCreatedAt(now.addSecs(-i * 60));
+        tasks.append(task);
+    }
+    qDebug() << "创建" << taskCount << "个任务:" << timer.elapsed() << "ms";
+
+    TaskListModel model(false);
+    timer.restart();
+    model.setTasks(tasks);
+    qDebug() << "填充模型:" << timer.elapsed() << "ms";
+    result.check(model.rowCount() == taskCount, "模型行数正确");
+
+    CountingTaskDelegate delegate;
+    QListView view;
+    view.setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    view.setSelectionMode(QAbstractItemView::NoSelection);
+    view.setUniformItemSizes(true);
+    view.setItemDelegate(&delegate);
+    view.resize(1000, 800);
+
+    timer.restart();
+    view.setModel(&model);
+    view.show();
+    QApplication::processEvents();
+    view.viewport()->repaint();
+    qint64 firstShowMs = timer.elapsed();
+    int visibleRows = 800 / delegate.sizeHint(QStyleOptionViewItem(), QModelIndex()).height() + 2;
+    qDebug() << "首次显示:" << firstShowMs << "ms, 绘制" << delegate.paintCount << "行";
+    result.check(delegate.paintCount <= visibleRows * 4, "首次显示只绘制可见行");
+
+    // 逐帧滚动：小步滚动和大跨度跳转交替
+    QScrollBar *scrollBar = view.verticalScrollBar();
+    const int frames = 300;
+    QList<double> frameMs;
+    int maxPaintsPerFrame = 0;
+    QElapsedTimer frameTimer;
+    for (int frame = 0; frame < frames; ++frame) {
+        int value = (frame % 2 == 0)
+            ? qMin(scrollBar->maximum(), scrollBar->value() + 40)
+            : static_cast<int>(static_cast<qint64>(scrollBar->maximum()) * frame / frames);
+        delegate.paintCount = 0;
+        frameTimer.start();
+        scrollBar->setValue(value);
+        view.viewport()->repaint();
+        frameMs.append(frameTimer.nsecsElapsed() / 1e6);
+        maxPaintsPerFrame = qMax(maxPaintsPerFrame, delegate.paintCount);
+    }
+    std::sort(frameMs.begin(), frameMs.end());
+    double total = 0;
+    for (double ms : frameMs) {
+        total += ms;
+    }
+    double p95 = frameMs[static_cast<int>(frames * 0.95)];
+    qDebug() << QString::fromUtf8("滚动 %1 帧: 平均 %2 ms, p95 %3 ms, 最大 %4 ms（帧预算 16.7 ms）")
+        .arg(frames).arg(total / frames, 0, 'f', 2).arg(p95, 0, 'f', 2).arg(frameMs.last(), 0, 'f', 2);
+    qDebug() << (p95 < 16.7 ? "  滚动在帧预算内" : "  ⚠ p95 超出帧预算");
+    result.check(maxPaintsPerFrame <= visibleRows * 4, QString("每帧最多绘制 %1 行").arg(maxPaintsPerFrame));
+
+    // 单个任务变化只重绘对应的行
+    QModelIndex top = view.indexAt(QPoint(10, 10));
+    QApplication::processEvents();
+    delegate.paintCount = 0;
+    tasks[top.row()]->setProgress((tasks[top.row()]->progress() + 1) % 101);
+    QApplication::processEvents();
+    qDebug() << "单个任务进度变化后重绘" << delegate.paintCount << "行";
+    result.check(delegate.paintCount >= 1 && delegate.paintCount <= 2, "只重绘变化的行");
+
+    qint64 rssAfter = peakRssBytes();
+    if (rssBefore > 0 && rssAfter > 0) {
+        qDebug() << "峰值内存增加:" << (rssAfter - rssBefore) / 1024 / 1024 << "MB（含任务对象本身）";
+    }
+
+    view.setModel(nullptr);
+    qDeleteAll(tasks);
+
+    return result.report();
+}
+
+/**
+ * @brief 任务进度推送基准测试：逐条写入任务与按帧合并写入对比
+ *
+ * 模拟大量渲染任务持续收到进度推送（WebSocket task:progress / 上传进度），
+ * 统计收到的事件数、模型行刷新次数和实际绘制的行数。需要 QApplication。
+ */
+bool benchmarkTaskUpdates(int taskCount)
+{
+    printSeparator(QString::fromUtf8("任务进度推送基准测试"));
+
+    TestResult result;
+
+    QList<Task*> tasks;
+    QDateTime now = QDateTime::currentDateTime();
+    for (int i = 0; i < taskCount; ++i) {
+        Task *task = new Task();
+        task->setTaskId(QString("bench_task_%1").arg(i));
+        task->setTaskName(QString::fromUtf8("渲染任务 %1").arg(i));
+        task->setStatus(TaskStatus::Rendering);
+        task->setCreatedAt(now.addSecs(-i * 60));
+        tasks.append(task);
+    }
+
+    TaskListModel model(false);
+    model.setTasks(tasks);
+    qint64 rowUpdates = 0;
+    QObject::connect(&model, &QAbstractItemModel::dataChanged, [&]() {
+        ++rowUpdates;
+    });
+
+    CountingTaskDelegate delegate;
+    QListView view;
+    view.setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    view.setSelectionMode(QAbstractItemView::NoSelection);
+    view.setUniformItemSizes(true);
+    view.setItemDelegate(&delegate);
+    view.resize(1000, 800);
+    view.setModel(&model);
+    view.show();
+    QApplication::processEvents();
+
+    // 每轮推送一批事件后处理一次事件循环，持续 durationMs；两种方式使用相同的随机序列
+    const int durationMs = 2000;
+    const int eventsPerRound = 200;
+    struct Result {
+        qint64 events = 0;
+        qint64 rowUpdates = 0;
+        qint64 paints = 0;
+        qint64 maxRoundMs = 0;
+    };
+    auto run = [&](TaskUpdateCoalescer *coalescer) {
+        Result result;
+        QRandomGenerator random(20241016);
+        rowUpdates = 0;
+        delegate.paintCount = 0;
+
+        QElapsedTimer timer;
+        QElapsedTimer roundTimer;
+        timer.start();
+        while (timer.elapsed() < durationMs) {
+            roundTimer.start();
+            for (int i = 0; i < eventsPerRound; ++i) {
+                int index = random.bounded(taskCount);
+                int progress = random.bounded(101);
+                if (coalescer) {
+                    coalescer->setProgress(tasks[index], tasks[index]->taskId(), progress);
+                } else {
+                    tasks[index]->setProgress(progress);
+                }
+                ++result.events;
+            }
+            QApplication::processEvents();
+            result.maxRoundMs = qMax(result.maxRoundMs, roundTimer.elapsed());
+        }
+        if (coalescer) {
+            coalescer->flush();
+            QApplication::processEvents();
+        }
+
+        result.rowUpdates = rowUpdates;
+        result.paints = delegate.paintCount;
+        return result;
+    };
+    auto report = [&](const QString& name, const Result& result) {
+        qDebug().noquote() << QString::fromUtf8("%1: 事件 %2（%3/秒），行刷新 %4，绘制 %5 行（%6 行/秒），最长一轮 %7 ms")
+            .arg(name).arg(result.events).arg(result.events * 1000 / durationMs)
+            .arg(result.rowUpdates).arg(result.paints).arg(result.paints * 1000 / durationMs)
+            .arg(result.maxRoundMs);
+    };
+
+    Result direct = run(nullptr);
+    report(QString::fromUtf8("逐条写入"), direct);
+
+    TaskUpdateCoalescer coalescer(30);
+    Result merged = run(&coalescer);
+    report(QString::fromUtf8("按帧合并"), merged);
+
+    TaskUpdateCoalescer::Stats stats = coalescer.stats();
+    qDebug().noquote() << QString::fromUtf8("合并器: 收到 %1 个事件，覆盖 %2 个，提交 %3 次，变化 %4 个任务")
+        .arg(stats.eventsIn).arg(stats.eventsMerged).arg(stats.flushes).arg(stats.tasksChanged);
+
+    result.check(stats.eventsIn == merged.events, "合并器统计到全部事件");
+    result.check(stats.flushes <= durationMs * 30 / 1000 + 2, QString::fromUtf8("提交次数不超过 30 次/秒（%1 次）").arg(stats.flushes));
+    result.check(merged.rowUpdates < direct.rowUpdates, "合并后行刷新次数减少");
+
+    // 合并后最终进度与最后一次推送一致
+    QRandomGenerator random(20241016);
+    QHash<int, int> lastProgress;
+    for (qint64 i = 0; i < merged.events; ++i) {
+        int index = random.bounded(taskCount);
+        lastProgress[index] = random.bounded(101);
+    }
+    bool consistent = true;
+    for (auto it = lastProgress.constBegin(); it != lastProgress.constEnd(); ++it) {
+        consistent = consistent && tasks[it.key()]->progress() == it.value();
+    }
+    result.check(consistent, "任务最终进度等于最后一次推送");
+
+    view.setModel(nullptr);
+    qDeleteAll(tasks);
+
+    return result.report();
+}
+
+/**
+ * @brief 关键字扫描基准测试：向量化多关键字扫描与 QRegularExpression 对比
+ *
+ * 关键字与原 scanSceneAssets 的正则一致。两种方式都统计包含关键字的行数，结果应相同。
+ */
+void benchmarkKeywordScanner(qint64 sizeMB)
+{
+    printSeparator(QString::fromUtf8("关键字扫描基准测试"));
+
+    const QList<QByteArray> keywords = {"fileTextureName", "iesProfile", "cacheFile", "requires"};
+
+    QTemporaryDir dir;
+    QString filePath = dir.path() + "/synthetic.ma";
+    if (writeSyntheticAsciiScene(filePath, sizeMB * 1024 * 1024) < 0) {
+        qDebug() << "无法创建测试文件";
+        return;
+    }
+
+    QFile file(filePath);
+    file.open(QIODevice::ReadOnly);
+    qint64 fileSize = file.size();
+    const char* data = reinterpret_cast<const char*>(file.map(0, fileSize));
+    if (!data) {
+        qDebug() << "无法映射测试文件";
+        return;
+    }
+    qDebug() << "场景大小:" << fileSize / 1024 / 1024 << "MB, CPU 支持:"
+             << KeywordScanner::instructionSetName(KeywordScanner::detectInstructionSet());
+
+    // 先完整读一遍，排除首次缺页的影响
+    volatile char sink = 0;
+    for (qint64 i = 0; i < fileSize; i += 4096) {
+        sink = sink + data[i];
+    }
+
+    KeywordScanner scanner(keywords);
+    int expectedLines = -1;
+    for (int isa = KeywordScanner::Scalar; isa <= KeywordScanner::detectInstructionSet(); ++isa) {
+        scanner.setInstructionSet(static_cast<KeywordScanner::InstructionSet>(isa));
+
+        // 命中后跳到行尾继续，每行只统计一次
+        QElapsedTimer timer;
+        timer.start();
+        int lines = 0;
+        qint64 position = 0;
+        while (position < fileSize) {
+            qint64 found = scanner.findNext(data + position, fileSize - position);
+            if (found < 0) {
+                break;
+            }
+            lines++;
+            const char* eol = static_cast<const char*>(std::memchr(data + position + found, '\n', fileSize - position - found));
+            position = eol ? eol - data + 1 : fileSize;
+        }
+        double seconds = qMax<qint64>(timer.elapsed(), 1) / 1000.0;
+
+        if (expectedLines < 0) {
+            expectedLines = lines;
+        }
+        qDebug() << "\n[KeywordScanner" << KeywordScanner::instructionSetName(scanner.instructionSet()) << "]";
+        qDebug() << "  吞吐:" << QString::number(fileSize / seconds / 1024 / 1024, 'f', 1) << "MB/s";
+        qDebug() << "  命中行:" << lines << (lines == expectedLines ? "✓" : "✗");
+    }
+
+    // 原方式：转换为 QString 后正则匹配（分块进行，避免一次性占用数 GB 内存）
+    {
+        QStringList alternatives;
+        for (const QByteArray& keyword : keywords) {
+            alternatives << QRegularExpression::escape(QString::fromUtf8(keyword));
+        }
+        QRegularExpression re("^[^\\n]*(?:" + alternatives.join('|') + ")", QRegularExpression::MultilineOption);
+
+        QElapsedTimer timer;
+        timer.start();
+        int lines = 0;
+        const qint64 blockSize = 64 * 1024 * 1024;
+        for (qint64 offset = 0; offset < fileSize;) {
+            // 分块边界对齐到行尾
+            qint64 blockEnd = qMin(offset + blockSize, fileSize);
+            const char* eol = static_cast<const char*>(std::memchr(data + blockEnd - 1, '\n', fileSize - blockEnd + 1));
+            blockEnd = eol ? eol - data + 1 : fileSize;
+
+            QString content = QString::fromUtf8(data + offset, blockEnd - offset);
+            QRegularExpressionMatchIterator it = re.globalMatch(content);
+            while (it.hasNext()) {
+                it.next();
+                lines++;
+            }
+            offset = blockEnd;
+        }
+        double seconds = qMax<qint64>(timer.elapsed(), 1) / 1000.0;
+
+        qDebug() << "\n[QRegularExpression]";
+        qDebug() << "  吞吐:" << QString::number(fileSize / seconds / 1024 / 1024, 'f', 1) << "MB/s";
+        qDebug() << "  命中行:" << lines << (lines == expectedLines ? "✓" : "✗");
+    }
+
+    file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(data)));
+}
+
+/**
+ * @brief 关键字扫描测试：CPU 支持的每种实现都与逐字节比较的结果一致
+ *
+ * 随机缓冲区由关键字片段和少量字符拼成，前缀候选密集，关键字落在向量块边界和缓冲区末尾附近；
+ * 每种实现找出全部命中，同时用同一批缓冲区检查 findFirstOf。
+ */
+bool testKeywordScanner(int rounds)
+{
+    printSeparator(QString::fromUtf8("关键字扫描测试"));
+
+    const QList<QByteArray> keywords = {"fileTextureName", "iesProfile", "cacheFile", "requires"};
+    const QByteArray alphabet = "fiicaqre\n \";";
+
+    quint32 seed = QRandomGenerator::global()->generate();
+    QRandomGenerator rng(seed);
+    qDebug() << "随机种子:" << seed << ", CPU 支持:"
+             << KeywordScanner::instructionSetName(KeywordScanner::detectInstructionSet());
+
+    // 逐字节比较的参考实现
+    auto referenceHits = [&](const char* data, qint64 size) {
+        QVector<QPair<qint64, int>> hits;
+        for (qint64 i = 0; i < size; ++i) {
+            for (int k = 0; k < keywords.size(); ++k) {
+                if (size - i >= keywords[k].size() && std::memcmp(data + i, keywords[k].constData(), keywords[k].size()) == 0) {
+                    hits.append(qMakePair(i, k));
+                    break;
+                }
+            }
+        }
+        return hits;
+    };
+    auto scannerHits = [](const KeywordScanner& scanner, const char* data, qint64 size) {
+        QVector<QPair<qint64, int>> hits;
+        qint64 position = 0;
+        int keyword = -1;
+        while (position < size) {
+            qint64 found = scanner.findNext(data + position, size - position, &keyword);
+            if (found < 0) {
+                break;
+            }
+            hits.append(qMakePair(position + found, keyword));
+            position += found + 1;
+        }
+        return hits;
+    };
+
+    KeywordScanner scanner(keywords);
+    QVector<int> mismatches(KeywordScanner::detectInstructionSet() + 1, 0);
+    int firstOfMismatches = 0;
+    qint64 totalHits = 0;
+
+    for (int round = 0; round < rounds; ++round) {
+        QByteArray buffer;
+        int targetSize = rng.bounded(300);
+        while (buffer.size() < targetSize) {
+            if (rng.bounded(4) == 0) {
+                // 完整关键字或被截断的关键字
+                const QByteArray& keyword = keywords[rng.bounded(static_cast<int>(keywords.size()))];
+                buffer += rng.bounded(3) == 0 ? keyword.left(rng.bounded(1, static_cast<int>(keyword.size()))) : keyword;
+            } else {
+                buffer += alphabet.at(rng.bounded(static_cast<int>(alphabet.size())));
+            }
+        }
+        if (rng.bounded(2) == 0) {
+            // 缓冲区以关键字结尾
+            buffer += keywords[rng.bounded(static_cast<int>(keywords.size()))];
+        }
+
+        // 从随机偏移开始扫描，覆盖未对齐的起点
+        int start = buffer.isEmpty() ? 0 : rng.bounded(qMin(static_cast<int>(buffer.size()), 40));
+        const char* data = buffer.constData() + start;
+        qint64 size = buffer.size() - start;
+
+        QVector<QPair<qint64, int>> expected = referenceHits(data, size);
+        totalHits += expected.size();
+        for (int isa = KeywordScanner::Scalar; isa <= KeywordScanner::detectInstructionSet(); ++isa) {
+            scanner.setInstructionSet(static_cast<KeywordScanner::InstructionSet>(isa));
+            if (scannerHits(scanner, data, size) != expected) {
+                mismatches[isa]++;
+            }
+        }
+
+        char a = alphabet.at(rng.bounded(static_cast<int>(alphabet.size())));
+        char b = alphabet.at(rng.bounded(static_cast<int>(alphabet.size())));
+        const char* end = data + size;
+        const char* naive = data;
+        while (naive < end && *naive != a && *naive != b) {
+            ++naive;
+        }
+        if (KeywordScanner::findFirstOf(data, end, a, b) != naive) {
+            firstOfMismatches++;
+        }
+    }
+
+    qDebug() << "轮数:" << rounds << ", 命中总数:" << totalHits;
+
+    TestResult result;
+    for (int isa = KeywordScanner::Scalar; isa < mismatches.size(); ++isa) {
+        result.check(mismatches[isa] == 0, QString::fromUtf8("%1 实现与逐字节比较一致（不一致 %2 轮）")
+                     .arg(KeywordScanner::instructionSetName(static_cast<KeywordScanner::InstructionSet>(isa)))
+                     .arg(mismatches[isa]));
+    }
+    result.check(firstOfMismatches == 0, QString::fromUtf8("findFirstOf 与逐字节查找一致（不一致 %1 轮）").arg(firstOfMismatches));
+    return result.report();
+}
+
+/**
+ * @brief IFF 场景写入器：生成 FOR4/FOR8 格式的 .mb 测试场景
+ *
+ * 组块的长度在 endGroup() 时回填。
+ */
+class IffSceneWriter
+{
+public:
+    IffSceneWriter(QFile* file, bool is64)
+        : m_file(file), m_is64(is64) {}
+
+    void beginGroup(const QByteArray& tag, const QByteArray& formType)
+    {
+        writeHeader(tag, 0);
+        m_groupStarts.append(m_file->pos());
+        m_file->write(formType);
+        if (m_is64) {
+            m_file->write(QByteArray(4, '\0'));
+        }
+    }
+
+    void endGroup()
+    {
+        qint64 start = m_groupStarts.takeLast();
+        qint64 end = m_file->pos();
+        m_file->seek(start - (m_is64 ? 8 : 4));
+        writeSize(end - start);
+        m_file->seek(end);
+    }
+
+    void chunk(const QByteArray& tag, const QByteArray& data)
+    {
+        writeHeader(tag, data.size());
+        m_file->write(data);
+        int alignment = m_is64 ? 8 : 4;
+        int padding = (alignment - data.size() % alignment) % alignment;
+        m_file->write(QByteArray(padding, '\0'));
+    }
+
+    // 以 '\0' 结尾的字符串序列；flag 非负时在最前面加 1 字节标志
+    static QByteArray strings(const QList<QByteArray>& values, int flag = -1)
+    {
+        QByteArray data;
+        if (flag >= 0) {
+            data.append(char(flag));
+        }
+        for (const QByteArray& value : values) {
+            data += value;
+            data.append('\0');
+        }
+        return data;
+    }
+
+    static QByteArray stringAttribute(const QByteArray& name, const QByteArray& value)
+    {
+        return name + QByteArray(1, '\0') + strings({value}, 1);
+    }
+
+private:
+    void writeHeader(const QByteArray& tag, qint64 size)
+    {
+        m_file->write(tag);
+        if (m_is64) {
+            m_file->write(QByteArray(4, '\0'));
+        }
+        writeSize(size);
+    }
+
+    void writeSize(qint64 size)
+    {
+        if (m_is64) {
+            quint64 value = qToBigEndian<quint64>(size);
+            m_file->write(reinterpret_cast<const char*>(&value), sizeof(value));
+        } else {
+            quint32 value = qToBigEndian<quint32>(size);
+            m_file->write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    }
+
+    QFile* m_file;
+    bool m_is64;
+    QList<qint64> m_groupStarts;
+};
+
+/**
+ * @brief 生成 .mb 场景
+ *
+ * 头部为版本、requires、fileInfo、引用和渲染器；之后重复 blocks 个网格 + file 节点，
+ * 每个网格带 meshBytes 字节的数值数据块（解析时应被跳过）。
+ *
+ * @return 写入的纹理路径数量
+ */
+int writeSyntheticBinaryScene(const QString& filePath, bool is64, int blocks, int meshBytes)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return -1;
+    }
+
+    IffSceneWriter writer(&file, is64);
+    writer.beginGroup(is64 ? "FOR8" : "FOR4", "Maya");
+
+    writer.beginGroup(is64 ? "FOR8" : "FOR4", "HEAD");
+    writer.chunk("VERS", IffSceneWriter::strings({"2024"}));
+    writer.chunk("PLUG", IffSceneWriter::strings({"mtoa", "5.3.0"}));
+    writer.chunk("PLUG", IffSceneWriter::strings({"stereoCamera", "10.0"}));
+    writer.chunk("FINF", IffSceneWriter::strings({"application", "maya"}));
+    writer.chunk("FINF", IffSceneWriter::strings({"product", "Maya 2024"}));
+    writer.chunk("FREF", IffSceneWriter::strings({"chrRN", "mayaAscii", "D:/assets/chr/chr_rig.ma"}));
+    writer.endGroup();
+
+    writer.beginGroup(is64 ? "FOR8" : "FOR4", "DRGL");
+    writer.chunk("SLCT", IffSceneWriter::strings({":defaultRenderGlobals"}, 1));
+    writer.chunk("STR ", IffSceneWriter::stringAttribute("ren", "arnold"));
+    writer.endGroup();
+
+    QByteArray meshData(meshBytes, Qt::Uninitialized);
+    for (int i = 0; i < meshData.size(); ++i) {
+        meshData[i] = char(i * 31);
+    }
+
+    int textures = 0;
+    for (int block = 0; block < blocks; ++block) {
+        QByteArray index = QByteArray::number(block);
+
+        writer.beginGroup(is64 ? "FOR8" : "FOR4", "MESH");
+        writer.chunk("CREA", IffSceneWriter::strings({"meshShape" + index, "mesh" + index}, 1));
+        // 故意用奇数长度检查对齐补齐
+        writer.chunk("STR ", IffSceneWriter::stringAttribute("notes", "uv; set \"main\""));
+        writer.beginGroup(is64 ? "LIS8" : "LIS4", "FLT3");
+        writer.chunk("FLT3", meshData);
+        writer.endGroup();
+        writer.endGroup();
+
+        writer.beginGroup(is64 ? "FOR8" : "FOR4", "FILE");
+        writer.chunk("CREA", IffSceneWriter::strings({"file" + index}, 1));
+        writer.chunk("STR ", IffSceneWriter::stringAttribute("ftn", "sourceimages/tex_" + index + ".<UDIM>.exr"));
+        writer.chunk("STR ", IffSceneWriter::stringAttribute("cs", "ACEScg"));
+        writer.endGroup();
+        textures++;
+    }
+
+    writer.endGroup();
+    return textures;
+}
+
+/**
+ * @brief .mb 解析测试：FOR4/FOR8 合成场景及截断文件
+ * @return 是否通过
+ */
+bool testMayaBinaryParser()
+{
+    printSeparator(QString::fromUtf8("Maya Binary 解析测试"));
+
+    QTemporaryDir dir;
+    TestResult result;
+
+    for (bool is64 : {false, true}) {
+        QString filePath = dir.path() + (is64 ? "/scene64.mb" : "/scene32.mb");
+        int expectedTextures = writeSyntheticBinaryScene(filePath, is64, 3, 1001);
+
+        MayaBinaryParser parser;
+        SceneInfo info = parser.parseFile(filePath);
+        qDebug() << (is64 ? "\n[FOR8]" : "\n[FOR4]") << QFileInfo(filePath).size() << "字节";
+
+        result.check(info.isValid && info.format == "mayaBinary", "文件头");
+        result.check(info.mayaVersion == "2024", QString("版本 %1").arg(info.mayaVersion));
+        result.check(info.plugins.size() == 2 && info.plugins[0].name == "mtoa" && info.plugins[0].version == "5.3.0", "requires");
+        result.check(info.fileInfo.value("product") == "Maya 2024", "fileInfo");
+        result.check(info.references == QStringList{"D:/assets/chr/chr_rig.ma"}, "引用");
+        result.check(info.currentRenderer == "arnold" && info.rendererName() == "Arnold", QString("渲染器 %1").arg(info.rendererName()));
+
+        int textures = 0;
+        for (const SceneFileAttribute& attribute : info.fileAttributes) {
+            if (attribute.nodeType == "file" && attribute.attribute == ".ftn"
+                && attribute.path == QString("sourceimages/tex_%1.<UDIM>.exr").arg(attribute.nodeName.mid(4))) {
+                textures++;
+            }
+        }
+        result.check(textures == expectedTextures && info.fileAttributes.size() == expectedTextures,
+              QString("纹理 %1/%2").arg(textures).arg(expectedTextures));
+
+        // 截断：不应越界，已解析的头部信息仍然可用
+        QFile file(filePath);
+        file.open(QIODevice::ReadWrite);
+        file.resize(file.size() / 2 + 3);
+        file.close();
+        SceneInfo truncated = MayaBinaryParser().parseFile(filePath);
+        result.check(truncated.isValid && truncated.mayaVersion == "2024" && truncated.plugins.size() == 2, "截断文件");
+    }
+
+    // 非 IFF 文件
+    QString bogusPath = dir.path() + "/bogus.mb";
+    QFile bogus(bogusPath);
+    bogus.open(QIODevice::WriteOnly);
+    bogus.write("//Maya ASCII 2024 scene\n");
+    bogus.close();
+    result.check(!MayaBinaryParser().parseFile(bogusPath).isValid, "非 IFF 文件");
+
+    return result.report();
+}
+
+/**
+ * @brief .mb 解析基准测试：大部分体积是需要跳过的网格数据块
+ */
+void benchmarkBinarySceneParser(qint64 sizeMB)
+{
+    printSeparator(QString::fromUtf8("Maya Binary 解析基准测试"));
+
+    const int meshBytes = 256 * 1024;
+    int blocks = qMax<qint64>(1, sizeMB * 1024 * 1024 / meshBytes);
+
+    for (bool is64 : {false, true}) {
+        QTemporaryDir dir;
+        QString filePath = dir.path() + "/synthetic.mb";
+
+        QElapsedTimer timer;
+        timer.start();
+        int expectedTextures = writeSyntheticBinaryScene(filePath, is64, blocks, meshBytes);
+        if (expectedTextures < 0) {
+            qDebug() << "无法创建测试文件";
+            return;
+        }
+        qint64 fileSize = QFileInfo(filePath).size();
+        qDebug() << (is64 ? "\n[FOR8]" : "\n[FOR4]") << "生成场景:" << fileSize / 1024 / 1024 << "MB, 耗时" << timer.elapsed() << "ms";
+
+        timer.restart();
+        MayaBinaryParser parser;
+        SceneInfo info = parser.parseFile(filePath);
+        double seconds = qMax<qint64>(timer.elapsed(), 1) / 1000.0;
+
+        qDebug() << "  吞吐:" << QString::number(fileSize / seconds / 1024 / 1024, 'f', 1) << "MB/s";
+        qDebug() << "  版本:" << info.mayaVersion << "渲染器:" << info.rendererName()
+                 << "插件:" << info.plugins.size() << "引用:" << info.references.size();
+        qDebug() << "  纹理:" << info.fileAttributes.size() << "/" << expectedTextures
+                 << (info.fileAttributes.size() == expectedTextures ? "✓" : "✗");
+        qDebug() << "  峰值内存:" << peakRssBytes() / 1024 / 1024 << "MB";
+    }
+}
+
+/**
+ * @brief 显示功能菜单
+ */
+void showMenu()
+{
+    printSeparator(QString::fromUtf8("盛世云图客户端 - 功能测试"));
+
+    printLine(QString::fromUtf8("可用测试项:"));
+    printLine(QString::fromUtf8("  1. Maya 环境检测"));
+    printLine(QString::fromUtf8("  2. 配置管理"));
+    printLine(QString::fromUtf8("  3. 日志系统"));
+    printLine(QString::fromUtf8("  4. HTTP 客户端（需要后端）"));
+    printLine(QString::fromUtf8("  5. WebSocket 客户端（需要后端）"));
+    printLine(QString::fromUtf8("  0. 退出"));
+    std::cout << QString::fromUtf8("\n选择测试项 (0-5): ").toUtf8().constData();
+    std::cout.flush();
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef Q_OS_WIN
+    // 设置 Windows 控制台为 UTF-8 编码
+    SetConsoleOutputCP(CP_UTF8);
+    SetConsoleCP(CP_UTF8);
+    // 启用 ANSI 转义序列支持（用于彩色输出）
+    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD dwMode = 0;
+    GetConsoleMode(hOut, &dwMode);
+    dwMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
+    SetConsoleMode(hOut, dwMode);
+#endif
+
+    // 任务列表基准测试需要界面（无显示环境时使用 offscreen 平台）
+    if (argc > 1 && QString(argv[1]) == "--bench-task-list") {
+        if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+        QApplication app(argc, argv);
+        return benchmarkTaskList(argc > 2 ? QString(argv[2]).toInt() : 100000) ? 0 : 1;
+    }
+    if (argc > 1 && QString(argv[1]) == "--bench-task-updates") {
+        if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+        QApplication app(argc, argv);
+        return benchmarkTaskUpdates(argc > 2 ? QString(argv[2]).toInt() : 500) ? 0 : 1;
+    }
+
+    QCoreApplication app(argc, argv);
+
+    // 模拟 Maya 进程：标准输出只用于协议，不初始化应用、不打印欢迎信息
+    if (argc > 1 && QString(argv[1]) == "--fake-maya") {
+        return runFakeMaya(argc > 2 ? QString(argv[2]).toInt() : 0);
+    }
+
+    // 设置应用信息
+    QCoreApplication::setOrganizationName("YunTu");
+    QCoreApplication::setOrganizationDomain("yuntu.com");
+    QCoreApplication::setApplicationName("盛世云图客户端");
+    QCoreApplication::setApplicationVersion("1.0.0");
+
+    // 初始化应用程序
+    Application::instance().initialize();
+
+    printSeparator(QString::fromUtf8("盛世云图客户端 - 测试程序"));
+    printLine(QString::fromUtf8("版本: 1.0.0-alpha"));
+    printLine(QString::fromUtf8("测试模式: 控制台"));
+    printLine(QString::fromUtf8("\n已实现的功能:"));
+    printLine(QString::fromUtf8("  ✓ 核心模块 (Application, Config, Logger)"));
+    printLine(QString::fromUtf8("  ✓ Maya 环境检测"));
+    printLine(QString::fromUtf8("  ✓ 网络层 (HTTP, WebSocket, FileUploader)"));
+    printLine(QString::fromUtf8("\n待实现的功能:"));
+    printLine(QString::fromUtf8("  ○ 数据模型"));
+    printLine(QString::fromUtf8("  ○ UI 界面"));
+    printLine(QString::fromUtf8("  ○ 任务管理"));
+
+    // 命令行参数模式
+    if (argc > 1) {
+        QString arg = argv[1];
+
+        if (arg == "--maya" || arg == "-m") {
+            testMayaDetector();
+        } else if (arg == "--config" || arg == "-c") {
+            testConfig();
+        } else if (arg == "--log" || arg == "-l") {
+            testLogger();
+        } else if (arg == "--test-log-format") {
+            return testLogFormat() ? 0 : 1;
+        } else if (arg == "--test-log-rotation") {
+            return testLogRotation() ? 0 : 1;
+        } else if (arg == "--test-log-upload") {
+            return testLogUpload() ? 0 : 1;
+        } else if (arg == "--test-http-pools") {
+            return testHttpPools() ? 0 : 1;
+        } else if (arg == "--bench-logger") {
+            return benchmarkLogger(argc > 2 ? QString(argv[2]).toInt() : 4,
+                                   argc > 3 ? QString(argv[3]).toInt() : 100000) ? 0 : 1;
+        } else if (arg == "--http" || arg == "-h") {
+            testHttpClient();
+        } else if (arg == "--ws" || arg == "-w") {
+            testWebSocket();
+        } else if (arg == "--bench-upload" && argc > 2) {
+            benchmarkChunkUpload(QString::fromLocal8Bit(argv[2]));
+            return 0;
+        } else if (arg == "--test-resume") {
+            return testUploadResume() ? 0 : 1;
+        } else if (arg == "--test-hash-cache") {
+            return testChunkHashCache() ? 0 : 1;
+        } else if (arg == "--test-scheduler") {
+            return testUploadScheduler() ? 0 : 1;
+        } else if (arg == "--bench-scene") {
+            benchmarkSceneParser(argc > 2 ? QString(argv[2]).toLongLong() : 2048);
+            return 0;
+        } else if (arg == "--test-scene-cache") {
+            return testSceneInfoCache(argc > 2 ? QString(argv[2]).toLongLong() : 256) ? 0 : 1;
+        } else if (arg == "--bench-crawler") {
+            return benchmarkFileCrawler(argc > 2 ? QString(argv[2]).toInt() : 20000) ? 0 : 1;
+        } else if (arg == "--test-maya-batch") {
+            return testMayaBatchRunner(argc > 2 ? QString(argv[2]).toInt() : 3000) ? 0 : 1;
+        } else if (arg == "--test-maya-index") {
+            return testMayaInstallIndex() ? 0 : 1;
+        } else if (arg == "--test-assets") {
+            return testAssetResolver(argc > 2 ? QString(argv[2]).toInt() : 20000) ? 0 : 1;
+        } else if (arg == "--bench-keywords") {
+            benchmarkKeywordScanner(argc > 2 ? QString(argv[2]).toLongLong() : 1024);
+            return 0;
+        } else if (arg == "--test-keywords") {
+            return testKeywordScanner(argc > 2 ? QString(argv[2]).toInt() : 20000) ? 0 : 1;
+        } else if (arg == "--test-mb") {
+            return testMayaBinaryParser() ? 0 : 1;
+        } else if (arg == "--bench-mb") {
+            benchmarkBinarySceneParser(argc > 2 ? QString(argv[2]).toLongLong() : 2048);
+            return 0;
         } else if (arg == "--all" || arg == "-a") {
             testConfig();
             testLogger();
@@ -301,14 +3472,36 @@ int main(int argc, char *argv[])
             testHttpClient();
             testWebSocket();
         } else {
-            printLine(QString::fromUtf8("\n用法: YuntuClient_Test [选项]"));
+            printLine(QString::fromUtf8("\n用法: YuntuTests [选项]"));
             printLine(QString::fromUtf8("选项:"));
             printLine(QString::fromUtf8("  -m, --maya     测试 Maya 检测"));
             printLine(QString::fromUtf8("  -c, --config   测试配置管理"));
             printLine(QString::fromUtf8("  -l, --log      测试日志系统"));
+            printLine(QString::fromUtf8("  --bench-logger [线程数] [每线程行数]  日志基准测试（异步 vs 同步，默认 4 x 100000）"));
+            printLine(QString::fromUtf8("  --test-log-format  结构化日志格式测试（往返、截断、损坏、大小对比）"));
+            printLine(QString::fromUtf8("  --test-log-rotation  日志轮转测试（按大小轮转、压缩归档、保留预算、上传水位线）"));
+            printLine(QString::fromUtf8("  --test-log-upload  日志上传测试（增量追加、压缩、续传、并发上限、退避重试，本地 OSS 替身）"));
             printLine(QString::fromUtf8("  -h, --http     测试 HTTP 客户端"));
+            printLine(QString::fromUtf8("  --test-http-pools  HTTP 连接池测试（分片上传占满连接时控制请求的延迟）"));
             printLine(QString::fromUtf8("  -w, --ws       测试 WebSocket"));
             printLine(QString::fromUtf8("  -a, --all      运行所有测试"));
+            printLine(QString::fromUtf8("  --bench-upload <文件>  分片上传基准测试（二进制 vs JSON）"));
+            printLine(QString::fromUtf8("  --test-resume  断点续传测试（日志随机中断；上传器中断后以新任务 ID 重启续传；失败后拆分未发送的分片并续传）"));
+            printLine(QString::fromUtf8("  --test-hash-cache  内容哈希缓存测试（命中、未命中、修改后失效、过期与超限清理、跨分片大小去重）"));
+            printLine(QString::fromUtf8("  --test-scheduler  上传调度器测试（任务失败/取消时分片在途，全局并发上限与槽位回收）"));
+            printLine(QString::fromUtf8("  --bench-scene [MB]  Maya ASCII 解析基准测试（默认 2048MB 合成场景）"));
+            printLine(QString::fromUtf8("  --test-scene-cache [MB]  场景分析缓存测试（命中耗时、失效、LRU）"));
+            printLine(QString::fromUtf8("  --bench-crawler [目录数]  插件文件搜索基准测试（单次多线程遍历 vs 逐个递归）"));
+            printLine(QString::fromUtf8("  --test-maya-batch [毫秒]  Maya 常驻批处理进程测试（模拟 Maya 启动耗时，默认 3000ms）"));
+            printLine(QString::fromUtf8("  --fake-maya [毫秒]  作为模拟 Maya 进程运行（由 --test-maya-batch 启动）"));
+            printLine(QString::fromUtf8("  --test-maya-index  Maya 安装索引测试（stat 校验、变化后失效）"));
+            printLine(QString::fromUtf8("  --test-assets [数量]  素材解析测试（UDIM/序列展开，批量 vs 逐个检查）"));
+            printLine(QString::fromUtf8("  --bench-keywords [MB]  关键字扫描基准测试（SIMD vs 正则，默认 1024MB）"));
+            printLine(QString::fromUtf8("  --test-keywords [轮数]  关键字扫描测试（各指令集实现结果一致，默认 20000 轮）"));
+            printLine(QString::fromUtf8("  --test-mb      Maya Binary 解析测试（FOR4/FOR8 合成场景）"));
+            printLine(QString::fromUtf8("  --bench-mb [MB]  Maya Binary 解析基准测试（默认 2048MB 合成场景）"));
+            printLine(QString::fromUtf8("  --bench-task-list [数量]  任务列表基准测试（模型/委托，默认 100000 个任务）"));
+            printLine(QString::fromUtf8("  --bench-task-updates [数量]  任务进度推送基准测试（逐条 vs 按帧合并，默认 500 个任务）"));
             return 0;
         }
 
@@ -0,0 +1,113 @@
+/**
+ * @file log_decoder.cpp
+ * @brief 结构化日志解码工具
+ *
+ * 把 *.ylog 结构化日志（及压缩归档 *.ylogz、从 OSS 下载的日志对象）还原为文本或
+ * JSON（每行一条），可按级别、分类筛选。压缩的文本日志（*.logz）解压后原样输出。
+ *
+ * 用法: YuntuLogDecoder [--json] [--level 级别] [--category 分类] 文件...
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <cstdio>
+
+#include "core/LogFormat.h"
+
+namespace {
+
+int parseLevel(const QString& name)
+{
+    const QString upper = name.trimmed().toUpper();
+    if (upper == "DEBUG") return 0;
+    if (upper == "INFO") return 1;
+    if (upper == "WARN" || upper == "WARNING") return 2;
+    if (upper == "ERROR") return 3;
+    return -1;
+}
+
+void writeLine(const QByteArray& line)
+{
+    fwrite(line.constData(), 1, static_cast<size_t>(line.size()), stdout);
+    fputc('\n', stdout);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("YuntuLogDecoder");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QString::fromUtf8("盛世云图结构化日志解码工具"));
+    parser.addHelpOption();
+    QCommandLineOption jsonOption("json", QString::fromUtf8("输出 JSON（每行一条）"));
+    QCommandLineOption levelOption("level", QString::fromUtf8("只输出不低于该级别的日志（DEBUG/INFO/WARN/ERROR）"), "level");
+    QCommandLineOption categoryOption("category", QString::fromUtf8("只输出该分类的日志"), "category");
+    parser.addOption(jsonOption);
+    parser.addOption(levelOption);
+    parser.addOption(categoryOption);
+    parser.addPositionalArgument("files", QString::fromUtf8("*.ylog / *.ylogz 日志文件"), "<文件...>");
+    parser.process(app);
+
+    const QStringList files = parser.positionalArguments();
+    if (files.isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    const bool json = parser.isSet(jsonOption);
+    int minLevel = 0;
+    if (parser.isSet(levelOption)) {
+        minLevel = parseLevel(parser.value(levelOption));
+        if (minLevel < 0) {
+            fprintf(stderr, "unknown level: %s\n", qPrintable(parser.value(levelOption)));
+            return 1;
+        }
+    }
+    const QString category = parser.value(categoryOption);
+    const bool filtered = minLevel > 0 || !category.isEmpty();
+
+    int exitCode = 0;
+    for (const QString& filePath : files) {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            fprintf(stderr, "cannot open: %s\n", qPrintable(filePath));
+            exitCode = 1;
+            continue;
+        }
+        QByteArray data = file.readAll();
+        file.close();
+
+        bool complete = true;
+        if (LogFormat::isCompressed(data)) {
+            data = LogFormat::decompressBlocks(data, &complete);
+        }
+
+        // 不是结构化日志（qDebug 文本日志）：原样输出
+        if (!data.startsWith(QByteArray(LogFormat::Magic, 4))) {
+            fwrite(data.constData(), 1, static_cast<size_t>(data.size()), stdout);
+            if (!complete) {
+                fprintf(stderr, "%s: trailing or damaged data skipped\n", qPrintable(filePath));
+            }
+            continue;
+        }
+
+        bool segmentsComplete = true;
+        LogFormat::decode(data, [&](const LogEntry& entry) {
+            // 原样文本没有级别和分类，筛选时跳过
+            if (filtered && (entry.isText || entry.level < minLevel
+                             || (!category.isEmpty() && entry.category != category))) {
+                return;
+            }
+            writeLine(json ? LogFormat::formatJson(entry) : LogFormat::formatText(entry).toUtf8());
+        }, &segmentsComplete);
+
+        if (!complete || !segmentsComplete) {
+            fprintf(stderr, "%s: trailing or damaged data skipped\n", qPrintable(filePath));
+        }
+    }
+
+    return exitCode;
+}
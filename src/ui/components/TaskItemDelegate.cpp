@@ -0,0 +1,346 @@
+/**
+ * @file TaskItemDelegate.cpp
+ * @brief 任务列表项绘制委托实现
+ */
+
+#include "TaskItemDelegate.h"
+#include "../ThemeManager.h"
+#include "../../models/TaskListModel.h"
+#include <QAbstractItemView>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPainterPath>
+
+namespace {
+// 卡片布局（与原任务卡片控件一致）
+const int CARD_HEIGHT = 120;
+const int CARD_SPACING = 12;        // 卡片之间的间距
+const int MARGIN_H = 16;
+const int MARGIN_V = 12;
+const int ROW_SPACING = 8;
+const int BUTTON_HEIGHT = 28;
+const int BUTTON_MIN_WIDTH = 60;
+const int BUTTON_SPACING = 12;
+const int PROGRESS_HEIGHT = 8;
+const int PROGRESS_LABEL_WIDTH = 40;
+const int INFO_LINE_HEIGHT = 14;
+}
+
+TaskItemDelegate::TaskItemDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+    , m_hoverAction(-1)
+    , m_pressed(false)
+{
+    m_nameFont.setPointSize(12);
+    m_nameFont.setBold(true);
+    m_infoFont.setPixelSize(11);
+
+    // 按钮宽度只与文字有关，预先计算
+    QFontMetrics metrics(m_buttonFont);
+    for (int action = ViewAction; action <= DeleteAction; ++action) {
+        m_actionWidths[action] = qMax(BUTTON_MIN_WIDTH,
+            metrics.horizontalAdvance(actionText(static_cast<Action>(action))) + 24);
+    }
+}
+
+TaskItemDelegate::~TaskItemDelegate()
+{
+}
+
+QSize TaskItemDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    Q_UNUSED(index);
+    return QSize(option.rect.width(), CARD_HEIGHT + CARD_SPACING);
+}
+
+QRect TaskItemDelegate::cardRect(const QRect &rowRect) const
+{
+    return QRect(rowRect.left(), rowRect.top(), rowRect.width(), CARD_HEIGHT);
+}
+
+QList<QPair<TaskItemDelegate::Action, QRect>> TaskItemDelegate::actionRects(const QRect &cardRect, const Task *task) const
+{
+    QList<Action> actions;
+    actions << ViewAction;
+
+    // 根据任务状态显示按钮；还没有服务器 ID 的任务（上传中）不能暂停/恢复
+    bool onServer = !task->taskId().isEmpty();
+    if (onServer && task->canPause()) {
+        actions << PauseAction;
+    }
+    if (onServer && task->canResume()) {
+        actions << ResumeAction;
+    }
+    if (task->canCancel()) {
+        actions << CancelAction;
+    }
+
+    // 删除按钮仅在任务完成或失败时显示
+    TaskStatus status = task->status();
+    if (status == TaskStatus::Completed || status == TaskStatus::Failed || status == TaskStatus::Cancelled) {
+        actions << DeleteAction;
+    }
+
+    // 从右向左排列
+    QList<QPair<Action, QRect>> rects;
+    int right = cardRect.right() - MARGIN_H;
+    int top = cardRect.top() + MARGIN_V;
+    for (int i = actions.size() - 1; i >= 0; --i) {
+        int width = m_actionWidths[actions[i]];
+        rects.prepend(qMakePair(actions[i], QRect(right - width + 1, top, width, BUTTON_HEIGHT)));
+        right -= width + BUTTON_SPACING;
+    }
+    return rects;
+}
+
+void TaskItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    Task *task = index.data(TaskListModel::TaskRole).value<Task*>();
+    if (!task) {
+        return;
+    }
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+
+    ThemeManager &theme = ThemeManager::instance();
+    QRect card = cardRect(option.rect);
+    bool hovered = option.state & QStyle::State_MouseOver;
+
+    // 背景和边框（Hover 效果）
+    QPainterPath path;
+    path.addRoundedRect(QRectF(card).adjusted(0.5, 0.5, -0.5, -0.5), 8, 8);
+    painter->fillPath(path, hovered ? theme.getHoverColor() : theme.getSurfaceColor());
+    painter->setPen(QPen(hovered ? theme.getAccentColor() : theme.getBorderColor(), 1));
+    painter->drawPath(path);
+
+    QRect content = card.adjusted(MARGIN_H, MARGIN_V, -MARGIN_H, -MARGIN_V);
+
+    // 第一行：任务名称 + 状态 + 操作按钮
+    QList<QPair<Action, QRect>> actions = actionRects(card, task);
+    int buttonsLeft = actions.isEmpty() ? content.right() : actions.first().second.left() - BUTTON_SPACING;
+
+    QString statusText = statusIcon(task->status()) + " " + task->statusString();
+    QFontMetrics baseMetrics(m_buttonFont);
+    int statusWidth = baseMetrics.horizontalAdvance(statusText) + 16;
+
+    QFontMetrics nameMetrics(m_nameFont);
+    int nameMaxWidth = qMax(0, buttonsLeft - content.left() - statusWidth - BUTTON_SPACING);
+    QString name = nameMetrics.elidedText(task->taskName(), Qt::ElideRight, nameMaxWidth);
+    int nameWidth = nameMetrics.horizontalAdvance(name);
+
+    QRect firstRow(content.left(), content.top(), content.width(), BUTTON_HEIGHT);
+    painter->setFont(m_nameFont);
+    painter->setPen(theme.getTextColor());
+    painter->drawText(QRect(firstRow.left(), firstRow.top(), nameWidth, BUTTON_HEIGHT),
+                      Qt::AlignVCenter | Qt::AlignLeft, name);
+
+    QRect statusRect(firstRow.left() + nameWidth + BUTTON_SPACING, firstRow.top() + 2, statusWidth, BUTTON_HEIGHT - 4);
+    QPainterPath statusPath;
+    statusPath.addRoundedRect(QRectF(statusRect), 4, 4);
+    painter->fillPath(statusPath, statusColor(task->status()));
+    painter->setFont(m_buttonFont);
+    painter->setPen(Qt::white);
+    painter->drawText(statusRect, Qt::AlignCenter, statusText);
+
+    for (const QPair<Action, QRect> &action : actions) {
+        bool buttonHovered = hovered && m_hoverIndex == index && m_hoverAction == action.first;
+        QColor bgColor = theme.getSurfaceColor();
+        QColor textColor = theme.getTextColor();
+        if (buttonHovered && m_pressed) {
+            bgColor = theme.getAccentColor();
+            textColor = QColor(255, 255, 255);
+        } else if (buttonHovered) {
+            bgColor = theme.getHoverColor();
+        }
+
+        QPainterPath buttonPath;
+        buttonPath.addRoundedRect(QRectF(action.second).adjusted(0.5, 0.5, -0.5, -0.5), 4, 4);
+        painter->fillPath(buttonPath, bgColor);
+        painter->setPen(QPen(theme.getBorderColor(), 1));
+        painter->drawPath(buttonPath);
+        painter->setPen(textColor);
+        painter->drawText(action.second, Qt::AlignCenter, actionText(action.first));
+    }
+
+    // 第二行：进度条 + 进度百分比
+    int progress = qBound(0, task->progress(), 100);
+    QRect progressRow(content.left(), firstRow.bottom() + 1 + ROW_SPACING, content.width(), INFO_LINE_HEIGHT);
+    QRect barRect(progressRow.left(), progressRow.center().y() - PROGRESS_HEIGHT / 2,
+                  progressRow.width() - PROGRESS_LABEL_WIDTH - ROW_SPACING, PROGRESS_HEIGHT);
+    QPainterPath barPath;
+    barPath.addRoundedRect(QRectF(barRect), PROGRESS_HEIGHT / 2, PROGRESS_HEIGHT / 2);
+    painter->fillPath(barPath, theme.getBorderColor());
+    if (progress > 0) {
+        QRectF filled(barRect.left(), barRect.top(), barRect.width() * progress / 100.0, barRect.height());
+        QPainterPath filledPath;
+        filledPath.addRoundedRect(filled, PROGRESS_HEIGHT / 2, PROGRESS_HEIGHT / 2);
+        painter->fillPath(filledPath, theme.getAccentColor());
+    }
+    painter->setPen(theme.getTextColor());
+    painter->drawText(QRect(progressRow.right() - PROGRESS_LABEL_WIDTH + 1, progressRow.top(),
+                            PROGRESS_LABEL_WIDTH, progressRow.height()),
+                      Qt::AlignVCenter | Qt::AlignLeft, QString("%1%").arg(progress));
+
+    // 第三行：时间信息
+    QString timeInfo;
+    if (task->startedAt().isValid()) {
+        timeInfo = QString::fromUtf8("开始: %1 | 用时: %2")
+            .arg(task->startedAt().toString("yyyy-MM-dd hh:mm"))
+            .arg(task->durationString());
+    } else {
+        timeInfo = QString::fromUtf8("创建: %1")
+            .arg(task->createdAt().toString("yyyy-MM-dd hh:mm"));
+    }
+
+    // 第四行：帧信息
+    QString frameInfo = QString::fromUtf8("帧范围: %1-%2 (步长%3) | 分辨率: %4x%5")
+        .arg(task->startFrame())
+        .arg(task->endFrame())
+        .arg(task->frameStep())
+        .arg(task->width())
+        .arg(task->height());
+
+    painter->setFont(m_infoFont);
+    painter->setPen(QColor("#808080"));
+    QRect timeRect(content.left(), progressRow.bottom() + 1 + ROW_SPACING, content.width(), INFO_LINE_HEIGHT);
+    painter->drawText(timeRect, Qt::AlignVCenter | Qt::AlignLeft, timeInfo);
+    QRect framesRect(content.left(), timeRect.bottom() + 1 + ROW_SPACING, content.width(), INFO_LINE_HEIGHT);
+    painter->drawText(framesRect, Qt::AlignVCenter | Qt::AlignLeft, frameInfo);
+
+    painter->restore();
+}
+
+bool TaskItemDelegate::editorEvent(QEvent *event, QAbstractItemModel *model,
+                                   const QStyleOptionViewItem &option, const QModelIndex &index)
+{
+    if (event->type() != QEvent::MouseMove && event->type() != QEvent::MouseButtonPress
+        && event->type() != QEvent::MouseButtonRelease) {
+        return QStyledItemDelegate::editorEvent(event, model, option, index);
+    }
+
+    Task *task = index.data(TaskListModel::TaskRole).value<Task*>();
+    if (!task) {
+        return false;
+    }
+
+    // 鼠标所在的按钮
+    QPoint pos = static_cast<QMouseEvent*>(event)->position().toPoint();
+    int action = -1;
+    for (const QPair<Action, QRect> &item : actionRects(cardRect(option.rect), task)) {
+        if (item.second.contains(pos)) {
+            action = item.first;
+            break;
+        }
+    }
+
+    int previousAction = m_hoverAction;
+    bool previousPressed = m_pressed;
+    bool sameRow = m_hoverIndex == index;
+    m_hoverIndex = index;
+    m_hoverAction = action;
+
+    bool handled = false;
+    if (event->type() == QEvent::MouseButtonPress) {
+        m_pressed = action >= 0;
+        handled = m_pressed;
+    } else if (event->type() == QEvent::MouseButtonRelease) {
+        bool clicked = m_pressed && sameRow && action >= 0 && action == previousAction;
+        m_pressed = false;
+        handled = action >= 0;
+
+        if (clicked) {
+            switch (action) {
+                case ViewAction:
+                    emit viewDetailsClicked(task);
+                    break;
+                case PauseAction:
+                    emit pauseClicked(task);
+                    break;
+                case ResumeAction:
+                    emit resumeClicked(task);
+                    break;
+                case CancelAction:
+                    emit cancelClicked(task);
+                    break;
+                case DeleteAction:
+                    emit deleteClicked(task);
+                    break;
+            }
+        }
+    }
+
+    // 只在按钮悬停/按下状态变化时重绘这一行
+    if (!sameRow || action != previousAction || m_pressed != previousPressed) {
+        if (const QAbstractItemView *view = qobject_cast<const QAbstractItemView*>(option.widget)) {
+            view->viewport()->update(option.rect);
+        }
+    }
+
+    return handled;
+}
+
+QString TaskItemDelegate::actionText(Action action)
+{
+    switch (action) {
+        case ViewAction:
+            return QString::fromUtf8("查看");
+        case PauseAction:
+            return QString::fromUtf8("暂停");
+        case ResumeAction:
+            return QString::fromUtf8("恢复");
+        case CancelAction:
+            return QString::fromUtf8("取消");
+        case DeleteAction:
+            return QString::fromUtf8("删除");
+    }
+    return QString();
+}
+
+QColor TaskItemDelegate::statusColor(TaskStatus status)
+{
+    switch (status) {
+        case TaskStatus::Draft:
+            return QColor("#808080");  // 灰色
+        case TaskStatus::Pending:
+            return QColor("#FFA500");  // 橙色
+        case TaskStatus::Queued:
+            return QColor("#0078D4");  // 蓝色
+        case TaskStatus::Rendering:
+            return QColor("#107C10");  // 绿色
+        case TaskStatus::Paused:
+            return QColor("#FFB900");  // 黄色
+        case TaskStatus::Completed:
+            return QColor("#107C10");  // 绿色
+        case TaskStatus::Failed:
+            return QColor("#D13438");  // 红色
+        case TaskStatus::Cancelled:
+            return QColor("#605E5C");  // 深灰色
+        default:
+            return QColor("#808080");
+    }
+}
+
+QString TaskItemDelegate::statusIcon(TaskStatus status)
+{
+    switch (status) {
+        case TaskStatus::Draft:
+            return QString::fromUtf8("✏️");
+        case TaskStatus::Pending:
+            return QString::fromUtf8("⏳");
+        case TaskStatus::Queued:
+            return QString::fromUtf8("⏸️");
+        case TaskStatus::Rendering:
+            return QString::fromUtf8("▶️");
+        case TaskStatus::Paused:
+            return QString::fromUtf8("⏸️");
+        case TaskStatus::Completed:
+            return QString::fromUtf8("✅");
+        case TaskStatus::Failed:
+            return QString::fromUtf8("❌");
+        case TaskStatus::Cancelled:
+            return QString::fromUtf8("⛔");
+        default:
+            return QString::fromUtf8("○");
+    }
+}
@@ -0,0 +1,117 @@
+/**
+ * @file TaskItemDelegate.h
+ * @brief 任务列表项绘制委托
+ */
+
+#ifndef TASKITEMDELEGATE_H
+#define TASKITEMDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QColor>
+#include <QFont>
+#include <QList>
+#include <QPair>
+#include <QRect>
+#include "../../models/Task.h"
+
+/**
+ * @brief 任务列表项绘制委托
+ *
+ * 配合 TaskListModel 使用，直接绘制任务卡片（名称、状态、操作按钮、进度条、
+ * 时间和帧信息），外观与原先每个任务一个控件的卡片一致。
+ * 列表中不存在任何子控件，只有可见行会被绘制，任务数量不影响内存和滚动性能。
+ *
+ * 视图需要开启 mouseTracking 才能显示悬停效果。
+ */
+class TaskItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 卡片上的操作按钮
+     */
+    enum Action {
+        ViewAction,
+        PauseAction,
+        ResumeAction,
+        CancelAction,
+        DeleteAction
+    };
+
+    explicit TaskItemDelegate(QObject *parent = nullptr);
+    ~TaskItemDelegate();
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+    /**
+     * @brief 任务在当前状态下可用的按钮及其位置
+     * @param cardRect 卡片区域
+     */
+    QList<QPair<Action, QRect>> actionRects(const QRect &cardRect, const Task *task) const;
+
+    /**
+     * @brief 获取状态颜色
+     */
+    static QColor statusColor(TaskStatus status);
+
+    /**
+     * @brief 获取状态图标
+     */
+    static QString statusIcon(TaskStatus status);
+
+signals:
+    /**
+     * @brief 查看详情按钮点击
+     */
+    void viewDetailsClicked(Task *task);
+
+    /**
+     * @brief 暂停按钮点击
+     */
+    void pauseClicked(Task *task);
+
+    /**
+     * @brief 恢复按钮点击
+     */
+    void resumeClicked(Task *task);
+
+    /**
+     * @brief 取消按钮点击
+     */
+    void cancelClicked(Task *task);
+
+    /**
+     * @brief 删除按钮点击
+     */
+    void deleteClicked(Task *task);
+
+protected:
+    /**
+     * @brief 处理按钮点击和悬停
+     */
+    bool editorEvent(QEvent *event, QAbstractItemModel *model,
+                     const QStyleOptionViewItem &option, const QModelIndex &index) override;
+
+private:
+    /**
+     * @brief 卡片区域（行区域去掉卡片间距）
+     */
+    QRect cardRect(const QRect &rowRect) const;
+
+    static QString actionText(Action action);
+
+private:
+    QFont m_nameFont;
+    QFont m_infoFont;
+    QFont m_buttonFont;             // 状态标签和按钮
+    int m_actionWidths[DeleteAction + 1];
+
+    // 鼠标所在的按钮（用于悬停和按下效果）
+    QPersistentModelIndex m_hoverIndex;
+    int m_hoverAction;
+    bool m_pressed;
+};
+
+#endif // TASKITEMDELEGATE_H
@@ -14,6 +14,7 @@
 #include <QGridLayout>
 #include <QFileDialog>
 #include <QMessageBox>
+#include <QtConcurrent/QtConcurrent>
 
 CreateTaskDialog::CreateTaskDialog(QWidget *parent)
     : QDialog(parent)
@@ -37,6 +38,8 @@ CreateTaskDialog::CreateTaskDialog(QWidget *parent)
     , m_createButton(nullptr)
     , m_cancelButton(nullptr)
     , m_detectStatusLabel(nullptr)
+    , m_sceneDetector(nullptr)
+    , m_detectWatcher(nullptr)
 {
     // 设置对话框属性
     setWindowFlags(Qt::Dialog | Qt::FramelessWindowHint);
@@ -50,6 +53,8 @@ CreateTaskDialog::CreateTaskDialog(QWidget *parent)
 
 CreateTaskDialog::~CreateTaskDialog()
 {
+    // 后台线程仍在使用检测器，必须等它结束
+    stopSceneDetection();
 }
 
 void CreateTaskDialog::paintEvent(QPaintEvent *event)
@@ -83,6 +88,14 @@ void CreateTaskDialog::onBrowseSceneClicked()
 
 void CreateTaskDialog::onDetectSceneClicked()
 {
+    // 检测中再次点击：取消
+    if (m_sceneDetector) {
+        m_sceneDetector->cancel();
+        m_detectButton->setEnabled(false);
+        m_detectStatusLabel->setText(QString::fromUtf8("正在取消..."));
+        return;
+    }
+
     QString sceneFile = m_sceneFileEdit->text().trimmed();
 
     if (sceneFile.isEmpty()) {
@@ -99,44 +112,95 @@ void CreateTaskDialog::onDetectSceneClicked()
 
     m_detectStatusLabel->setText(QString::fromUtf8("🔍 正在检测场景信息..."));
     m_detectStatusLabel->setStyleSheet("color: #0078D4;");
-    m_detectButton->setEnabled(false);
+    m_detectButton->setText(QString::fromUtf8("取消检测"));
+
+    // 大场景解析需要数十秒，放到后台线程执行，界面保持响应
+    m_sceneDetector = new MayaDetector(this);
+    connect(m_sceneDetector, &MayaDetector::detectProgress, this, [this](int progress, const QString &message) {
+        Q_UNUSED(message);
+        if (m_sceneDetector && !m_sceneDetector->isCancelled()) {
+            m_detectStatusLabel->setText(QString::fromUtf8("🔍 正在检测场景信息... %1%").arg(progress));
+        }
+    });
 
-    // 使用 MayaDetector 检测场景信息
-    MayaDetector detector;
+    m_detectWatcher = new QFutureWatcher<SceneDetection>(this);
+    connect(m_detectWatcher, &QFutureWatcher<SceneDetection>::finished,
+            this, &CreateTaskDialog::onDetectSceneFinished);
+
+    MayaDetector *detector = m_sceneDetector;
+    m_detectWatcher->setFuture(QtConcurrent::run([detector, sceneFile]() {
+        SceneDetection detection;
+        detection.info = detector->parseScene(sceneFile);
+        detection.mayaVersion = detection.info.resolvedMayaVersion();
+        detection.renderer = detection.info.format.isEmpty() ? QString() : detection.info.rendererName();
+        detection.missingAssets = detector->detectMissingAssets(detection.info, sceneFile);
+        return detection;
+    }));
+}
+
+void CreateTaskDialog::onDetectSceneFinished()
+{
+    SceneDetection detection = m_detectWatcher->result();
+    bool cancelled = m_sceneDetector->isCancelled();
+
+    m_detectWatcher->deleteLater();
+    m_detectWatcher = nullptr;
+    m_sceneDetector->deleteLater();
+    m_sceneDetector = nullptr;
+
+    m_detectButton->setText(QString::fromUtf8("检测场景信息"));
+    m_detectButton->setEnabled(true);
+
+    if (cancelled) {
+        m_detectStatusLabel->setText(QString::fromUtf8("已取消检测"));
+        m_detectStatusLabel->setStyleSheet("color: #605E5C;");
+        return;
+    }
 
     // 检测 Maya 版本
-    QString mayaVersion = detector.extractMayaVersionFromScene(sceneFile);
-    if (!mayaVersion.isEmpty()) {
+    if (!detection.mayaVersion.isEmpty()) {
         Application::instance().logger()->info("CreateTaskDialog",
-            QString::fromUtf8("检测到 Maya 版本: %1").arg(mayaVersion));
+            QString::fromUtf8("检测到 Maya 版本: %1").arg(detection.mayaVersion));
     }
 
     // 检测渲染器
-    QString renderer = detector.extractRendererFromScene(sceneFile);
-    if (!renderer.isEmpty()) {
+    if (!detection.renderer.isEmpty()) {
         // 在下拉框中选择对应的渲染器
-        int index = m_rendererComboBox->findText(renderer);
+        int index = m_rendererComboBox->findText(detection.renderer);
         if (index >= 0) {
             m_rendererComboBox->setCurrentIndex(index);
         }
         Application::instance().logger()->info("CreateTaskDialog",
-            QString::fromUtf8("检测到渲染器: %1").arg(renderer));
+            QString::fromUtf8("检测到渲染器: %1").arg(detection.renderer));
     }
 
     // 检测缺失资源
-    QStringList missingAssets = detector.detectMissingAssets(sceneFile);
-    if (!missingAssets.isEmpty()) {
-        m_detectStatusLabel->setText(QString::fromUtf8("⚠️ 检测到 %1 个缺失资源").arg(missingAssets.size()));
+    if (!detection.missingAssets.isEmpty()) {
+        m_detectStatusLabel->setText(QString::fromUtf8("⚠️ 检测到 %1 个缺失资源").arg(detection.missingAssets.size()));
         m_detectStatusLabel->setStyleSheet("color: #FFB900;");
 
         Application::instance().logger()->warning("CreateTaskDialog",
-            QString::fromUtf8("缺失资源: %1").arg(missingAssets.join(", ")));
+            QString::fromUtf8("缺失资源: %1").arg(detection.missingAssets.join(", ")));
     } else {
         m_detectStatusLabel->setText(QString::fromUtf8("✅ 场景检测完成，无缺失资源"));
         m_detectStatusLabel->setStyleSheet("color: #107C10;");
     }
+}
 
-    m_detectButton->setEnabled(true);
+void CreateTaskDialog::stopSceneDetection()
+{
+    if (!m_detectWatcher) {
+        return;
+    }
+
+    m_sceneDetector->cancel();
+    m_detectWatcher->disconnect(this);
+    m_detectWatcher->waitForFinished();
+
+    delete m_detectWatcher;
+    m_detectWatcher = nullptr;
+    delete m_sceneDetector;
+    m_sceneDetector = nullptr;
 }
 
 void CreateTaskDialog::onCreateClicked()
@@ -145,12 +209,14 @@ void CreateTaskDialog::onCreateClicked()
         return;
     }
 
+    stopSceneDetection();
     createTask();
     accept();
 }
 
 void CreateTaskDialog::onCancelClicked()
 {
+    stopSceneDetection();
     reject();
 }
 
@@ -12,10 +12,14 @@
 #include <QHBoxLayout>
 #include <QComboBox>
 #include <QSpinBox>
+#include <QFutureWatcher>
 #include "../components/FluentButton.h"
 #include "../components/FluentLineEdit.h"
 #include "../../models/Task.h"
 #include "../../models/RenderConfig.h"
+#include "../../services/SceneInfo.h"
+
+class MayaDetector;
 
 /**
  * @brief 新建任务对话框
@@ -52,10 +56,15 @@ private slots:
     void onBrowseSceneClicked();
 
     /**
-     * @brief 检测场景信息
+     * @brief 检测场景信息（检测中再次点击则取消）
      */
     void onDetectSceneClicked();
 
+    /**
+     * @brief 后台场景检测完成
+     */
+    void onDetectSceneFinished();
+
     /**
      * @brief 创建任务
      */
@@ -67,6 +76,21 @@ private slots:
     void onCancelClicked();
 
 private:
+    /**
+     * @brief 后台场景检测结果
+     */
+    struct SceneDetection {
+        SceneInfo info;
+        QString mayaVersion;
+        QString renderer;
+        QStringList missingAssets;
+    };
+
+    /**
+     * @brief 取消并等待后台场景检测结束
+     */
+    void stopSceneDetection();
+
     /**
      * @brief 初始化 UI
      */
@@ -122,6 +146,8 @@ private:
 
     // 检测状态
     QLabel *m_detectStatusLabel;
+    MayaDetector *m_sceneDetector;
+    QFutureWatcher<SceneDetection> *m_detectWatcher;
 };
 
 #endif // CREATETASKDIALOG_H
@@ -7,11 +7,12 @@
 #include "CreateTaskDialog.h"
 #include "TaskDetailDialog.h"
 #include "../ThemeManager.h"
-#include "../components/TaskItemWidget.h"
+#include "../components/TaskItemDelegate.h"
 #include "../../managers/AuthManager.h"
 #include "../../managers/TaskManager.h"
 #include "../../managers/UserManager.h"
 #include "../../models/Task.h"
+#include "../../models/TaskListModel.h"
 #include "../../core/Logger.h"
 #include "../../core/Application.h"
 #include <QPainter>
@@ -19,7 +20,8 @@
 #include <QMouseEvent>
 #include <QScreen>
 #include <QApplication>
-#include <QScrollArea>
+#include <QListView>
+#include <QScrollBar>
 
 MainWindow::MainWindow(QWidget *parent)
     : QWidget(parent)
@@ -41,6 +43,9 @@ MainWindow::MainWindow(QWidget *parent)
     , m_aboutPage(nullptr)
     , m_createTaskButton(nullptr)
     , m_refreshButton(nullptr)
+    , m_taskListView(nullptr)
+    , m_taskListModel(nullptr)
+    , m_taskDelegate(nullptr)
     , m_mainLayout(nullptr)
 {
     initUI();
@@ -356,93 +361,24 @@ QWidget* MainWindow::createTaskPage()
     toolbarLayout->addWidget(m_refreshButton);
     toolbarLayout->addWidget(m_createTaskButton);
 
-    // 任务列表容器（使用滚动区域）
-    QScrollArea *scrollArea = new QScrollArea(page);
-    scrollArea->setFrameShape(QFrame::NoFrame);
-    scrollArea->setWidgetResizable(true);
-    scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-
-    QWidget *scrollContent = new QWidget(scrollArea);
-    QVBoxLayout *taskListLayout = new QVBoxLayout(scrollContent);
-    taskListLayout->setContentsMargins(0, 0, 0, 0);
-    taskListLayout->setSpacing(12);
-
-    // 创建演示任务 1 - 渲染中
-    Task *task1 = new Task(this);
-    task1->setTaskId("demo_task_001");
-    task1->setTaskName(QString::fromUtf8("渲染场景 - 办公室内景"));
-    task1->setSceneFile("C:/Projects/Maya/office_scene.ma");
-    task1->setStatus(TaskStatus::Rendering);
-    task1->setProgress(65);
-    task1->setStartFrame(1);
-    task1->setEndFrame(240);
-    task1->setFrameStep(1);
-    task1->setWidth(1920);
-    task1->setHeight(1080);
-    task1->setRenderer("Arnold");
-    task1->setOutputFormat("exr");
-    task1->setCreatedAt(QDateTime::currentDateTime().addSecs(-3600));
-    task1->setStartedAt(QDateTime::currentDateTime().addSecs(-1800));
-    task1->setEstimatedCost(45.50);
-
-    TaskItemWidget *taskItem1 = new TaskItemWidget(task1, scrollContent);
-    connect(taskItem1, &TaskItemWidget::viewDetailsClicked,
-            this, &MainWindow::onViewTaskDetails);
-    taskListLayout->addWidget(taskItem1);
-
-    // 创建演示任务 2 - 队列中
-    Task *task2 = new Task(this);
-    task2->setTaskId("demo_task_002");
-    task2->setTaskName(QString::fromUtf8("产品展示动画"));
-    task2->setSceneFile("C:/Projects/Maya/product_showcase.ma");
-    task2->setStatus(TaskStatus::Queued);
-    task2->setProgress(0);
-    task2->setStartFrame(1);
-    task2->setEndFrame(180);
-    task2->setFrameStep(1);
-    task2->setWidth(1920);
-    task2->setHeight(1080);
-    task2->setRenderer("V-Ray");
-    task2->setOutputFormat("png");
-    task2->setCreatedAt(QDateTime::currentDateTime().addSecs(-600));
-    task2->setEstimatedCost(32.00);
-
-    TaskItemWidget *taskItem2 = new TaskItemWidget(task2, scrollContent);
-    connect(taskItem2, &TaskItemWidget::viewDetailsClicked,
-            this, &MainWindow::onViewTaskDetails);
-    taskListLayout->addWidget(taskItem2);
-
-    // 创建演示任务 3 - 已完成
-    Task *task3 = new Task(this);
-    task3->setTaskId("demo_task_003");
-    task3->setTaskName(QString::fromUtf8("建筑外观渲染"));
-    task3->setSceneFile("C:/Projects/Maya/building_exterior.ma");
-    task3->setStatus(TaskStatus::Completed);
-    task3->setProgress(100);
-    task3->setStartFrame(1);
-    task3->setEndFrame(120);
-    task3->setFrameStep(1);
-    task3->setWidth(3840);
-    task3->setHeight(2160);
-    task3->setRenderer("Arnold");
-    task3->setOutputFormat("exr");
-    task3->setCreatedAt(QDateTime::currentDateTime().addSecs(-7200));
-    task3->setStartedAt(QDateTime::currentDateTime().addSecs(-6000));
-    task3->setCompletedAt(QDateTime::currentDateTime().addSecs(-300));
-    task3->setEstimatedCost(68.00);
-    task3->setActualCost(65.50);
-
-    TaskItemWidget *taskItem3 = new TaskItemWidget(task3, scrollContent);
-    connect(taskItem3, &TaskItemWidget::viewDetailsClicked,
-            this, &MainWindow::onViewTaskDetails);
-    taskListLayout->addWidget(taskItem3);
-
-    taskListLayout->addStretch();
-
-    scrollArea->setWidget(scrollContent);
+    // 任务列表（模型/委托绘制，只有可见的行才有开销）
+    m_taskListModel = new TaskListModel(true, this);
+    m_taskDelegate = new TaskItemDelegate(this);
+
+    m_taskListView = new QListView(page);
+    m_taskListView->setFrameShape(QFrame::NoFrame);
+    m_taskListView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    m_taskListView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    m_taskListView->verticalScrollBar()->setSingleStep(24);
+    m_taskListView->setSelectionMode(QAbstractItemView::NoSelection);
+    m_taskListView->setUniformItemSizes(true);
+    m_taskListView->setMouseTracking(true);
+    m_taskListView->setStyleSheet("QListView { background: transparent; }");
+    m_taskListView->setItemDelegate(m_taskDelegate);
+    m_taskListView->setModel(m_taskListModel);
 
     layout->addLayout(toolbarLayout);
-    layout->addWidget(scrollArea);
+    layout->addWidget(m_taskListView);
 
     return page;
 }
@@ -529,6 +465,34 @@ void MainWindow::connectSignals()
     connect(m_refreshButton, &FluentButton::clicked,
             this, &MainWindow::onRefreshClicked);
 
+    // 任务列表操作
+    connect(m_taskDelegate, &TaskItemDelegate::viewDetailsClicked,
+            this, &MainWindow::onViewTaskDetails);
+    connect(m_taskListView, &QListView::doubleClicked, this, [this](const QModelIndex &index) {
+        onViewTaskDetails(m_taskListModel->taskAt(index.row()));
+    });
+    connect(m_taskDelegate, &TaskItemDelegate::pauseClicked, this, [](Task *task) {
+        TaskManager::instance().pauseTask(task->taskId());
+    });
+    connect(m_taskDelegate, &TaskItemDelegate::resumeClicked, this, [](Task *task) {
+        TaskManager::instance().resumeTask(task->taskId());
+    });
+    // 上传中的任务还没有服务器 ID，取消和删除只在本地进行
+    connect(m_taskDelegate, &TaskItemDelegate::cancelClicked, this, [](Task *task) {
+        if (task->taskId().isEmpty()) {
+            TaskManager::instance().cancelUpload(task);
+        } else {
+            TaskManager::instance().cancelTask(task->taskId());
+        }
+    });
+    connect(m_taskDelegate, &TaskItemDelegate::deleteClicked, this, [](Task *task) {
+        if (task->taskId().isEmpty()) {
+            TaskManager::instance().removeLocalTask(task);
+        } else {
+            TaskManager::instance().deleteTask(task->taskId());
+        }
+    });
+
     // 主题变更时更新样式
     connect(&ThemeManager::instance(), &ThemeManager::themeChanged,
             this, [this](ThemeType theme) {
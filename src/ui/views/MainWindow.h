@@ -17,6 +17,9 @@
 
 // 前向声明
 class Task;
+class QListView;
+class TaskListModel;
+class TaskItemDelegate;
 
 /**
  * @brief 主窗口
@@ -175,6 +178,9 @@ private:
     // 任务页面组件
     FluentButton *m_createTaskButton;
     FluentButton *m_refreshButton;
+    QListView *m_taskListView;
+    TaskListModel *m_taskListModel;
+    TaskItemDelegate *m_taskDelegate;
 
     // 布局
     QVBoxLayout *m_mainLayout;
@@ -16,7 +16,6 @@
 #include <QTextStream>
 #include <QMessageBox>
 #include <QScrollBar>
-#include <QApplication>
 #include <QTimer>
 #include <QSet>
 #include <QStandardPaths>
@@ -36,11 +35,12 @@ MayaDetectionDialog::MayaDetectionDialog(QWidget *parent)
     , m_isDetecting(false)
 {
     initUI();
-    connectSignals();
 
-    // 创建检测器
+    // 创建检测器（连接信号前）
     m_detector = new MayaDetector(this);
 
+    connectSignals();
+
     // 设置窗口属性
     setWindowTitle(QString::fromUtf8("Maya 环境检测"));
     setMinimumSize(900, 700);
@@ -62,9 +62,28 @@ MayaDetectionDialog::MayaDetectionDialog(QWidget *parent)
 
 MayaDetectionDialog::~MayaDetectionDialog()
 {
+    if (m_detector && m_detector->isDetecting()) {
+        // 检测阶段可能正在等待 Maya 进程，不在界面线程等待：
+        // 检测器脱离对话框，取消后所有阶段结束时自行删除
+        disconnect(m_detector, nullptr, this, nullptr);
+        m_detector->setParent(nullptr);
+        connect(m_detector, &MayaDetector::detectionCancelled, m_detector, &QObject::deleteLater);
+        connect(m_detector, &MayaDetector::detectionCompleted, m_detector, &QObject::deleteLater);
+        m_detector->cancelDetection();
+
+        // 连接之前检测已经结束时不会再有信号
+        if (!m_detector->isDetecting()) {
+            m_detector->deleteLater();
+        }
+    }
 }
 
 void MayaDetectionDialog::onStartDetection()
+{
+    startDetection(false);
+}
+
+void MayaDetectionDialog::startDetection(bool forceRescan)
 {
     if (m_isDetecting) {
         return;
@@ -100,16 +119,14 @@ void MayaDetectionDialog::onStartDetection()
     Application::instance().logger()->info("MayaDetectionDialog",
         QString::fromUtf8("开始 Maya 环境检测"));
 
-    // 在后台线程执行检测（使用 QtConcurrent）
-    QTimer::singleShot(100, this, [this]() {
-        m_detectedMayaVersions = m_detector->detectAllMayaVersions();
-        onDetectFinished();
-    });
+    // 检测在后台线程池中分阶段执行，结果通过信号逐个返回
+    m_detector->startDetection(forceRescan);
 }
 
 void MayaDetectionDialog::onRefreshClicked()
 {
-    onStartDetection();
+    // 手动刷新时忽略安装索引，重新完整扫描
+    startDetection(true);
 }
 
 void MayaDetectionDialog::onExportResults()
@@ -162,14 +179,38 @@ void MayaDetectionDialog::onDetectProgress(int progress, const QString &message)
 {
     m_progressBar->setValue(progress);
     m_statusLabel->setText(message);
-    m_resultText->append(QString::fromUtf8("[%1%] %2").arg(progress).arg(message));
+    appendLine(QString::fromUtf8("[%1%] %2").arg(progress).arg(message));
+}
+
+void MayaDetectionDialog::onMayaVersionFound(const MayaSoftwareInfo &info)
+{
+    appendLine(QString::fromUtf8("✓ 发现 Maya %1: %2").arg(info.version).arg(info.installPath));
+}
+
+void MayaDetectionDialog::onRendererDetected(const QString &installPath, const RendererInfo &renderer)
+{
+    appendLine(QString::fromUtf8("   🎨 渲染器 %1 %2 (%3)").arg(renderer.name).arg(renderer.version).arg(installPath));
+}
+
+void MayaDetectionDialog::onMayaVersionDetected(const MayaSoftwareInfo &info)
+{
+    appendLine(QString::fromUtf8("✅ Maya %1 检测完成: %2 个渲染器, %3 个插件")
+        .arg(info.version).arg(info.renderers.size()).arg(info.plugins.size()));
+}
+
+void MayaDetectionDialog::onDetectionCompleted(const QVector<MayaSoftwareInfo> &results)
+{
+    m_detectedMayaVersions = results;
+    onDetectFinished();
+}
+
+void MayaDetectionDialog::appendLine(const QString &text)
+{
+    m_resultText->append(text);
 
     // 自动滚动到底部
     QScrollBar *scrollBar = m_resultText->verticalScrollBar();
     scrollBar->setValue(scrollBar->maximum());
-
-    // 处理事件，确保界面刷新
-    QApplication::processEvents();
 }
 
 void MayaDetectionDialog::onDetectFinished()
@@ -290,8 +331,17 @@ void MayaDetectionDialog::connectSignals()
     connect(m_detector, &MayaDetector::detectProgress,
             this, &MayaDetectionDialog::onDetectProgress);
 
-    connect(m_detector, &MayaDetector::detectFinished,
-            this, &MayaDetectionDialog::onDetectFinished);
+    connect(m_detector, &MayaDetector::mayaVersionFound,
+            this, &MayaDetectionDialog::onMayaVersionFound);
+
+    connect(m_detector, &MayaDetector::rendererDetected,
+            this, &MayaDetectionDialog::onRendererDetected);
+
+    connect(m_detector, &MayaDetector::mayaVersionDetected,
+            this, &MayaDetectionDialog::onMayaVersionDetected);
+
+    connect(m_detector, &MayaDetector::detectionCompleted,
+            this, &MayaDetectionDialog::onDetectionCompleted);
 }
 
 void MayaDetectionDialog::displayResults(const QVector<MayaSoftwareInfo> &mayaVersions)
@@ -59,7 +59,38 @@ private slots:
      */
     void onDetectFinished();
 
+    /**
+     * @brief 确认了一个 Maya 安装（检测过程中逐个显示）
+     */
+    void onMayaVersionFound(const MayaSoftwareInfo &info);
+
+    /**
+     * @brief 找到一个渲染器
+     */
+    void onRendererDetected(const QString &installPath, const RendererInfo &renderer);
+
+    /**
+     * @brief 一个 Maya 安装检测完成
+     */
+    void onMayaVersionDetected(const MayaSoftwareInfo &info);
+
+    /**
+     * @brief 全部检测完成
+     */
+    void onDetectionCompleted(const QVector<MayaSoftwareInfo> &results);
+
 private:
+    /**
+     * @brief 开始检测
+     * @param forceRescan 是否忽略安装索引完整扫描
+     */
+    void startDetection(bool forceRescan);
+
+    /**
+     * @brief 追加一行检测过程信息并滚动到底部
+     */
+    void appendLine(const QString &text);
+
     /**
      * @brief 初始化 UI
      */
@@ -101,7 +101,11 @@ void TaskDetailDialog::onCancelClicked()
             QMessageBox::Yes | QMessageBox::No);
 
         if (reply == QMessageBox::Yes) {
-            TaskManager::instance().cancelTask(m_task->taskId());
+            if (m_task->taskId().isEmpty()) {
+                TaskManager::instance().cancelUpload(m_task);  // 上传中，还没有服务器 ID
+            } else {
+                TaskManager::instance().cancelTask(m_task->taskId());
+            }
             Application::instance().logger()->info("TaskDetailDialog",
                 QString::fromUtf8("取消任务: %1").arg(m_task->taskId()));
         }
@@ -428,8 +432,9 @@ void TaskDetailDialog::updateButtons()
 {
     if (!m_task) return;
 
-    m_pauseButton->setVisible(m_task->canPause());
-    m_resumeButton->setVisible(m_task->canResume());
+    bool onServer = !m_task->taskId().isEmpty();
+    m_pauseButton->setVisible(onServer && m_task->canPause());
+    m_resumeButton->setVisible(onServer && m_task->canResume());
     m_cancelButton->setVisible(m_task->canCancel());
 
     // 下载按钮仅在任务完成时可用